@@ -36,6 +36,7 @@
 #include "utils/LogSinkOgre.h"
 #include "utils/Random.h"
 #include "utils/ResourceManager.h"
+#include "utils/Tracing.h"
 
 #include <OgreRenderWindow.h>
 #include <OgreRoot.h>
@@ -70,6 +71,13 @@ void ODApplication::startGame(boost::program_options::variables_map& options)
     logMgr.addSink(std::unique_ptr<LogSink>(new LogSinkConsole()));
     logMgr.addSink(std::unique_ptr<LogSink>(new LogSinkFile(resMgr.getLogFile())));
 
+    // Traces can be dumped with the "trace" console command or by sending SIGUSR1
+    Tracing::setThreadName("Main");
+    Tracing::setDefaultDumpFile(resMgr.getUserDataPath() + "trace.json");
+    Tracing::installSignalHandler();
+    if(resMgr.getTraceAtStartup())
+        Tracing::start();
+
     if(resMgr.isServerMode())
         startServer();
     else
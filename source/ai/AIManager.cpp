@@ -19,9 +19,19 @@
 
 #include "ai/AIFactory.h"
 #include "ai/BaseAI.h"
+#include "game/Player.h"
+#include "game/Seat.h"
+#include "utils/Helper.h"
+
+#include <algorithm>
+#include <chrono>
+
+//! \brief Default time an AI may spend per turn (in microseconds)
+static const uint32_t DEFAULT_AI_TURN_BUDGET = 2000;
 
 AIManager::AIManager(GameMap& gameMap)
-    : mGameMap(gameMap)
+    : mGameMap(gameMap),
+      mTurnBudget(DEFAULT_AI_TURN_BUDGET)
 {
 }
 
@@ -37,18 +47,59 @@ bool AIManager::assignAI(Player& player, KeeperAIType type)
         return false;
 
     mAiList.push_back(ai);
+    mAiStats.push_back(AIStats());
     return true;
 }
 
 bool AIManager::doTurn(double timeSinceLastTurn)
 {
-    for(BaseAI* ai : mAiList)
+    for(uint32_t i = 0; i < mAiList.size(); ++i)
     {
+        BaseAI* ai = mAiList[i];
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        ai->startTurnBudget(mTurnBudget);
         ai->doTurn(timeSinceLastTurn);
+        uint64_t duration = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - start).count());
+
+        AIStats& stats = mAiStats[i];
+        stats.mLastTurn = duration;
+        stats.mMaxTurn = std::max(stats.mMaxTurn, duration);
+        stats.mTotal += duration;
+        ++stats.mNbTurns;
+        if(duration > mTurnBudget)
+            ++stats.mNbTurnsOverBudget;
     }
     return true;
 }
 
+std::string AIManager::getStatsText() const
+{
+    std::string text = "AI turn budget: " + Helper::toString(mTurnBudget) + " us";
+    if(mAiList.empty())
+        return text + "\nNo AI";
+
+    for(uint32_t i = 0; i < mAiList.size(); ++i)
+    {
+        Player& player = mAiList[i]->getPlayer();
+        const AIStats& stats = mAiStats[i];
+        uint64_t average = (stats.mNbTurns == 0) ? 0 : stats.mTotal / stats.mNbTurns;
+        text += "\nSeat " + Helper::toString(player.getSeat()->getId()) + " (" + player.getNick() + ")"
+            + ": last=" + Helper::toString(stats.mLastTurn) + " us"
+            + ", avg=" + Helper::toString(average) + " us"
+            + ", max=" + Helper::toString(stats.mMaxTurn) + " us"
+            + ", turns=" + Helper::toString(stats.mNbTurns)
+            + ", over budget=" + Helper::toString(stats.mNbTurnsOverBudget);
+    }
+    return text;
+}
+
+void AIManager::tileStateChanged(Tile& tile)
+{
+    for(BaseAI* ai : mAiList)
+        ai->tileStateChanged(tile);
+}
+
 void AIManager::clearAIList()
 {
     for(BaseAI* ai : mAiList)
@@ -56,4 +107,5 @@ void AIManager::clearAIList()
         delete ai;
     }
     mAiList.clear();
+    mAiStats.clear();
 }
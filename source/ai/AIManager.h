@@ -18,11 +18,14 @@
 #ifndef AIMANAGER_H
 #define AIMANAGER_H
 
+#include <cstdint>
+#include <string>
 #include <vector>
 
 class BaseAI;
 class GameMap;
 class Player;
+class Tile;
 
 enum class KeeperAIType;
 
@@ -39,9 +42,46 @@ public:
     bool doTurn(double timeSinceLastTurn);
     void clearAIList();
 
+    //! \brief Forwards the tile change to every AI
+    void tileStateChanged(Tile& tile);
+
+    //! \brief Time (in microseconds) each AI may spend per turn. Long searches that exceed it
+    //! are continued during the next turns
+    inline uint32_t getTurnBudget() const
+    { return mTurnBudget; }
+
+    inline void setTurnBudget(uint32_t budgetMicroseconds)
+    { mTurnBudget = budgetMicroseconds; }
+
+    //! \brief Returns a text describing the time spent by each AI
+    std::string getStatsText() const;
+
 private:
+    //! \brief Time spent by an AI in doTurn (in microseconds)
+    struct AIStats
+    {
+        AIStats() :
+            mLastTurn(0),
+            mMaxTurn(0),
+            mTotal(0),
+            mNbTurns(0),
+            mNbTurnsOverBudget(0)
+        {}
+
+        uint64_t mLastTurn;
+        uint64_t mMaxTurn;
+        uint64_t mTotal;
+        uint32_t mNbTurns;
+        uint32_t mNbTurnsOverBudget;
+    };
+
     GameMap& mGameMap;
     AIList mAiList;
+
+    //! \brief Stats of the AIs. Same order as mAiList
+    std::vector<AIStats> mAiStats;
+
+    uint32_t mTurnBudget;
 };
 
 #endif // AIMANAGER_H
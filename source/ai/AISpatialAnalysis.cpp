@@ -0,0 +1,237 @@
+/*!
+ *  Copyright (C) 2011-2016  OpenDungeons Team
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "ai/AISpatialAnalysis.h"
+
+#include "entities/Tile.h"
+#include "game/Player.h"
+#include "gamemap/GameMap.h"
+#include "utils/Helper.h"
+#include "utils/LogManager.h"
+
+AISpatialAnalysis::AISpatialAnalysis(GameMap& gameMap, Player& player) :
+    mGameMap(gameMap),
+    mPlayer(player),
+    mMapSizeX(0),
+    mMapSizeY(0),
+    mNeedsFullRefresh(true),
+    mSumsOutdated(true)
+{
+}
+
+void AISpatialAnalysis::tileStateChanged(Tile& tile)
+{
+    // If everything will be recomputed, no need to remember the tile
+    if(mNeedsFullRefresh)
+        return;
+
+    if((tile.getX() >= mMapSizeX) || (tile.getY() >= mMapSizeY))
+    {
+        mNeedsFullRefresh = true;
+        return;
+    }
+
+    // The flags of a ground tile depend on its neighbors
+    if(!mIsTileDirty[tile.getX() + tile.getY() * mMapSizeX])
+    {
+        mIsTileDirty[tile.getX() + tile.getY() * mMapSizeX] = true;
+        mDirtyTiles.push_back(&tile);
+    }
+    for(Tile* neigh : tile.getAllNeighbors())
+    {
+        int32_t index = neigh->getX() + neigh->getY() * mMapSizeX;
+        if(mIsTileDirty[index])
+            continue;
+
+        mIsTileDirty[index] = true;
+        mDirtyTiles.push_back(neigh);
+    }
+}
+
+bool AISpatialAnalysis::isInMap(int32_t x, int32_t y) const
+{
+    return (x >= 0) && (y >= 0) && (x < mGameMap.getMapSizeX()) && (y < mGameMap.getMapSizeY());
+}
+
+int32_t AISpatialAnalysis::countBuildableGroundTiles(int32_t x1, int32_t y1, int32_t x2, int32_t y2)
+{
+    update();
+    return sumRectangle(mBuildableGroundSums, x1, y1, x2, y2);
+}
+
+int32_t AISpatialAnalysis::countUsableWallTiles(int32_t x1, int32_t y1, int32_t x2, int32_t y2)
+{
+    update();
+    return sumRectangle(mUsableWallSums, x1, y1, x2, y2);
+}
+
+bool AISpatialAnalysis::isUsableWallTile(int32_t x, int32_t y)
+{
+    if(!isInMap(x, y))
+        return false;
+
+    update();
+    return (mFlags[x + y * mMapSizeX] & usableWall) != 0;
+}
+
+void AISpatialAnalysis::update()
+{
+    if((mMapSizeX != mGameMap.getMapSizeX()) || (mMapSizeY != mGameMap.getMapSizeY()))
+        mNeedsFullRefresh = true;
+
+    if(mNeedsFullRefresh)
+    {
+        mNeedsFullRefresh = false;
+        mMapSizeX = mGameMap.getMapSizeX();
+        mMapSizeY = mGameMap.getMapSizeY();
+        size_t nbTiles = static_cast<size_t>(mMapSizeX * mMapSizeY);
+        mFlags.assign(nbTiles, 0);
+        mIsTileDirty.assign(nbTiles, false);
+        mDirtyTiles.clear();
+        for(int32_t yy = 0; yy < mMapSizeY; ++yy)
+        {
+            for(int32_t xx = 0; xx < mMapSizeX; ++xx)
+            {
+                Tile* tile = mGameMap.getTile(xx, yy);
+                if(tile == nullptr)
+                    continue;
+
+                computeFlags(*tile);
+            }
+        }
+        mSumsOutdated = true;
+    }
+
+    for(Tile* tile : mDirtyTiles)
+    {
+        mIsTileDirty[tile->getX() + tile->getY() * mMapSizeX] = false;
+        computeFlags(*tile);
+    }
+    mDirtyTiles.clear();
+
+    if(mSumsOutdated)
+        computeSums();
+}
+
+void AISpatialAnalysis::computeFlags(Tile& tile)
+{
+    uint8_t flags = 0;
+    if(isGroundTileBuildable(tile, mPlayer))
+        flags |= buildableGround;
+    if(isWallTileUsable(tile, mPlayer))
+        flags |= usableWall;
+
+    uint8_t& currentFlags = mFlags[tile.getX() + tile.getY() * mMapSizeX];
+    if(currentFlags == flags)
+        return;
+
+    currentFlags = flags;
+    mSumsOutdated = true;
+}
+
+void AISpatialAnalysis::computeSums()
+{
+    // Rebuilding both tables is a single pass on the map. That is done at most once per query
+    // and only if a tile changed since the last one
+    mSumsOutdated = false;
+    int32_t width = mMapSizeX + 1;
+    size_t nbSums = static_cast<size_t>(width * (mMapSizeY + 1));
+    mBuildableGroundSums.assign(nbSums, 0);
+    mUsableWallSums.assign(nbSums, 0);
+    for(int32_t yy = 0; yy < mMapSizeY; ++yy)
+    {
+        int32_t groundRow = 0;
+        int32_t wallRow = 0;
+        for(int32_t xx = 0; xx < mMapSizeX; ++xx)
+        {
+            uint8_t flags = mFlags[xx + yy * mMapSizeX];
+            if((flags & buildableGround) != 0)
+                ++groundRow;
+            if((flags & usableWall) != 0)
+                ++wallRow;
+
+            int32_t index = (xx + 1) + (yy + 1) * width;
+            mBuildableGroundSums[index] = mBuildableGroundSums[index - width] + groundRow;
+            mUsableWallSums[index] = mUsableWallSums[index - width] + wallRow;
+        }
+    }
+}
+
+int32_t AISpatialAnalysis::sumRectangle(const std::vector<int32_t>& sums, int32_t x1, int32_t y1, int32_t x2, int32_t y2) const
+{
+    if(!isInMap(x1, y1) || !isInMap(x2, y2) || (x1 > x2) || (y1 > y2))
+    {
+        OD_LOG_ERR("Wrong rectangle x1=" + Helper::toString(x1) + ", y1=" + Helper::toString(y1)
+            + ", x2=" + Helper::toString(x2) + ", y2=" + Helper::toString(y2));
+        return 0;
+    }
+
+    int32_t width = mMapSizeX + 1;
+    return sums[(x2 + 1) + (y2 + 1) * width] - sums[x1 + (y2 + 1) * width]
+        - sums[(x2 + 1) + y1 * width] + sums[x1 + y1 * width];
+}
+
+bool AISpatialAnalysis::isGroundTileBuildable(Tile& tile, Player& player)
+{
+    Seat* seat = player.getSeat();
+    switch(tile.getType())
+    {
+        case TileType::dirt:
+        case TileType::gold:
+        {
+            // Dirt and gold can always be built (even if digging may be needed depending on fullness)
+            if(!tile.isClaimed())
+                return true;
+
+            // We check if we can build on that tile and if there is no building currently
+            if(!tile.isClaimedForSeat(seat))
+                return false;
+            if(tile.getCoveringBuilding() != nullptr)
+                return false;
+
+            // We don't want to break a wall where there are activespots from another one
+            for(Tile* t : tile.getAllNeighbors())
+            {
+                if(t->isClaimedForSeat(seat) &&
+                    (t->getCoveringRoom() != nullptr))
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+        default:
+            return false;
+    }
+
+    return false;
+}
+
+bool AISpatialAnalysis::isWallTileUsable(Tile& tile, Player& player)
+{
+    // We only consider wall claimed for the correct seat or dirt (that can be claimed)
+    if(tile.getFullness() <= 0.0)
+        return false;
+
+    if(tile.getType() == TileType::dirt)
+        return true;
+
+    if(tile.isWallClaimedForSeat(player.getSeat()))
+        return true;
+
+    return false;
+}
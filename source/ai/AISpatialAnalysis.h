@@ -0,0 +1,100 @@
+/*!
+ *  Copyright (C) 2011-2016  OpenDungeons Team
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef AISPATIALANALYSIS_H
+#define AISPATIALANALYSIS_H
+
+#include <cstdint>
+#include <vector>
+
+class GameMap;
+class Player;
+class Tile;
+
+//! \brief Keeps, for the seat of an AI player, which tiles could be used to build a room and which
+//! walls could hold active spots. The flags are only recomputed for the tiles that changed (claimed,
+//! dug, covered by a building, ...) and summed-area tables are kept on top of them so that the number
+//! of buildable or wall tiles in any rectangle can be known in constant time.
+class AISpatialAnalysis
+{
+public:
+    AISpatialAnalysis(GameMap& gameMap, Player& player);
+
+    //! \brief Called on the server when the given tile changed in a way that may change its flags
+    void tileStateChanged(Tile& tile);
+
+    //! \brief Returns the number of tiles where a room could be built for the seat in the given
+    //! rectangle (bounds included). The rectangle should be inside the map
+    int32_t countBuildableGroundTiles(int32_t x1, int32_t y1, int32_t x2, int32_t y2);
+
+    //! \brief Returns the number of walls that could hold active spots in the given rectangle
+    int32_t countUsableWallTiles(int32_t x1, int32_t y1, int32_t x2, int32_t y2);
+
+    //! \brief Returns true if the given tile could hold active spots. False if it is not usable
+    //! or outside the map
+    bool isUsableWallTile(int32_t x, int32_t y);
+
+    //! \brief Returns true if the given coordinates are within the map
+    bool isInMap(int32_t x, int32_t y) const;
+
+private:
+    enum TileFlag : uint8_t
+    {
+        buildableGround = 0x01,
+        usableWall = 0x02
+    };
+
+    GameMap& mGameMap;
+    Player& mPlayer;
+
+    int32_t mMapSizeX;
+    int32_t mMapSizeY;
+
+    //! \brief TileFlag values for each tile (indexed by x + y * mMapSizeX)
+    std::vector<uint8_t> mFlags;
+
+    //! \brief Summed-area tables of the buildableGround and usableWall flags. They have one more
+    //! row and column than the map so that the sums for index 0 are always 0
+    std::vector<int32_t> mBuildableGroundSums;
+    std::vector<int32_t> mUsableWallSums;
+
+    //! \brief Tiles to recompute before the next query. mIsTileDirty avoids duplicates
+    std::vector<Tile*> mDirtyTiles;
+    std::vector<bool> mIsTileDirty;
+
+    //! \brief true if every flag has to be recomputed (like when the map is not known yet)
+    bool mNeedsFullRefresh;
+
+    //! \brief true if some flags changed since the summed-area tables were computed
+    bool mSumsOutdated;
+
+    //! \brief Processes the dirty tiles and recomputes the summed-area tables if needed
+    void update();
+
+    void computeFlags(Tile& tile);
+    void computeSums();
+
+    int32_t sumRectangle(const std::vector<int32_t>& sums, int32_t x1, int32_t y1, int32_t x2, int32_t y2) const;
+
+    //! \brief Returns true if a room could be built on the given tile (even if digging is needed)
+    static bool isGroundTileBuildable(Tile& tile, Player& player);
+
+    //! \brief Returns true if the given tile is a wall that could be claimed by the seat
+    static bool isWallTileUsable(Tile& tile, Player& player);
+};
+
+#endif // AISPATIALANALYSIS_H
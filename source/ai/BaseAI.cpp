@@ -33,15 +33,24 @@
 #include "utils/Helper.h"
 #include "utils/LogManager.h"
 
+#include <algorithm>
+
 const int32_t pointsPerWallSpot = 50;
 const int32_t handicapPerTileOffset = 20;
 
 BaseAI::BaseAI(GameMap& gameMap, Player& player):
     mGameMap(gameMap),
-    mPlayer(player)
+    mPlayer(player),
+    mSpatialAnalysis(gameMap, player),
+    mHasTurnBudget(false)
 {
 }
 
+void BaseAI::tileStateChanged(Tile& tile)
+{
+    mSpatialAnalysis.tileStateChanged(tile);
+}
+
 Room* BaseAI::getDungeonTemple()
 {
     std::vector<Room*> dt = mGameMap.getRoomsByTypeAndSeat(RoomType::dungeonTemple, mPlayer.getSeat());
@@ -51,221 +60,210 @@ Room* BaseAI::getDungeonTemple()
         return nullptr;
 }
 
-bool BaseAI::shouldGroundTileBeConsideredForBestPlaceForRoom(Tile* tile, Seat* mPlayerSeat)
+void BaseAI::startTurnBudget(uint32_t budgetMicroseconds)
 {
-    switch(tile->getType())
-    {
-        case TileType::dirt:
-        case TileType::gold:
-        {
-            // Dirt and gold can always be built (even if digging may be needed depending on fullness)
-            if(!tile->isClaimed())
-                return true;
-
-            // We check if we can build on that tile and if there is no building currently
-            if(!tile->isClaimedForSeat(mPlayerSeat))
-                return false;
-            if(tile->getCoveringBuilding() != nullptr)
-                return false;
-
-            // We don't want to break a wall where there are activespots from another one
-            for(Tile* t : tile->getAllNeighbors())
-            {
-                if(t->isClaimedForSeat(mPlayerSeat) &&
-                    (t->getCoveringRoom() != nullptr))
-                {
-                    return false;
-                }
-            }
-            return true;
-        }
-        default:
-            return false;
-    }
-
-    return false;
+    mHasTurnBudget = (budgetMicroseconds > 0);
+    mTurnDeadline = std::chrono::steady_clock::now() + std::chrono::microseconds(budgetMicroseconds);
 }
 
-bool BaseAI::shouldWallTileBeConsideredForBestPlaceForRoom(Tile* tile, Seat* mPlayerSeat)
+bool BaseAI::isTurnBudgetExhausted() const
 {
-    // We only consider wall claimed for the correct seat or dirt (that can be claimed)
-    if(tile->getFullness() <= 0.0)
+    if(!mHasTurnBudget)
         return false;
 
-    if(tile->getType() == TileType::dirt)
-        return true;
-
-    if(tile->isWallClaimedForSeat(mPlayerSeat))
-        return true;
+    return std::chrono::steady_clock::now() >= mTurnDeadline;
+}
 
-    return false;
+bool BaseAI::findBestPlaceForRoom(Tile* tile, int32_t wantedSize, bool useWalls,
+    int32_t& bestX, int32_t& bestY)
+{
+    startRoomPlacementSearch(tile, wantedSize, useWalls);
+    return continueRoomPlacementSearch(false, bestX, bestY) == AIJobStatus::done;
 }
 
 //! To find the position, we try every square of the wantedSize width around the given tile for each possible distance
-bool BaseAI::findBestPlaceForRoom(Tile* tile, Seat* mPlayerSeat, int32_t wantedSize, bool useWalls,
-    int32_t& bestX, int32_t& bestY)
+void BaseAI::startRoomPlacementSearch(Tile* tile, int32_t wantedSize, bool useWalls)
 {
     // We use a point system to find the best position. Once we find a valid position, we will set a handicap
     // that will increase as we go away from the given tile. Once the handicap is > to the max points we can get minus
     // the points the room we found got, we can stop searching.
     // With this logic, we can tune easily what the AI should prefer between distance and active spots.
+    RoomPlacementSearch& search = mRoomPlacementSearch;
+    search.mIsInProgress = true;
+    search.mTile = tile;
+    search.mWantedSize = wantedSize;
+    search.mUseWalls = useWalls;
 
     // We search for the maximum points a room can get
-    int32_t maxPointsPossible = 0;
+    search.mMaxPointsPossible = 0;
     if(wantedSize >= 3)
     {
         // Maximum central active spots
         int32_t nbCentralActiveSpots = ((wantedSize - 3) / 2) + 1;
         // Wall active spots
         if(useWalls)
-            maxPointsPossible += nbCentralActiveSpots * 4 * pointsPerWallSpot;
+            search.mMaxPointsPossible += nbCentralActiveSpots * 4 * pointsPerWallSpot;
+    }
+
+    search.mOffset = 1;
+    search.mIsFound = false;
+    search.mHandicap = 0;
+    search.mBestPoints = 0;
+    search.mBestDistance = 0;
+    search.mBestX = 0;
+    search.mBestY = 0;
+}
+
+AIJobStatus BaseAI::continueRoomPlacementSearch(bool useTurnBudget, int32_t& bestX, int32_t& bestY)
+{
+    RoomPlacementSearch& search = mRoomPlacementSearch;
+    if(!search.mIsInProgress)
+    {
+        OD_LOG_ERR("No room placement search in progress for player=" + mPlayer.getNick());
+        return AIJobStatus::failed;
     }
 
-    bool isFound = false;
-    int32_t handicap = 0;
-    int32_t bestPoints = 0;
-    int32_t bestDistance = 0;
     int32_t maxOffset = std::max(mGameMap.getMapSizeX(), mGameMap.getMapSizeY());
+    bool isFirstRing = true;
+    for(; search.mOffset < maxOffset; ++search.mOffset)
+    {
+        // We always process at least one ring so that the search progresses
+        if(useTurnBudget && !isFirstRing && isTurnBudgetExhausted())
+            return AIJobStatus::inProgress;
 
-    for(int32_t offset = 1; offset < maxOffset; ++offset)
+        isFirstRing = false;
+        if(searchRoomPlacementRing())
+            break;
+    }
+
+    search.mIsInProgress = false;
+    if(!search.mIsFound)
+        return AIJobStatus::failed;
+
+    bestX = search.mBestX;
+    bestY = search.mBestY;
+    return AIJobStatus::done;
+}
+
+bool BaseAI::searchRoomPlacementRing()
+{
+    RoomPlacementSearch& search = mRoomPlacementSearch;
+    Tile* tile = search.mTile;
+    int32_t wantedSize = search.mWantedSize;
+    bool useWalls = search.mUseWalls;
+    int32_t offset = search.mOffset;
+    int32_t points = 0;
+    int32_t nbTiles = offset * 2 + wantedSize - 1;
+    for(int32_t k = 0; k < nbTiles; ++k)
     {
-        int32_t points = 0;
-        int32_t nbTiles = offset * 2 + wantedSize - 1;
-        for(int32_t k = 0; k < nbTiles; ++k)
+        Tile* t;
+        // North
+        t  = mGameMap.getTile(tile->getX() - offset - wantedSize + 2 + k, tile->getY() + offset);
+        if((t != nullptr) &&
+           computePointsForRoom(t, wantedSize, true, useWalls, points))
         {
-            Tile* t;
-            // North
-            t  = mGameMap.getTile(tile->getX() - offset - wantedSize + 2 + k, tile->getY() + offset);
-            if((t != nullptr) &&
-               computePointsForRoom(t, mPlayerSeat, wantedSize, true, useWalls, points))
+            points -= search.mHandicap;
+            int32_t centerX = t->getX() + (wantedSize / 2);
+            int32_t centerY = t->getY() + (wantedSize / 2);
+            int32_t distance = (tile->getX() - centerX) * (tile->getX() - centerX);
+            distance += (tile->getY() - centerY) * (tile->getY() - centerY);
+            if((points > search.mBestPoints) ||
+               (points == search.mBestPoints && distance < search.mBestDistance))
             {
-                points -= handicap;
-                int32_t centerX = t->getX() + (wantedSize / 2);
-                int32_t centerY = t->getY() + (wantedSize / 2);
-                int32_t distance = (tile->getX() - centerX) * (tile->getX() - centerX);
-                distance += (tile->getY() - centerY) * (tile->getY() - centerY);
-                if((points > bestPoints) ||
-                   (points == bestPoints && distance < bestDistance))
-                {
-                    bestDistance = distance;
-                    bestX = t->getX();
-                    bestY = t->getY();
-                    bestPoints = points;
-                    isFound = true;
-                }
+                search.mBestDistance = distance;
+                search.mBestX = t->getX();
+                search.mBestY = t->getY();
+                search.mBestPoints = points;
+                search.mIsFound = true;
             }
-            // East
-            t  = mGameMap.getTile(tile->getX() + offset, tile->getY() - k + offset);
-            if((t != nullptr) &&
-               computePointsForRoom(t, mPlayerSeat, wantedSize, true, useWalls, points))
-            {
-                points -= handicap;
-                int32_t centerX = t->getX() + (wantedSize / 2);
-                int32_t centerY = t->getY() + (wantedSize / 2);
-                int32_t distance = (tile->getX() - centerX) * (tile->getX() - centerX);
-                distance += (tile->getY() - centerY) * (tile->getY() - centerY);
-                if((points > bestPoints) ||
-                   (points == bestPoints && distance < bestDistance))
-                {
-                    bestDistance = distance;
-                    bestX = t->getX();
-                    bestY = t->getY();
-                    bestPoints = points;
-                    isFound = true;
-                }
-            }
-            // South
-            t  = mGameMap.getTile(tile->getX() + offset + wantedSize - 2 - k, tile->getY() - offset);
-            if((t != nullptr) &&
-               computePointsForRoom(t, mPlayerSeat, wantedSize, false, useWalls, points))
+        }
+        // East
+        t  = mGameMap.getTile(tile->getX() + offset, tile->getY() - k + offset);
+        if((t != nullptr) &&
+           computePointsForRoom(t, wantedSize, true, useWalls, points))
+        {
+            points -= search.mHandicap;
+            int32_t centerX = t->getX() + (wantedSize / 2);
+            int32_t centerY = t->getY() + (wantedSize / 2);
+            int32_t distance = (tile->getX() - centerX) * (tile->getX() - centerX);
+            distance += (tile->getY() - centerY) * (tile->getY() - centerY);
+            if((points > search.mBestPoints) ||
+               (points == search.mBestPoints && distance < search.mBestDistance))
             {
-                points -= handicap;
-                int32_t centerX = t->getX() - (wantedSize / 2);
-                int32_t centerY = t->getY() - (wantedSize / 2);
-                int32_t distance = (tile->getX() - centerX) * (tile->getX() - centerX);
-                distance += (tile->getY() - centerY) * (tile->getY() - centerY);
-                if((points > bestPoints) ||
-                   (points == bestPoints && distance < bestDistance))
-                {
-                    bestDistance = distance;
-                    bestX = t->getX() - wantedSize + 1;
-                    bestY = t->getY() - wantedSize + 1;
-                    bestPoints = points;
-                    isFound = true;
-                }
+                search.mBestDistance = distance;
+                search.mBestX = t->getX();
+                search.mBestY = t->getY();
+                search.mBestPoints = points;
+                search.mIsFound = true;
             }
-            // West
-            t  = mGameMap.getTile(tile->getX() - offset, tile->getY() - offset + k);
-            if((t != nullptr) &&
-               computePointsForRoom(t, mPlayerSeat, wantedSize, false, useWalls, points))
+        }
+        // South
+        t  = mGameMap.getTile(tile->getX() + offset + wantedSize - 2 - k, tile->getY() - offset);
+        if((t != nullptr) &&
+           computePointsForRoom(t, wantedSize, false, useWalls, points))
+        {
+            points -= search.mHandicap;
+            int32_t centerX = t->getX() - (wantedSize / 2);
+            int32_t centerY = t->getY() - (wantedSize / 2);
+            int32_t distance = (tile->getX() - centerX) * (tile->getX() - centerX);
+            distance += (tile->getY() - centerY) * (tile->getY() - centerY);
+            if((points > search.mBestPoints) ||
+               (points == search.mBestPoints && distance < search.mBestDistance))
             {
-                points -= handicap;
-                int32_t centerX = t->getX() - (wantedSize / 2);
-                int32_t centerY = t->getY() - (wantedSize / 2);
-                int32_t distance = (tile->getX() - centerX) * (tile->getX() - centerX);
-                distance += (tile->getY() - centerY) * (tile->getY() - centerY);
-                if((points > bestPoints) ||
-                   (points == bestPoints && distance < bestDistance))
-                {
-                    bestDistance = distance;
-                    bestX = t->getX() - wantedSize + 1;
-                    bestY = t->getY() - wantedSize + 1;
-                    bestPoints = points;
-                    isFound = true;
-                }
+                search.mBestDistance = distance;
+                search.mBestX = t->getX() - wantedSize + 1;
+                search.mBestY = t->getY() - wantedSize + 1;
+                search.mBestPoints = points;
+                search.mIsFound = true;
             }
         }
-
-        if(isFound)
+        // West
+        t  = mGameMap.getTile(tile->getX() - offset, tile->getY() - offset + k);
+        if((t != nullptr) &&
+           computePointsForRoom(t, wantedSize, false, useWalls, points))
         {
-            handicap += handicapPerTileOffset;
-            // If we already found the best place, stop searching
-            if(handicap > (maxPointsPossible - bestPoints))
-                break;
+            points -= search.mHandicap;
+            int32_t centerX = t->getX() - (wantedSize / 2);
+            int32_t centerY = t->getY() - (wantedSize / 2);
+            int32_t distance = (tile->getX() - centerX) * (tile->getX() - centerX);
+            distance += (tile->getY() - centerY) * (tile->getY() - centerY);
+            if((points > search.mBestPoints) ||
+               (points == search.mBestPoints && distance < search.mBestDistance))
+            {
+                search.mBestDistance = distance;
+                search.mBestX = t->getX() - wantedSize + 1;
+                search.mBestY = t->getY() - wantedSize + 1;
+                search.mBestPoints = points;
+                search.mIsFound = true;
+            }
         }
     }
-    return isFound;
+
+    if(!search.mIsFound)
+        return false;
+
+    search.mHandicap += handicapPerTileOffset;
+    // If we already found the best place, stop searching
+    return search.mHandicap > (search.mMaxPointsPossible - search.mBestPoints);
 }
 
-bool BaseAI::computePointsForRoom(Tile* tile, Seat* mPlayerSeat, int32_t wantedSize,
+bool BaseAI::computePointsForRoom(Tile* tile, int32_t wantedSize,
     bool bottomLeft2TopRight, bool useWalls, int32_t& points)
 {
-    int tileX = tile->getX();
-    int tileY = tile->getY();
-    bool isOk = true;
-
-    // We check if the tile is reachable. No need to compute if the tile is behind rocks
+    int32_t tileX = tile->getX();
+    int32_t tileY = tile->getY();
+    int32_t dir = bottomLeft2TopRight ? 1 : -1;
     points = 0;
-    // We start by searching for a place fitting the min size. If we find it,
-    // we increase tile by tile until the max size. If not, no need to continue
-    for(int32_t xx = 0; xx < wantedSize; ++xx)
-    {
-        for(int32_t yy = 0; yy < wantedSize; ++yy)
-        {
-            Tile* t;
-            if(bottomLeft2TopRight)
-                t  = mGameMap.getTile(tileX + xx, tileY + yy);
-            else
-                t  = mGameMap.getTile(tileX - xx, tileY - yy);
 
-            if(t == nullptr)
-            {
-                isOk = false;
-                break;
-            }
-
-            if(!shouldGroundTileBeConsideredForBestPlaceForRoom(t, mPlayerSeat))
-            {
-                isOk = false;
-                break;
-            }
-        }
-
-        if(!isOk)
-            break;
-    }
+    // Every tile of the square should be constructible
+    int32_t x1 = std::min(tileX, tileX + dir * (wantedSize - 1));
+    int32_t y1 = std::min(tileY, tileY + dir * (wantedSize - 1));
+    int32_t x2 = std::max(tileX, tileX + dir * (wantedSize - 1));
+    int32_t y2 = std::max(tileY, tileY + dir * (wantedSize - 1));
+    if(!mSpatialAnalysis.isInMap(x1, y1) || !mSpatialAnalysis.isInMap(x2, y2))
+        return false;
 
-    if(!isOk)
+    if(mSpatialAnalysis.countBuildableGroundTiles(x1, y1, x2, y2) != wantedSize * wantedSize)
         return false;
 
     // If we don't want to consider walls, we stop here (for example for rooms that do not have bonus
@@ -273,123 +271,39 @@ bool BaseAI::computePointsForRoom(Tile* tile, Seat* mPlayerSeat, int32_t wantedS
     if(!useWalls)
         return true;
 
-    // We search points for first wall. That's not exactly how the activespots will be computed but it will be enough (especially
+    // We search points for each wall. That's not exactly how the activespots will be computed but it will be enough (especially
     // when the room size is even)
-    int nbConsecutiveTiles;
-    int nbActiveWallSpots;
-    // We search points for first wall
-    nbConsecutiveTiles = 0;
-    nbActiveWallSpots = 0;
-    for(int32_t kk = 0; kk < wantedSize; ++kk)
-    {
-        Tile* t;
-        if(bottomLeft2TopRight)
-            t  = mGameMap.getTile(tileX - 1, tileY + kk);
-        else
-            t  = mGameMap.getTile(tileX + 1, tileY - kk);
-        if(t == nullptr)
-            continue;
+    points += countActiveWallSpots(tileX - dir, tileY, 0, dir, wantedSize) * pointsPerWallSpot;
+    points += countActiveWallSpots(tileX + dir * wantedSize, tileY, 0, dir, wantedSize) * pointsPerWallSpot;
+    points += countActiveWallSpots(tileX, tileY - dir, dir, 0, wantedSize) * pointsPerWallSpot;
+    points += countActiveWallSpots(tileX, tileY + dir * wantedSize, dir, 0, wantedSize) * pointsPerWallSpot;
 
-        if(shouldWallTileBeConsideredForBestPlaceForRoom(t, mPlayerSeat))
-            ++nbConsecutiveTiles;
-        else
-            nbConsecutiveTiles = 0;
+    return true;
+}
 
-        if(nbActiveWallSpots == 0)
-        {
-            if(nbConsecutiveTiles >= 3)
-            {
-                nbConsecutiveTiles = 0;
-                ++nbActiveWallSpots;
-            }
-        }
-        else if(nbConsecutiveTiles >= 2)
-        {
-            nbConsecutiveTiles = 0;
-            ++nbActiveWallSpots;
-        }
-    }
-    points += nbActiveWallSpots * pointsPerWallSpot;
-    // We search points for second wall
-    nbConsecutiveTiles = 0;
-    nbActiveWallSpots = 0;
-    for(int32_t kk = 0; kk < wantedSize; ++kk)
+int32_t BaseAI::countActiveWallSpots(int32_t x, int32_t y, int32_t dx, int32_t dy, int32_t length)
+{
+    // The first active spot needs 3 consecutive walls. If the whole wall is within the map, we can
+    // check if there are enough walls before looking at each tile
+    int32_t xEnd = x + dx * (length - 1);
+    int32_t yEnd = y + dy * (length - 1);
+    if(mSpatialAnalysis.isInMap(x, y) && mSpatialAnalysis.isInMap(xEnd, yEnd) &&
+       (mSpatialAnalysis.countUsableWallTiles(std::min(x, xEnd), std::min(y, yEnd),
+            std::max(x, xEnd), std::max(y, yEnd)) < 3))
     {
-        Tile* t;
-        if(bottomLeft2TopRight)
-            t = mGameMap.getTile(tileX + wantedSize, tileY + kk);
-        else
-            t = mGameMap.getTile(tileX - wantedSize, tileY - kk);
-        if(t == nullptr)
-            continue;
-
-        if(shouldWallTileBeConsideredForBestPlaceForRoom(t, mPlayerSeat))
-            ++nbConsecutiveTiles;
-        else
-            nbConsecutiveTiles = 0;
-
-        if(nbActiveWallSpots == 0)
-        {
-            if(nbConsecutiveTiles >= 3)
-            {
-                nbConsecutiveTiles = 0;
-                ++nbActiveWallSpots;
-            }
-        }
-        else if(nbConsecutiveTiles >= 2)
-        {
-            nbConsecutiveTiles = 0;
-            ++nbActiveWallSpots;
-        }
+        return 0;
     }
-    points += nbActiveWallSpots * pointsPerWallSpot;
-    // We search points for first wall
-    nbConsecutiveTiles = 0;
-    nbActiveWallSpots = 0;
-    for(int32_t kk = 0; kk < wantedSize; ++kk)
-    {
-        Tile* t;
-        if(bottomLeft2TopRight)
-            t = mGameMap.getTile(tileX + kk, tileY - 1);
-        else
-            t = mGameMap.getTile(tileX - kk, tileY + 1);
-        if(t == nullptr)
-            continue;
-
-        if(shouldWallTileBeConsideredForBestPlaceForRoom(t, mPlayerSeat))
-            ++nbConsecutiveTiles;
-        else
-            nbConsecutiveTiles = 0;
 
-        if(nbActiveWallSpots == 0)
-        {
-            if(nbConsecutiveTiles >= 3)
-            {
-                nbConsecutiveTiles = 0;
-                ++nbActiveWallSpots;
-            }
-        }
-        else if(nbConsecutiveTiles >= 2)
-        {
-            nbConsecutiveTiles = 0;
-            ++nbActiveWallSpots;
-        }
-    }
-    points += nbActiveWallSpots * pointsPerWallSpot;
-    // We search points for first wall
-    nbConsecutiveTiles = 0;
-    nbActiveWallSpots = 0;
-    for(int32_t kk = 0; kk < wantedSize; ++kk)
+    int32_t nbConsecutiveTiles = 0;
+    int32_t nbActiveWallSpots = 0;
+    for(int32_t kk = 0; kk < length; ++kk)
     {
-        Tile* t;
-        if(bottomLeft2TopRight)
-            t = mGameMap.getTile(tileX + kk, tileY + wantedSize);
-        else
-            t = mGameMap.getTile(tileX - kk, tileY - wantedSize);
-        if(t == nullptr)
+        int32_t xx = x + dx * kk;
+        int32_t yy = y + dy * kk;
+        if(!mSpatialAnalysis.isInMap(xx, yy))
             continue;
 
-        if(shouldWallTileBeConsideredForBestPlaceForRoom(t, mPlayerSeat))
+        if(mSpatialAnalysis.isUsableWallTile(xx, yy))
             ++nbConsecutiveTiles;
         else
             nbConsecutiveTiles = 0;
@@ -408,9 +322,7 @@ bool BaseAI::computePointsForRoom(Tile* tile, Seat* mPlayerSeat, int32_t wantedS
             ++nbActiveWallSpots;
         }
     }
-    points += nbActiveWallSpots * pointsPerWallSpot;
-
-    return true;
+    return nbActiveWallSpots;
 }
 
 bool BaseAI::digWayToTile(Tile* tileStart, Tile* tileEnd)
@@ -18,6 +18,9 @@
 #ifndef BASEAI_H
 #define BASEAI_H
 
+#include "ai/AISpatialAnalysis.h"
+
+#include <chrono>
 #include <string>
 #include <vector>
 #include <cstdint>
@@ -30,6 +33,14 @@ class Seat;
 
 enum class KeeperAIType;
 
+//! \brief State of a job that may be spread over several turns
+enum class AIJobStatus
+{
+    inProgress,
+    done,
+    failed
+};
+
 class BaseAI
 {
 public:
@@ -44,6 +55,16 @@ public:
      */
     virtual bool doTurn(double timeSinceLastTurn) = 0;
 
+    //! \brief Called on the server when a tile is claimed, dug, covered by a building, ...
+    void tileStateChanged(Tile& tile);
+
+    //! \brief Called by the AIManager before doTurn. Jobs that can be spread over several turns
+    //! should stop once the given time is spent. 0 means no limit
+    void startTurnBudget(uint32_t budgetMicroseconds);
+
+    inline Player& getPlayer()
+    { return mPlayer; }
+
 protected:
     BaseAI(GameMap& gameMap, Player& player);
 
@@ -53,19 +74,81 @@ protected:
     //! into account any constructible tile (even if not digged yet). On success, it returns true and bestX
     //! and bestY will be set accordingly. It will return false if no constructible square of wantedSize
     //! is found
-    bool findBestPlaceForRoom(Tile* tile, Seat* playerSeat, int32_t wantedSize, bool useWalls,
+    bool findBestPlaceForRoom(Tile* tile, int32_t wantedSize, bool useWalls,
         int32_t& bestX, int32_t& bestY);
 
+    //! \brief Same as findBestPlaceForRoom but the search can be spread over several turns. The search is
+    //! started with startRoomPlacementSearch and continueRoomPlacementSearch should be called (once per turn)
+    //! until it does not return AIJobStatus::inProgress. If useTurnBudget is true, the search is paused when
+    //! the turn budget is exhausted
+    void startRoomPlacementSearch(Tile* tile, int32_t wantedSize, bool useWalls);
+    AIJobStatus continueRoomPlacementSearch(bool useTurnBudget, int32_t& bestX, int32_t& bestY);
+
+    inline bool isRoomPlacementSearchInProgress() const
+    { return mRoomPlacementSearch.mIsInProgress; }
+
+    //! \brief Returns true if the time allowed for this turn is spent
+    bool isTurnBudgetExhausted() const;
+
     bool digWayToTile(Tile* tileStart, Tile* tileEnd);
-    bool computePointsForRoom(Tile* tile, Seat* playerSeat, int32_t wantedSize,
+
+    //! \brief Checks if a room of wantedSize can be built from the given tile (to the top right or to
+    //! the bottom left) and computes how interesting it would be. Thanks to mSpatialAnalysis, the constructible
+    //! tiles are checked in constant time and only the surrounding walls are looked at
+    bool computePointsForRoom(Tile* tile, int32_t wantedSize,
         bool bottomLeft2TopRight, bool useWalls, int32_t& points);
 
     GameMap& mGameMap;
     Player& mPlayer;
 
 private:
-    bool shouldGroundTileBeConsideredForBestPlaceForRoom(Tile* tile, Seat* playerSeat);
-    bool shouldWallTileBeConsideredForBestPlaceForRoom(Tile* tile, Seat* playerSeat);
+    //! \brief State of the room placement search between 2 turns
+    struct RoomPlacementSearch
+    {
+        RoomPlacementSearch() :
+            mIsInProgress(false),
+            mTile(nullptr),
+            mWantedSize(0),
+            mUseWalls(false),
+            mMaxPointsPossible(0),
+            mOffset(0),
+            mIsFound(false),
+            mHandicap(0),
+            mBestPoints(0),
+            mBestDistance(0),
+            mBestX(0),
+            mBestY(0)
+        {}
+
+        bool mIsInProgress;
+        Tile* mTile;
+        int32_t mWantedSize;
+        bool mUseWalls;
+        int32_t mMaxPointsPossible;
+        //! \brief Distance of the next ring of tiles to look at
+        int32_t mOffset;
+        bool mIsFound;
+        int32_t mHandicap;
+        int32_t mBestPoints;
+        int32_t mBestDistance;
+        int32_t mBestX;
+        int32_t mBestY;
+    };
+
+    //! \brief Looks at the ring of tiles at mRoomPlacementSearch.mOffset. Returns true if the search
+    //! is over
+    bool searchRoomPlacementRing();
+
+    //! \brief Returns the number of active spots the wall of the given length starting at x, y and
+    //! going in the dx, dy direction could hold
+    int32_t countActiveWallSpots(int32_t x, int32_t y, int32_t dx, int32_t dy, int32_t length);
+
+    AISpatialAnalysis mSpatialAnalysis;
+
+    RoomPlacementSearch mRoomPlacementSearch;
+
+    bool mHasTurnBudget;
+    std::chrono::steady_clock::time_point mTurnDeadline;
 };
 
 #endif // BASEAI_H
@@ -31,10 +31,14 @@
 #include "spells/SpellSummonWorker.h"
 #include "utils/Helper.h"
 #include "utils/LogManager.h"
+#include "utils/Metrics.h"
 #include "utils/Random.h"
 
 #include <vector>
 
+// Number of gold tiles we look at when searching for the closest one. Tiles at the same distance are picked randomly
+static const uint32_t NB_GOLD_TILES_CANDIDATES = 8;
+
 // Contains the rooms the AI will try to build. It will try to build them in the given order
 static const std::vector<RoomType> wantedBuildings = {
     RoomType::dormitory,
@@ -75,6 +79,10 @@ KeeperAI::KeeperAI(GameMap& gameMap, Player& player, int cooldownDefenseMin, int
 
 bool KeeperAI::doTurn(double timeSinceLastTurn)
 {
+    static Metrics::Histogram& aiTurnTime = Metrics::getTimerHistogram("od_keeperai_turn_ms",
+        "Time spent in KeeperAI::doTurn (ms)");
+    Metrics::ScopedTimer timer(aiTurnTime);
+
     // If we have no dungeon temple, we are dead
     if(getDungeonTemple() == nullptr)
         return false;
@@ -124,16 +132,9 @@ bool KeeperAI::checkTreasury()
     }
     mCooldownCheckTreasury = Random::Int(10,30);
 
-    int totalGold = 0;
-    int totalStorage = 0;
-    for(Room* room : mGameMap.getRooms())
-    {
-        if(room->getSeat() != mPlayer.getSeat())
-            continue;
-
-        totalGold += room->getTotalGoldStored();
-        totalStorage += room->getTotalGoldStorage();
-    }
+    const SeatAggregates& aggregates = mPlayer.getSeat()->getAggregates();
+    int totalGold = aggregates.getGoldStored();
+    int totalStorage = aggregates.getGoldStorage();
 
     // We want at least to be allowed to store 3000 gold
     if(totalStorage >= 3000)
@@ -283,6 +284,10 @@ bool KeeperAI::checkTreasury()
 
 bool KeeperAI::handleRooms()
 {
+    // If we are looking for a place for a new room, we continue
+    if(isRoomPlacementSearchInProgress())
+        return continueSearchingRoomPlace();
+
     if(mCooldownLookingForRooms > 0)
     {
         --mCooldownLookingForRooms;
@@ -302,7 +307,7 @@ bool KeeperAI::handleRooms()
             return false;
         }
         int32_t points;
-        if(!computePointsForRoom(tile, mPlayer.getSeat(), mRoomSize, true, false, points))
+        if(!computePointsForRoom(tile, mRoomSize, true, false, points))
         {
             // The room is not valid anymore (may be claimed or built by somebody else). We redo
             mRoomSize = -1;
@@ -319,15 +324,22 @@ bool KeeperAI::handleRooms()
     }
 
     Tile* central = getDungeonTemple()->getCentralTile();
+    startRoomPlacementSearch(central, 5, true);
+    return continueSearchingRoomPlace();
+}
+
+bool KeeperAI::continueSearchingRoomPlace()
+{
     int32_t bestX = 0;
     int32_t bestY = 0;
-    if(!findBestPlaceForRoom(central, mPlayer.getSeat(), 5, true, bestX, bestY))
+    if(continueRoomPlacementSearch(true, bestX, bestY) != AIJobStatus::done)
         return false;
 
     mRoomSize = 5;
     mRoomPosX = bestX;
     mRoomPosY = bestY;
 
+    Tile* central = getDungeonTemple()->getCentralTile();
     Tile* tileDest = mGameMap.getTile(mRoomPosX, mRoomPosY);
     if(tileDest == nullptr)
     {
@@ -369,108 +381,37 @@ bool KeeperAI::lookForGold()
     mCooldownLookingForGold = Random::Int(70,120);
 
     // Do we need gold ?
-    int emptyStorage = 0;
-    for(Room* room : mGameMap.getRooms())
-    {
-        if(room->getSeat() != mPlayer.getSeat())
-            continue;
-
-        emptyStorage += (room->getTotalGoldStorage() - room->getTotalGoldStored());
-    }
+    const SeatAggregates& aggregates = mPlayer.getSeat()->getAggregates();
+    int emptyStorage = aggregates.getGoldStorage() - aggregates.getGoldStored();
 
     // No need to search for gold
     if(emptyStorage < 100)
         return false;
 
     Tile* central = getDungeonTemple()->getCentralTile();
-    int widerSide = mGameMap.getMapSizeX() > mGameMap.getMapSizeY() ?
-        mGameMap.getMapSizeX() : mGameMap.getMapSizeY();
 
-    // We search for the closest gold tile
+    // We search for the closest gold tile. If several tiles are at the same distance, we randomly
+    // pick one to try to not be too predictable
+    std::vector<Tile*> goldTiles;
+    mGameMap.getResourceTileIndex().findNearestTilesOfType(TileType::gold, central->getX(), central->getY(),
+        NB_GOLD_TILES_CANDIDATES, -1, goldTiles);
     Tile* firstGoldTile = nullptr;
-    for(int32_t distance = 1; distance < widerSide; ++distance)
+    if(!goldTiles.empty())
     {
-        for(int k = 0; k <= distance; ++k)
+        uint32_t nbClosest = 0;
+        int32_t closestDist = -1;
+        for(Tile* tile : goldTiles)
         {
-            Tile* t;
-            // North-East
-            t = mGameMap.getTile(central->getX() + k, central->getY() + distance);
-            if(t != nullptr && t->getType() == TileType::gold && t->getFullness() > 0.0)
-            {
-                // If we already have a tile at same distance, we randomly change to
-                // try to not be too predictable
-                if((firstGoldTile == nullptr) || (Random::Uint(1,2) == 1))
-                    firstGoldTile = t;
-            }
-            // North-West
-            if(k > 0)
-            {
-                t = mGameMap.getTile(central->getX() - k, central->getY() + distance);
-                if(t != nullptr && t->getType() == TileType::gold && t->getFullness() > 0.0)
-                {
-                    if((firstGoldTile == nullptr) || (Random::Uint(1,2) == 1))
-                        firstGoldTile = t;
-                }
-            }
-            // South-East
-            t = mGameMap.getTile(central->getX() + k, central->getY() - distance);
-            if(t != nullptr && t->getType() == TileType::gold && t->getFullness() > 0.0)
-            {
-                if((firstGoldTile == nullptr) || (Random::Uint(1,2) == 1))
-                    firstGoldTile = t;
-            }
-            // South-West
-            if(k > 0)
-            {
-                t = mGameMap.getTile(central->getX() - k, central->getY() - distance);
-                if(t != nullptr && t->getType() == TileType::gold && t->getFullness() > 0.0)
-                {
-                    if((firstGoldTile == nullptr) || (Random::Uint(1,2) == 1))
-                        firstGoldTile = t;
-                }
-            }
-            // East-North
-            t = mGameMap.getTile(central->getX() + distance, central->getY() + k);
-            if(t != nullptr && t->getType() == TileType::gold && t->getFullness() > 0.0)
-            {
-                if((firstGoldTile == nullptr) || (Random::Uint(1,2) == 1))
-                    firstGoldTile = t;
-            }
-            // East-South
-            if(k > 0)
-            {
-                t = mGameMap.getTile(central->getX() + distance, central->getY() - k);
-                if(t != nullptr && t->getType() == TileType::gold && t->getFullness() > 0.0)
-                {
-                    if((firstGoldTile == nullptr) || (Random::Uint(1,2) == 1))
-                        firstGoldTile = t;
-                }
-            }
-            // West-North
-            t = mGameMap.getTile(central->getX() - distance, central->getY() + k);
-            if(t != nullptr && t->getType() == TileType::gold && t->getFullness() > 0.0)
-            {
-                if((firstGoldTile == nullptr) || (Random::Uint(1,2) == 1))
-                    firstGoldTile = t;
-            }
-            // West-South
-            if(k > 0)
-            {
-                t = mGameMap.getTile(central->getX() - distance, central->getY() - k);
-                if(t != nullptr && t->getType() == TileType::gold && t->getFullness() > 0.0)
-                {
-                    if((firstGoldTile == nullptr) || (Random::Uint(1,2) == 1))
-                        firstGoldTile = t;
-                }
-            }
-
-            if(firstGoldTile != nullptr)
+            int32_t diffX = tile->getX() - central->getX();
+            int32_t diffY = tile->getY() - central->getY();
+            int32_t dist = diffX * diffX + diffY * diffY;
+            if((closestDist != -1) && (dist > closestDist))
                 break;
-        }
 
-        // If we found a tile, no need to continue
-        if(firstGoldTile != nullptr)
-            break;
+            closestDist = dist;
+            ++nbClosest;
+        }
+        firstGoldTile = goldTiles[Random::Uint(0, nbClosest - 1)];
     }
 
     // No more gold
@@ -744,11 +685,8 @@ bool KeeperAI::repairRooms()
     mCooldownRepairRooms = Random::Int(20,60);
 
     Seat* seat = mPlayer.getSeat();
-    for(Room* room : mGameMap.getRooms())
+    for(Room* room : seat->getAggregates().getRooms())
     {
-        if(room->getSeat() != seat)
-            continue;
-
         if(!room->canBeRepaired())
             continue;
 
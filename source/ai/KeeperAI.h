@@ -42,6 +42,11 @@ protected:
     //! Returns true if the action has been done and false if nothing has been done
     bool handleRooms();
 
+    //! \brief Continues searching a place for a new room (the search may take several turns). Once found,
+    //! starts digging for it.
+    //! Returns true if the action has been done and false if nothing has been done
+    bool continueSearchingRoomPlace();
+
     //! \brief Look for gold and make way up to it.
     //! \brief Returns whether the action could succeed.
     //! It will also return false once it's done.
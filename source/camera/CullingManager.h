@@ -18,9 +18,13 @@
 #ifndef CULLINGMANAGER_H_
 #define CULLINGMANAGER_H_
 
-#include "camera/SlopeWalk.h"
+#include "camera/TileVisibility.h"
 
-#include "utils/VectorInt64.h"
+#include <OgreVector3.h>
+
+#include <cstdint>
+#include <utility>
+#include <vector>
 
 class GameMap;
 
@@ -43,24 +47,14 @@ namespace CullingType
  *  manage culling methods used in game. So far there is only
  *  one algorithm included : it is supposed to cull the Tiles.
  *  It should be started with the method startTileCulling.
-
- * Currently I try to implement the most general polygon rasterizing algorithm , that is :
- * 1. We choose the max and min points due to their Y value .
- * 2. We sort all the points by the angle value in it's polar representation
- * ( that is going , by visiting them clockwise due to the center of the polygon )
- * 3. Now we have two paths from which we can walk from top to down vertices : call them left and right .
- * 4. Between each following pair of vertices we can establish a >> slope << ,
- * which is just the the "a" in the eq. of linear form y = ax + b
- * 5. Now start drawing our polygon Row by Row From top to bottom .
- * Each Row has given the most left and rightmost tile due to use of both paths prepared before
- * -- Left path for tracing the most Leftmost Tile , Right path the most Rightmost Tile in each .
+ *
+ * The tiles under the footprint of the camera on the ground are computed by TileVisibility.
+ * Each time the camera moves, the new visible tiles are compared with the previous ones and
+ * only the tiles that became visible or hidden have their culling flag changed.
  */
 class CullingManager
 {
 public:
-    static const uint32_t HIDE =  1;
-    static const uint32_t SHOW =  2;
-
     CullingManager(GameMap* gameMap, uint32_t cullingMask);
 
     void startTileCulling(Ogre::Camera* camera, const std::vector<Ogre::Vector3>& ogreVectors);
@@ -77,24 +71,21 @@ private:
 
     void cullTiles(const std::vector<Ogre::Vector3>& ogreVectors);
 
-    void hideAllTiles();
-    void showAllTiles();
-
-    // set the new tiles
-    void newBashAndSplashTiles(uint32_t);
+    //! \brief Changes the culling flag of the tiles that changed in mVisibility
+    void applyChangedTiles();
 
-    void sort(VectorInt64& p1, VectorInt64& p2, bool sortByX);
-
-    // Objects representing past and present walk around the polygon
-    SlopeWalk mWalk;
-    SlopeWalk mOldWalk;
-
-    bool mFirstIter;
     GameMap* mGameMap;
 
     uint32_t mCullingMask;
 
     bool mCullTilesFlag;
+
+    TileVisibility mVisibility;
+
+    //! \brief Kept to avoid allocating each time the camera moves
+    std::vector<TileVisibility::Point> mFootprint;
+    std::vector<std::pair<int32_t, int32_t>> mShownTiles;
+    std::vector<std::pair<int32_t, int32_t>> mHiddenTiles;
 };
 
 #endif // CULLINGMANAGER_H_
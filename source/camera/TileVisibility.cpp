@@ -0,0 +1,220 @@
+/*
+ *  Copyright (C) 2011-2016  OpenDungeons Team
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "camera/TileVisibility.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+    const int32_t BITS_PER_WORD = 64;
+
+    //! \brief Extends [xMin, xMax] with the part of the segment (a, b) that is between yLow and yHigh
+    void clipSegmentToBand(const TileVisibility::Point& a, const TileVisibility::Point& b, double yLow, double yHigh,
+        double& xMin, double& xMax)
+    {
+        const TileVisibility::Point& low = (a.mY <= b.mY) ? a : b;
+        const TileVisibility::Point& high = (a.mY <= b.mY) ? b : a;
+        if((high.mY < yLow) || (low.mY > yHigh))
+            return;
+
+        double x1 = low.mX;
+        double x2 = high.mX;
+        double dy = high.mY - low.mY;
+        if(dy > 0.0)
+        {
+            double slope = (high.mX - low.mX) / dy;
+            if(low.mY < yLow)
+                x1 = low.mX + slope * (yLow - low.mY);
+            if(high.mY > yHigh)
+                x2 = low.mX + slope * (yHigh - low.mY);
+        }
+
+        xMin = std::min(xMin, std::min(x1, x2));
+        xMax = std::max(xMax, std::max(x1, x2));
+    }
+
+    //! \brief Clamps value to [min, max] in double before converting it. Casting a double out of
+    //! the int32_t range is undefined, and the footprint can be far outside of the map when the
+    //! camera looks near the horizon. NaN gives min
+    int32_t clampToInt(double value, int32_t min, int32_t max)
+    {
+        if(!(value >= static_cast<double>(min)))
+            return min;
+
+        if(value >= static_cast<double>(max))
+            return max;
+
+        return static_cast<int32_t>(value);
+    }
+
+    //! \brief Calls func(x, y) with the coordinates of the tile of each bit set in word
+    template<typename Func>
+    void forEachBit(uint64_t word, int32_t firstIndex, int32_t mapSizeX, Func func)
+    {
+        while(word != 0)
+        {
+            int32_t bit = 0;
+            while((word & (static_cast<uint64_t>(1) << bit)) == 0)
+                ++bit;
+
+            word &= word - 1;
+            int32_t index = firstIndex + bit;
+            func(index % mapSizeX, index / mapSizeX);
+        }
+    }
+}
+
+TileVisibility::TileVisibility() :
+    mMapSizeX(0),
+    mMapSizeY(0)
+{
+}
+
+void TileVisibility::reset(int32_t mapSizeX, int32_t mapSizeY)
+{
+    mMapSizeX = std::max(mapSizeX, 0);
+    mMapSizeY = std::max(mapSizeY, 0);
+    size_t nbWords = static_cast<size_t>((mMapSizeX * mMapSizeY + BITS_PER_WORD - 1) / BITS_PER_WORD);
+    mVisible.assign(nbWords, 0);
+    mPreviousVisible.assign(nbWords, 0);
+}
+
+void TileVisibility::setSpan(int32_t y, int32_t xMin, int32_t xMax)
+{
+    int32_t first = xMin + y * mMapSizeX;
+    int32_t last = xMax + y * mMapSizeX;
+    int32_t firstWord = first / BITS_PER_WORD;
+    int32_t lastWord = last / BITS_PER_WORD;
+    uint64_t firstMask = ~static_cast<uint64_t>(0) << (first % BITS_PER_WORD);
+    uint64_t lastMask = ~static_cast<uint64_t>(0) >> (BITS_PER_WORD - 1 - (last % BITS_PER_WORD));
+    if(firstWord == lastWord)
+    {
+        mVisible[firstWord] |= firstMask & lastMask;
+        return;
+    }
+
+    mVisible[firstWord] |= firstMask;
+    for(int32_t word = firstWord + 1; word < lastWord; ++word)
+        mVisible[word] = ~static_cast<uint64_t>(0);
+    mVisible[lastWord] |= lastMask;
+}
+
+void TileVisibility::computeVisibleTiles(const std::vector<Point>& footprint)
+{
+    mPreviousVisible.swap(mVisible);
+    std::fill(mVisible.begin(), mVisible.end(), 0);
+    if(footprint.empty() || (mMapSizeX == 0) || (mMapSizeY == 0))
+        return;
+
+    // The vertices may be in any order. Since the footprint is convex, sorting them by angle around
+    // their center gives its edges
+    double centerX = 0.0;
+    double centerY = 0.0;
+    for(const Point& point : footprint)
+    {
+        centerX += point.mX;
+        centerY += point.mY;
+    }
+    centerX /= static_cast<double>(footprint.size());
+    centerY /= static_cast<double>(footprint.size());
+    std::vector<Point> polygon = footprint;
+    std::sort(polygon.begin(), polygon.end(), [centerX, centerY](const Point& a, const Point& b)
+    {
+        return std::atan2(a.mY - centerY, a.mX - centerX) < std::atan2(b.mY - centerY, b.mX - centerX);
+    });
+
+    double polygonYMin = polygon[0].mY;
+    double polygonYMax = polygon[0].mY;
+    for(const Point& point : polygon)
+    {
+        polygonYMin = std::min(polygonYMin, point.mY);
+        polygonYMax = std::max(polygonYMax, point.mY);
+    }
+
+    // Tile (x, y) covers [x - 0.5, x + 0.5] x [y - 0.5, y + 0.5]
+    // An upper bound can be -1 so that an empty range stays empty
+    int32_t yMin = clampToInt(std::ceil(polygonYMin - 0.5), 0, mMapSizeY);
+    int32_t yMax = clampToInt(std::floor(polygonYMax + 0.5), -1, mMapSizeY - 1);
+    for(int32_t y = yMin; y <= yMax; ++y)
+    {
+        double xMinRow = static_cast<double>(mMapSizeX);
+        double xMaxRow = -1.0;
+        double yLow = static_cast<double>(y) - 0.5;
+        double yHigh = static_cast<double>(y) + 0.5;
+        for(size_t i = 0; i < polygon.size(); ++i)
+            clipSegmentToBand(polygon[i], polygon[(i + 1) % polygon.size()], yLow, yHigh, xMinRow, xMaxRow);
+
+        if(xMinRow > xMaxRow)
+            continue;
+
+        int32_t xMin = clampToInt(std::ceil(xMinRow - 0.5), 0, mMapSizeX);
+        int32_t xMax = clampToInt(std::floor(xMaxRow + 0.5), -1, mMapSizeX - 1);
+        if(xMin > xMax)
+            continue;
+
+        setSpan(y, xMin, xMax);
+    }
+}
+
+void TileVisibility::showAllTiles()
+{
+    mPreviousVisible.swap(mVisible);
+    std::fill(mVisible.begin(), mVisible.end(), 0);
+    for(int32_t y = 0; y < mMapSizeY; ++y)
+        setSpan(y, 0, mMapSizeX - 1);
+}
+
+void TileVisibility::hideAllTiles()
+{
+    mPreviousVisible.swap(mVisible);
+    std::fill(mVisible.begin(), mVisible.end(), 0);
+}
+
+bool TileVisibility::isVisible(int32_t x, int32_t y) const
+{
+    if((x < 0) || (y < 0) || (x >= mMapSizeX) || (y >= mMapSizeY))
+        return false;
+
+    int32_t index = x + y * mMapSizeX;
+    return (mVisible[index / BITS_PER_WORD] & (static_cast<uint64_t>(1) << (index % BITS_PER_WORD))) != 0;
+}
+
+void TileVisibility::getChangedTiles(std::vector<std::pair<int32_t, int32_t>>& shownTiles,
+    std::vector<std::pair<int32_t, int32_t>>& hiddenTiles) const
+{
+    shownTiles.clear();
+    hiddenTiles.clear();
+    // Most words do not change from one frame to the other. Only the changed ones are looked at bit by bit
+    for(size_t word = 0; word < mVisible.size(); ++word)
+    {
+        uint64_t changed = mVisible[word] ^ mPreviousVisible[word];
+        if(changed == 0)
+            continue;
+
+        int32_t firstIndex = static_cast<int32_t>(word) * BITS_PER_WORD;
+        forEachBit(changed & mVisible[word], firstIndex, mMapSizeX, [&shownTiles](int32_t x, int32_t y)
+        {
+            shownTiles.push_back(std::make_pair(x, y));
+        });
+        forEachBit(changed & mPreviousVisible[word], firstIndex, mMapSizeX, [&hiddenTiles](int32_t x, int32_t y)
+        {
+            hiddenTiles.push_back(std::make_pair(x, y));
+        });
+    }
+}
@@ -0,0 +1,77 @@
+/*
+ *  Copyright (C) 2011-2016  OpenDungeons Team
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TILEVISIBILITY_H
+#define TILEVISIBILITY_H
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+//! \brief Computes the tiles covered by the footprint of a camera on the ground and what changed
+//! since the previous footprint. The visible tiles are stored in a bitset (one bit per tile) filled
+//! row by row from the spans of the convex footprint. The previous and current bitsets are compared
+//! 64 tiles at a time so that only the tiles whose state flipped have to be updated.
+//! This does not depend on the renderer so that it can be tested and benchmarked without a GPU.
+class TileVisibility
+{
+public:
+    struct Point
+    {
+        double mX;
+        double mY;
+    };
+
+    TileVisibility();
+
+    //! \brief Sets the map size. Every tile is considered hidden
+    void reset(int32_t mapSizeX, int32_t mapSizeY);
+
+    inline int32_t getMapSizeX() const
+    { return mMapSizeX; }
+
+    inline int32_t getMapSizeY() const
+    { return mMapSizeY; }
+
+    //! \brief Computes the visible tiles from the given convex polygon (vertices in any order).
+    //! Tiles overlapping the polygon are visible. The current visible tiles become the previous ones
+    void computeVisibleTiles(const std::vector<Point>& footprint);
+
+    //! \brief Makes every tile visible (resp. hidden). The current visible tiles become the previous ones
+    void showAllTiles();
+    void hideAllTiles();
+
+    bool isVisible(int32_t x, int32_t y) const;
+
+    //! \brief Fills shownTiles and hiddenTiles with the coordinates of the tiles that became visible
+    //! or hidden with the last call to computeVisibleTiles, showAllTiles or hideAllTiles
+    void getChangedTiles(std::vector<std::pair<int32_t, int32_t>>& shownTiles,
+        std::vector<std::pair<int32_t, int32_t>>& hiddenTiles) const;
+
+private:
+    int32_t mMapSizeX;
+    int32_t mMapSizeY;
+
+    //! \brief Bit x + y * mMapSizeX is set if tile (x, y) is visible
+    std::vector<uint64_t> mVisible;
+    std::vector<uint64_t> mPreviousVisible;
+
+    //! \brief Sets the bits of the tiles from (xMin, y) to (xMax, y) included
+    void setSpan(int32_t y, int32_t xMin, int32_t xMax);
+};
+
+#endif // TILEVISIBILITY_H
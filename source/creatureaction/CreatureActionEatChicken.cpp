@@ -108,10 +108,10 @@ bool CreatureActionEatChicken::handleEatChicken(Creature& creature, ChickenEntit
 
     // We can eat the chicken
     chicken->eatChicken(&creature);
-    creature.foodEaten(ConfigManager::getSingleton().getRoomConfigDouble("HatcheryHungerPerChicken"));
-    creature.setJobCooldown(Random::Int(ConfigManager::getSingleton().getRoomConfigUInt32("HatcheryCooldownChickenMin"),
-        ConfigManager::getSingleton().getRoomConfigUInt32("HatcheryCooldownChickenMax")));
-    creature.setHP(creature.getHP() + ConfigManager::getSingleton().getRoomConfigDouble("HatcheryHpRecoveredPerChicken"));
+    creature.foodEaten(ConfigManager::getSingleton().getRoomsConfig().mHatcheryHungerPerChicken);
+    creature.setJobCooldown(Random::Int(ConfigManager::getSingleton().getRoomsConfig().mHatcheryCooldownChickenMin,
+        ConfigManager::getSingleton().getRoomsConfig().mHatcheryCooldownChickenMax));
+    creature.setHP(creature.getHP() + ConfigManager::getSingleton().getRoomsConfig().mHatcheryHpRecoveredPerChicken);
     creature.computeCreatureOverlayHealthValue();
     Ogre::Vector3 walkDirection = Ogre::Vector3(chickenTile->getX(), chickenTile->getY(), 0) - creature.getPosition();
     walkDirection.normalise();
@@ -20,6 +20,7 @@
 #include "creatureaction/CreatureActionDigTile.h"
 #include "creatureaction/CreatureActionGrabEntity.h"
 #include "entities/Creature.h"
+#include "entities/CreatureDefinition.h"
 #include "entities/Tile.h"
 #include "entities/TreasuryObject.h"
 #include "game/Player.h"
@@ -31,6 +32,8 @@
 #include "utils/MakeUnique.h"
 #include "utils/LogManager.h"
 
+#include <limits>
+
 CreatureActionSearchTileToDig::CreatureActionSearchTileToDig(Creature& creature, bool forced) :
     CreatureAction(creature),
     mForced(forced)
@@ -108,17 +111,21 @@ bool CreatureActionSearchTileToDig::handleSearchTileToDig(Creature& creature, in
         return true;
     }
 
-    // Find the closest tile to dig
+    // Find the closest tile to dig among the tiles marked for digging within sight radius
+    std::vector<Tile*> markedTiles;
+    if(tempPlayer != nullptr)
+    {
+        creature.getGameMap()->getResourceTileIndex().findNearestTilesMarkedForDigging(*tempPlayer,
+            myTile->getX(), myTile->getY(), std::numeric_limits<uint32_t>::max(),
+            creature.getDefinition()->getSightRadius(), markedTiles);
+    }
+
     float distBest = -1;
     Tile* tileToDig = nullptr;
     Tile* tilePos = nullptr;
-    for (Tile* tile : creature.getTilesWithinSightRadius())
+    for (Tile* tile : markedTiles)
     {
-        // Check to see whether the tile is marked for digging
-        if(!tile->getMarkedForDigging(tempPlayer))
-            continue;
-
-        // and there is still room to work on it
+        // Check if there is still room to work on it
         std::vector<Tile*> tiles;
         tile->canWorkerDig(creature, tiles);
         if(tiles.empty())
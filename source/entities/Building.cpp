@@ -437,7 +437,10 @@ bool Building::importFromStream(std::istream& is)
         }
 
         if(tileData->mHP > 0)
+        {
             tile->setSeat(getSeat());
+            tile->refreshSeatAggregates();
+        }
     }
 
     return true;
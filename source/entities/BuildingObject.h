@@ -45,6 +45,9 @@ public:
 
     void doUpkeep() override;
 
+    bool canBeInstanced() const override
+    { return true; }
+
     void addParticleEffect(const std::string& effectScript, uint32_t nbTurns);
 
     void fireRefresh();
@@ -58,6 +58,7 @@
 #include "gamemap/GameMap.h"
 #include "gamemap/Pathfinding.h"
 #include "giftboxes/GiftBoxSkill.h"
+#include "goals/Goal.h"
 #include "network/ODClient.h"
 #include "network/ODServer.h"
 #include "network/ServerNotification.h"
@@ -73,7 +74,9 @@
 #include "utils/Helper.h"
 #include "utils/LogManager.h"
 #include "utils/MakeUnique.h"
+#include "utils/Metrics.h"
 #include "utils/Random.h"
+#include "utils/Tracing.h"
 
 #include <CEGUI/Event.h>
 #include <CEGUI/System.h>
@@ -171,7 +174,10 @@ Creature::Creature(GameMap* gameMap, const CreatureDefinition* definition, Seat*
     mSeatPrison              (nullptr),
     mNbTurnsTorture          (0),
     mNbTurnsPrison           (0),
-    mActiveSlapsCount        (0)
+    mActiveSlapsCount        (0),
+    mIsInGameMap             (false),
+    mSeatCountingCreature    (nullptr),
+    mDefinitionCounted       (nullptr)
 
 {
     //TODO: This should be set in initialiser list in parent classes
@@ -249,7 +255,10 @@ Creature::Creature(GameMap* gameMap) :
     mSeatPrison              (nullptr),
     mNbTurnsTorture          (0),
     mNbTurnsPrison           (0),
-    mActiveSlapsCount        (0)
+    mActiveSlapsCount        (0),
+    mIsInGameMap             (false),
+    mSeatCountingCreature    (nullptr),
+    mDefinitionCounted       (nullptr)
 {
 }
 
@@ -321,6 +330,8 @@ void Creature::addToGameMap()
         return;
 
     getGameMap()->addActiveObject(this);
+    mIsInGameMap = true;
+    refreshSeatAggregates();
 }
 
 void Creature::removeFromGameMap()
@@ -334,6 +345,9 @@ void Creature::removeFromGameMap()
     if(!getIsOnServerMap())
         return;
 
+    mIsInGameMap = false;
+    refreshSeatAggregates();
+
     // If the creature has a homeTile where it sleeps, its bed needs to be destroyed.
     if (getHomeTile() != nullptr)
     {
@@ -771,6 +785,7 @@ void Creature::doUpkeep()
             // it is not standing on a jail. It is free
             mSeatPrison = nullptr;
             mNeedFireRefresh = true;
+            wakeUpWatchingTraps();
         }
     }
 
@@ -986,6 +1001,7 @@ void Creature::doUpkeep()
 
         if (mActions.empty())
         {
+            OD_TRACE_SCOPE("Creature action idle");
             loopBack = handleIdleAction();
             OD_LOG_DBG("creature=" + getName() + " action queue empty, defaulting to idle, result=" + (loopBack?"1":"0"));
         }
@@ -995,6 +1011,7 @@ void Creature::doUpkeep()
             // We save the action type here because the action may be removed after calling
             // the action function
             CreatureActionType actType = act->getType();
+            OD_TRACE_SCOPE_DYNAMIC("Creature action " + CreatureAction::toString(actType));
             std::function<bool()> func = act->action();
             loopBack = func();
             OD_LOG_DBG("creature=" + getName() + " trying action=" + CreatureAction::toString(actType) + ", result=" + std::string(loopBack?"1":"0"));
@@ -2580,17 +2597,46 @@ void Creature::fireRemoveEntity(Seat* seat)
 
 void Creature::fireCreatureRefreshIfNeeded()
 {
-    if(!mNeedFireRefresh)
+    if(mNeedFireRefresh)
+    {
+        mNeedFireRefresh = false;
+        for(Seat* seat : mSeatsWithVisionNotified)
+        {
+            if(seat->getPlayer() == nullptr)
+                continue;
+            if(!seat->getPlayer()->getIsHuman())
+                continue;
+            if(std::find(mSeatsWithRefreshPending.begin(), mSeatsWithRefreshPending.end(), seat) != mSeatsWithRefreshPending.end())
+                continue;
+
+            mSeatsWithRefreshPending.push_back(seat);
+        }
+    }
+
+    if(mSeatsWithRefreshPending.empty())
         return;
 
-    mNeedFireRefresh = false;
-    for(Seat* seat : mSeatsWithVisionNotified)
+    static Metrics::Counter& deferredRefreshes = Metrics::getCounter("od_server_deferred_creature_refreshes",
+        "Creature refreshes not notified because the creature was far from the player camera");
+    Tile* posTile = getPositionTile();
+    for(auto it = mSeatsWithRefreshPending.begin(); it != mSeatsWithRefreshPending.end();)
     {
-        if(seat->getPlayer() == nullptr)
+        Seat* seat = *it;
+        // If the seat lost vision, it will get the whole creature when it sees it again
+        if(std::find(mSeatsWithVisionNotified.begin(), mSeatsWithVisionNotified.end(), seat) == mSeatsWithVisionNotified.end())
+        {
+            it = mSeatsWithRefreshPending.erase(it);
             continue;
-        if(!seat->getPlayer()->getIsHuman())
+        }
+
+        if((posTile != nullptr) && !seat->getInterest().isUpdateAllowed(posTile->getX(), posTile->getY()))
+        {
+            deferredRefreshes.increment();
+            ++it;
             continue;
+        }
 
+        it = mSeatsWithRefreshPending.erase(it);
         const std::string& name = getName();
         ServerNotification *serverNotification = new ServerNotification(
             ServerNotificationType::entitiesRefresh, seat->getPlayer());
@@ -2599,6 +2645,7 @@ void Creature::fireCreatureRefreshIfNeeded()
         serverNotification->mPacket << GameEntityType::creature;
         serverNotification->mPacket << name;
         exportToPacketForUpdate(serverNotification->mPacket, seat);
+        seat->getInterest().updateSent(serverNotification->mPacket.getDataSize());
         ODServer::getSingleton().queueServerNotification(serverNotification);
     }
 }
@@ -2801,18 +2848,7 @@ void Creature::fireCreatureSound(CreatureSound sound)
     }
 
     std::string soundComplete = "Creatures/" + soundFamily;
-    for(Seat* seat : mSeatsWithVisionNotified)
-    {
-        if(seat->getPlayer() == nullptr)
-            continue;
-        if(!seat->getPlayer()->getIsHuman())
-            continue;
-
-        ServerNotification *serverNotification = new ServerNotification(
-            ServerNotificationType::playSpatialSound, seat->getPlayer());
-        serverNotification->mPacket << soundComplete << posTile->getX() << posTile->getY();
-        ODServer::getSingleton().queueServerNotification(serverNotification);
-    }
+    getGameMap()->fireSpatialSound(mSeatsWithVisionNotified, soundComplete, posTile->getX(), posTile->getY());
 }
 
 void Creature::itsPayDay()
@@ -2894,6 +2930,9 @@ void Creature::computeCreatureOverlayHealthValue()
         mOverlayHealthValue = value;
         mNeedFireRefresh = true;
     }
+
+    // This is called after every HP change so the creature may have died or been healed back
+    refreshSeatAggregates();
 }
 
 void Creature::computeCreatureOverlayMoodValue()
@@ -3077,6 +3116,7 @@ void Creature::setInJail(Room* prison)
 
         mSeatPrison = nullptr;
         mNeedFireRefresh = true;
+        wakeUpWatchingTraps();
         return;
     }
 
@@ -3220,6 +3260,7 @@ void Creature::changeSeat(Seat* newSeat)
     OD_LOG_INF("creature=" + getName() + " changes side from seatId=" + Helper::toString(getSeat()->getId()) + " to seatId=" + Helper::toString(newSeat->getId()));
     OD_ASSERT_TRUE_MSG(getSeat() != newSeat, "creature=" + getName() + ", seatId=" + Helper::toString(newSeat->getId()));
     setSeat(newSeat);
+    refreshSeatAggregates();
     mMoodValue = CreatureMoodLevel::Neutral;
     mMoodPoints = 0;
     mWakefulness = 100;
@@ -3235,4 +3276,42 @@ void Creature::changeSeat(Seat* newSeat)
         RoomDormitory* home = static_cast<RoomDormitory*>(getHomeTile()->getCoveringBuilding());
         home->releaseTileForSleeping(getHomeTile(), this);
     }
+    // Traps that were ignoring the creature as an ally may now target it
+    wakeUpWatchingTraps();
+}
+
+void Creature::refreshSeatAggregates()
+{
+    if(!getIsOnServerMap())
+        return;
+
+    // Dead creatures stay on the map for a few turns but are not counted
+    Seat* seat = nullptr;
+    if(mIsInGameMap && (mDefinition != nullptr) && isAlive())
+        seat = getSeat();
+
+    if((seat == mSeatCountingCreature) && (mDefinition == mDefinitionCounted))
+        return;
+
+    if(mSeatCountingCreature != nullptr)
+        mSeatCountingCreature->getAggregates().creatureRemoved(*mDefinitionCounted);
+
+    mSeatCountingCreature = seat;
+    mDefinitionCounted = mDefinition;
+    if(mSeatCountingCreature != nullptr)
+        mSeatCountingCreature->getAggregates().creatureAdded(*mDefinitionCounted);
+
+    getGameMap()->notifyGoalEvent(Goal::creaturesChanged);
+}
+
+void Creature::wakeUpWatchingTraps()
+{
+    if(!getIsOnServerMap() || !getIsOnMap())
+        return;
+
+    Tile* posTile = getPositionTile();
+    if(posTile == nullptr)
+        return;
+
+    getGameMap()->getTrapTriggerIndex().creatureEnteredTile(*posTile);
 }
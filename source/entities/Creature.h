@@ -471,6 +471,8 @@ public:
     void pushAction(std::unique_ptr<CreatureAction>&& action);
     void popAction();
 
+    //! \brief Notifies the seats with vision if something changed. Seats looking far from the creature
+    //! may be notified during a later turn
     void fireCreatureRefreshIfNeeded();
 
     void fireChatMsgTookFee(int goldTaken);
@@ -588,6 +590,10 @@ public:
     //! \brief Called when the creature changes seat (for example when it becomes rogue or after torture)
     void changeSeat(Seat* newSeat);
 
+    //! \brief Server side. Updates the creature counts of the seats if the creature died, changed
+    //! seat or was added/removed from the game map since the last call
+    void refreshSeatAggregates();
+
 protected:
     virtual void exportToPacket(ODPacket& os, const Seat* seat) const override;
     virtual void importFromPacket(ODPacket& is) override;
@@ -724,6 +730,10 @@ private:
     //! level or HP)
     bool                            mNeedFireRefresh;
 
+    //! Used on server side. Seats that should be notified about the last change but were not because the
+    //! creature is far from their camera
+    std::vector<Seat*>              mSeatsWithRefreshPending;
+
     //! \brief Used on client side. When a creature is dropped, this cooldown will be set to a value > 0
     //! and decreased at each turn. Until it is > 0, the creature cannot be slapped. That's to avoid
     //! slapping creatures to death when dropping many.
@@ -758,6 +768,13 @@ private:
     //! \brief Counts the number of active slaps affecting the creature
     uint32_t                        mActiveSlapsCount;
 
+    //! \brief True between addToGameMap and removeFromGameMap
+    bool                            mIsInGameMap;
+
+    //! \brief Seat (and class) whose creature counts include this creature. Used on server side only
+    Seat*                           mSeatCountingCreature;
+    const CreatureDefinition*       mDefinitionCounted;
+
     //! \brief Skills the creature can use
     std::vector<CreatureSkillData> mSkillData;
 
@@ -779,6 +796,11 @@ private:
     void computeMood();
 
     void computeCreatureOverlayMoodValue();
+
+    //! \brief Server side. Wakes up the traps watching the creature tile. Should be called when the
+    //! creature becomes attackable without moving because traps are only woken up when a creature
+    //! enters a tile they watch
+    void wakeUpWatchingTraps();
 };
 
 #endif // CREATURE_H
@@ -349,7 +349,7 @@ ODPacket& operator>>(ODPacket& is, CreatureDefinition* c)
     return is;
 }
 
-CreatureDefinition* CreatureDefinition::load(std::stringstream& defFile, const std::map<std::string, CreatureDefinition*>& defMap)
+CreatureDefinition* CreatureDefinition::load(std::istream& defFile, const std::map<std::string, CreatureDefinition*>& defMap)
 {
     if (!defFile.good())
         return nullptr;
@@ -365,7 +365,7 @@ CreatureDefinition* CreatureDefinition::load(std::stringstream& defFile, const s
 
 }
 
-bool CreatureDefinition::update(CreatureDefinition* creatureDef, std::stringstream& defFile, const std::map<std::string, CreatureDefinition*>& defMap)
+bool CreatureDefinition::update(CreatureDefinition* creatureDef, std::istream& defFile, const std::map<std::string, CreatureDefinition*>& defMap)
 {
     std::string nextParam;
     bool exit = false;
@@ -1002,7 +1002,7 @@ void CreatureDefinition::writeCreatureDefinitionDiff(
     file << "[/Creature]" << std::endl;
 }
 
-void CreatureDefinition::loadXPTable(std::stringstream& defFile, CreatureDefinition* creatureDef)
+void CreatureDefinition::loadXPTable(std::istream& defFile, CreatureDefinition* creatureDef)
 {
     if (creatureDef == nullptr)
     {
@@ -1042,7 +1042,7 @@ void CreatureDefinition::loadXPTable(std::stringstream& defFile, CreatureDefinit
     }
 }
 
-void CreatureDefinition::loadCreatureSkills(std::stringstream& defFile, CreatureDefinition* creatureDef)
+void CreatureDefinition::loadCreatureSkills(std::istream& defFile, CreatureDefinition* creatureDef)
 {
     if (creatureDef == nullptr)
     {
@@ -1082,7 +1082,7 @@ void CreatureDefinition::loadCreatureSkills(std::stringstream& defFile, Creature
     }
 }
 
-void CreatureDefinition::loadCreatureBehaviours(std::stringstream& defFile, CreatureDefinition* creatureDef)
+void CreatureDefinition::loadCreatureBehaviours(std::istream& defFile, CreatureDefinition* creatureDef)
 {
     if (creatureDef == nullptr)
     {
@@ -1122,7 +1122,7 @@ void CreatureDefinition::loadCreatureBehaviours(std::stringstream& defFile, Crea
     }
 }
 
-void CreatureDefinition::loadCreatureMoods(std::stringstream& defFile, CreatureDefinition* creatureDef)
+void CreatureDefinition::loadCreatureMoods(std::istream& defFile, CreatureDefinition* creatureDef)
 {
     if (creatureDef == nullptr)
     {
@@ -1162,7 +1162,7 @@ void CreatureDefinition::loadCreatureMoods(std::stringstream& defFile, CreatureD
     }
 }
 
-void CreatureDefinition::loadRoomAffinity(std::stringstream& defFile, CreatureDefinition* creatureDef)
+void CreatureDefinition::loadRoomAffinity(std::istream& defFile, CreatureDefinition* creatureDef)
 {
     OD_ASSERT_TRUE(creatureDef != nullptr);
     if (creatureDef == nullptr)
@@ -139,8 +139,8 @@ public:
 
     //! \brief Loads a definition from the creature definition file sub [Creature][/Creature] part
     //! \returns A creature definition if valid, nullptr otherwise.
-    static CreatureDefinition* load(std::stringstream& defFile, const std::map<std::string, CreatureDefinition*>& defMap);
-    static bool update(CreatureDefinition* creatureDef, std::stringstream& defFile, const std::map<std::string, CreatureDefinition*>& defMap);
+    static CreatureDefinition* load(std::istream& defFile, const std::map<std::string, CreatureDefinition*>& defMap);
+    static bool update(CreatureDefinition* creatureDef, std::istream& defFile, const std::map<std::string, CreatureDefinition*>& defMap);
 
     inline CreatureJob          getCreatureJob  () const    { return mCreatureJob; }
     inline const std::string&   getClassName    () const    { return mClassName; }
@@ -352,19 +352,19 @@ private:
     std::string mSoundFamilySlap;
 
     //! \brief Loads the creature XP values for the given definition.
-    static void loadXPTable(std::stringstream& defFile, CreatureDefinition* creatureDef);
+    static void loadXPTable(std::istream& defFile, CreatureDefinition* creatureDef);
 
     //! \brief Loads the creature skills for the given definition.
-    static void loadCreatureSkills(std::stringstream& defFile, CreatureDefinition* creatureDef);
+    static void loadCreatureSkills(std::istream& defFile, CreatureDefinition* creatureDef);
 
     //! \brief Loads the creature specific behaviours for the given definition.
-    static void loadCreatureBehaviours(std::stringstream& defFile, CreatureDefinition* creatureDef);
+    static void loadCreatureBehaviours(std::istream& defFile, CreatureDefinition* creatureDef);
 
     //! \brief Loads the creature specific mood modifiers for the given definition.
-    static void loadCreatureMoods(std::stringstream& defFile, CreatureDefinition* creatureDef);
+    static void loadCreatureMoods(std::istream& defFile, CreatureDefinition* creatureDef);
 
     //! \brief Loads the creature room affinity for the given definition.
-    static void loadRoomAffinity(std::stringstream& defFile, CreatureDefinition* creatureDef);
+    static void loadRoomAffinity(std::istream& defFile, CreatureDefinition* creatureDef);
 };
 
 #endif // CREATUREDEFINITION_H
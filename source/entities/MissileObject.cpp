@@ -96,21 +96,18 @@ void MissileObject::doUpkeep()
     Ogre::Vector3 position = getPosition();
     double moveDist = getMoveSpeed();
     Ogre::Vector3 destination;
-    std::list<Tile*> tiles;
+    TileLineIterator tiles(*getGameMap());
     mIsMissileAlive = computeDestination(position, moveDist, mDirection, destination, tiles);
 
     std::vector<Ogre::Vector3> path;
+    // Used to look for creatures on the tiles we go through one by one
+    std::vector<Tile*> tileVector(1, nullptr);
     Tile* lastTile = nullptr;
-    while(!tiles.empty() && mIsMissileAlive)
+    while(mIsMissileAlive)
     {
-        Tile* tmpTile = tiles.front();
-        tiles.pop_front();
-
+        Tile* tmpTile = tiles.next();
         if(tmpTile == nullptr)
-        {
-            OD_LOG_ERR("Unexpected null tile when reading missile path name=" + getName() + ", lastTile=" + (lastTile == nullptr ? std::string("nullptr") : Tile::displayAsString(lastTile)));
-            continue;
-        }
+            break;
 
         if(tmpTile->getFullness() > 0.0)
         {
@@ -165,8 +162,7 @@ void MissileObject::doUpkeep()
             }
         }
 
-        std::vector<Tile*> tileVector;
-        tileVector.push_back(tmpTile);
+        tileVector[0] = tmpTile;
         std::vector<GameEntity*> enemyCreatures = getGameMap()->getVisibleCreatures(tileVector, getSeat(), true);
         for(std::vector<GameEntity*>::iterator it = enemyCreatures.begin(); it != enemyCreatures.end(); ++it)
         {
@@ -202,12 +198,23 @@ void MissileObject::doUpkeep()
 }
 
 bool MissileObject::computeDestination(const Ogre::Vector3& position, double moveDist, const Ogre::Vector3& direction,
-        Ogre::Vector3& destination, std::list<Tile*>& tiles)
+        Ogre::Vector3& destination, TileLineIterator& tiles)
 {
     destination = position + (moveDist * direction);
-    tiles = getGameMap()->tilesBetween(Helper::round(position.x),
-        Helper::round(position.y), Helper::round(destination.x), Helper::round(destination.y));
-    if(tiles.empty())
+    tiles.reset(Helper::round(position.x), Helper::round(position.y),
+        Helper::round(destination.x), Helper::round(destination.y));
+
+    // We walk through a copy of the line to get the last tile without building the list
+    TileLineIterator it = tiles;
+    Tile* lastTile = nullptr;
+    uint32_t nbTiles = 0;
+    for(Tile* tile = it.next(); tile != nullptr; tile = it.next())
+    {
+        lastTile = tile;
+        ++nbTiles;
+    }
+
+    if(lastTile == nullptr)
     {
         OD_LOG_ERR("missile=" + getName() + " has unexpected empty tiles destination");
         return false;
@@ -219,12 +226,11 @@ bool MissileObject::computeDestination(const Ogre::Vector3& position, double mov
        (direction.y > 0 && destination.y > static_cast<Ogre::Real>(getGameMap()->getMapSizeY() - 1)) ||
        (direction.y < 0 && destination.y < 0))
     {
-        Tile* lastTile = tiles.back();
         destination.x = static_cast<Ogre::Real>(lastTile->getX());
         destination.y = static_cast<Ogre::Real>(lastTile->getY());
 
         // We are in the last position, we can die
-        if(tiles.size() <= 1)
+        if(nbTiles <= 1)
             return false;
     }
 
@@ -28,6 +28,7 @@ class Creature;
 class Room;
 class GameMap;
 class Tile;
+class TileLineIterator;
 class ODPacket;
 
 enum class MissileObjectType
@@ -104,7 +105,7 @@ protected:
 
 private:
     bool computeDestination(const Ogre::Vector3& position, double moveDist, const Ogre::Vector3& direction,
-        Ogre::Vector3& destination, std::list<Tile*>& tiles);
+        Ogre::Vector3& destination, TileLineIterator& tiles);
     Ogre::Vector3 mDirection;
     bool mIsMissileAlive;
     GameEntity* mEntityTarget;
@@ -19,6 +19,7 @@
 #define MISSILEONEHIT_H
 
 #include "entities/MissileObject.h"
+#include "utils/ObjectPool.h"
 
 #include <string>
 #include <iosfwd>
@@ -29,7 +30,7 @@ class GameMap;
 class Tile;
 class ODPacket;
 
-class MissileOneHit: public MissileObject
+class MissileOneHit: public MissileObject, public PooledObject<MissileOneHit>
 {
 public:
     MissileOneHit(GameMap* gameMap, Seat* seat, const std::string& senderName, const std::string& meshName,
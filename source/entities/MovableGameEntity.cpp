@@ -17,6 +17,7 @@
 
 #include "entities/MovableGameEntity.h"
 
+#include "camera/CullingManager.h"
 #include "entities/Tile.h"
 #include "game/Player.h"
 #include "game/Seat.h"
@@ -26,6 +27,7 @@
 #include "render/RenderManager.h"
 #include "utils/Helper.h"
 #include "utils/LogManager.h"
+#include "utils/Metrics.h"
 #include "utils/Random.h"
 #include "ODApplication.h"
 
@@ -39,7 +41,8 @@ MovableGameEntity::MovableGameEntity(GameMap* gameMap) :
     mDestinationPlayIdleWhenAnimationEnds(false),
     mDestinationAnimationDirection(Ogre::Vector3::ZERO),
     mWalkDirection(Ogre::Vector3::ZERO),
-    mAnimationTime(0.0)
+    mAnimationTime(0.0),
+    mPendingAnimationTime(0.0)
 {
 }
 
@@ -215,11 +218,19 @@ void MovableGameEntity::update(Ogre::Real timeSinceLastFrame)
     mAnimationTime += addedTime;
     if (!getIsOnServerMap() && getAnimationState() != nullptr)
     {
+        static Metrics::Counter& deferredAnimations = Metrics::getCounter("od_deferred_animation_updates",
+            "Frames where the animation of an entity was not advanced because it was off screen or far from the camera");
+        mPendingAnimationTime += addedTime;
+        if(!isAnimationUpdated())
+            deferredAnimations.increment();
         // If the animation has stopped we set it to idle if we have to
-        if(mDestinationPlayIdleWhenAnimationEnds && getAnimationState()->hasEnded())
+        else if(mDestinationPlayIdleWhenAnimationEnds && getAnimationState()->hasEnded())
             RenderManager::getSingleton().rrSetObjectAnimationState(this, EntityAnimation::idle_anim, true);
         else
-            getAnimationState()->addTime(static_cast<Ogre::Real>(addedTime));
+        {
+            getAnimationState()->addTime(static_cast<Ogre::Real>(mPendingAnimationTime));
+            mPendingAnimationTime = 0.0;
+        }
     }
 
     if (mWalkQueue.empty())
@@ -268,6 +279,17 @@ void MovableGameEntity::update(Ogre::Real timeSinceLastFrame)
     setPosition(newPosition);
 }
 
+bool MovableGameEntity::isAnimationUpdated() const
+{
+    // Entities that are not on a tile (in the keeper hand for example) are always displayed
+    Tile* tile = getPositionTile();
+    if(!getIsOnMap() || (tile == nullptr))
+        return true;
+
+    bool isOnScreen = (tile->getTileCulling() & CullingType::SHOW_MAIN_WINDOW) != 0;
+    return getGameMap()->getAnimationScheduler().isAnimationUpdated(isOnScreen, tile->getX(), tile->getY());
+}
+
 void MovableGameEntity::setPosition(const Ogre::Vector3& v)
 {
     Tile* oldTile = nullptr;
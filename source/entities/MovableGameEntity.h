@@ -98,7 +98,10 @@ public:
     virtual void setPosition(const Ogre::Vector3& v) override;
 
     inline void setAnimationState(Ogre::AnimationState* animationState)
-    { mAnimationState = animationState; }
+    {
+        mAnimationState = animationState;
+        mPendingAnimationTime = 0.0;
+    }
 
     inline Ogre::AnimationState* getAnimationState() const
     { return mAnimationState; }
@@ -126,6 +129,12 @@ private:
     Ogre::Vector3 mDestinationAnimationDirection;
     Ogre::Vector3 mWalkDirection;
     double mAnimationTime;
+    //! \brief Client side time not applied yet to mAnimationState because the entity was
+    //! off screen or far from the camera (see AnimationScheduler)
+    double mPendingAnimationTime;
+
+    //! \brief Returns true if the animation should be advanced this frame
+    bool isAnimationUpdated() const;
 };
 
 
@@ -71,6 +71,12 @@ public:
 
     virtual void setMeshOpacity(float opacity);
 
+    //! \brief Returns true if the mesh is static and can be merged with the other objects using it
+    //! instead of having its own entity. Objects that should be animated or carried will get their
+    //! entity back when needed
+    virtual bool canBeInstanced() const
+    { return false; }
+
     virtual void pickup() override;
     virtual void drop(const Ogre::Vector3& v) override;
 
@@ -19,6 +19,7 @@
 #define RESEARCHENTITY_H
 
 #include "entities/RenderedMovableEntity.h"
+#include "utils/ObjectPool.h"
 
 #include <string>
 #include <iosfwd>
@@ -29,7 +30,7 @@ class GameMap;
 class Tile;
 class ODPacket;
 
-class SkillEntity: public RenderedMovableEntity
+class SkillEntity: public RenderedMovableEntity, public PooledObject<SkillEntity>
 {
 public:
     SkillEntity(GameMap* gameMap, const std::string& libraryName, int32_t skillPoints);
@@ -19,6 +19,7 @@
 #define SMALLSPIDERENTITY_H
 
 #include "entities/RenderedMovableEntity.h"
+#include "utils/ObjectPool.h"
 
 #include <string>
 #include <iosfwd>
@@ -29,7 +30,7 @@ class GameMap;
 class Tile;
 class ODPacket;
 
-class SmallSpiderEntity: public RenderedMovableEntity
+class SmallSpiderEntity: public RenderedMovableEntity, public PooledObject<SmallSpiderEntity>
 {
 public:
     SmallSpiderEntity(GameMap* gameMap, const std::string& cryptName, int32_t nbTurnLife);
@@ -21,6 +21,7 @@
 #include "entities/Building.h"
 #include "entities/Creature.h"
 #include "entities/GameEntityType.h"
+#include "entities/TileClaim.h"
 #include "entities/TreasuryObject.h"
 #include "game/Player.h"
 #include "game/Seat.h"
@@ -33,6 +34,7 @@
 #include "utils/ConfigManager.h"
 #include "utils/Helper.h"
 #include "utils/LogManager.h"
+#include "utils/TextFileTokenizer.h"
 
 #include <cstddef>
 #include <bitset>
@@ -60,6 +62,7 @@ Tile::Tile(GameMap* gameMap, int x, int y, TileType type, double fullness) :
     mRefundPriceTrap    (0),
     mCoveringBuilding   (nullptr),
     mClaimedPercentage  (0.0),
+    mSeatCountingClaim  (nullptr),
     mIsRoom             (false),
     mIsTrap             (false),
     mDisplayTileMesh    (true),
@@ -417,6 +420,7 @@ bool Tile::isMarkedForDiggingByAnySeat()
 void Tile::addPlayerMarkingTile(const Player *p)
 {
     mPlayersMarkingTile.push_back(p);
+    getGameMap()->getResourceTileIndex().tileMarkingChanged(*this, *p, true);
 }
 
 void Tile::removePlayerMarkingTile(const Player *p)
@@ -426,6 +430,7 @@ void Tile::removePlayerMarkingTile(const Player *p)
         return;
 
     mPlayersMarkingTile.erase(it);
+    getGameMap()->getResourceTileIndex().tileMarkingChanged(*this, *p, false);
 }
 
 void Tile::addNeighbor(Tile *n)
@@ -713,10 +718,7 @@ bool Tile::isClaimed() const
     if(getSeat() == nullptr)
         return false;
 
-    if(mClaimedPercentage < 1.0)
-        return false;
-
-    return true;
+    return TileClaim::isClaimed(mClaimedPercentage);
 }
 
 void Tile::clearVision()
@@ -897,12 +899,27 @@ void Tile::exportToStream(Tile* tile, std::ostream& os)
     tile->exportToStream(os);
 }
 
+void Tile::setType(TileType t)
+{
+    if(mType == t)
+        return;
+
+    mType = t;
+    getGameMap()->getResourceTileIndex().tileTypeChanged(*this);
+}
+
 void Tile::setFullness(double f)
 {
     double oldFullness = getFullness();
 
     mFullness = f;
 
+    if((oldFullness > 0.0) != (mFullness > 0.0))
+    {
+        getGameMap()->getResourceTileIndex().tileTypeChanged(*this);
+        getGameMap()->getTrapTriggerIndex().tileVisionChanged(*this);
+    }
+
     // If the tile was marked for digging and has been dug out, unmark it and set its fullness to 0.
     if (mFullness == 0.0 && isMarkedForDiggingByAnySeat())
     {
@@ -1000,6 +1017,14 @@ void Tile::setCoveringBuilding(Building *building)
         setSeat(mCoveringBuilding->getSeat());
         mClaimedPercentage = 1.0;
     }
+
+    if(getIsOnServerMap())
+    {
+        refreshSeatAggregates();
+        getGameMap()->tileStateChangedForAI(*this);
+        // The new building may block vision (for example a door)
+        getGameMap()->getTrapTriggerIndex().tileVisionChanged(*this);
+    }
 }
 
 bool Tile::isGroundClaimable(Seat* seat) const
@@ -1090,29 +1115,28 @@ void Tile::updateFromPacket(ODPacket& is)
     fireTileStateChanged();
 }
 
-void Tile::loadFromLine(const std::string& line, Tile *t)
+void Tile::loadFromLine(boost::string_ref line, Tile *t)
 {
-    std::vector<std::string> elems = Helper::split(line, '\t');
-
-    int xLocation = Helper::toInt(elems[0]);
-    int yLocation = Helper::toInt(elems[1]);
+    TextFileTokenizer tokenizer(line);
 
-    std::stringstream tileName("");
-    tileName << TILE_PREFIX;
-    tileName << xLocation;
-    tileName << "_";
-    tileName << yLocation;
+    int32_t xLocation = 0;
+    int32_t yLocation = 0;
+    int32_t tileTypeInt = 0;
+    tokenizer.nextInt32(xLocation);
+    tokenizer.nextInt32(yLocation);
+    tokenizer.nextInt32(tileTypeInt);
 
-    t->setName(tileName.str());
+    t->setName(buildName(xLocation, yLocation));
     t->mX = xLocation;
     t->mY = yLocation;
     t->mPosition = Ogre::Vector3(static_cast<Ogre::Real>(t->mX), static_cast<Ogre::Real>(t->mY), 0.0f);
 
-    TileType tileType = static_cast<TileType>(Helper::toInt(elems[2]));
+    TileType tileType = static_cast<TileType>(tileTypeInt);
     t->setType(tileType);
 
     // If the tile type is lava or water, we ignore fullness
-    double fullness;
+    double fullness = 0.0;
+    tokenizer.nextDouble(fullness);
     switch(tileType)
     {
         case TileType::water:
@@ -1121,14 +1145,14 @@ void Tile::loadFromLine(const std::string& line, Tile *t)
             break;
 
         default:
-            fullness = Helper::toDouble(elems[3]);
             break;
     }
     t->setFullnessValue(fullness);
 
     bool shouldSetSeat = false;
+    int32_t seatId = 0;
     // We allow to set seat if the tile is dirt (full or not) or if it is gold (ground only)
-    if(elems.size() >= 5)
+    if(tokenizer.nextInt32(seatId))
     {
         if(tileType == TileType::dirt)
         {
@@ -1147,7 +1171,6 @@ void Tile::loadFromLine(const std::string& line, Tile *t)
         return;
     }
 
-    int seatId = Helper::toInt(elems[4]);
     Seat* seat = t->getGameMap()->getSeatById(seatId);
     if(seat == nullptr)
         return;
@@ -1203,6 +1226,9 @@ bool Tile::addEntity(GameEntity *entity)
         entity->setParentNodeDetachFlags(
             EntityParentNodeAttach::DETACH_CULLING, mTileCulling == CullingType::HIDE);
     }
+    else if(entity->getObjectType() == GameEntityType::creature)
+        getGameMap()->getTrapTriggerIndex().creatureEnteredTile(*this);
+
     fireTileStateChanged();
     return true;
 }
@@ -1236,27 +1262,22 @@ void Tile::claimForSeat(Seat* seat, double nDanceRate)
         nDanceRate *= ConfigManager::getSingleton().getClaimingWallPenalty();
 
     // If the seat is allied, we add to it. If it is an enemy seat, we subtract from it.
-    if (getSeat() != nullptr && getSeat()->isAlliedSeat(seat))
-    {
-        mClaimedPercentage += nDanceRate;
-    }
-    else
+    bool isAlliedClaim = (getSeat() != nullptr) && getSeat()->isAlliedSeat(seat);
+    if(TileClaim::applyStep(mClaimedPercentage, isAlliedClaim, nDanceRate))
     {
-        mClaimedPercentage -= nDanceRate;
-        if (mClaimedPercentage <= 0.0)
-        {
-            // We notify the old seat that the tile is lost
-            if(getSeat() != nullptr)
-                getSeat()->notifyTileClaimedByEnemy(this);
+        // We notify the old seat that the tile is lost
+        if(getSeat() != nullptr)
+            getSeat()->notifyTileClaimedByEnemy(this);
 
-            // The tile is not yet claimed, but it is now an allied seat.
-            mClaimedPercentage *= -1.0;
-            setSeat(seat);
-            computeTileVisual();
-            setDirtyForAllSeats();
-        }
+        // The tile is not yet claimed, but it is now an allied seat.
+        setSeat(seat);
+        computeTileVisual();
+        setDirtyForAllSeats();
     }
 
+    // The first enemy claim step is enough for the owner to lose the tile
+    refreshSeatAggregates();
+
     if ((getSeat() != nullptr) && (mClaimedPercentage >= 1.0) &&
         (getSeat()->isAlliedSeat(seat)))
     {
@@ -1273,6 +1294,7 @@ void Tile::claimTile(Seat* seat)
     // We need this because if we are a client, the tile may be from a non allied seat
     setSeat(seat);
     mClaimedPercentage = 1.0;
+    refreshSeatAggregates();
 
     if(isFullTile())
         fireTileSound(TileSound::ClaimWall);
@@ -1308,6 +1330,7 @@ void Tile::unclaimTile()
 
     setSeat(nullptr);
     mClaimedPercentage = 0.0;
+    refreshSeatAggregates();
 
     computeTileVisual();
     setDirtyForAllSeats();
@@ -1327,6 +1350,23 @@ void Tile::unclaimTile()
     fireTileStateChanged();
 }
 
+void Tile::refreshSeatAggregates()
+{
+    if(!getIsOnServerMap())
+        return;
+
+    Seat* seat = isClaimed() ? getSeat() : nullptr;
+    if(seat == mSeatCountingClaim)
+        return;
+
+    if(mSeatCountingClaim != nullptr)
+        mSeatCountingClaim->getAggregates().claimedTileRemoved();
+
+    mSeatCountingClaim = seat;
+    if(mSeatCountingClaim != nullptr)
+        mSeatCountingClaim->getAggregates().claimedTileAdded();
+}
+
 double Tile::digOut(double digRate)
 {
     // We scle dig rate depending on the tile type
@@ -1735,6 +1775,8 @@ void Tile::setDirtyForAllSeats()
 
     for(std::pair<Seat*, bool>& seatChanged : mTileChangedForSeats)
         seatChanged.second = true;
+
+    getGameMap()->tileStateChangedForAI(*this);
 }
 
 void Tile::notifyEntitiesSeatsWithVision()
@@ -1963,6 +2005,7 @@ void Tile::setTileCullingFlags(uint32_t mask, bool value)
     // We save the current state. If the result is different, we refresh culling
     mTileCulling = (value ? mTileCulling | mask : mTileCulling & ~mask);
 
+    RenderManager::getSingleton().rrCullTile(*this, mTileCulling == CullingType::HIDE);
     if(mTileCulling == CullingType::HIDE)
     {
         // We cull the tile
@@ -22,6 +22,8 @@
 
 #include <OgreVector3.h>
 
+#include <boost/utility/string_ref.hpp>
+
 #include <string>
 #include <vector>
 #include <iosfwd>
@@ -172,8 +174,7 @@ public:
      * In addition to setting the tile type this function also reloads the new mesh
      * for the tile.
      */
-    inline void setType(TileType t)
-    { mType = t; }
+    void setType(TileType t);
 
     //! \brief Returns the tile type (rock, claimed, etc.).
     inline TileType getType() const
@@ -233,6 +234,10 @@ public:
     //! \brief Set/unset the value of the mask depending on boolean value
     void setTileCullingFlags(uint32_t mask, bool value);
 
+    //! \brief Returns where the tile is displayed (see CullingType)
+    inline uint32_t getTileCulling() const
+    { return mTileCulling; }
+
     //! \brief Set the tile digging mark for the given player.
     void setMarkedForDigging(bool s, const Player* p);
 
@@ -272,6 +277,10 @@ public:
     void claimForSeat(Seat* seat, double nDanceRate);
     void claimTile(Seat* seat);
     void unclaimTile();
+
+    //! \brief Server side. Updates the claimed tiles count of the seats if the tile was claimed
+    //! or unclaimed since the last call
+    void refreshSeatAggregates();
     double digOut(double digRate);
 
     inline Building* getCoveringBuilding() const
@@ -328,7 +337,7 @@ public:
     static std::string getFormat();
 
     //! \brief Loads the tile data from a level line.
-    static void loadFromLine(const std::string& line, Tile *t);
+    static void loadFromLine(boost::string_ref line, Tile *t);
 
     /*! \brief This is a helper function which just converts the tile type enum into a string.
      *
@@ -520,6 +529,9 @@ private:
     //! \brief The tile claiming. Used on server side only
     double mClaimedPercentage;
 
+    //! \brief Seat whose claimed tiles count includes this tile. Used on server side only
+    Seat* mSeatCountingClaim;
+
     //! \brief True if a building is on this tile. False otherwise. It is used on client side because the clients do not know about
     //! buildings. However, it needs to know the tiles where a building is to display the room/trap costs.
     bool mIsRoom;
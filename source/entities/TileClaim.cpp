@@ -15,28 +15,24 @@
  *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
-#ifndef CULLINGVECTORMANAGER_H_
-#define CULLINGVECTORMANAGER_H_
+#include "entities/TileClaim.h"
 
-#include "utils/VectorInt64.h"
-
-#include <array>
-#include <vector>
-
-/*! \brief The DummyArrayClass class is a wrapper 
- *  around the std::array mainly to overload the 
- *  operator [].        
- */
-
-
-class CullingVectorManager
+namespace TileClaim
+{
+bool applyStep(double& claimedPercentage, bool isAlliedClaim, double rate)
 {
-public:
-    VectorInt64& operator[](int ii) ;
-    void sort();
-    void sortByPhi(std::vector<VectorInt64> &ll, VectorInt64& cc);
-    void zoom(double);
-    std::vector<VectorInt64>  mMyArray;
-};
+    if(isAlliedClaim)
+    {
+        claimedPercentage += rate;
+        return false;
+    }
+
+    claimedPercentage -= rate;
+    if(claimedPercentage > 0.0)
+        return false;
 
-#endif // CULLINGVECTORMANAGER_H_
+    // The tile is not yet claimed, but it now belongs to the claiming seat
+    claimedPercentage *= -1.0;
+    return true;
+}
+}
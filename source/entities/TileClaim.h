@@ -0,0 +1,34 @@
+/*
+ *  Copyright (C) 2011-2016  OpenDungeons Team
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TILECLAIM_H
+#define TILECLAIM_H
+
+//! \brief Claim progress of a tile. The claimed percentage is counted for the tile seat and the
+//! tile is claimed once it reaches 1.0. Kept apart from Tile so that it can be tested without a game map
+namespace TileClaim
+{
+    //! \brief Applies a claim step of the given rate. If the claiming seat is allied with the tile seat,
+    //! the percentage increases. Otherwise, it decreases. Returns true if it went below 0. In that case,
+    //! the claiming seat should become the tile seat and the percentage is counted for it
+    bool applyStep(double& claimedPercentage, bool isAlliedClaim, double rate);
+
+    inline bool isClaimed(double claimedPercentage)
+    { return claimedPercentage >= 1.0; }
+}
+
+#endif // TILECLAIM_H
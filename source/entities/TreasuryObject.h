@@ -19,6 +19,7 @@
 #define TREASURYOBJECT_H
 
 #include "entities/RenderedMovableEntity.h"
+#include "utils/ObjectPool.h"
 
 #include <string>
 #include <iosfwd>
@@ -28,7 +29,7 @@ class GameMap;
 class ODPacket;
 class Room;
 
-class TreasuryObject: public RenderedMovableEntity
+class TreasuryObject: public RenderedMovableEntity, public PooledObject<TreasuryObject>
 {
 public:
     TreasuryObject(GameMap* gameMap, int goldValue);
@@ -38,6 +39,9 @@ public:
 
     virtual GameEntityType getObjectType() const override;
 
+    virtual bool canBeInstanced() const override
+    { return true; }
+
     virtual bool tryPickup(Seat* seat) override;
     virtual bool tryDrop(Seat* seat, Tile* tile) override;
     void mergeGold(TreasuryObject* obj);
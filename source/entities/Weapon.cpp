@@ -26,7 +26,7 @@
 #include <sstream>
 #include <fstream>
 
-Weapon* Weapon::load(std::stringstream& defFile)
+Weapon* Weapon::load(std::istream& defFile)
 {
     if (!defFile.good())
         return nullptr;
@@ -39,7 +39,7 @@ Weapon* Weapon::load(std::stringstream& defFile)
     }
     return weapon;
 }
-bool Weapon::update(Weapon* weapon, std::stringstream& defFile)
+bool Weapon::update(Weapon* weapon, std::istream& defFile)
 {
     std::string nextParam;
     bool exit = false;
@@ -41,6 +41,7 @@
 #include "utils/ConfigManager.h"
 #include "utils/Helper.h"
 #include "utils/LogManager.h"
+#include "utils/Metrics.h"
 #include "utils/Random.h"
 
 #include <istream>
@@ -71,6 +72,7 @@ Seat::Seat(GameMap* gameMap) :
     mGameMap(gameMap),
     mPlayer(nullptr),
     mGoldMined(0),
+    mGoalEventsPending(Goal::allEvents),
     mDefaultWorkerClass(nullptr),
     mTeamIndex(0),
     mIsDebuggingVision(false),
@@ -87,6 +89,7 @@ Seat::Seat(GameMap* gameMap) :
 void Seat::addGoal(Goal* g)
 {
     mUncompleteGoals.push_back(g);
+    mGoalEventsPending |= Goal::allEvents;
 }
 
 unsigned int Seat::numUncompleteGoals()
@@ -142,26 +145,45 @@ Goal* Seat::getFailedGoal(unsigned int index)
 
 unsigned int Seat::checkAllCompletedGoals()
 {
+    bool isPollingGoals = mGameMap->getIsPollingGoals();
+    bool hasGoalsMoved = false;
+
     // Loop over the goals vector and move any goals that have been met to the completed goals vector.
     std::vector<Goal*>::iterator currentGoal = mCompletedGoals.begin();
     while (currentGoal != mCompletedGoals.end())
     {
+        Goal* goal = *currentGoal;
+        // If nothing the goal depends on happened, it cannot have changed
+        bool hasEvent = (goal->getGoalEvents() & mGoalEventsPending) != 0;
+        if(!hasEvent && !isPollingGoals)
+        {
+            ++currentGoal;
+            continue;
+        }
+
         // Start by checking if this previously met goal has now been unmet.
-        if ((*currentGoal)->isUnmet(*this, *mGameMap))
+        if (goal->isUnmet(*this, *mGameMap))
         {
-            mUncompleteGoals.push_back(*currentGoal);
+            if(!hasEvent)
+                logGoalChangedWithoutEvent(*goal);
+
+            mUncompleteGoals.push_back(goal);
 
             currentGoal = mCompletedGoals.erase(currentGoal);
 
             //Signal that the list of goals has changed.
             mHasGoalsChanged = true;
+            hasGoalsMoved = true;
         }
         else
         {
             // Next check to see if this previously met goal has now been failed.
-            if ((*currentGoal)->isFailed(*this, *mGameMap))
+            if (goal->isFailed(*this, *mGameMap))
             {
-                mFailedGoals.push_back(*currentGoal);
+                if(!hasEvent)
+                    logGoalChangedWithoutEvent(*goal);
+
+                mFailedGoals.push_back(goal);
 
                 std::vector<Seat*> seats;
                 seats.push_back(this);
@@ -171,6 +193,7 @@ unsigned int Seat::checkAllCompletedGoals()
 
                 //Signal that the list of goals has changed.
                 mHasGoalsChanged = true;
+                hasGoalsMoved = true;
             }
             else
             {
@@ -179,9 +202,19 @@ unsigned int Seat::checkAllCompletedGoals()
         }
     }
 
+    // The goals moved back to the unmet list will be checked by checkAllGoals
+    if(hasGoalsMoved)
+        mGoalEventsPending |= Goal::allEvents;
+
     return numCompletedGoals();
 }
 
+void Seat::logGoalChangedWithoutEvent(const Goal& goal) const
+{
+    OD_LOG_ERR("seatId=" + Helper::toString(getId()) + ", goal=" + goal.getName()
+        + " changed while none of its events were notified");
+}
+
 bool Seat::isAlliedSeat(const Seat *seat) const
 {
     return getTeamId() == seat->getTeamId();
@@ -511,16 +544,31 @@ void Seat::setMapSize(int x, int y)
 
 unsigned int Seat::checkAllGoals()
 {
+    bool isPollingGoals = mGameMap->getIsPollingGoals();
+    bool hasGoalsMoved = false;
+
     // Loop over the goals vector and move any goals that have been met to the completed goals vector.
     std::vector<Goal*> goalsToAdd;
     std::vector<Goal*>::iterator currentGoal = mUncompleteGoals.begin();
     while (currentGoal != mUncompleteGoals.end())
     {
         Goal* goal = *currentGoal;
+        // If nothing the goal depends on happened, it cannot have changed
+        bool hasEvent = (goal->getGoalEvents() & mGoalEventsPending) != 0;
+        if(!hasEvent && !isPollingGoals)
+        {
+            ++currentGoal;
+            continue;
+        }
+
         // Start by checking if the goal has been met by this seat.
         if (goal->isMet(*this, *mGameMap))
         {
+            if(!hasEvent)
+                logGoalChangedWithoutEvent(*goal);
+
             mCompletedGoals.push_back(goal);
+            hasGoalsMoved = true;
 
             // Add any subgoals upon completion to the list of outstanding goals.
             for (unsigned int i = 0; i < goal->numSuccessSubGoals(); ++i)
@@ -552,7 +600,11 @@ unsigned int Seat::checkAllGoals()
             // If the goal has not been met, check to see if it cannot be met in the future.
             if (goal->isFailed(*this, *mGameMap))
             {
+                if(!hasEvent)
+                    logGoalChangedWithoutEvent(*goal);
+
                 mFailedGoals.push_back(goal);
+                hasGoalsMoved = true;
 
                 // Add any subgoals upon completion to the list of outstanding goals.
                 for (unsigned int i = 0; i < goal->numFailureSubGoals(); ++i)
@@ -592,9 +644,19 @@ unsigned int Seat::checkAllGoals()
         mUncompleteGoals.push_back(goal);
     }
 
+    // Every goal is up to date. If some goals moved (or subgoals were added), we check
+    // everything at next turn like a newly added goal
+    mGoalEventsPending = hasGoalsMoved ? Goal::allEvents : 0;
+
     return numUncompleteGoals();
 }
 
+void Seat::addGoldMined(int quantity)
+{
+    mGoldMined += quantity;
+    mGoalEventsPending |= Goal::goldMinedChanged;
+}
+
 void Seat::notifyChangedVisibleTiles()
 {
     if(mPlayer == nullptr)
@@ -602,7 +664,9 @@ void Seat::notifyChangedVisibleTiles()
     if(!mPlayer->getIsHuman())
         return;
 
+    // Tiles near the camera are notified first so that they get the bandwidth budget
     std::vector<Tile*> tilesToNotify;
+    std::vector<Tile*> tilesFarToNotify;
     int xMax = static_cast<int>(mTilesStates.size());
     for(int xxx = 0; xxx < xMax; ++xxx)
     {
@@ -616,24 +680,48 @@ void Seat::notifyChangedVisibleTiles()
             if(!tile->hasChangedForSeat(this))
                 continue;
 
-            tilesToNotify.push_back(tile);
+            if(mInterest.getLevel(xxx, yyy) == SeatInterest::Level::nearCamera)
+                tilesToNotify.push_back(tile);
+            else
+                tilesFarToNotify.push_back(tile);
+        }
+    }
+
+    if(tilesToNotify.empty() && tilesFarToNotify.empty())
+        return;
+
+    static Metrics::Counter& deferredTiles = Metrics::getCounter("od_server_deferred_tiles",
+        "Changed tiles not notified because they were far from the player camera");
+    ODPacket packetTiles;
+    uint32_t nbTiles = 0;
+    for(std::vector<Tile*>* tiles : { &tilesToNotify, &tilesFarToNotify })
+    {
+        for(Tile* tile : *tiles)
+        {
+            // Deferred tiles stay changed and will be checked again next turn
+            if(!mInterest.isUpdateAllowed(tile->getX(), tile->getY()))
+            {
+                deferredTiles.increment();
+                continue;
+            }
+
+            uint32_t sizeBefore = packetTiles.getDataSize();
+            mGameMap->tileToPacket(packetTiles, tile);
+            updateTileStateForSeat(tile, false);
+            tile->exportToPacketForUpdate(packetTiles, this);
             tile->changeNotifiedForSeat(this);
+            mInterest.updateSent(packetTiles.getDataSize() - sizeBefore);
+            ++nbTiles;
         }
     }
 
-    if(tilesToNotify.empty())
+    if(nbTiles == 0)
         return;
 
-    uint32_t nbTiles = tilesToNotify.size();
     ServerNotification *serverNotification = new ServerNotification(
         ServerNotificationType::refreshTiles, getPlayer());
     serverNotification->mPacket << nbTiles;
-    for(Tile* tile : tilesToNotify)
-    {
-        mGameMap->tileToPacket(serverNotification->mPacket, tile);
-        updateTileStateForSeat(tile, false);
-        tile->exportToPacketForUpdate(serverNotification->mPacket, this);
-    }
+    serverNotification->mPacket.append(packetTiles);
     ODServer::getSingleton().queueServerNotification(serverNotification);
 }
 
@@ -755,6 +843,12 @@ void Seat::sendVisibleTiles()
     if(!getPlayer()->getIsHuman())
         return;
 
+    static Metrics::Histogram& sendVisibleTilesTime = Metrics::getTimerHistogram("od_seat_send_visible_tiles_ms",
+        "Time spent in Seat::sendVisibleTiles (ms)");
+    static Metrics::Counter& visibleTilesSent = Metrics::getCounter("od_seat_visible_tiles_sent",
+        "Tiles sent to the players because their vision changed");
+    Metrics::ScopedTimer timer(sendVisibleTilesTime);
+
     uint32_t nbTiles;
     ServerNotification *serverNotification = new ServerNotification(
         ServerNotificationType::refreshVisibleTiles, getPlayer());
@@ -792,6 +886,8 @@ void Seat::sendVisibleTiles()
         mGameMap->tileToPacket(serverNotification->mPacket, tile);
     }
 
+    visibleTilesSent.increment(tilesVisionGained.size() + tilesVisionLost.size());
+
     // Notify tiles we lost vision
     nbTiles = tilesVisionLost.size();
     serverNotification->mPacket << nbTiles;
@@ -807,11 +903,8 @@ void Seat::computeSeatBeginTurn()
     if(mPlayer != nullptr)
     {
         std::fill(mNbRooms.begin(), mNbRooms.end(), 0);
-        for(Room* room : mGameMap->getRooms())
+        for(Room* room : mAggregates.getRooms())
         {
-            if(room->getSeat() != this)
-                continue;
-
             if(room->getHP(nullptr) <= 0.0)
                 continue;
 
@@ -18,6 +18,8 @@
 #ifndef SEAT_H
 #define SEAT_H
 
+#include "game/SeatAggregates.h"
+#include "game/SeatInterest.h"
 #include "game/SeatData.h"
 
 #include <OgreVector3.h>
@@ -91,14 +93,21 @@ public:
 
     /** \brief Loop over the vector of unmet goals and call the isMet() and isFailed() functions on
      * each one, if it is met move it to the completedGoals vector.
+     * Only the goals depending on an event notified since the last call are checked (unless the
+     * game map is polling goals).
      */
     unsigned int checkAllGoals();
 
     /** \brief Loop over the vector of met goals and call the isUnmet() function on each one,
      * if any of them are no longer satisfied move them back to the goals vector.
+     * Like checkAllGoals, only the goals depending on a notified event are checked.
      */
     unsigned int checkAllCompletedGoals();
 
+    //! \brief Called when something the goals may depend on changed (see Goal::GoalEvents)
+    inline void notifyGoalEvent(uint32_t goalEvents)
+    { mGoalEventsPending |= goalEvents; }
+
     //! \brief A simple accessor function to return the number of goals completed by this seat.
     unsigned int numCompletedGoals();
 
@@ -164,8 +173,7 @@ public:
     inline Ogre::Vector3 getStartingPosition() const
     { return Ogre::Vector3(static_cast<Ogre::Real>(mStartingX), static_cast<Ogre::Real>(mStartingY), 0); }
 
-    inline void addGoldMined(int quantity)
-    { mGoldMined += quantity; }
+    void addGoldMined(int quantity);
 
     inline bool getIsDebuggingVision()
     { return mIsDebuggingVision; }
@@ -208,7 +216,7 @@ public:
     bool hasVisionOnTile(Tile* tile);
 
     //! \brief Checks if the visible tiles seen by this seat have changed and notify
-    //! the players if yes
+    //! the players if yes. Tiles far from the player camera may be notified during a later turn
     void notifyChangedVisibleTiles();
 
     //! \brief Server side to toggle the tiles this seat has vision on
@@ -227,6 +235,19 @@ public:
 
     void computeSeatBeginTurn();
 
+    //! \brief Server side counters of what this seat owns, kept up to date by the tiles, creatures
+    //! and rooms. The values used during the turn are copied in SeatData by the game map upkeep
+    inline SeatAggregates& getAggregates()
+    { return mAggregates; }
+
+    inline const SeatAggregates& getAggregates() const
+    { return mAggregates; }
+
+    //! \brief Server side knowledge of where the player is looking at. Used to decide which
+    //! updates can be deferred
+    inline SeatInterest& getInterest()
+    { return mInterest; }
+
     //! \brief Gets whether a skill is being done
     bool isSkilling() const
     { return mCurrentSkill != nullptr; }
@@ -333,6 +354,9 @@ private:
     //! \brief The total amount of gold coins mined by workers under this seat's control.
     int mGoldMined;
 
+    //! \brief Goal::GoalEvents notified since the goals were last checked
+    uint32_t mGoalEventsPending;
+
     //! \brief The actual color that this color index translates into.
     Ogre::ColourValue mColorValue;
 
@@ -395,6 +419,13 @@ private:
     //! \brief Should the creatures fight to death or ko enemy creatures
     bool mKoCreatures;
 
+    SeatAggregates mAggregates;
+
+    SeatInterest mInterest;
+
+    //! \brief Called when polling goals and a goal changed state while none of its events were notified
+    void logGoalChangedWithoutEvent(const Goal& goal) const;
+
     //! \brief Server side function. Sets mCurrentSkill to the first entry in mSkillPending. If the pending
     //! list in empty, mCurrentSkill will be set to null
     //! researchedType is the currently researched type if any (nullSkillType if none)
@@ -0,0 +1,161 @@
+/*
+ *  Copyright (C) 2011-2016  OpenDungeons Team
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "game/SeatAggregates.h"
+
+#include "entities/CreatureDefinition.h"
+#include "rooms/Room.h"
+#include "utils/Helper.h"
+#include "utils/LogManager.h"
+
+#include <algorithm>
+
+SeatAggregates::SeatAggregates() :
+    mNbClaimedTiles(0),
+    mNbCreaturesWorkers(0),
+    mNbCreaturesFighters(0),
+    mGoldStored(0),
+    mGoldStorage(0)
+{
+}
+
+void SeatAggregates::clear()
+{
+    mNbClaimedTiles = 0;
+    mNbCreaturesWorkers = 0;
+    mNbCreaturesFighters = 0;
+    mGoldStored = 0;
+    mGoldStorage = 0;
+    mNbCreaturesByClass.clear();
+    mRooms.clear();
+}
+
+void SeatAggregates::claimedTileAdded()
+{
+    ++mNbClaimedTiles;
+}
+
+void SeatAggregates::claimedTileRemoved()
+{
+    if(mNbClaimedTiles == 0)
+    {
+        OD_LOG_ERR("Removing a claimed tile from an empty count");
+        return;
+    }
+    --mNbClaimedTiles;
+}
+
+void SeatAggregates::creatureAdded(const CreatureDefinition& definition)
+{
+    ++mNbCreaturesByClass[&definition];
+    if(definition.isWorker())
+        ++mNbCreaturesWorkers;
+    else
+        ++mNbCreaturesFighters;
+}
+
+void SeatAggregates::creatureRemoved(const CreatureDefinition& definition)
+{
+    auto it = mNbCreaturesByClass.find(&definition);
+    if(it == mNbCreaturesByClass.end())
+    {
+        OD_LOG_ERR("Removing uncounted creature class=" + definition.getClassName());
+        return;
+    }
+
+    if(--it->second == 0)
+        mNbCreaturesByClass.erase(it);
+
+    if(definition.isWorker())
+        --mNbCreaturesWorkers;
+    else
+        --mNbCreaturesFighters;
+}
+
+void SeatAggregates::roomAdded(Room& room)
+{
+    if(std::find(mRooms.begin(), mRooms.end(), &room) != mRooms.end())
+    {
+        OD_LOG_ERR("room=" + room.getName() + " already added");
+        return;
+    }
+    mRooms.push_back(&room);
+}
+
+void SeatAggregates::roomRemoved(Room& room)
+{
+    auto it = std::find(mRooms.begin(), mRooms.end(), &room);
+    if(it == mRooms.end())
+    {
+        OD_LOG_ERR("room=" + room.getName() + " not found");
+        return;
+    }
+    // We keep the order so that the rooms are iterated like in the game map list
+    mRooms.erase(it);
+}
+
+void SeatAggregates::goldChanged(int32_t storedDelta, int32_t storageDelta)
+{
+    mGoldStored += storedDelta;
+    mGoldStorage += storageDelta;
+}
+
+uint32_t SeatAggregates::getNbCreatures(const CreatureDefinition* definition) const
+{
+    auto it = mNbCreaturesByClass.find(definition);
+    if(it == mNbCreaturesByClass.end())
+        return 0;
+
+    return it->second;
+}
+
+bool SeatAggregates::isSameAs(const SeatAggregates& other, std::string& errors) const
+{
+    bool isSame = true;
+    auto compare = [&](const std::string& name, int64_t value, int64_t expected)
+    {
+        if(value == expected)
+            return;
+
+        isSame = false;
+        errors += " " + name + "=" + Helper::toString(value) + " (expected " + Helper::toString(expected) + ")";
+    };
+
+    compare("claimedTiles", mNbClaimedTiles, other.mNbClaimedTiles);
+    compare("workers", mNbCreaturesWorkers, other.mNbCreaturesWorkers);
+    compare("fighters", mNbCreaturesFighters, other.mNbCreaturesFighters);
+    compare("goldStored", mGoldStored, other.mGoldStored);
+    compare("goldStorage", mGoldStorage, other.mGoldStorage);
+    compare("rooms", static_cast<int64_t>(mRooms.size()), static_cast<int64_t>(other.mRooms.size()));
+
+    if(mNbCreaturesByClass != other.mNbCreaturesByClass)
+    {
+        isSame = false;
+        errors += " creatures by class differ";
+    }
+
+    for(Room* room : other.mRooms)
+    {
+        if(std::find(mRooms.begin(), mRooms.end(), room) != mRooms.end())
+            continue;
+
+        isSame = false;
+        errors += " missing room=" + room->getName();
+    }
+
+    return isSame;
+}
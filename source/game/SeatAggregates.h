@@ -0,0 +1,93 @@
+/*
+ *  Copyright (C) 2011-2016  OpenDungeons Team
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SEATAGGREGATES_H
+#define SEATAGGREGATES_H
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+class CreatureDefinition;
+class Room;
+
+//! \brief Server side counters of what a seat owns: claimed tiles, alive creatures by class,
+//! rooms and the gold stored in them. They are kept up to date by the tiles, creatures and
+//! rooms when their state changes (each of them remembers what it added to which seat) so
+//! that the game map does not have to scan everything at each turn.
+class SeatAggregates
+{
+public:
+    SeatAggregates();
+
+    void clear();
+
+    void claimedTileAdded();
+    void claimedTileRemoved();
+
+    void creatureAdded(const CreatureDefinition& definition);
+    void creatureRemoved(const CreatureDefinition& definition);
+
+    void roomAdded(Room& room);
+    void roomRemoved(Room& room);
+
+    //! \brief Called by the rooms when the gold they store or can store changes
+    void goldChanged(int32_t storedDelta, int32_t storageDelta);
+
+    inline uint32_t getNbClaimedTiles() const
+    { return mNbClaimedTiles; }
+
+    inline uint32_t getNbCreaturesWorkers() const
+    { return mNbCreaturesWorkers; }
+
+    inline uint32_t getNbCreaturesFighters() const
+    { return mNbCreaturesFighters; }
+
+    //! \brief Returns the number of alive creatures of the given class
+    uint32_t getNbCreatures(const CreatureDefinition* definition) const;
+
+    inline int32_t getGoldStored() const
+    { return mGoldStored; }
+
+    inline int32_t getGoldStorage() const
+    { return mGoldStorage; }
+
+    //! \brief Rooms owned by the seat in the order they were added to the game map. Note that
+    //! destroyed rooms stay in the list until they are removed from the game map
+    inline const std::vector<Room*>& getRooms() const
+    { return mRooms; }
+
+    //! \brief Compares with the given aggregates (computed by a full recount). Every difference
+    //! is appended to errors. Returns true if both are the same
+    bool isSameAs(const SeatAggregates& other, std::string& errors) const;
+
+private:
+    uint32_t mNbClaimedTiles;
+    uint32_t mNbCreaturesWorkers;
+    uint32_t mNbCreaturesFighters;
+    int32_t mGoldStored;
+    int32_t mGoldStorage;
+
+    //! \brief Alive creatures by class. CreatureDefinition are managed by the configuration
+    //! manager and should NOT be deleted
+    std::map<const CreatureDefinition*, uint32_t> mNbCreaturesByClass;
+
+    std::vector<Room*> mRooms;
+};
+
+#endif // SEATAGGREGATES_H
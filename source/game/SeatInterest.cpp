@@ -0,0 +1,100 @@
+/*
+ *  Copyright (C) 2011-2016  OpenDungeons Team
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "game/SeatInterest.h"
+
+#include <algorithm>
+#include <cstdlib>
+
+namespace
+{
+    //! \brief Updates sent per turn to each seat (in bytes) before deferring the ones far from the camera
+    const uint32_t BUDGET_PER_TURN = 16384;
+
+    //! \brief Tiles within FAR_RADIUS_FACTOR * radius from the camera are far, the ones farther away are distant
+    const int32_t FAR_RADIUS_FACTOR = 3;
+
+    //! \brief Updates about far (resp. distant) tiles are sent once every FAR_PERIOD (resp. DISTANT_PERIOD) turns
+    const int64_t FAR_PERIOD = 2;
+    const int64_t DISTANT_PERIOD = 8;
+}
+
+SeatInterest::SeatInterest() :
+    mX(0),
+    mY(0),
+    mRadius(-1),
+    mTurn(0),
+    mBudgetUsed(0)
+{
+}
+
+void SeatInterest::setViewport(int32_t x, int32_t y, int32_t radius)
+{
+    mX = x;
+    mY = y;
+    mRadius = std::max(radius, 0);
+}
+
+SeatInterest::Level SeatInterest::getLevel(int32_t x, int32_t y) const
+{
+    if(!hasViewport())
+        return Level::nearCamera;
+
+    int32_t dist = std::max(std::abs(x - mX), std::abs(y - mY));
+    if(dist <= mRadius)
+        return Level::nearCamera;
+
+    if(dist <= mRadius * FAR_RADIUS_FACTOR)
+        return Level::farFromCamera;
+
+    return Level::distant;
+}
+
+void SeatInterest::startTurn(int64_t turn)
+{
+    mTurn = turn;
+    mBudgetUsed = 0;
+}
+
+bool SeatInterest::isUpdateAllowed(int32_t x, int32_t y) const
+{
+    int64_t period;
+    switch(getLevel(x, y))
+    {
+        case Level::nearCamera:
+            return true;
+        case Level::farFromCamera:
+            period = FAR_PERIOD;
+            break;
+        case Level::distant:
+        default:
+            period = DISTANT_PERIOD;
+            break;
+    }
+
+    if(mBudgetUsed >= BUDGET_PER_TURN)
+        return false;
+
+    // We spread the updates over the period so that they are not all sent during the same turn
+    int64_t slot = mTurn + std::abs(x) + std::abs(y);
+    return (slot % period) == 0;
+}
+
+void SeatInterest::updateSent(uint32_t nbBytes)
+{
+    mBudgetUsed += nbBytes;
+}
@@ -0,0 +1,73 @@
+/*
+ *  Copyright (C) 2011-2016  OpenDungeons Team
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SEATINTEREST_H
+#define SEATINTEREST_H
+
+#include <cstdint>
+
+//! \brief Server side knowledge of where the player of a seat is looking at. Clients report the
+//! tile their camera is centered on and the update notifications that only refresh something
+//! already known by the client (changed tiles, creature overlays, ...) are sent at full rate
+//! near the camera and at a reduced rate farther away.
+//! Each turn, the seat has a bandwidth budget. Updates near the camera are always sent (but
+//! use the budget) while the other ones are deferred to a later turn if the budget is exhausted.
+//! Until the client reports its camera, everything is considered near the camera.
+class SeatInterest
+{
+public:
+    enum class Level
+    {
+        nearCamera,
+        farFromCamera,
+        distant
+    };
+
+    SeatInterest();
+
+    //! \brief Sets the tile the camera is centered on and the radius (in tiles) seen around it
+    void setViewport(int32_t x, int32_t y, int32_t radius);
+
+    inline bool hasViewport() const
+    { return mRadius >= 0; }
+
+    Level getLevel(int32_t x, int32_t y) const;
+
+    //! \brief Should be called at the beginning of each turn before the updates are sent
+    void startTurn(int64_t turn);
+
+    //! \brief Returns true if an update about the given tile can be sent this turn. If not,
+    //! it should be deferred
+    bool isUpdateAllowed(int32_t x, int32_t y) const;
+
+    //! \brief Should be called after an update was sent with the size of the data sent
+    void updateSent(uint32_t nbBytes);
+
+    inline uint32_t getBudgetUsed() const
+    { return mBudgetUsed; }
+
+private:
+    int32_t mX;
+    int32_t mY;
+    //! \brief Negative if the client did not report its camera
+    int32_t mRadius;
+
+    int64_t mTurn;
+    uint32_t mBudgetUsed;
+};
+
+#endif // SEATINTEREST_H
@@ -0,0 +1,87 @@
+/*
+ *  Copyright (C) 2011-2016  OpenDungeons Team
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "gamemap/AnimationScheduler.h"
+
+#include <algorithm>
+#include <cstdlib>
+
+namespace
+{
+    //! \brief Entities within this distance (in tiles) from the camera target are animated every frame
+    const int32_t NEAR_DISTANCE = 8;
+
+    //! \brief Entities far from the camera target are animated once every FAR_PERIOD frames
+    const int64_t FAR_PERIOD = 3;
+}
+
+AnimationScheduler::AnimationScheduler() :
+    mEnabled(true),
+    mX(0),
+    mY(0),
+    mHasViewTarget(false),
+    mFrame(0)
+{
+}
+
+void AnimationScheduler::setViewTarget(int32_t x, int32_t y)
+{
+    mX = x;
+    mY = y;
+    mHasViewTarget = true;
+}
+
+void AnimationScheduler::startFrame()
+{
+    ++mFrame;
+}
+
+AnimationScheduler::Level AnimationScheduler::getLevel(bool isOnScreen, int32_t x, int32_t y) const
+{
+    if(!mEnabled)
+        return Level::nearCamera;
+
+    if(!isOnScreen)
+        return Level::offScreen;
+
+    if(!mHasViewTarget)
+        return Level::nearCamera;
+
+    int32_t dist = std::max(std::abs(x - mX), std::abs(y - mY));
+    if(dist <= NEAR_DISTANCE)
+        return Level::nearCamera;
+
+    return Level::farFromCamera;
+}
+
+bool AnimationScheduler::isAnimationUpdated(bool isOnScreen, int32_t x, int32_t y) const
+{
+    switch(getLevel(isOnScreen, x, y))
+    {
+        case Level::nearCamera:
+            return true;
+        case Level::offScreen:
+            return false;
+        case Level::farFromCamera:
+        default:
+            break;
+    }
+
+    // We spread the updates over the period so that they are not all done during the same frame
+    int64_t slot = mFrame + std::abs(x) + std::abs(y);
+    return (slot % FAR_PERIOD) == 0;
+}
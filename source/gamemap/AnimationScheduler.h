@@ -0,0 +1,65 @@
+/*
+ *  Copyright (C) 2011-2016  OpenDungeons Team
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef ANIMATIONSCHEDULER_H
+#define ANIMATIONSCHEDULER_H
+
+#include <cstdint>
+
+//! \brief Client side decision of how often the skeletal animations of the entities are advanced.
+//! Entities on a tile culled from the main window are not animated at all, the ones on screen
+//! but far from the camera target are animated once every few frames and the ones near the
+//! camera target every frame. Entities keep the time that was not applied to their animation
+//! and apply it when they are updated so that animations stay in sync.
+//! This only concerns the animations: entities still move every frame.
+class AnimationScheduler
+{
+public:
+    enum class Level
+    {
+        nearCamera,
+        farFromCamera,
+        offScreen
+    };
+
+    AnimationScheduler();
+
+    //! \brief If disabled, every animation is advanced every frame
+    inline void setEnabled(bool enabled)
+    { mEnabled = enabled; }
+
+    //! \brief Sets the tile the camera is looking at
+    void setViewTarget(int32_t x, int32_t y);
+
+    //! \brief Should be called once per frame before the entities are updated
+    void startFrame();
+
+    Level getLevel(bool isOnScreen, int32_t x, int32_t y) const;
+
+    //! \brief Returns true if the animation of an entity on the given tile should be
+    //! advanced this frame
+    bool isAnimationUpdated(bool isOnScreen, int32_t x, int32_t y) const;
+
+private:
+    bool mEnabled;
+    int32_t mX;
+    int32_t mY;
+    bool mHasViewTarget;
+    int64_t mFrame;
+};
+
+#endif // ANIMATIONSCHEDULER_H
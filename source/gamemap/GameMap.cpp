@@ -59,6 +59,7 @@
 #include "utils/ConfigManager.h"
 #include "utils/Helper.h"
 #include "utils/LogManager.h"
+#include "utils/Metrics.h"
 #include "utils/ResourceManager.h"
 
 #include <OgreTimer.h>
@@ -73,6 +74,9 @@
 
 const std::string DEFAULT_NICK = "You";
 
+//! \brief Identical spatial sounds fired in the same square of tiles during a turn are sent once
+const int32_t SPATIAL_SOUND_REGION_SIZE = 4;
+
 using namespace std;
 
 /*! \brief A helper class for the A* search in the GameMap::path function.
@@ -158,10 +162,15 @@ GameMap::GameMap(bool isServerGameMap) :
         mTurnNumber(-1),
         mIsPaused(false),
         mTimePayDay(0),
+        mIsCheckingSeatAggregates(false),
+        mIsPollingGoals(false),
         mFloodFillEnabled(false),
         mIsFOWActivated(true),
         mNumCallsTo_path(0),
         mAiManager(*this),
+        mResourceTileIndex(*this),
+        mTrapTriggerIndex(*this),
+        mSpatialSounds(SPATIAL_SOUND_REGION_SIZE),
         mTileSet(nullptr)
 {
     resetUniqueNumbers();
@@ -223,6 +232,8 @@ bool GameMap::loadLevel(const std::string& levelFilepath)
 
 bool GameMap::createNewMap(int sizeX, int sizeY)
 {
+    mResourceTileIndex.clear();
+    mTrapTriggerIndex.clear();
     if (!allocateMapMemory(sizeX, sizeY))
         return false;
 
@@ -270,12 +281,16 @@ void GameMap::clearAll()
 
     processDeletionQueues();
 
+    mResourceTileIndex.clear();
+    mTrapTriggerIndex.clear();
     clearTiles();
     processDeletionQueues();
 
     clearGoalsForAllSeats();
     clearSeats();
     mLocalPlayer = nullptr;
+    // The pending sounds reference the players
+    mSpatialSounds.clear();
     clearPlayers();
 
     clearAiManager();
@@ -343,6 +358,11 @@ void GameMap::clearAiManager()
    mAiManager.clearAIList();
 }
 
+void GameMap::tileStateChangedForAI(Tile& tile)
+{
+    mAiManager.tileStateChanged(tile);
+}
+
 void GameMap::clearClasses()
 {
     for (std::pair<const CreatureDefinition*,CreatureDefinition*>& def : mClassDescriptions)
@@ -382,6 +402,7 @@ void GameMap::clearRenderedMovableEntities()
     }
 
     mRenderedMovableEntities.clear();
+    mRenderedMovableEntitiesByName.clear();
 }
 
 void GameMap::clearPlayers()
@@ -490,6 +511,7 @@ void GameMap::addCreature(Creature *cc)
         + ", seatId=" + (cc->getSeat() != nullptr ? Helper::toString(cc->getSeat()->getId()) : std::string("null")));
 
     mCreatures.push_back(cc);
+    notifyGoalEvent(Goal::creaturesChanged);
 }
 
 void GameMap::removeCreature(Creature *c)
@@ -504,6 +526,7 @@ void GameMap::removeCreature(Creature *c)
     }
 
     mCreatures.erase(it);
+    notifyGoalEvent(Goal::creaturesChanged);
 }
 
 void GameMap::queueEntityForDeletion(GameEntity *ge)
@@ -833,6 +856,7 @@ void GameMap::addRenderedMovableEntity(RenderedMovableEntity *obj)
     OD_LOG_INF(serverStr() + "Adding rendered object " + obj->getName()
         + ",MeshName=" + obj->getMeshName());
     mRenderedMovableEntities.push_back(obj);
+    mRenderedMovableEntitiesByName.insert(std::make_pair(obj->getName(), obj));
 }
 
 void GameMap::removeRenderedMovableEntity(RenderedMovableEntity *obj)
@@ -847,16 +871,19 @@ void GameMap::removeRenderedMovableEntity(RenderedMovableEntity *obj)
     }
 
     mRenderedMovableEntities.erase(it);
+
+    auto itName = mRenderedMovableEntitiesByName.find(obj->getName());
+    if((itName != mRenderedMovableEntitiesByName.end()) && (itName->second == obj))
+        mRenderedMovableEntitiesByName.erase(itName);
 }
 
 RenderedMovableEntity* GameMap::getRenderedMovableEntity(const std::string& name)
 {
-    for(RenderedMovableEntity* renderedMovableEntity : mRenderedMovableEntities)
-    {
-        if(name.compare(renderedMovableEntity->getName()) == 0)
-            return renderedMovableEntity;
-    }
-    return nullptr;
+    auto it = mRenderedMovableEntitiesByName.find(name);
+    if(it == mRenderedMovableEntitiesByName.end())
+        return nullptr;
+
+    return it->second;
 }
 
 void GameMap::addActiveObject(GameEntity *a)
@@ -1098,7 +1125,10 @@ void GameMap::doPlayerAITurn(double timeSinceLastTurn)
 
 unsigned long int GameMap::doMiscUpkeep(double timeSinceLastTurn)
 {
-    Tile *tempTile;
+    static Metrics::Histogram& miscUpkeepTime = Metrics::getTimerHistogram("od_gamemap_misc_upkeep_ms",
+        "Time spent in GameMap::doMiscUpkeep (ms)");
+    Metrics::ScopedTimer timer(miscUpkeepTime);
+
     Ogre::Timer stopwatch;
     unsigned long int timeTaken;
 
@@ -1160,28 +1190,18 @@ unsigned long int GameMap::doMiscUpkeep(double timeSinceLastTurn)
             addWinningSeat(seat);
 
         seat->mNumCreaturesFightersMax = getMaxNumberCreatures(seat);
-
-        // Set the creatures count to 0. It will be reset by the next count in doTurn()
-        seat->mNumCreaturesFighters = 0;
-        seat->mNumCreaturesWorkers = 0;
     }
 
-    // Count how many creatures the player controls
-    for(Creature* creature : mCreatures)
-    {
-        // Check to see if the creature has died.
-        if (!creature->isAlive())
-            continue;
+    if(mIsCheckingSeatAggregates)
+        checkSeatAggregates();
 
-        Seat *tempSeat = creature->getSeat();
-        if(tempSeat == nullptr)
-            continue;
-
-        // We only count fighters
-        if (creature->getDefinition()->isWorker())
-            ++(tempSeat->mNumCreaturesWorkers);
-        else
-            ++(tempSeat->mNumCreaturesFighters);
+    // The creatures the players control are counted when they are added, die or change seat.
+    // We take a snapshot that will be used during the turn
+    for (Seat* seat : mSeats)
+    {
+        const SeatAggregates& aggregates = seat->getAggregates();
+        seat->mNumCreaturesFighters = static_cast<int>(aggregates.getNbCreaturesFighters());
+        seat->mNumCreaturesWorkers = static_cast<int>(aggregates.getNbCreaturesWorkers());
     }
 
     // At each upkeep, we re-compute tiles with vision
@@ -1260,37 +1280,19 @@ unsigned long int GameMap::doMiscUpkeep(double timeSinceLastTurn)
         }
 
         // Update the count on how much gold is available in all of the treasuries claimed by the given seat.
-        seat->mGold = 0;
-        seat->mGoldMax = 0;
-        for (Room* room : getRooms())
-        {
-            if(room->getSeat() != seat)
-                continue;
-
-            seat->mGold += room->getTotalGoldStored();
-            seat->mGoldMax += room->getTotalGoldStorage();
-        }
+        seat->mGold = seat->getAggregates().getGoldStored();
+        seat->mGoldMax = seat->getAggregates().getGoldStorage();
     }
 
-    // Determine the number of tiles claimed by each seat.
-    // Begin by setting the number of claimed tiles for each seat to 0.
+    // The claimed tiles are counted by the tiles when they are claimed or unclaimed
     for (Seat* seat : mSeats)
-        seat->setNumClaimedTiles(0);
-
-    // Now loop over all of the tiles, if the tile is claimed increment the given seats count.
-    for (int jj = 0; jj < getMapSizeY(); ++jj)
     {
-        for (int ii = 0; ii < getMapSizeX(); ++ii)
-        {
-            tempTile = getTile(ii,jj);
+        uint32_t nbClaimedTiles = seat->getAggregates().getNbClaimedTiles();
+        if(seat->getNumClaimedTiles() == nbClaimedTiles)
+            continue;
 
-            // Check to see if the current tile is claimed by anyone.
-            if (tempTile->isClaimed())
-            {
-                // Increment the count of the seat who owns the tile.
-                tempTile->getSeat()->incrementNumClaimedTiles();
-            }
-        }
+        seat->setNumClaimedTiles(nbClaimedTiles);
+        seat->notifyGoalEvent(Goal::claimedTilesChanged);
     }
 
     timeTaken = stopwatch.getMicroseconds();
@@ -1306,6 +1308,7 @@ void GameMap::updateAnimations(Ogre::Real timeSinceLastFrame)
         return;
 
     // Update the animations on all AnimatedObjects
+    mAnimationScheduler.startFrame();
     for(MovableGameEntity* mge : mAnimatedObjects)
         mge->update(timeSinceLastFrame);
 }
@@ -1434,6 +1437,11 @@ bool GameMap::pathExists(const Creature* creature, Tile* tileStart, Tile* tileEn
 
 std::list<Tile*> GameMap::path(int x1, int y1, int x2, int y2, const Creature* creature, Seat* seat, bool throughDiggableTiles)
 {
+    static Metrics::Counter& pathCalls = Metrics::getCounter("od_gamemap_path_calls", "Calls to GameMap::path");
+    static Metrics::Histogram& pathTime = Metrics::getTimerHistogram("od_gamemap_path_ms", "Time spent in GameMap::path (ms)");
+    Metrics::ScopedTimer timer(pathTime);
+    pathCalls.increment();
+
     ++mNumCallsTo_path;
     std::list<Tile*> returnList;
 
@@ -1812,6 +1820,7 @@ void GameMap::addRoom(Room *r)
     }
 
     mRooms.push_back(r);
+    notifyGoalEvent(Goal::roomsChanged);
 }
 
 void GameMap::removeRoom(Room *r)
@@ -1827,6 +1836,7 @@ void GameMap::removeRoom(Room *r)
     }
 
     mRooms.erase(it);
+    notifyGoalEvent(Goal::roomsChanged);
 }
 
 std::vector<Room*> GameMap::getRoomsByType(RoomType type) const
@@ -1844,7 +1854,7 @@ std::vector<Room*> GameMap::getRoomsByType(RoomType type) const
 std::vector<Room*> GameMap::getRoomsByTypeAndSeat(RoomType type, const Seat* seat)
 {
     std::vector<Room*> returnList;
-    for (Room* room : mRooms)
+    for (Room* room : getRoomsToCheckForSeat(seat))
     {
         if (room->getType() == type && room->getSeat() == seat && room->getHP(nullptr) > 0.0)
             returnList.push_back(room);
@@ -1856,7 +1866,7 @@ std::vector<Room*> GameMap::getRoomsByTypeAndSeat(RoomType type, const Seat* sea
 std::vector<const Room*> GameMap::getRoomsByTypeAndSeat(RoomType type, const Seat* seat) const
 {
     std::vector<const Room*> returnList;
-    for (const Room* room : mRooms)
+    for (const Room* room : getRoomsToCheckForSeat(seat))
     {
         if (room->getType() == type && room->getSeat() == seat && room->getHP(nullptr) > 0.0)
             returnList.push_back(room);
@@ -1868,7 +1878,7 @@ std::vector<const Room*> GameMap::getRoomsByTypeAndSeat(RoomType type, const Sea
 unsigned int GameMap::numRoomsByTypeAndSeat(RoomType type, const Seat* seat) const
 {
     int cptRooms = 0;
-    for (Room* room : mRooms)
+    for (Room* room : getRoomsToCheckForSeat(seat))
     {
         if (room->getType() == type && room->getSeat() == seat && room->getHP(nullptr) > 0.0)
             ++cptRooms;
@@ -1876,6 +1886,15 @@ unsigned int GameMap::numRoomsByTypeAndSeat(RoomType type, const Seat* seat) con
     return cptRooms;
 }
 
+const std::vector<Room*>& GameMap::getRoomsToCheckForSeat(const Seat* seat) const
+{
+    // The seat aggregates are only maintained on the server
+    if(!isServerGameMap() || (seat == nullptr))
+        return mRooms;
+
+    return seat->getAggregates().getRooms();
+}
+
 std::vector<Room*> GameMap::getReachableRooms(const std::vector<Room*>& vec,
                                               Tile* startTile,
                                               const Creature* creature)
@@ -1995,7 +2014,7 @@ bool GameMap::withdrawFromTreasuries(int gold, Seat* seat)
 
     // Loop over the treasuries withdrawing gold until the full amount has been withdrawn.
     int goldStillNeeded = gold;
-    for (Room* room : getRooms())
+    for (Room* room : getRoomsToCheckForSeat(seat))
     {
         if(room->getSeat() != seat)
             continue;
@@ -2009,6 +2028,62 @@ bool GameMap::withdrawFromTreasuries(int gold, Seat* seat)
     return true;
 }
 
+uint32_t GameMap::checkSeatAggregates()
+{
+    // We recount everything the same way as the aggregates are computed
+    std::map<Seat*, SeatAggregates> recount;
+    for(Seat* seat : mSeats)
+        recount[seat];
+
+    for(int jj = 0; jj < getMapSizeY(); ++jj)
+    {
+        for(int ii = 0; ii < getMapSizeX(); ++ii)
+        {
+            Tile* tile = getTile(ii, jj);
+            if(!tile->isClaimed())
+                continue;
+
+            recount[tile->getSeat()].claimedTileAdded();
+        }
+    }
+
+    for(Creature* creature : mCreatures)
+    {
+        if(!creature->isAlive())
+            continue;
+        if(creature->getSeat() == nullptr)
+            continue;
+        if(creature->getDefinition() == nullptr)
+            continue;
+
+        recount[creature->getSeat()].creatureAdded(*creature->getDefinition());
+    }
+
+    for(Room* room : mRooms)
+    {
+        if(room->getSeat() == nullptr)
+            continue;
+
+        SeatAggregates& aggregates = recount[room->getSeat()];
+        aggregates.roomAdded(*room);
+        aggregates.goldChanged(room->getTotalGoldStored(), room->getTotalGoldStorage());
+    }
+
+    uint32_t nbSeatsWithErrors = 0;
+    for(Seat* seat : mSeats)
+    {
+        std::string errors;
+        if(seat->getAggregates().isSameAs(recount[seat], errors))
+            continue;
+
+        ++nbSeatsWithErrors;
+        OD_LOG_ERR(serverStr() + "Wrong aggregates for seat=" + Helper::toString(seat->getId()) + ":" + errors);
+        seat->getAggregates() = recount[seat];
+    }
+
+    return nbSeatsWithErrors;
+}
+
 void GameMap::clearMapLights()
 {
     // We need to work on a copy of mMapLights because removeFromGameMap will remove them from this vector
@@ -2141,6 +2216,16 @@ void GameMap::addGoalForAllSeats(std::unique_ptr<Goal>&& g)
     mGoalsForAllSeats.emplace_back(std::move(g));
 }
 
+void GameMap::notifyGoalEvent(uint32_t goalEvents)
+{
+    // Goals are only checked on the server
+    if(!isServerGameMap())
+        return;
+
+    for (Seat* seat : mSeats)
+        seat->notifyGoalEvent(goalEvents);
+}
+
 void GameMap::clearGoalsForAllSeats()
 {
     for (Seat* seat : mSeats)
@@ -2818,7 +2903,10 @@ void GameMap::fireRefreshEntities()
 {
     // Notify changes on visible tiles
     for(Seat* seat : mSeats)
+    {
+        seat->getInterest().startTurn(mTurnNumber);
         seat->notifyChangedVisibleTiles();
+    }
 
     for(Creature* creature : mCreatures)
     {
@@ -3058,6 +3146,9 @@ void GameMap::clientUpKeep(int64_t turnNumber)
 
 void GameMap::doorLock(Tile* tileDoor, Seat* seat, bool locked)
 {
+    // Locked doors block vision
+    mTrapTriggerIndex.tileVisionChanged(*tileDoor);
+
     if(!locked)
     {
         // When a door is unlocked, we check all its neighboors to find a floodfill value for each possible
@@ -3252,16 +3343,40 @@ void GameMap::notifySeatsConfigured()
 void GameMap::fireGameSound(Tile& tile, const std::string& soundFamily)
 {
     std::string sound = "Game/" + soundFamily;
-    for(Seat* seat : tile.getSeatsWithVision())
+    fireSpatialSound(tile.getSeatsWithVision(), sound, tile.getX(), tile.getY());
+}
+
+void GameMap::fireSpatialSound(const std::vector<Seat*>& seats, const std::string& sound, int32_t x, int32_t y)
+{
+    for(Seat* seat : seats)
     {
         if(seat->getPlayer() == nullptr)
             continue;
         if(!seat->getPlayer()->getIsHuman())
             continue;
 
+        mSpatialSounds.addSound(seat->getPlayer(), sound, x, y);
+    }
+}
+
+void GameMap::flushSpatialSounds()
+{
+    static Metrics::Counter& firedSounds = Metrics::getCounter("od_server_spatial_sounds_fired",
+        "Spatial sounds fired to human players before merging");
+    static Metrics::Counter& sentSounds = Metrics::getCounter("od_server_spatial_sounds_sent",
+        "Spatial sound notifications sent after merging the identical sounds fired nearby");
+    if(mSpatialSounds.isEmpty())
+        return;
+
+    std::vector<SpatialSoundCoalescer::SoundEvent> events;
+    mSpatialSounds.flush(events);
+    for(const SpatialSoundCoalescer::SoundEvent& event : events)
+    {
+        firedSounds.increment(event.mCount);
+        sentSounds.increment();
         ServerNotification *serverNotification = new ServerNotification(
-            ServerNotificationType::playSpatialSound, seat->getPlayer());
-        serverNotification->mPacket << sound << tile.getX() << tile.getY();
+            ServerNotificationType::playSpatialSound, const_cast<Player*>(event.mPlayer));
+        serverNotification->mPacket << event.mSound << event.mX << event.mY << event.mCount;
         ODServer::getSingleton().queueServerNotification(serverNotification);
     }
 }
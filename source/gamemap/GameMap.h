@@ -21,6 +21,10 @@
 #include "gamemap/TileContainer.h"
 
 #include "ai/AIManager.h"
+#include "gamemap/AnimationScheduler.h"
+#include "gamemap/ResourceTileIndex.h"
+#include "gamemap/TrapTriggerIndex.h"
+#include "sound/SpatialSoundCoalescer.h"
 
 #ifdef __MINGW32__
 #ifndef mode_t
@@ -290,6 +294,9 @@ public:
     void clearFilledSeats();
     void clearAiManager();
 
+    //! \brief Notifies the AIs that the given tile changed (claimed, dug, covered by a building, ...)
+    void tileStateChangedForAI(Tile& tile);
+
     Seat* getSeatById(int id) const;
 
     inline Seat* getSeatRogue() const
@@ -303,8 +310,32 @@ public:
     { return mGoalsForAllSeats; }
     void clearGoalsForAllSeats();
 
+    //! \brief Notifies every seat that something some goals depend on changed (see Goal::GoalEvents)
+    void notifyGoalEvent(uint32_t goalEvents);
+
+    //! \brief When set, the seats check every goal at each turn instead of only the goals depending
+    //! on the notified events. Goals changing without event are logged. Used for debugging only
+    inline void setIsPollingGoals(bool isPolling)
+    { mIsPollingGoals = isPolling; }
+
+    inline bool getIsPollingGoals() const
+    { return mIsPollingGoals; }
+
     bool withdrawFromTreasuries(int gold, Seat* seat);
 
+    //! \brief When set, the seat aggregates are compared with a full recount of the map at each
+    //! upkeep. Used for debugging only
+    inline void setIsCheckingSeatAggregates(bool isChecking)
+    { mIsCheckingSeatAggregates = isChecking; }
+
+    inline bool getIsCheckingSeatAggregates() const
+    { return mIsCheckingSeatAggregates; }
+
+    //! \brief Recounts claimed tiles, creatures, rooms and gold for every seat and compares with
+    //! the seat aggregates. Differences are logged and the aggregates are replaced by the recount.
+    //! Returns the number of seats that had differences
+    uint32_t checkSeatAggregates();
+
     inline const std::string& getLevelFileName() const
     { return mLevelFileName; }
 
@@ -505,6 +536,26 @@ public:
     inline const std::string& getTileSetName() const
     { return mTileSetName; }
 
+    //! \brief Returns the tileset used by the map. Only set once the entities are created
+    inline const TileSet* getTileSet() const
+    { return mTileSet; }
+
+    inline AIManager& getAiManager()
+    { return mAiManager; }
+
+    //! \brief Index of the diggable tiles by type and of the tiles marked for digging. It is
+    //! only built (and thus kept up to date) on the GameMap where it is used
+    inline ResourceTileIndex& getResourceTileIndex()
+    { return mResourceTileIndex; }
+
+    //! \brief Index of the tiles watched by the traps. Only filled on the server GameMap
+    inline TrapTriggerIndex& getTrapTriggerIndex()
+    { return mTrapTriggerIndex; }
+
+    //! \brief Decides how often the animations are advanced. Only used on the client GameMap
+    inline AnimationScheduler& getAnimationScheduler()
+    { return mAnimationScheduler; }
+
     //! \brief getMeshForDefaultTile returns a mesh for some default dirt tile. This
     //! is used as a workaround to avoid lightning issues
     const std::string& getMeshForDefaultTile() const;
@@ -536,6 +587,14 @@ public:
     //! \brief Fires to the human seats in the given tile the game sound corresponding to the family
     void fireGameSound(Tile& tile, const std::string& soundFamily);
 
+    //! \brief Fires the given sound at the given tile position to the human seats in the given list.
+    //! The sound is sent by flushSpatialSounds, merged with the identical ones fired nearby
+    void fireSpatialSound(const std::vector<Seat*>& seats, const std::string& sound, int32_t x, int32_t y);
+
+    //! \brief Sends the spatial sounds fired since the last call. Should be called by the server
+    //! before sending the notifications
+    void flushSpatialSounds();
+
     //! \brief Convenience function to send a relative sound to the human seats in the given list
     void fireRelativeSound(const std::vector<Seat*>& seats, const std::string& soundFamily);
 
@@ -567,6 +626,10 @@ private:
 
     Ogre::Real mTimePayDay;
 
+    bool mIsCheckingSeatAggregates;
+
+    bool mIsPollingGoals;
+
     //! \brief Level related filenames.
     std::string mLevelFileName;
 
@@ -620,6 +683,10 @@ private:
 
     std::vector<RenderedMovableEntity*> mRenderedMovableEntities;
 
+    //! \brief Same entities as mRenderedMovableEntities sorted by name. Missiles and other short-lived entities are
+    //! created often and need a unique name
+    std::map<std::string, RenderedMovableEntity*> mRenderedMovableEntitiesByName;
+
     std::vector<Spell*> mSpells;
 
     std::vector<int> mTeamIds;
@@ -627,6 +694,13 @@ private:
     //! AI Handling manager
     AIManager mAiManager;
 
+    ResourceTileIndex mResourceTileIndex;
+    TrapTriggerIndex mTrapTriggerIndex;
+    AnimationScheduler mAnimationScheduler;
+
+    //! \brief Spatial sounds fired since the last flushSpatialSounds
+    SpatialSoundCoalescer mSpatialSounds;
+
     //! Map tileset
     const TileSet* mTileSet;
     std::string mTileSetName;
@@ -637,6 +711,10 @@ private:
 
     //! \brief Resets the unique numbers
     void resetUniqueNumbers();
+
+    //! \brief Returns the rooms owned by the given seat or all the rooms on the client side (where
+    //! seat aggregates are not computed). The caller still needs to check the seat
+    const std::vector<Room*>& getRoomsToCheckForSeat(const Seat* seat) const;
 };
 
 #endif // GAMEMAP_H
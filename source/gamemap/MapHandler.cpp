@@ -45,6 +45,7 @@
 #include "utils/Helper.h"
 #include "utils/LogManager.h"
 #include "utils/ResourceManager.h"
+#include "utils/TextFileTokenizer.h"
 
 #include "ODApplication.h"
 
@@ -55,24 +56,28 @@ namespace MapHandler {
 
 bool readGameMapFromFile(const std::string& fileName, GameMap& gameMap)
 {
-    std::stringstream levelFile;
-    if(!Helper::readFileWithoutComments(fileName, levelFile))
+    TextFileTokenizer levelFile;
+    if(!levelFile.open(fileName))
         return false;
 
-    std::string nextParam;
+    // Some loaders still work with streams. This stream reads directly from the tokenizer
+    // and shares its read position
+    std::istream levelStream(&levelFile);
+
+    boost::string_ref nextParam;
     // Read in the version number from the level file
-    levelFile >> nextParam;
-    if (nextParam.compare(ODApplication::VERSIONSTRING) != 0)
+    levelFile.nextToken(nextParam);
+    if (nextParam != ODApplication::VERSIONSTRING)
     {
         OD_LOG_WRN("Attempting to load a file produced by a different version of OpenDungeons, filename="
-            + fileName + ", file version=" + nextParam + ", odversion=" + ODApplication::VERSION);
+            + fileName + ", file version=" + nextParam.to_string() + ", odversion=" + ODApplication::VERSION);
         return false;
     }
 
-    levelFile >> nextParam;
+    levelFile.nextToken(nextParam);
     if (nextParam != "[Info]")
     {
-        OD_LOG_WRN("Invalid info start format: " + nextParam);
+        OD_LOG_WRN("Invalid info start format: " + nextParam.to_string());
         return false;
     }
 
@@ -82,83 +87,81 @@ bool readGameMapFromFile(const std::string& fileName, GameMap& gameMap)
     // Read in the seats from the level file
     while (true)
     {
-        if(!levelFile.good())
+        // Information can contain spaces. We need to read the whole line to get content
+        if(!levelFile.nextLine(nextParam))
             return false;
-        // Information can contain spaces. We need to use std::getline to get content
-        std::getline(levelFile, nextParam);
-        std::string param;
+
         if (nextParam == "[/Info]")
         {
             break;
         }
 
-        param = "Name\t";
-        if (nextParam.compare(0, param.size(), param) == 0)
+        boost::string_ref param = "Name\t";
+        if (nextParam.starts_with(param))
         {
-            gameMap.setLevelName(nextParam.substr(param.size()));
+            gameMap.setLevelName(nextParam.substr(param.size()).to_string());
             continue;
         }
 
         param = "Description\t";
-        if (nextParam.compare(0, param.size(), param) == 0)
+        if (nextParam.starts_with(param))
         {
-            gameMap.setLevelDescription(nextParam.substr(param.size()));
+            gameMap.setLevelDescription(nextParam.substr(param.size()).to_string());
             continue;
         }
 
         param = "Music\t";
-        if (nextParam.compare(0, param.size(), param) == 0)
+        if (nextParam.starts_with(param))
         {
-            std::string musicFile = nextParam.substr(param.size());
+            std::string musicFile = nextParam.substr(param.size()).to_string();
             gameMap.setLevelMusicFile(musicFile);
             OD_LOG_INF("Level Music: " + musicFile);
             continue;
         }
 
         param = "FightMusic\t";
-        if (nextParam.compare(0, param.size(), param) == 0)
+        if (nextParam.starts_with(param))
         {
-            std::string musicFile = nextParam.substr(param.size());
-            gameMap.setLevelFightMusicFile(nextParam.substr(param.size()));
+            std::string musicFile = nextParam.substr(param.size()).to_string();
+            gameMap.setLevelFightMusicFile(musicFile);
             OD_LOG_INF("Level Fight Music: " + musicFile);
             continue;
         }
 
         param = "TileSet\t";
-        if (nextParam.compare(0, param.size(), param) == 0)
+        if (nextParam.starts_with(param))
         {
-            std::string tileSet = nextParam.substr(param.size());
+            std::string tileSet = nextParam.substr(param.size()).to_string();
             gameMap.setTileSetName(tileSet);
             OD_LOG_INF("TileSet: " + tileSet);
             continue;
         }
     }
 
-    levelFile >> nextParam;
+    levelFile.nextToken(nextParam);
     if (nextParam != "[Seats]")
     {
-        OD_LOG_WRN("Invalid seats start format=" + nextParam);
+        OD_LOG_WRN("Invalid seats start format=" + nextParam.to_string());
         return false;
     }
 
     // Read in the seats from the level file
     while (true)
     {
-        if(!levelFile.good())
+        if(!levelFile.nextToken(nextParam))
             return false;
 
-        levelFile >> nextParam;
         if (nextParam == "[/Seats]")
             break;
 
         if (nextParam != "[Seat]")
         {
-            OD_LOG_WRN("Expected a Seat tag but got " + nextParam);
+            OD_LOG_WRN("Expected a Seat tag but got " + nextParam.to_string());
             return false;
         }
 
         Seat* tempSeat = new Seat(&gameMap);
-        if(!tempSeat->importSeatFromStream(levelFile))
+        if(!tempSeat->importSeatFromStream(levelStream))
         {
             delete tempSeat;
             return false;
@@ -173,40 +176,42 @@ bool readGameMapFromFile(const std::string& fileName, GameMap& gameMap)
     }
 
     // Read in the goals that are shared by all players, the first player to complete all these goals is the winner.
-    levelFile >> nextParam;
+    levelFile.nextToken(nextParam);
     if (nextParam != "[Goals]")
     {
-        OD_LOG_WRN("Invalid Goals start format=" + nextParam);
+        OD_LOG_WRN("Invalid Goals start format=" + nextParam.to_string());
         return false;
     }
 
     while(true)
     {
-        if(!levelFile.good())
+        if(!levelFile.nextToken(nextParam))
             return false;
 
-        levelFile >> nextParam;
         if (nextParam == "[/Goals]")
             break;
 
-        std::unique_ptr<Goal> tempGoal = Goals::loadGoalFromStream(nextParam, levelFile);
+        std::unique_ptr<Goal> tempGoal = Goals::loadGoalFromStream(nextParam.to_string(), levelStream);
 
         if (tempGoal.get() != nullptr)
             gameMap.addGoalForAllSeats(std::move(tempGoal));
     }
 
-    levelFile >> nextParam;
+    levelFile.nextToken(nextParam);
     if (nextParam != "[Tiles]")
     {
-        OD_LOG_WRN("Invalid tile start format:" + nextParam);
+        OD_LOG_WRN("Invalid tile start format:" + nextParam.to_string());
         return false;
     }
 
     // Load the map size on next two lines
-    int mapSizeX;
-    int mapSizeY;
-    levelFile >> mapSizeX;
-    levelFile >> mapSizeY;
+    int32_t mapSizeX;
+    int32_t mapSizeY;
+    if(!levelFile.nextInt32(mapSizeX) || !levelFile.nextInt32(mapSizeY))
+    {
+        OD_LOG_WRN("Invalid map size");
+        return false;
+    }
 
     if (!gameMap.createNewMap(mapSizeX, mapSizeY))
         return false;
@@ -216,61 +221,60 @@ bool readGameMapFromFile(const std::string& fileName, GameMap& gameMap)
 
     while (true)
     {
-        if(!levelFile.good())
+        if(!levelFile.peekToken(nextParam))
         {
             OD_LOG_WRN("unexpected EOF reached");
             return false;
         }
 
-        levelFile >> nextParam;
         if (nextParam == "[/Tiles]")
+        {
+            levelFile.nextToken(nextParam);
             break;
+        }
 
-        // Get all the params together in order to prepare for the new parsing function
-        std::string entire_line = nextParam;
-        std::getline(levelFile, nextParam);
-        entire_line += nextParam;
+        levelFile.nextLine(nextParam);
 
         Tile* tile = new Tile(&gameMap, true);
 
-        Tile::loadFromLine(entire_line, tile);
+        Tile::loadFromLine(nextParam, tile);
         tile->computeTileVisual();
 
         gameMap.addTile(tile);
+        tile->refreshSeatAggregates();
     }
 
     gameMap.setAllFullnessAndNeighbors();
 
     // Read in the rooms
-    levelFile >> nextParam;
+    levelFile.nextToken(nextParam);
     if (nextParam != "[Rooms]")
     {
-        OD_LOG_WRN("Invalid Rooms start format:" + nextParam);
+        OD_LOG_WRN("Invalid Rooms start format:" + nextParam.to_string());
         return false;
     }
 
     while(true)
     {
-        if(!levelFile.good())
+        if(!levelFile.nextToken(nextParam))
         {
             OD_LOG_WRN("unexpected EOF reached");
             return false;
         }
 
-        levelFile >> nextParam;
         if (nextParam == "[/Rooms]")
             break;
 
         if (gameMap.isServerGameMap() && (nextParam != "[Room]"))
         {
-            OD_LOG_WRN("Expected [Room] but got:" + nextParam);
+            OD_LOG_WRN("Expected [Room] but got:" + nextParam.to_string());
             return false;
         }
 
         if(!gameMap.isServerGameMap())
             continue;
 
-        Room* tempRoom = RoomManager::getRoomFromStream(&gameMap, levelFile);
+        Room* tempRoom = RoomManager::getRoomFromStream(&gameMap, levelStream);
         if(tempRoom == nullptr)
         {
             OD_LOG_ERR("unexpected null room");
@@ -279,41 +283,40 @@ bool readGameMapFromFile(const std::string& fileName, GameMap& gameMap)
 
         tempRoom->addToGameMap();
 
-        levelFile >> nextParam;
+        levelFile.nextToken(nextParam);
         if (nextParam != "[/Room]")
         {
-            OD_LOG_WRN("Expected [/Room] but got:" + nextParam);
+            OD_LOG_WRN("Expected [/Room] but got:" + nextParam.to_string());
             return false;
         }
     }
 
     // Read in the traps
-    levelFile >> nextParam;
+    levelFile.nextToken(nextParam);
     if (nextParam != "[Traps]")
     {
-        OD_LOG_WRN("Invalid Traps start format:" + nextParam);
+        OD_LOG_WRN("Invalid Traps start format:" + nextParam.to_string());
         return false;
     }
 
     while(true)
     {
-        if(!levelFile.good())
+        if(!levelFile.nextToken(nextParam))
         {
             OD_LOG_WRN("unexpected EOF reached");
             return false;
         }
 
-        levelFile >> nextParam;
         if (nextParam == "[/Traps]")
             break;
 
         if (nextParam != "[Trap]")
         {
-            OD_LOG_WRN("Expected [Trap] but got:" + nextParam);
+            OD_LOG_WRN("Expected [Trap] but got:" + nextParam.to_string());
             return false;
         }
 
-        Trap* tempTrap = TrapManager::getTrapFromStream(&gameMap, levelFile);
+        Trap* tempTrap = TrapManager::getTrapFromStream(&gameMap, levelStream);
         if(tempTrap == nullptr)
         {
             OD_LOG_ERR("unexpected null trap");
@@ -322,36 +325,36 @@ bool readGameMapFromFile(const std::string& fileName, GameMap& gameMap)
 
         tempTrap->addToGameMap();
 
-        levelFile >> nextParam;
+        levelFile.nextToken(nextParam);
         if (nextParam != "[/Trap]")
         {
-            OD_LOG_WRN("Expected [/Trap] but got:" + nextParam);
+            OD_LOG_WRN("Expected [/Trap] but got:" + nextParam.to_string());
             return false;
         }
     }
 
     // Read in the lights
-    levelFile >> nextParam;
+    levelFile.nextToken(nextParam);
     if (nextParam != "[Lights]")
     {
-        OD_LOG_WRN("Invalid Lights start format:" + nextParam);
+        OD_LOG_WRN("Invalid Lights start format:" + nextParam.to_string());
         return false;
     }
 
     while(true)
     {
-        if(!levelFile.good())
+        if(!levelFile.peekToken(nextParam))
             return false;
 
-        levelFile >> nextParam;
         if (nextParam == "[/Lights]")
+        {
+            levelFile.nextToken(nextParam);
             break;
+        }
 
-        std::string entire_line = nextParam;
-        std::getline(levelFile, nextParam);
-        entire_line += nextParam;
-
-        std::stringstream ss(entire_line);
+        levelFile.nextLine(nextParam);
+        TextFileTokenizer lineTokenizer(nextParam);
+        std::istream ss(&lineTokenizer);
         MapLight* tempLight = MapLight::getMapLightFromStream(&gameMap, ss);
         if(tempLight == nullptr)
         {
@@ -362,12 +365,11 @@ bool readGameMapFromFile(const std::string& fileName, GameMap& gameMap)
         tempLight->addToGameMap();
     }
 
-    levelFile >> nextParam;
+    levelFile.nextToken(nextParam);
     if (nextParam == "[CreatureDefinitions]")
     {
-        while(levelFile.good())
+        while(levelFile.nextToken(nextParam))
         {
-            levelFile >> nextParam;
             if (nextParam == "[/CreatureDefinitions]")
                 break;
 
@@ -377,33 +379,32 @@ bool readGameMapFromFile(const std::string& fileName, GameMap& gameMap)
             // Seek the [Creature] tag
             if (nextParam != "[Creature]")
             {
-                OD_LOG_WRN("Invalid Creature start format:" + nextParam);
+                OD_LOG_WRN("Invalid Creature start format:" + nextParam.to_string());
                 return false;
             }
 
-            levelFile >> nextParam;
+            levelFile.nextToken(nextParam);
             if (nextParam == "Name")
             {
-                levelFile >> nextParam;
-                CreatureDefinition* def = gameMap.getClassDescriptionForTuning(nextParam);
+                levelFile.nextToken(nextParam);
+                CreatureDefinition* def = gameMap.getClassDescriptionForTuning(nextParam.to_string());
                 if (def == nullptr)
                 {
-                    OD_LOG_WRN("Invalid Creature definition format for " + nextParam);
+                    OD_LOG_WRN("Invalid Creature definition format for " + nextParam.to_string());
                     return false;
                 }
-                if(!CreatureDefinition::update(def, levelFile, ConfigManager::getSingleton().getCreatureDefinitions()))
+                if(!CreatureDefinition::update(def, levelStream, ConfigManager::getSingleton().getCreatureDefinitions()))
                     return false;
             }
         }
 
-        levelFile >> nextParam;
+        levelFile.nextToken(nextParam);
     }
 
     if (nextParam == "[EquipmentDefinitions]")
     {
-        while(levelFile.good())
+        while(levelFile.nextToken(nextParam))
         {
-            levelFile >> nextParam;
             if (nextParam == "[/EquipmentDefinitions]")
                 break;
 
@@ -412,50 +413,50 @@ bool readGameMapFromFile(const std::string& fileName, GameMap& gameMap)
 
             if (nextParam != "[Equipment]")
             {
-                OD_LOG_WRN("Invalid Weapon start format:" + nextParam);
+                OD_LOG_WRN("Invalid Weapon start format:" + nextParam.to_string());
                 return false;
             }
 
-            levelFile >> nextParam;
+            levelFile.nextToken(nextParam);
             if (nextParam == "Name")
             {
-                levelFile >> nextParam;
-                Weapon* def = gameMap.getWeaponForTuning(nextParam);
+                levelFile.nextToken(nextParam);
+                Weapon* def = gameMap.getWeaponForTuning(nextParam.to_string());
                 if (def == nullptr)
                 {
-                    OD_LOG_WRN("Invalid Weapon definition format for " + nextParam);
+                    OD_LOG_WRN("Invalid Weapon definition format for " + nextParam.to_string());
                     return false;
                 }
-                if(!Weapon::update(def, levelFile))
+                if(!Weapon::update(def, levelStream))
                     return false;
             }
         }
 
-        levelFile >> nextParam;
+        levelFile.nextToken(nextParam);
     }
 
     // Read in the actual creatures themselves
     if (nextParam != "[Creatures]")
     {
-        OD_LOG_WRN("Invalid Creatures start format:" + nextParam);
+        OD_LOG_WRN("Invalid Creatures start format:" + nextParam.to_string());
         return false;
     }
 
     uint32_t nbCreatures = 0;
     while(true)
     {
-        if(!levelFile.good())
+        if(!levelFile.peekToken(nextParam))
             return false;
 
-        levelFile >> nextParam;
         if (nextParam == "[/Creatures]")
+        {
+            levelFile.nextToken(nextParam);
             break;
+        }
 
-        std::string entire_line = nextParam;
-        std::getline(levelFile, nextParam);
-        entire_line += nextParam;
-
-        std::stringstream ss(entire_line);
+        levelFile.nextLine(nextParam);
+        TextFileTokenizer lineTokenizer(nextParam);
+        std::istream ss(&lineTokenizer);
         Creature* tempCreature = Creature::getCreatureFromStream(&gameMap, ss);
         if(tempCreature == nullptr)
         {
@@ -513,28 +514,30 @@ bool readGameMapFromFile(const std::string& fileName, GameMap& gameMap)
     return true;
 }
 
-bool readGameEntity(GameMap& gameMap, const std::string& item, GameEntityType type, std::stringstream& levelFile)
+bool readGameEntity(GameMap& gameMap, const std::string& item, GameEntityType type, TextFileTokenizer& levelFile)
 {
-    std::string nextParam;
-    levelFile >> nextParam;
-    if (nextParam != "[" + item + "]")
+    const std::string beginTag = "[" + item + "]";
+    const std::string endTag = "[/" + item + "]";
+    boost::string_ref nextParam;
+    levelFile.nextToken(nextParam);
+    if (nextParam != beginTag)
         return false;
 
     uint32_t nbEntity = 0;
     while(true)
     {
-        if(!levelFile.good())
+        if(!levelFile.peekToken(nextParam))
             return false;
 
-        levelFile >> nextParam;
-        if (nextParam == "[/" + item + "]")
+        if (nextParam == endTag)
+        {
+            levelFile.nextToken(nextParam);
             break;
+        }
 
-        std::string entire_line = nextParam;
-        std::getline(levelFile, nextParam);
-        entire_line += nextParam;
-
-        std::stringstream ss(entire_line);
+        levelFile.nextLine(nextParam);
+        TextFileTokenizer lineTokenizer(nextParam);
+        std::istream ss(&lineTokenizer);
         GameEntity* entity = Entities::getGameEntityFromStream(&gameMap, type, ss);
         if(entity == nullptr)
         {
@@ -791,17 +794,17 @@ bool writeGameMapToFile(const std::string& fileName, GameMap& gameMap)
 bool getMapInfo(const std::string& fileName, LevelInfo& levelInfo)
 {
     // Prepare an invalid level reference
-    std::stringstream levelFile;
-    if(!Helper::readFileWithoutComments(fileName, levelFile))
+    TextFileTokenizer levelFile;
+    if(!levelFile.open(fileName))
         return false;
 
-    std::string nextParam;
+    boost::string_ref nextParam;
     // Read in the version number from the level file
-    levelFile >> nextParam;
-    if (nextParam.compare(ODApplication::VERSIONSTRING) != 0)
+    levelFile.nextToken(nextParam);
+    if (nextParam != ODApplication::VERSIONSTRING)
         return false;
 
-    levelFile >> nextParam;
+    levelFile.nextToken(nextParam);
     if (nextParam != "[Info]")
         return false;
 
@@ -810,26 +813,25 @@ bool getMapInfo(const std::string& fileName, LevelInfo& levelInfo)
     // Read in the seats from the level file
     while (true)
     {
-        if(!levelFile.good())
+        // Information can contain spaces. We need to read the whole line to get content
+        if(!levelFile.nextLine(nextParam))
             return false;
-        // Information can contain spaces. We need to use std::getline to get content
-        std::getline(levelFile, nextParam);
-        std::string param;
+
         if (nextParam == "[/Info]")
         {
             break;
         }
 
-        param = "Name\t";
-        if (nextParam.compare(0, param.size(), param) == 0)
+        boost::string_ref param = "Name\t";
+        if (nextParam.starts_with(param))
         {
-            levelInfo.mLevelName = nextParam.substr(param.size());
+            levelInfo.mLevelName = nextParam.substr(param.size()).to_string();
             mapInfo << levelInfo.mLevelName << std::endl << std::endl;
             continue;
         }
 
         param = "Description\t";
-        if (nextParam.compare(0, param.size(), param) == 0)
+        if (nextParam.starts_with(param))
         {
             mapInfo << nextParam.substr(param.size()) << std::endl << std::endl;
             continue;
@@ -837,7 +839,7 @@ bool getMapInfo(const std::string& fileName, LevelInfo& levelInfo)
 
     }
 
-    levelFile >> nextParam;
+    levelFile.nextToken(nextParam);
     if (nextParam != "[Seats]")
     {
         levelInfo.mLevelDescription = mapInfo.str();
@@ -850,10 +852,9 @@ bool getMapInfo(const std::string& fileName, LevelInfo& levelInfo)
     int seatConfigurable = 0;
     while (true)
     {
-        if(!levelFile.good())
+        if(!levelFile.nextToken(nextParam))
             return false;
 
-        levelFile >> nextParam;
         if (nextParam == "[/Seats]")
             break;
 
@@ -862,10 +863,14 @@ bool getMapInfo(const std::string& fileName, LevelInfo& levelInfo)
 
         while(true)
         {
-            std::string line;
-            std::getline(levelFile, line);
-            std::stringstream ss(line);
-            ss >> nextParam;
+            boost::string_ref line;
+            if(!levelFile.nextLine(line))
+                return false;
+
+            TextFileTokenizer lineTokenizer(line);
+            if(!lineTokenizer.nextToken(nextParam))
+                continue;
+
             if(nextParam == "[/Seat]")
                 break;
 
@@ -873,7 +878,7 @@ bool getMapInfo(const std::string& fileName, LevelInfo& levelInfo)
                 continue;
 
             // We get the player type
-            ss >> nextParam;
+            lineTokenizer.nextToken(nextParam);
             if (nextParam == Seat::PLAYER_TYPE_HUMAN)
                 ++playerSeatNumber;
             else if (nextParam == Seat::PLAYER_TYPE_CHOICE)
@@ -908,7 +913,7 @@ bool getMapInfo(const std::string& fileName, LevelInfo& levelInfo)
     }
 
     // Read in the goals that are shared by all players, the first player to complete all these goals is the winner.
-    levelFile >> nextParam;
+    levelFile.nextToken(nextParam);
     if (nextParam != "[Goals]")
     {
         levelInfo.mLevelDescription = mapInfo.str();
@@ -917,15 +922,14 @@ bool getMapInfo(const std::string& fileName, LevelInfo& levelInfo)
 
     while(true)
     {
-        if(!levelFile.good())
+        if(!levelFile.nextToken(nextParam))
             return false;
 
-        levelFile >> nextParam;
         if (nextParam == "[/Goals]")
             break;
     }
 
-    levelFile >> nextParam;
+    levelFile.nextToken(nextParam);
     if (nextParam != "[Tiles]")
     {
         levelInfo.mLevelDescription = mapInfo.str();
@@ -933,10 +937,10 @@ bool getMapInfo(const std::string& fileName, LevelInfo& levelInfo)
     }
 
     // Load the map size on next two lines
-    int mapSizeX;
-    int mapSizeY;
-    levelFile >> mapSizeX;
-    levelFile >> mapSizeY;
+    int32_t mapSizeX = 0;
+    int32_t mapSizeY = 0;
+    levelFile.nextInt32(mapSizeX);
+    levelFile.nextInt32(mapSizeY);
 
     mapInfo << "Size: " << mapSizeX << "x" << mapSizeY << std::endl << std::endl;
 
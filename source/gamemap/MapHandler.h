@@ -22,6 +22,7 @@
 #include <string>
 
 class GameMap;
+class TextFileTokenizer;
 
 enum class GameEntityType;
 
@@ -44,7 +45,7 @@ namespace MapHandler
 
     bool writeGameMapToFile(const std::string& fileName, GameMap& gameMap);
 
-    bool readGameEntity(GameMap& gameMap, const std::string& item, GameEntityType type, std::stringstream& levelFile);
+    bool readGameEntity(GameMap& gameMap, const std::string& item, GameEntityType type, TextFileTokenizer& levelFile);
 
     bool loadEquipments(const std::string& fileName, GameMap& gameMap);
 
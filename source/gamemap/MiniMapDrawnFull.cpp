@@ -39,6 +39,8 @@
 #include <CEGUI/Window.h>
 #include <CEGUI/WindowManager.h>
 
+#include <algorithm>
+
 class MiniMapDrawnFullTileStateListener : public TileStateListener
 {
 public:
@@ -54,6 +56,7 @@ public:
         mTileXMax(tileXMax),
         mTileYMin(tileYMin),
         mTileYMax(tileYMax),
+        mIsDirty(false),
         mMinimap(minimap)
     {}
 
@@ -62,13 +65,7 @@ public:
 
     void tileStateChanged(Tile& tile) override
     {
-        fireTileStateChanged();
-    }
-
-    void fireTileStateChanged()
-    {
-        mMinimap.updateTileState(mMinimapXMin, mMinimapXMax, mMinimapYMin,
-            mMinimapYMax, mTileXMin, mTileXMax, mTileYMin, mTileYMax);
+        mMinimap.tileRangeChanged(*this);
     }
 
     const uint32_t mMinimapXMin;
@@ -80,6 +77,9 @@ public:
     const uint32_t mTileYMin;
     const uint32_t mTileYMax;
 
+    //! \brief true if the listener is waiting in the minimap dirty listeners
+    bool mIsDirty;
+
 private:
     MiniMapDrawnFull& mMinimap;
 };
@@ -184,10 +184,7 @@ MiniMapDrawnFullPixel getPixelValueFromTile(Seat& playerSeat, Tile& tile)
     return value;
 }
 
-void colourFromPixelValue(MiniMapDrawnFullPixel pixelValue, Seat* seatIfClaimed,
-        Ogre::HardwarePixelBufferSharedPtr& pixelBuffer, Ogre::PixelBox pixelBox,
-        uint32_t minimapWidth, uint32_t minimapHeight, uint32_t minimapXMin,
-        uint32_t minimapXMax, uint32_t minimapYMin, uint32_t minimapYMax)
+MiniMapRaster::Colour colourFromPixelValue(MiniMapDrawnFullPixel pixelValue, Seat* seatIfClaimed)
 {
     Ogre::uint8 RR = 0x00;
     Ogre::uint8 GG = 0x00;
@@ -307,22 +304,7 @@ void colourFromPixelValue(MiniMapDrawnFullPixel pixelValue, Seat* seatIfClaimed,
         }
     }
 
-    auto output = pixelBuffer->lock(pixelBox, Ogre::HardwareBuffer::HBL_NORMAL);
-
-    assert(minimapXMax <= output.getWidth());
-    assert(minimapYMax <= output.getHeight());
-
-    for(size_t xx = minimapXMin; xx < minimapXMax; ++xx)
-    {
-        for(size_t yy = minimapYMin; yy < minimapYMax; ++yy)
-        {
-            // TODO: This is probably a bit inefficient at the moment.
-            output.setColourAt(Ogre::ColourValue(RR/255.0, GG/255.0, BB/255.0), xx, output.getHeight() - yy, 0);
-
-        }
-    }
-
-    pixelBuffer->unlock();
+    return MiniMapRaster::Colour(RR, GG, BB);
 }
 }
 
@@ -334,12 +316,12 @@ MiniMapDrawnFull::MiniMapDrawnFull(CEGUI::Window* miniMapWindow) :
     mTopLeftCornerY(0),
     mWidth(static_cast<unsigned int>(mMiniMapWindow->getPixelSize().d_width)),
     mHeight(static_cast<unsigned int>(mMiniMapWindow->getPixelSize().d_height)),
-    mPixelBox(mWidth, mHeight, 1, Ogre::PF_R8G8B8),
+    mRaster(mWidth, mHeight),
     mMiniMapOgreTexture(Ogre::TextureManager::getSingletonPtr()->createManual(
             "miniMapOgreTexture",
             Ogre::ResourceGroupManager::DEFAULT_RESOURCE_GROUP_NAME,
             Ogre::TEX_TYPE_2D,
-            mWidth, mHeight, 0, Ogre::PF_R8G8B8,
+            mWidth, mHeight, 0, Ogre::PF_BYTE_RGBA,
             Ogre::TU_DYNAMIC_WRITE_ONLY)),
     mPixelBuffer(mMiniMapOgreTexture->getBuffer())
 {
@@ -401,7 +383,7 @@ MiniMapDrawnFull::MiniMapDrawnFull(CEGUI::Window* miniMapWindow) :
             }
         }
 
-        listener->fireTileStateChanged();
+        updateTileState(*listener);
     }
 
     CEGUI::Texture& miniMapTextureGui = static_cast<CEGUI::OgreRenderer*>(CEGUI::System::getSingletonPtr()
@@ -419,6 +401,7 @@ MiniMapDrawnFull::MiniMapDrawnFull(CEGUI::Window* miniMapWindow) :
     mMiniMapWindow->setProperty("Image", CEGUI::PropertyHelper<CEGUI::Image*>::toString(&imageset));
 
     mMiniMapOgreTexture->load();
+    uploadDirtyRects();
 
     mTopLeftCornerX = mMiniMapWindow->getUnclippedOuterRect().get().getPosition().d_x;
     mTopLeftCornerY = mMiniMapWindow->getUnclippedOuterRect().get().getPosition().d_y;
@@ -463,17 +446,25 @@ Ogre::Vector2 MiniMapDrawnFull::camera_2dPositionFromClick(int xx, int yy)
     return v;
 }
 
-void MiniMapDrawnFull::updateTileState(uint32_t minimapXMin, uint32_t minimapXMax,
-        uint32_t minimapYMin, uint32_t minimapYMax, uint32_t tileXMin,
-        uint32_t tileXMax, uint32_t tileYMin, uint32_t tileYMax)
+void MiniMapDrawnFull::tileRangeChanged(MiniMapDrawnFullTileStateListener& listener)
+{
+    // Many tiles can change during a frame. We only compute the pixels once per update
+    if(listener.mIsDirty)
+        return;
+
+    listener.mIsDirty = true;
+    mDirtyListeners.push_back(&listener);
+}
+
+void MiniMapDrawnFull::updateTileState(const MiniMapDrawnFullTileStateListener& listener)
 {
     Seat& localPlayerSeat = *(mGameMap.getLocalPlayer()->getSeat());
     // We compute the tile representation
     MiniMapDrawnFullPixel curValue = MiniMapDrawnFullPixel::dirtFull;
     Seat* seatIfClaimed = nullptr;
-    for(uint32_t xxx = tileXMin; xxx < tileXMax; ++xxx)
+    for(uint32_t xxx = listener.mTileXMin; xxx < listener.mTileXMax; ++xxx)
     {
-        for(uint32_t yyy = tileYMin; yyy < tileYMax; ++yyy)
+        for(uint32_t yyy = listener.mTileYMin; yyy < listener.mTileYMax; ++yyy)
         {
             Tile* tile = mGameMap.getTile(xxx, yyy);
             if(tile == nullptr)
@@ -497,68 +488,36 @@ void MiniMapDrawnFull::updateTileState(uint32_t minimapXMin, uint32_t minimapXMa
         }
     }
 
-    // We paint corresponding pixels
-    colourFromPixelValue(curValue, seatIfClaimed, mPixelBuffer, mPixelBox,
-        mWidth, mHeight, minimapXMin, minimapXMax, minimapYMin, minimapYMax);
+    // We paint corresponding pixels. The tile y axis goes up while the texture rows go down
+    MiniMapRaster::Rect rect(listener.mMinimapXMin, listener.mMinimapXMax,
+        mHeight - std::min(listener.mMinimapYMax, mHeight), mHeight - std::min(listener.mMinimapYMin, mHeight));
+    mRaster.fillRect(rect, colourFromPixelValue(curValue, seatIfClaimed));
 }
 
-bool MiniMapDrawnFull::crossSegment(const Ogre::Vector3& p1, const Ogre::Vector3& p2,
-        uint32_t xMin, uint32_t xMax, uint32_t yMin, uint32_t yMax)
+void MiniMapDrawnFull::uploadDirtyRects()
 {
-    if((p1.x < static_cast<Ogre::Real>(xMin)) &&
-       (p2.x < static_cast<Ogre::Real>(xMin)))
-    {
-        return false;
-    }
-    if((p1.x > static_cast<Ogre::Real>(xMax)) &&
-       (p2.x > static_cast<Ogre::Real>(xMax)))
-    {
-        return false;
-    }
-
-    if((p1.y < static_cast<Ogre::Real>(yMin)) &&
-       (p2.y < static_cast<Ogre::Real>(yMin)))
-    {
-        return false;
-    }
-    if((p1.y > static_cast<Ogre::Real>(yMax)) &&
-       (p2.y > static_cast<Ogre::Real>(yMax)))
-    {
-        return false;
-    }
+    const std::vector<MiniMapRaster::Rect>& dirtyRects = mRaster.getDirtyRects();
+    if(dirtyRects.empty())
+        return;
 
-    Ogre::Real diffYPoints = p2.y - p1.y;
-    Ogre::Real diffXPoints = p2.x - p1.x;
-    Ogre::Real diffYMin = p2.y - static_cast<Ogre::Real>(yMin);
-    Ogre::Real diffXMin = p2.x - static_cast<Ogre::Real>(xMin);
-    Ogre::Real diffYMax = p2.y - static_cast<Ogre::Real>(yMax);
-    Ogre::Real diffXMax = p2.x - static_cast<Ogre::Real>(xMax);
-
-    // Magic number to change the size of the line
-    static const Ogre::Real DIFF_MIN = 5;
-    if(
-       (
-        (diffYMin * diffXPoints - diffYPoints * diffXMin - DIFF_MIN< 0) &&
-        (diffYMax * diffXPoints - diffYPoints * diffXMax + DIFF_MIN >= 0)
-       ) ||
-       (
-        (diffYMax * diffXPoints - diffYPoints * diffXMax - DIFF_MIN< 0) &&
-        (diffYMin * diffXPoints - diffYPoints * diffXMin + DIFF_MIN >= 0)
-       )
-      )
+    Ogre::PixelBox pixels(mWidth, mHeight, 1, Ogre::PF_BYTE_RGBA,
+        const_cast<uint8_t*>(mRaster.getPixels()));
+    for(const MiniMapRaster::Rect& rect : dirtyRects)
     {
-        return true;
+        Ogre::Box box(rect.mXMin, rect.mYMin, rect.mXMax, rect.mYMax);
+        mPixelBuffer->blitFromMemory(pixels.getSubVolume(box), box);
     }
-
-    return false;
+    mRaster.clearDirtyRects();
 }
 
 void MiniMapDrawnFull::update(Ogre::Real timeSinceLastFrame, const std::vector<Ogre::Vector3>& cornerTiles)
 {
-    const Ogre::Vector3& topRight = cornerTiles[0];
-    const Ogre::Vector3& topLeft = cornerTiles[1];
-    const Ogre::Vector3& bottomLeft = cornerTiles[2];
-    const Ogre::Vector3& bottomRight = cornerTiles[3];
+    for(MiniMapDrawnFullTileStateListener* listener : mDirtyListeners)
+    {
+        listener->mIsDirty = false;
+        updateTileState(*listener);
+    }
+    mDirtyListeners.clear();
 
     bool isSame = (mLastCornerTiles.size() == cornerTiles.size());
     static const Ogre::Real squareDiffMin = 0.5;
@@ -568,68 +527,24 @@ void MiniMapDrawnFull::update(Ogre::Real timeSinceLastFrame, const std::vector<O
         isSame &= (val <= squareDiffMin);
     }
 
-    if(isSame)
-        return;
-
-    // We save corner tiles
-    mLastCornerTiles = cornerTiles;
-
-    // We refresh the old rectangle
-    for(MiniMapDrawnFullTileStateListener* listener : mVisibleRectangle)
-    {
-        listener->fireTileStateChanged();
-    }
-    mVisibleRectangle.clear();
-
-    // And we paint the new visible rectangle
-    auto output = mPixelBuffer->lock(mPixelBox, Ogre::HardwareBuffer::HBL_NORMAL);
-
-    // we look for the tiles at the border of vision to paint them black
-    for(MiniMapDrawnFullTileStateListener* listener : mTileStateListeners)
+    if(!isSame)
     {
-        bool isInBorder = false;
-
-        // We check if the listener tiles are on the top line
-        if(!isInBorder &&
-            crossSegment(topRight, topLeft, listener->mTileXMin, listener->mTileXMax,
-                listener->mTileYMin, listener->mTileYMax))
-        {
-            isInBorder = true;
-        }
-
-        if(!isInBorder &&
-            crossSegment(topLeft, bottomLeft, listener->mTileXMin, listener->mTileXMax,
-                listener->mTileYMin, listener->mTileYMax))
-        {
-            isInBorder = true;
-        }
-
-        if(!isInBorder &&
-            crossSegment(bottomLeft, bottomRight, listener->mTileXMin, listener->mTileXMax,
-                listener->mTileYMin, listener->mTileYMax))
-        {
-            isInBorder = true;
-        }
-
-        if(!isInBorder &&
-            crossSegment(bottomRight, topRight, listener->mTileXMin, listener->mTileXMax,
-                listener->mTileYMin, listener->mTileYMax))
+        // We save corner tiles
+        mLastCornerTiles = cornerTiles;
+
+        // The visible area is drawn over the tiles. Corners are top right, top left, bottom left
+        // and bottom right so going through them draws the outline
+        Ogre::Real gainX = static_cast<Ogre::Real>(mWidth) / static_cast<Ogre::Real>(mGameMap.getMapSizeX());
+        Ogre::Real gainY = static_cast<Ogre::Real>(mHeight) / static_cast<Ogre::Real>(mGameMap.getMapSizeY());
+        std::vector<std::pair<int32_t, int32_t>> outline;
+        for(const Ogre::Vector3& corner : cornerTiles)
         {
-            isInBorder = true;
-        }
-
-        if(!isInBorder)
-            continue;
-
-        mVisibleRectangle.push_back(listener);
-        for(uint32_t xxx = listener->mMinimapXMin; xxx < listener->mMinimapXMax; ++xxx)
-        {
-            for(uint32_t yyy = listener->mMinimapYMin; yyy < listener->mMinimapYMax; ++yyy)
-            {
-                output.setColourAt(Ogre::ColourValue(0.0f, 0.0f, 0.0f), xxx,
-                                   output.getHeight() - yyy, 0);
-            }
+            int32_t xx = static_cast<int32_t>(round(corner.x * gainX));
+            int32_t yy = static_cast<int32_t>(mHeight) - 1 - static_cast<int32_t>(round(corner.y * gainY));
+            outline.push_back(std::make_pair(xx, yy));
         }
+        mRaster.setOverlayOutline(outline, MiniMapRaster::Colour(0x00, 0x00, 0x00));
     }
-    mPixelBuffer->unlock();
+
+    uploadDirtyRects();
 }
@@ -19,6 +19,7 @@
 #define MINIMAPDRAWNFULL_H_
 
 #include "gamemap/MiniMap.h"
+#include "gamemap/MiniMapRaster.h"
 
 #include <OgreHardwarePixelBuffer.h>
 #include <OgrePixelFormat.h>
@@ -53,17 +54,18 @@ public:
 
     void update(Ogre::Real timeSinceLastFrame, const std::vector<Ogre::Vector3>& cornerTiles) override;
 
-    void updateTileState(uint32_t minimapXMin, uint32_t xMinimapMax,
-        uint32_t minimapYMin, uint32_t minimapYMax, uint32_t tileXMin,
-        uint32_t tileXMax, uint32_t tileYMin, uint32_t tileYMax);
+    //! \brief Called when a tile of the given listener changed. The pixels will be
+    //! computed during the next update
+    void tileRangeChanged(MiniMapDrawnFullTileStateListener& listener);
 
     Ogre::Vector2 camera_2dPositionFromClick(int xx, int yy) override;
 
 private:
-    //! \brief Returns true is the segment between p1 and p2 (using x and y only)
-    //! crosses the values within xMin, xMax, yMin and yMax
-    bool crossSegment(const Ogre::Vector3& p1, const Ogre::Vector3& p2,
-        uint32_t xMin, uint32_t xMax, uint32_t yMin, uint32_t yMax);
+    //! \brief Computes the colour of the pixels of the given listener from its tiles
+    void updateTileState(const MiniMapDrawnFullTileStateListener& listener);
+
+    //! \brief Copies the pixels that changed to the texture
+    void uploadDirtyRects();
 
     CEGUI::Window* mMiniMapWindow;
 
@@ -72,7 +74,8 @@ private:
 
     std::vector<MiniMapDrawnFullTileStateListener*> mTileStateListeners;
 
-    std::vector<MiniMapDrawnFullTileStateListener*> mVisibleRectangle;
+    //! \brief Listeners with tiles that changed since the last update
+    std::vector<MiniMapDrawnFullTileStateListener*> mDirtyListeners;
 
     std::vector<Ogre::Vector3> mLastCornerTiles;
 
@@ -83,7 +86,8 @@ private:
 
     Ogre::Vector2 mCamera_2dPosition;
 
-    Ogre::PixelBox mPixelBox;
+    //! \brief Pixels of the minimap (the first row is the top of the texture)
+    MiniMapRaster mRaster;
     Ogre::TexturePtr mMiniMapOgreTexture;
     Ogre::HardwarePixelBufferSharedPtr mPixelBuffer;
 };
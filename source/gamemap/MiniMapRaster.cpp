@@ -0,0 +1,248 @@
+/*
+ *  Copyright (C) 2011-2016  OpenDungeons Team
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "gamemap/MiniMapRaster.h"
+
+#include <algorithm>
+#include <cstdlib>
+
+namespace
+{
+    //! \brief Above that, the dirty rectangles are merged in their bounding rectangle
+    const uint32_t MAX_DIRTY_RECTS = 8;
+
+    bool areTouching(const MiniMapRaster::Rect& r1, const MiniMapRaster::Rect& r2)
+    {
+        return (r1.mXMin <= r2.mXMax) && (r2.mXMin <= r1.mXMax) &&
+            (r1.mYMin <= r2.mYMax) && (r2.mYMin <= r1.mYMax);
+    }
+
+    void mergeRect(MiniMapRaster::Rect& r1, const MiniMapRaster::Rect& r2)
+    {
+        r1.mXMin = std::min(r1.mXMin, r2.mXMin);
+        r1.mXMax = std::max(r1.mXMax, r2.mXMax);
+        r1.mYMin = std::min(r1.mYMin, r2.mYMin);
+        r1.mYMax = std::max(r1.mYMax, r2.mYMax);
+    }
+
+    //! \brief Liang-Barsky clipping of the segment (x1, y1) (x2, y2) in [0, xMax] x [0, yMax].
+    //! Returns false if the segment is fully outside
+    bool clipSegment(double& x1, double& y1, double& x2, double& y2, double xMax, double yMax)
+    {
+        double dx = x2 - x1;
+        double dy = y2 - y1;
+        double p[4] = { -dx, dx, -dy, dy };
+        double q[4] = { x1, xMax - x1, y1, yMax - y1 };
+        double tMin = 0.0;
+        double tMax = 1.0;
+        for(uint32_t i = 0; i < 4; ++i)
+        {
+            if(p[i] == 0.0)
+            {
+                if(q[i] < 0.0)
+                    return false;
+
+                continue;
+            }
+
+            double t = q[i] / p[i];
+            if(p[i] < 0.0)
+                tMin = std::max(tMin, t);
+            else
+                tMax = std::min(tMax, t);
+        }
+
+        if(tMin > tMax)
+            return false;
+
+        x2 = x1 + tMax * dx;
+        y2 = y1 + tMax * dy;
+        x1 = x1 + tMin * dx;
+        y1 = y1 + tMin * dy;
+        return true;
+    }
+}
+
+MiniMapRaster::MiniMapRaster(uint32_t width, uint32_t height) :
+    mWidth(width),
+    mHeight(height),
+    mBase(width * height),
+    mPixels(width * height * 4, 0),
+    mIsOverlayPixel(width * height, false)
+{
+    for(uint32_t i = 0; i < width * height; ++i)
+        writePixel(i, mBase[i]);
+
+    addDirtyRect(Rect(0, mWidth, 0, mHeight));
+}
+
+void MiniMapRaster::writePixel(uint32_t index, const Colour& colour)
+{
+    uint8_t* pixel = &mPixels[index * 4];
+    pixel[0] = colour.mR;
+    pixel[1] = colour.mG;
+    pixel[2] = colour.mB;
+    pixel[3] = colour.mA;
+}
+
+MiniMapRaster::Colour MiniMapRaster::getPixel(uint32_t x, uint32_t y) const
+{
+    const uint8_t* pixel = &mPixels[(x + y * mWidth) * 4];
+    Colour colour(pixel[0], pixel[1], pixel[2]);
+    colour.mA = pixel[3];
+    return colour;
+}
+
+void MiniMapRaster::fillRect(const Rect& rect, const Colour& colour)
+{
+    Rect clipped(rect.mXMin, std::min(rect.mXMax, mWidth), rect.mYMin, std::min(rect.mYMax, mHeight));
+    if((clipped.mXMin >= clipped.mXMax) || (clipped.mYMin >= clipped.mYMax))
+        return;
+
+    bool isChanged = false;
+    for(uint32_t yy = clipped.mYMin; yy < clipped.mYMax; ++yy)
+    {
+        for(uint32_t xx = clipped.mXMin; xx < clipped.mXMax; ++xx)
+        {
+            uint32_t index = xx + yy * mWidth;
+            if(mBase[index] == colour)
+                continue;
+
+            mBase[index] = colour;
+            isChanged = true;
+            // The overlay hides the base layer
+            if(!mIsOverlayPixel[index])
+                writePixel(index, colour);
+        }
+    }
+
+    if(isChanged)
+        addDirtyRect(clipped);
+}
+
+void MiniMapRaster::setOverlayOutline(const std::vector<std::pair<int32_t, int32_t>>& points, const Colour& colour)
+{
+    // We restore the pixels hidden by the previous outline
+    for(uint32_t index : mOverlayPixels)
+    {
+        mIsOverlayPixel[index] = false;
+        writePixel(index, mBase[index]);
+        uint32_t xx = index % mWidth;
+        uint32_t yy = index / mWidth;
+        addDirtyRect(Rect(xx, xx + 1, yy, yy + 1));
+    }
+    mOverlayPixels.clear();
+
+    for(uint32_t i = 0; i < points.size(); ++i)
+    {
+        const std::pair<int32_t, int32_t>& p1 = points[i];
+        const std::pair<int32_t, int32_t>& p2 = points[(i + 1) % points.size()];
+        drawOverlaySegment(p1.first, p1.second, p2.first, p2.second, colour);
+    }
+}
+
+void MiniMapRaster::drawOverlaySegment(int32_t x1, int32_t y1, int32_t x2, int32_t y2, const Colour& colour)
+{
+    if((mWidth == 0) || (mHeight == 0))
+        return;
+
+    // The camera can see far outside of the map. We only draw the visible part of the segment
+    double cx1 = static_cast<double>(x1);
+    double cy1 = static_cast<double>(y1);
+    double cx2 = static_cast<double>(x2);
+    double cy2 = static_cast<double>(y2);
+    if(!clipSegment(cx1, cy1, cx2, cy2, static_cast<double>(mWidth - 1), static_cast<double>(mHeight - 1)))
+        return;
+
+    // Bresenham
+    int32_t xx = static_cast<int32_t>(cx1 + 0.5);
+    int32_t yy = static_cast<int32_t>(cy1 + 0.5);
+    int32_t xEnd = static_cast<int32_t>(cx2 + 0.5);
+    int32_t yEnd = static_cast<int32_t>(cy2 + 0.5);
+    int32_t dx = std::abs(xEnd - xx);
+    int32_t dy = -std::abs(yEnd - yy);
+    int32_t stepX = (xx < xEnd) ? 1 : -1;
+    int32_t stepY = (yy < yEnd) ? 1 : -1;
+    int32_t err = dx + dy;
+    while(true)
+    {
+        addOverlayPixel(xx, yy, colour);
+        if((xx == xEnd) && (yy == yEnd))
+            break;
+
+        int32_t err2 = 2 * err;
+        if(err2 >= dy)
+        {
+            err += dy;
+            xx += stepX;
+        }
+        if(err2 <= dx)
+        {
+            err += dx;
+            yy += stepY;
+        }
+    }
+}
+
+void MiniMapRaster::addOverlayPixel(int32_t x, int32_t y, const Colour& colour)
+{
+    if((x < 0) || (y < 0) || (x >= static_cast<int32_t>(mWidth)) || (y >= static_cast<int32_t>(mHeight)))
+        return;
+
+    uint32_t index = static_cast<uint32_t>(x) + static_cast<uint32_t>(y) * mWidth;
+    if(mIsOverlayPixel[index])
+        return;
+
+    mIsOverlayPixel[index] = true;
+    mOverlayPixels.push_back(index);
+    writePixel(index, colour);
+    addDirtyRect(Rect(static_cast<uint32_t>(x), static_cast<uint32_t>(x) + 1,
+        static_cast<uint32_t>(y), static_cast<uint32_t>(y) + 1));
+}
+
+void MiniMapRaster::addDirtyRect(const Rect& rect)
+{
+    Rect merged = rect;
+    // Merging a rectangle can make it touch other ones so we loop until nothing is merged
+    bool isMerged = true;
+    while(isMerged)
+    {
+        isMerged = false;
+        for(auto it = mDirtyRects.begin(); it != mDirtyRects.end(); ++it)
+        {
+            if(!areTouching(*it, merged))
+                continue;
+
+            mergeRect(merged, *it);
+            mDirtyRects.erase(it);
+            isMerged = true;
+            break;
+        }
+    }
+
+    if(mDirtyRects.size() < MAX_DIRTY_RECTS)
+    {
+        mDirtyRects.push_back(merged);
+        return;
+    }
+
+    for(const Rect& dirty : mDirtyRects)
+        mergeRect(merged, dirty);
+
+    mDirtyRects.clear();
+    mDirtyRects.push_back(merged);
+}
@@ -0,0 +1,126 @@
+/*
+ *  Copyright (C) 2011-2016  OpenDungeons Team
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MINIMAPRASTER_H
+#define MINIMAPRASTER_H
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+//! \brief RGBA pixels of the minimap kept in memory. The tiles are painted in a base layer and
+//! the viewport outline is drawn over it as an overlay so that moving the camera only repaints
+//! the outline pixels. The modified areas are remembered as dirty rectangles so that only them
+//! have to be copied to the texture.
+//! Pixels are stored row by row, 4 bytes per pixel (red, green, blue, alpha).
+class MiniMapRaster
+{
+public:
+    struct Colour
+    {
+        Colour() :
+            mR(0), mG(0), mB(0), mA(0xFF)
+        {}
+
+        Colour(uint8_t r, uint8_t g, uint8_t b) :
+            mR(r), mG(g), mB(b), mA(0xFF)
+        {}
+
+        bool operator==(const Colour& other) const
+        { return (mR == other.mR) && (mG == other.mG) && (mB == other.mB) && (mA == other.mA); }
+
+        uint8_t mR;
+        uint8_t mG;
+        uint8_t mB;
+        uint8_t mA;
+    };
+
+    //! \brief Rectangle of pixels. Max values are excluded
+    struct Rect
+    {
+        Rect() :
+            mXMin(0), mXMax(0), mYMin(0), mYMax(0)
+        {}
+
+        Rect(uint32_t xMin, uint32_t xMax, uint32_t yMin, uint32_t yMax) :
+            mXMin(xMin), mXMax(xMax), mYMin(yMin), mYMax(yMax)
+        {}
+
+        uint32_t mXMin;
+        uint32_t mXMax;
+        uint32_t mYMin;
+        uint32_t mYMax;
+    };
+
+    MiniMapRaster(uint32_t width, uint32_t height);
+
+    inline uint32_t getWidth() const
+    { return mWidth; }
+
+    inline uint32_t getHeight() const
+    { return mHeight; }
+
+    //! \brief Paints the given rectangle of the base layer
+    void fillRect(const Rect& rect, const Colour& colour);
+
+    //! \brief Replaces the overlay with a closed outline going through the given points (in
+    //! pixels). The parts of the outline outside of the raster are ignored
+    void setOverlayOutline(const std::vector<std::pair<int32_t, int32_t>>& points, const Colour& colour);
+
+    //! \brief Returns the displayed colour (overlay if any, base otherwise) of the given pixel
+    Colour getPixel(uint32_t x, uint32_t y) const;
+
+    //! \brief Displayed pixels (see class description)
+    inline const uint8_t* getPixels() const
+    { return mPixels.data(); }
+
+    //! \brief Areas modified since the last call to clearDirtyRects
+    inline const std::vector<Rect>& getDirtyRects() const
+    { return mDirtyRects; }
+
+    inline void clearDirtyRects()
+    { mDirtyRects.clear(); }
+
+private:
+    uint32_t mWidth;
+    uint32_t mHeight;
+
+    //! \brief Colours of the tiles
+    std::vector<Colour> mBase;
+
+    //! \brief Displayed pixels (base layer with the overlay drawn over it)
+    std::vector<uint8_t> mPixels;
+
+    //! \brief Indexes of the pixels covered by the overlay
+    std::vector<uint32_t> mOverlayPixels;
+    std::vector<bool> mIsOverlayPixel;
+
+    std::vector<Rect> mDirtyRects;
+
+    void writePixel(uint32_t index, const Colour& colour);
+
+    //! \brief Adds a pixel to the overlay if inside the raster
+    void addOverlayPixel(int32_t x, int32_t y, const Colour& colour);
+
+    //! \brief Draws the part of the segment that is inside the raster in the overlay
+    void drawOverlaySegment(int32_t x1, int32_t y1, int32_t x2, int32_t y2, const Colour& colour);
+
+    //! \brief Adds the given rectangle to the dirty ones. Rectangles touching each other are merged
+    void addDirtyRect(const Rect& rect);
+};
+
+#endif // MINIMAPRASTER_H
@@ -0,0 +1,139 @@
+/*
+ *  Copyright (C) 2011-2016  OpenDungeons Team
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "gamemap/ResourceTileIndex.h"
+
+#include "entities/Tile.h"
+#include "game/Player.h"
+#include "gamemap/GameMap.h"
+
+ResourceTileIndex::ResourceTileIndex(GameMap& gameMap) :
+    mGameMap(gameMap),
+    mIsBuilt(false)
+{
+}
+
+void ResourceTileIndex::clear()
+{
+    mIsBuilt = false;
+    mTilesByType.clear();
+    mTilesMarkedForDigging.clear();
+}
+
+void ResourceTileIndex::build()
+{
+    if(mIsBuilt)
+        return;
+
+    mIsBuilt = true;
+    int32_t mapSizeX = mGameMap.getMapSizeX();
+    int32_t mapSizeY = mGameMap.getMapSizeY();
+    for(TileType type : { TileType::dirt, TileType::gold, TileType::gem })
+        mTilesByType[type].reset(mapSizeX, mapSizeY);
+
+    for(Player* player : mGameMap.getPlayers())
+        mTilesMarkedForDigging[player].reset(mapSizeX, mapSizeY);
+
+    for(int32_t yy = 0; yy < mapSizeY; ++yy)
+    {
+        for(int32_t xx = 0; xx < mapSizeX; ++xx)
+        {
+            Tile* tile = mGameMap.getTile(xx, yy);
+            if(tile == nullptr)
+                continue;
+
+            TileBucketIndex* typeIndex = getTypeIndex(tile->getType());
+            if((typeIndex != nullptr) && (tile->getFullness() > 0.0))
+                typeIndex->add(tile);
+
+            for(Player* player : mGameMap.getPlayers())
+            {
+                if(tile->getMarkedForDigging(player))
+                    mTilesMarkedForDigging[player].add(tile);
+            }
+        }
+    }
+}
+
+TileBucketIndex* ResourceTileIndex::getTypeIndex(TileType type)
+{
+    auto it = mTilesByType.find(type);
+    if(it == mTilesByType.end())
+        return nullptr;
+
+    return &it->second;
+}
+
+TileBucketIndex& ResourceTileIndex::getMarkedIndex(const Player& player)
+{
+    auto it = mTilesMarkedForDigging.find(&player);
+    if(it != mTilesMarkedForDigging.end())
+        return it->second;
+
+    // Players can be added after the index was built
+    TileBucketIndex& index = mTilesMarkedForDigging[&player];
+    index.reset(mGameMap.getMapSizeX(), mGameMap.getMapSizeY());
+    return index;
+}
+
+void ResourceTileIndex::tileTypeChanged(Tile& tile)
+{
+    // If the index is not built yet, the tile will be handled when it is
+    if(!mIsBuilt)
+        return;
+
+    // The type may have changed so we remove the tile from every index before adding it back
+    for(std::pair<const TileType, TileBucketIndex>& p : mTilesByType)
+        p.second.remove(&tile);
+
+    TileBucketIndex* typeIndex = getTypeIndex(tile.getType());
+    if((typeIndex != nullptr) && (tile.getFullness() > 0.0))
+        typeIndex->add(&tile);
+}
+
+void ResourceTileIndex::tileMarkingChanged(Tile& tile, const Player& player, bool isMarked)
+{
+    if(!mIsBuilt)
+        return;
+
+    TileBucketIndex& index = getMarkedIndex(player);
+    if(isMarked)
+        index.add(&tile);
+    else
+        index.remove(&tile);
+}
+
+void ResourceTileIndex::findNearestTilesOfType(TileType type, int32_t x, int32_t y, uint32_t nbTiles,
+    int32_t maxDistance, std::vector<Tile*>& tiles)
+{
+    build();
+    TileBucketIndex* typeIndex = getTypeIndex(type);
+    if(typeIndex == nullptr)
+    {
+        tiles.clear();
+        return;
+    }
+
+    typeIndex->findNearest(x, y, nbTiles, maxDistance, tiles);
+}
+
+void ResourceTileIndex::findNearestTilesMarkedForDigging(const Player& player, int32_t x, int32_t y, uint32_t nbTiles,
+    int32_t maxDistance, std::vector<Tile*>& tiles)
+{
+    build();
+    getMarkedIndex(player).findNearest(x, y, nbTiles, maxDistance, tiles);
+}
@@ -0,0 +1,79 @@
+/*
+ *  Copyright (C) 2011-2016  OpenDungeons Team
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef RESOURCETILEINDEX_H
+#define RESOURCETILEINDEX_H
+
+#include "gamemap/TileBucketIndex.h"
+
+#include <cstdint>
+#include <map>
+#include <vector>
+
+class GameMap;
+class Player;
+class Tile;
+
+enum class TileType;
+
+//! \brief Server side index of the tiles that creatures or AIs look for: the tiles that can still
+//! be dug by type (dirt, gold and gems) and the tiles marked for digging by each player.
+//! The index is built from the whole map the first time it is used and then kept up to date by the
+//! tiles when their type, fullness or digging marks change.
+class ResourceTileIndex
+{
+public:
+    ResourceTileIndex(GameMap& gameMap);
+
+    //! \brief Forgets every tile. Should be called when the tiles are deleted
+    void clear();
+
+    //! \brief Called by the tile when its type or fullness changed
+    void tileTypeChanged(Tile& tile);
+
+    //! \brief Called by the tile when the given player marks or unmarks it for digging
+    void tileMarkingChanged(Tile& tile, const Player& player, bool isMarked);
+
+    //! \brief Fills tiles with the nbTiles closest non dug tiles of the given type (dirt, gold or gem) sorted
+    //! by distance. If maxDistance is >= 0, only tiles within this distance are returned
+    void findNearestTilesOfType(TileType type, int32_t x, int32_t y, uint32_t nbTiles, int32_t maxDistance,
+        std::vector<Tile*>& tiles);
+
+    //! \brief Same as findNearestTilesOfType for the tiles marked for digging by the given player
+    void findNearestTilesMarkedForDigging(const Player& player, int32_t x, int32_t y, uint32_t nbTiles,
+        int32_t maxDistance, std::vector<Tile*>& tiles);
+
+private:
+    GameMap& mGameMap;
+
+    bool mIsBuilt;
+
+    //! \brief Non dug tiles indexed by type. Only the types we look for are indexed
+    std::map<TileType, TileBucketIndex> mTilesByType;
+
+    std::map<const Player*, TileBucketIndex> mTilesMarkedForDigging;
+
+    //! \brief Builds the index from the whole map if not already done
+    void build();
+
+    //! \brief Returns the index to use for the given type or nullptr if the type is not indexed
+    TileBucketIndex* getTypeIndex(TileType type);
+
+    TileBucketIndex& getMarkedIndex(const Player& player);
+};
+
+#endif // RESOURCETILEINDEX_H
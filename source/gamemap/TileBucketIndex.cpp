@@ -0,0 +1,179 @@
+/*
+ *  Copyright (C) 2011-2016  OpenDungeons Team
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "gamemap/TileBucketIndex.h"
+
+#include "entities/Tile.h"
+#include "utils/LogManager.h"
+
+#include <algorithm>
+
+namespace
+{
+    //! \brief Width (in tiles) of the square buckets
+    const int32_t BUCKET_SIZE = 8;
+
+    typedef std::pair<int32_t, Tile*> TileDistance;
+
+    bool compareTileDistance(const TileDistance& a, const TileDistance& b)
+    {
+        return a.first < b.first;
+    }
+}
+
+TileBucketIndex::TileBucketIndex() :
+    mNbBucketsX(0),
+    mNbBucketsY(0),
+    mNbTiles(0)
+{
+}
+
+void TileBucketIndex::reset(int32_t mapSizeX, int32_t mapSizeY)
+{
+    mNbBucketsX = (mapSizeX + BUCKET_SIZE - 1) / BUCKET_SIZE;
+    mNbBucketsY = (mapSizeY + BUCKET_SIZE - 1) / BUCKET_SIZE;
+    mNbTiles = 0;
+    mBuckets.clear();
+    mBuckets.resize(static_cast<size_t>(mNbBucketsX * mNbBucketsY));
+}
+
+std::vector<Tile*>* TileBucketIndex::getBucket(Tile* tile)
+{
+    int32_t bucketX = tile->getX() / BUCKET_SIZE;
+    int32_t bucketY = tile->getY() / BUCKET_SIZE;
+    if((tile->getX() < 0) || (tile->getY() < 0) || (bucketX >= mNbBucketsX) || (bucketY >= mNbBucketsY))
+    {
+        OD_LOG_ERR("tile=" + Tile::displayAsString(tile) + " is outside the indexed map");
+        return nullptr;
+    }
+
+    return &mBuckets[bucketX + bucketY * mNbBucketsX];
+}
+
+const std::vector<Tile*>* TileBucketIndex::getBucket(Tile* tile) const
+{
+    return const_cast<TileBucketIndex*>(this)->getBucket(tile);
+}
+
+void TileBucketIndex::add(Tile* tile)
+{
+    std::vector<Tile*>* bucket = getBucket(tile);
+    if(bucket == nullptr)
+        return;
+
+    if(std::find(bucket->begin(), bucket->end(), tile) != bucket->end())
+        return;
+
+    bucket->push_back(tile);
+    ++mNbTiles;
+}
+
+void TileBucketIndex::remove(Tile* tile)
+{
+    std::vector<Tile*>* bucket = getBucket(tile);
+    if(bucket == nullptr)
+        return;
+
+    auto it = std::find(bucket->begin(), bucket->end(), tile);
+    if(it == bucket->end())
+        return;
+
+    // Order within a bucket does not matter
+    *it = bucket->back();
+    bucket->pop_back();
+    --mNbTiles;
+}
+
+bool TileBucketIndex::contains(Tile* tile) const
+{
+    const std::vector<Tile*>* bucket = getBucket(tile);
+    if(bucket == nullptr)
+        return false;
+
+    return std::find(bucket->begin(), bucket->end(), tile) != bucket->end();
+}
+
+void TileBucketIndex::findNearest(int32_t x, int32_t y, uint32_t nbTiles, int32_t maxDistance,
+    std::vector<Tile*>& tiles) const
+{
+    tiles.clear();
+    if((nbTiles == 0) || (mNbTiles == 0))
+        return;
+
+    int32_t centerBucketX = std::min(std::max(x / BUCKET_SIZE, 0), mNbBucketsX - 1);
+    int32_t centerBucketY = std::min(std::max(y / BUCKET_SIZE, 0), mNbBucketsY - 1);
+    int32_t maxRing = std::max(mNbBucketsX, mNbBucketsY);
+    if(maxDistance >= 0)
+        maxRing = std::min(maxRing, (maxDistance / BUCKET_SIZE) + 1);
+
+    int32_t maxDistanceSquared = maxDistance * maxDistance;
+    std::vector<TileDistance> candidates;
+    auto addBucket = [&](int32_t bucketX, int32_t bucketY)
+    {
+        if((bucketX < 0) || (bucketY < 0) || (bucketX >= mNbBucketsX) || (bucketY >= mNbBucketsY))
+            return;
+
+        for(Tile* tile : mBuckets[bucketX + bucketY * mNbBucketsX])
+        {
+            int32_t diffX = tile->getX() - x;
+            int32_t diffY = tile->getY() - y;
+            int32_t distSquared = diffX * diffX + diffY * diffY;
+            if((maxDistance >= 0) && (distSquared > maxDistanceSquared))
+                continue;
+
+            candidates.push_back(TileDistance(distSquared, tile));
+        }
+    };
+
+    for(int32_t ring = 0; ring <= maxRing; ++ring)
+    {
+        if(ring == 0)
+            addBucket(centerBucketX, centerBucketY);
+        else
+        {
+            // Top and bottom rows of the ring, then left and right columns (without the corners)
+            for(int32_t bucketX = centerBucketX - ring; bucketX <= centerBucketX + ring; ++bucketX)
+            {
+                addBucket(bucketX, centerBucketY - ring);
+                addBucket(bucketX, centerBucketY + ring);
+            }
+            for(int32_t bucketY = centerBucketY - ring + 1; bucketY <= centerBucketY + ring - 1; ++bucketY)
+            {
+                addBucket(centerBucketX - ring, bucketY);
+                addBucket(centerBucketX + ring, bucketY);
+            }
+        }
+
+        if(candidates.size() < nbTiles)
+            continue;
+
+        // Tiles in the next rings are at least ring * BUCKET_SIZE + 1 away. If we already have
+        // enough tiles closer than that, we can stop
+        std::nth_element(candidates.begin(), candidates.begin() + (nbTiles - 1), candidates.end(), compareTileDistance);
+        int32_t nextRingDist = ring * BUCKET_SIZE;
+        if(candidates[nbTiles - 1].first <= nextRingDist * nextRingDist)
+            break;
+    }
+
+    std::stable_sort(candidates.begin(), candidates.end(), compareTileDistance);
+    if(candidates.size() > nbTiles)
+        candidates.resize(nbTiles);
+
+    tiles.reserve(candidates.size());
+    for(const TileDistance& candidate : candidates)
+        tiles.push_back(candidate.second);
+}
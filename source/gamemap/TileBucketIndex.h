@@ -0,0 +1,63 @@
+/*
+ *  Copyright (C) 2011-2016  OpenDungeons Team
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TILEBUCKETINDEX_H
+#define TILEBUCKETINDEX_H
+
+#include <cstdint>
+#include <vector>
+
+class Tile;
+
+//! \brief Set of tiles sorted in square buckets of the map so that the tiles closest to a
+//! given position can be found without scanning the whole map.
+class TileBucketIndex
+{
+public:
+    TileBucketIndex();
+
+    //! \brief Removes every tile and sets the size of the indexed map
+    void reset(int32_t mapSizeX, int32_t mapSizeY);
+
+    //! \brief Adds the given tile if it is not already in the index
+    void add(Tile* tile);
+
+    //! \brief Removes the given tile if it is in the index
+    void remove(Tile* tile);
+
+    bool contains(Tile* tile) const;
+
+    inline uint32_t size() const
+    { return mNbTiles; }
+
+    //! \brief Fills tiles with at most nbTiles tiles closest to the given position (sorted by
+    //! increasing distance). If maxDistance is >= 0, only tiles within this distance are
+    //! returned
+    void findNearest(int32_t x, int32_t y, uint32_t nbTiles, int32_t maxDistance,
+        std::vector<Tile*>& tiles) const;
+
+private:
+    int32_t mNbBucketsX;
+    int32_t mNbBucketsY;
+    uint32_t mNbTiles;
+    std::vector<std::vector<Tile*>> mBuckets;
+
+    std::vector<Tile*>* getBucket(Tile* tile);
+    const std::vector<Tile*>* getBucket(Tile* tile) const;
+};
+
+#endif // TILEBUCKETINDEX_H
@@ -718,9 +718,31 @@ void TileContainer::buildTileDistance(int distance)
     mTileDistanceComputed = distance;
 }
 
-std::list<Tile*> TileContainer::tilesBetween(int x1, int y1, int x2, int y2) const
+TileLineIterator::TileLineIterator(const TileContainer& tileContainer) :
+    mTileContainer(&tileContainer),
+    mStep(Step::done),
+    mX(0),
+    mY(0),
+    mX2(0),
+    mY2(0),
+    mDiffX(1),
+    mDiffY(1),
+    mIsXMajor(true),
+    mError(0.0),
+    mDeltaErr(0.0)
 {
-    std::list<Tile*> path;
+}
+
+void TileLineIterator::reset(int x1, int y1, int x2, int y2)
+{
+    mStep = Step::line;
+    mX = x1;
+    mY = y1;
+    mX2 = x2;
+    mY2 = y2;
+    mDiffX = (x1 > x2) ? -1 : 1;
+    mDiffY = (y1 > y2) ? -1 : 1;
+    mError = 0.0;
 
     double deltax = x2 - x1;
     double deltay = y2 - y1;
@@ -729,80 +751,78 @@ std::list<Tile*> TileContainer::tilesBetween(int x1, int y1, int x2, int y2) con
     // never compute std::abs(deltax / deltay);
     if(deltax == 0)
     {
-        // Vertical line, no need to compute
-        int diffY = 1;
-        if(y1 > y2)
-            diffY = -1;
-
-        for(int y = y1; y != y2; y += diffY)
-        {
-            Tile* tile = getTile(x1, y);
-            if(tile == nullptr)
-                break;
-
-            path.push_back(tile);
-        }
+        // Vertical line, we never move along the X axis
+        mIsXMajor = false;
+        mDeltaErr = 0.0;
     }
     else if(std::abs(deltax) >= std::abs(deltay))
     {
-        double error = 0;
-        double deltaerr = std::abs(deltay / deltax);
-        int diffX = 1;
-        if(x1 > x2)
-            diffX = -1;
-
-        int diffY = 1;
-        if(y1 > y2)
-            diffY = -1;
-
-        int y = y1;
-        for(int x = x1; x != x2; x += diffX)
-        {
-            Tile* tile = getTile(x, y);
-            if(tile == nullptr)
-                break;
-
-            path.push_back(tile);
-            error += deltaerr;
-            if(error >= 0.5)
-            {
-                y += diffY;
-                error = error - 1.0;
-            }
-        }
+        mIsXMajor = true;
+        mDeltaErr = std::abs(deltay / deltax);
     }
-    else // if(std::abs(deltax) < std::abs(deltay))
+    else
     {
-        double error = 0;
-        double deltaerr = std::abs(deltax / deltay);
-        int diffX = 1;
-        if(x1 > x2)
-            diffX = -1;
-
-        int diffY = 1;
-        if(y1 > y2)
-            diffY = -1;
+        mIsXMajor = false;
+        mDeltaErr = std::abs(deltax / deltay);
+    }
+}
 
-        int x = x1;
-        for(int y = y1; y != y2; y += diffY)
+Tile* TileLineIterator::next()
+{
+    switch(mStep)
+    {
+        case Step::line:
         {
-            Tile* tile = getTile(x, y);
+            Tile* tile = nullptr;
+            if((mIsXMajor && (mX != mX2)) || (!mIsXMajor && (mY != mY2)))
+                tile = mTileContainer->getTile(mX, mY);
+
             if(tile == nullptr)
-                break;
+            {
+                // We reached the end of the line (or the map border). We add the last tile
+                mStep = Step::done;
+                return mTileContainer->getTile(mX2, mY2);
+            }
 
-            path.push_back(tile);
-            error += deltaerr;
-            if(error >= 0.5)
+            mError += mDeltaErr;
+            if(mIsXMajor)
+            {
+                mX += mDiffX;
+                if(mError >= 0.5)
+                {
+                    mY += mDiffY;
+                    mError = mError - 1.0;
+                }
+            }
+            else
             {
-                x += diffX;
-                error = error - 1.0;
+                mY += mDiffY;
+                if(mError >= 0.5)
+                {
+                    mX += mDiffX;
+                    mError = mError - 1.0;
+                }
             }
+            return tile;
         }
+        case Step::done:
+        default:
+            return nullptr;
     }
+}
 
-    // We add the last tile
-    Tile* tile = getTile(x2, y2);
-    if(tile != nullptr)
+TileLineIterator TileContainer::lineIterator(int x1, int y1, int x2, int y2) const
+{
+    TileLineIterator it(*this);
+    it.reset(x1, y1, x2, y2);
+    return it;
+}
+
+std::list<Tile*> TileContainer::tilesBetween(int x1, int y1, int x2, int y2) const
+{
+    std::list<Tile*> path;
+    TileLineIterator it = lineIterator(x1, y1, x2, y2);
+    for(Tile* tile = it.next(); tile != nullptr; tile = it.next())
         path.push_back(tile);
 
     return path;
@@ -28,6 +28,42 @@ class Tile;
 
 enum class TileType;
 
+class TileContainer;
+
+//! \brief Walks through the tiles along a straight line from (x1, y1) to (x2, y2) without allocating
+//! anything. The tiles returned are the same (and in the same order) as the ones from TileContainer::tilesBetween
+class TileLineIterator
+{
+public:
+    TileLineIterator(const TileContainer& tileContainer);
+
+    //! \brief Starts a new line
+    void reset(int x1, int y1, int x2, int y2);
+
+    //! \brief Returns the next tile on the line or nullptr if the end of the line has been reached
+    Tile* next();
+
+private:
+    enum class Step
+    {
+        line,
+        done
+    };
+
+    const TileContainer* mTileContainer;
+    Step mStep;
+    int mX;
+    int mY;
+    int mX2;
+    int mY2;
+    int mDiffX;
+    int mDiffY;
+    //! \brief true if we move along the X axis at each step (and along the Y axis depending on the error)
+    bool mIsXMajor;
+    double mError;
+    double mDeltaErr;
+};
+
 class TileContainer
 {
 public:
@@ -92,6 +128,9 @@ public:
      * A more detailed description of how it works can be found there.
      */
     std::list<Tile*> tilesBetween(int x1, int y1, int x2, int y2) const;
+    //! \brief Same as tilesBetween without building the list. Useful for entities computing lines
+    //! each turn (like missiles)
+    TileLineIterator lineIterator(int x1, int y1, int x2, int y2) const;
 
     //! \brief Returns the tiles visible from the given start tile within radius. The tiles are ordered from the closest to
     //! the furthest
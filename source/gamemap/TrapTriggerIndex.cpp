@@ -0,0 +1,121 @@
+/*
+ *  Copyright (C) 2011-2016  OpenDungeons Team
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "gamemap/TrapTriggerIndex.h"
+
+#include "entities/Tile.h"
+#include "gamemap/GameMap.h"
+#include "traps/Trap.h"
+#include "utils/LogManager.h"
+
+#include <algorithm>
+
+TrapTriggerIndex::TrapTriggerIndex(GameMap& gameMap) :
+    mGameMap(gameMap),
+    mMapSizeX(0),
+    mMapSizeY(0)
+{
+}
+
+void TrapTriggerIndex::clear()
+{
+    mMapSizeX = 0;
+    mMapSizeY = 0;
+    mWatchers.clear();
+}
+
+void TrapTriggerIndex::addTrapTile(Trap& trap, Tile& trapTile, int32_t range)
+{
+    if(mWatchers.empty())
+    {
+        mMapSizeX = mGameMap.getMapSizeX();
+        mMapSizeY = mGameMap.getMapSizeY();
+        mWatchers.resize(static_cast<size_t>(mMapSizeX * mMapSizeY));
+    }
+
+    // We watch the whole disc even if walls hide some tiles: if a wall is dug, the tiles behind
+    // become visible and the trap will have to be woken up if a creature enters them
+    int32_t rangeSquared = range * range;
+    for(int32_t yy = std::max(0, trapTile.getY() - range); yy <= std::min(mMapSizeY - 1, trapTile.getY() + range); ++yy)
+    {
+        for(int32_t xx = std::max(0, trapTile.getX() - range); xx <= std::min(mMapSizeX - 1, trapTile.getX() + range); ++xx)
+        {
+            int32_t diffX = xx - trapTile.getX();
+            int32_t diffY = yy - trapTile.getY();
+            if(diffX * diffX + diffY * diffY > rangeSquared)
+                continue;
+
+            mWatchers[xx + yy * mMapSizeX].push_back(TrapTileWatcher(&trap, &trapTile));
+        }
+    }
+}
+
+void TrapTriggerIndex::removeTrapTile(Trap& trap, Tile& trapTile, int32_t range)
+{
+    if(mWatchers.empty())
+    {
+        OD_LOG_ERR("trap=" + trap.getName() + ", tile=" + Tile::displayAsString(&trapTile));
+        return;
+    }
+
+    for(int32_t yy = std::max(0, trapTile.getY() - range); yy <= std::min(mMapSizeY - 1, trapTile.getY() + range); ++yy)
+    {
+        for(int32_t xx = std::max(0, trapTile.getX() - range); xx <= std::min(mMapSizeX - 1, trapTile.getX() + range); ++xx)
+        {
+            std::vector<TrapTileWatcher>& watchers = mWatchers[xx + yy * mMapSizeX];
+            watchers.erase(std::remove_if(watchers.begin(), watchers.end(), [&](const TrapTileWatcher& watcher)
+                {
+                    return (watcher.mTrap == &trap) && (watcher.mTrapTile == &trapTile);
+                }), watchers.end());
+        }
+    }
+}
+
+std::vector<TrapTriggerIndex::TrapTileWatcher>* TrapTriggerIndex::getWatchers(Tile& tile)
+{
+    if(mWatchers.empty())
+        return nullptr;
+
+    if((tile.getX() < 0) || (tile.getY() < 0) || (tile.getX() >= mMapSizeX) || (tile.getY() >= mMapSizeY))
+        return nullptr;
+
+    std::vector<TrapTileWatcher>& watchers = mWatchers[tile.getX() + tile.getY() * mMapSizeX];
+    if(watchers.empty())
+        return nullptr;
+
+    return &watchers;
+}
+
+void TrapTriggerIndex::creatureEnteredTile(Tile& tile)
+{
+    std::vector<TrapTileWatcher>* watchers = getWatchers(tile);
+    if(watchers == nullptr)
+        return;
+
+    for(TrapTileWatcher& watcher : *watchers)
+        watcher.mTrap->wakeUpTrapTile(watcher.mTrapTile);
+}
+
+void TrapTriggerIndex::tileVisionChanged(Tile& tile)
+{
+    std::vector<TrapTileWatcher>* watchers = getWatchers(tile);
+    if(watchers == nullptr)
+        return;
+
+    for(TrapTileWatcher& watcher : *watchers)
+        watcher.mTrap->triggerZoneChanged(watcher.mTrapTile);
+}
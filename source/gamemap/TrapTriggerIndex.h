@@ -0,0 +1,79 @@
+/*
+ *  Copyright (C) 2011-2016  OpenDungeons Team
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TRAPTRIGGERINDEX_H
+#define TRAPTRIGGERINDEX_H
+
+#include <cstdint>
+#include <vector>
+
+class GameMap;
+class Tile;
+class Trap;
+
+//! \brief Server side index of the tiles watched by the trap tiles. Each trap tile watches every tile
+//! within its trigger range. When a creature enters a watched tile (or becomes attackable on it), the
+//! trap tile is woken up so that sleeping traps do not have to look for targets every turn. When the
+//! vision through a watched tile changes (a wall is dug or a door is locked), the trigger zone cached
+//! by the trap tile is invalidated.
+class TrapTriggerIndex
+{
+public:
+    TrapTriggerIndex(GameMap& gameMap);
+
+    //! \brief Forgets every trap tile. Should be called when the tiles are deleted
+    void clear();
+
+    //! \brief Starts watching the tiles within range around trapTile for the given trap
+    void addTrapTile(Trap& trap, Tile& trapTile, int32_t range);
+
+    //! \brief Stops watching for the given trap tile. range should be the one given to addTrapTile
+    void removeTrapTile(Trap& trap, Tile& trapTile, int32_t range);
+
+    //! \brief Called when a creature enters the given tile or when a creature standing on it becomes
+    //! attackable (released from prison, changed seat). Wakes up the trap tiles watching it
+    void creatureEnteredTile(Tile& tile);
+
+    //! \brief Called when the given tile starts or stops blocking vision
+    void tileVisionChanged(Tile& tile);
+
+private:
+    struct TrapTileWatcher
+    {
+        TrapTileWatcher(Trap* trap, Tile* trapTile) :
+            mTrap(trap),
+            mTrapTile(trapTile)
+        {}
+
+        Trap* mTrap;
+        Tile* mTrapTile;
+    };
+
+    GameMap& mGameMap;
+
+    int32_t mMapSizeX;
+    int32_t mMapSizeY;
+
+    //! \brief Trap tiles watching each tile (indexed by x + y * mMapSizeX). Empty until a trap
+    //! tile is added so that the index costs nothing on the client side
+    std::vector<std::vector<TrapTileWatcher>> mWatchers;
+
+    //! \brief Returns the watchers of the given tile or nullptr if nobody watches it
+    std::vector<TrapTileWatcher>* getWatchers(Tile& tile);
+};
+
+#endif // TRAPTRIGGERINDEX_H
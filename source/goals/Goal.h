@@ -18,6 +18,7 @@
 #ifndef GOAL_H
 #define GOAL_H
 
+#include <cstdint>
 #include <iosfwd>
 #include <memory>
 #include <string>
@@ -29,6 +30,17 @@ class GameMap;
 class Goal
 {
 public:
+    //! \brief Game events a goal depends on. The seats only check a goal when one of the
+    //! events it depends on happened since the last check
+    enum GoalEvents : uint32_t
+    {
+        creaturesChanged = 0x01,
+        roomsChanged = 0x02,
+        claimedTilesChanged = 0x04,
+        goldMinedChanged = 0x08,
+        allEvents = 0xFF
+    };
+
     // Constructors
     Goal(const std::string& nName, const std::string& nArguments);
     virtual ~Goal() {}
@@ -45,6 +57,11 @@ public:
     virtual bool isUnmet(const Seat& s, const GameMap& gameMap);
     virtual bool isFailed(const Seat&, const GameMap&);
 
+    //! \brief Returns the GoalEvents that can change the result of isMet, isUnmet or isFailed.
+    //! By default, any event will trigger a check
+    virtual uint32_t getGoalEvents() const
+    { return allEvents; }
+
     // Functions which cannot be overridden by child classes
     const std::string& getName() const
     { return mName; }
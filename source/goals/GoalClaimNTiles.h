@@ -33,6 +33,9 @@ public:
     std::string getSuccessMessage(const Seat&);
     std::string getFailedMessage(const Seat&);
 
+    uint32_t getGoalEvents() const
+    { return claimedTilesChanged; }
+
 private:
     unsigned int mNumberOfTiles;
 };
@@ -32,6 +32,9 @@ public:
     std::string getDescription(const Seat&);
     std::string getSuccessMessage(const Seat&);
     std::string getFailedMessage(const Seat&);
+
+    uint32_t getGoalEvents() const
+    { return creaturesChanged | roomsChanged; }
 };
 
 #endif // GOAKILLALLENEMIES_H
@@ -33,6 +33,9 @@ public:
     std::string getSuccessMessage(const Seat &s);
     std::string getFailedMessage(const Seat &s);
 
+    uint32_t getGoalEvents() const
+    { return goldMinedChanged; }
+
 private:
     int mGoldToMine;
 };
@@ -33,6 +33,9 @@ public:
     std::string getSuccessMessage(const Seat&);
     std::string getFailedMessage(const Seat&);
 
+    uint32_t getGoalEvents() const
+    { return creaturesChanged; }
+
 private:
     std::string mCreatureName;
 };
@@ -35,6 +35,9 @@ public:
     std::string getDescription(const Seat&);
     std::string getSuccessMessage(const Seat&);
     std::string getFailedMessage(const Seat&);
+
+    uint32_t getGoalEvents() const
+    { return roomsChanged; }
 };
 
 #endif // GOALPROTECTDUNGEONTEMPLE_H
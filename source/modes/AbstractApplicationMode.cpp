@@ -20,9 +20,11 @@
 #include "network/ODClient.h"
 #include "network/ODServer.h"
 #include "render/Gui.h"
+#include "utils/Helper.h"
 
 #include <CEGUI/System.h>
 #include <CEGUI/GUIContext.h>
+#include <CEGUI/Window.h>
 #include <CEGUI/widgets/PushButton.h>
 
 AbstractApplicationMode::~AbstractApplicationMode()
@@ -34,6 +36,13 @@ AbstractApplicationMode::~AbstractApplicationMode()
     }
 }
 
+void AbstractApplicationMode::displayLoadingProgress(CEGUI::Window* loadingText, float progress)
+{
+    int32_t percent = static_cast<int32_t>(progress * 100.0f);
+    loadingText->setText("Loading... " + Helper::toString(percent) + "%");
+    loadingText->setVisible(true);
+}
+
 bool AbstractApplicationMode::isConnected()
 {
     return (ODServer::getSingleton().isConnected() || ODClient::getSingleton().isConnected());
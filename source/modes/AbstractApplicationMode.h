@@ -30,6 +30,11 @@
 
 #include <vector>
 
+namespace CEGUI
+{
+class Window;
+}
+
 class ChatMessage;
 class GameEntity;
 class Keyboard;
@@ -125,7 +130,14 @@ public:
     virtual void receiveChat(const ChatMessage& chat)
     {}
 
+    //! \brief Displays the progress (between 0 and 1) of the resources loading when the game is starting
+    virtual void setLoadingProgress(float progress)
+    {}
+
 protected:
+    //! \brief Displays the loading progress in the given text window of the menu
+    static void displayLoadingProgress(CEGUI::Window* loadingText, float progress);
+
     ModeManager& getModeManager()
     {
         return *mModeManager;
@@ -1,5 +1,6 @@
 #include "modes/ConsoleCommands.h"
 
+#include "ai/AIManager.h"
 #include "entities/Creature.h"
 #include "game/Player.h"
 #include "game/Seat.h"
@@ -15,6 +16,8 @@
 #include "utils/ConfigManager.h"
 #include "utils/Helper.h"
 #include "utils/LogManager.h"
+#include "utils/ResourceManager.h"
+#include "utils/Tracing.h"
 
 #include <OgreCamera.h>
 #include <OgreSceneManager.h>
@@ -56,7 +59,12 @@ const std::string HELPMESSAGE =
         "\n\tcatmullspline - Triggers the catmullspline camera movement type."
         "\n\tcirclearound - Triggers the circle camera movement type."
         "\n\tsetcamerafovy - Sets the camera vertical field of view aspect ratio value."
-        "\n\tlogfloodfill - Displays the FloodFillValues of all the Tiles in the GameMap.";
+        "\n\tlogfloodfill - Displays the FloodFillValues of all the Tiles in the GameMap."
+        "\n\tgameconfig - Displays or changes a rooms/traps/spells configuration value."
+        "\n\taistats - Displays the time spent by the AIs or changes their time budget."
+        "\n\tcheckaggregates - Compares the seat counters (claimed tiles, creatures, gold) with a full recount."
+        "\n\tpollgoals - Checks every goal at each turn to verify the goal events."
+        "\n\ttrace - Records a timeline of the client and server frames.";
 
 //! \brief Template function to get/set a variable from the ODFrameListener object
 template<typename ValType, typename Getter, typename Setter>
@@ -469,12 +477,147 @@ Command::Result cSetLogLevel(const Command::ArgumentList_t& args, ConsoleInterfa
     return Command::Result::SUCCESS;
 }
 
+Command::Result cTrace(const Command::ArgumentList_t& args, ConsoleInterface& c, AbstractModeManager&)
+{
+#ifndef OD_ENABLE_TRACING
+    c.print("\nWARNING : Tracing points were not compiled (OD_ENABLE_TRACING is off). Only empty traces will be recorded");
+#endif
+    if(args.size() < 2)
+    {
+        c.print("\nTrace recording is " + std::string(Tracing::isRecording() ? "on" : "off")
+            + ", recorded events=" + Helper::toString(Tracing::getNbEvents()));
+        return Command::Result::SUCCESS;
+    }
+
+    const std::string& action = args[1];
+    if(action == "start")
+    {
+        Tracing::start();
+        c.print("\nTrace recording started");
+        return Command::Result::SUCCESS;
+    }
+
+    if(action == "stop")
+    {
+        Tracing::stop();
+        c.print("\nTrace recording stopped, recorded events=" + Helper::toString(Tracing::getNbEvents()));
+        return Command::Result::SUCCESS;
+    }
+
+    if(action == "dump")
+    {
+        std::string fileName = ResourceManager::getSingleton().getUserDataPath()
+            + (args.size() >= 3 ? args[2] : std::string("trace.json"));
+        if(!Tracing::dumpToFile(fileName))
+        {
+            c.print("\nERROR : Couldn't write trace file " + fileName);
+            return Command::Result::FAILED;
+        }
+        c.print("\nTrace written to " + fileName);
+        return Command::Result::SUCCESS;
+    }
+
+    c.print("\nERROR : Unknown action '" + action + "'. Expected start, stop or dump");
+    return Command::Result::INVALID_ARGUMENT;
+}
+
 Command::Result cSrvUnlockSkills(const Command::ArgumentList_t& args, ConsoleInterface& c, GameMap& gameMap)
 {
     gameMap.consoleAskUnlockSkills();
     return Command::Result::SUCCESS;
 }
 
+Command::Result cSrvGameConfig(const Command::ArgumentList_t& args, ConsoleInterface& c, GameMap& gameMap)
+{
+    if(args.size() < 3)
+    {
+        c.print("\nERROR : Need to specify category (rooms, traps or spells) and parameter");
+        return Command::Result::INVALID_ARGUMENT;
+    }
+
+    ConfigManager& config = ConfigManager::getSingleton();
+    const std::string& category = args[1];
+    const std::string& param = args[2];
+    if(args.size() >= 4)
+    {
+        if(!config.setGameConfigParam(category, param, args[3]))
+        {
+            c.print("\nERROR : Cannot set " + category + " parameter '" + param + "' to " + args[3]);
+            return Command::Result::INVALID_ARGUMENT;
+        }
+    }
+
+    std::string value;
+    if(!config.getGameConfigParam(category, param, value))
+    {
+        c.print("\nERROR : Unknown " + category + " parameter '" + param + "'");
+        return Command::Result::INVALID_ARGUMENT;
+    }
+
+    c.print("\n" + category + " parameter '" + param + "' is " + value);
+    return Command::Result::SUCCESS;
+}
+
+Command::Result cSrvAIStats(const Command::ArgumentList_t& args, ConsoleInterface& c, GameMap& gameMap)
+{
+    AIManager& aiManager = gameMap.getAiManager();
+    if(args.size() >= 2)
+    {
+        int budget = Helper::toInt(args[1]);
+        if(budget <= 0)
+        {
+            c.print("\nERROR : The AI turn budget should be a positive number of microseconds");
+            return Command::Result::INVALID_ARGUMENT;
+        }
+        aiManager.setTurnBudget(static_cast<uint32_t>(budget));
+    }
+
+    c.print("\n" + aiManager.getStatsText());
+    return Command::Result::SUCCESS;
+}
+
+Command::Result cSrvCheckAggregates(const Command::ArgumentList_t& args, ConsoleInterface& c, GameMap& gameMap)
+{
+    if(args.size() >= 2)
+    {
+        if(args[1] == "on")
+            gameMap.setIsCheckingSeatAggregates(true);
+        else if(args[1] == "off")
+            gameMap.setIsCheckingSeatAggregates(false);
+        else
+        {
+            c.print("\nERROR : Expected on or off");
+            return Command::Result::INVALID_ARGUMENT;
+        }
+
+        c.print("\nSeat aggregates check at each turn is " + std::string(gameMap.getIsCheckingSeatAggregates() ? "on" : "off"));
+        return Command::Result::SUCCESS;
+    }
+
+    uint32_t nbSeats = gameMap.checkSeatAggregates();
+    c.print("\nSeats with wrong aggregates=" + Helper::toString(nbSeats));
+    return Command::Result::SUCCESS;
+}
+
+Command::Result cSrvPollGoals(const Command::ArgumentList_t& args, ConsoleInterface& c, GameMap& gameMap)
+{
+    if(args.size() >= 2)
+    {
+        if(args[1] == "on")
+            gameMap.setIsPollingGoals(true);
+        else if(args[1] == "off")
+            gameMap.setIsPollingGoals(false);
+        else
+        {
+            c.print("\nERROR : Expected on or off");
+            return Command::Result::INVALID_ARGUMENT;
+        }
+    }
+
+    c.print("\nGoal polling is " + std::string(gameMap.getIsPollingGoals() ? "on" : "off"));
+    return Command::Result::SUCCESS;
+}
+
 Command::Result cKeys(const Command::ArgumentList_t&, ConsoleInterface& c, AbstractModeManager&)
 {
     c.print("|| Action               || US Keyboard layout ||     Mouse      ||\n\
@@ -662,6 +805,31 @@ void addConsoleCommands(ConsoleInterface& cl)
                    cSrvLogFloodFill,
                    {AbstractModeManager::ModeType::GAME},
                    {});
+    cl.addCommand("aistats",
+                   "'aistats' displays the time spent by each AI during the last turns. If a value is given, it sets "
+                   "the time (in microseconds) each AI may spend per turn.\n\nExample:\n"
+                   "aistats 3000",
+                   cSendCmdToServer,
+                   cSrvAIStats,
+                   {AbstractModeManager::ModeType::GAME},
+                   {});
+    cl.addCommand("checkaggregates",
+                   "'checkaggregates' recounts the claimed tiles, creatures, rooms and gold of every seat and compares "
+                   "with the counters kept up to date during the game. Differences are logged and corrected. With on or off, "
+                   "enables or disables the check at each turn.\n\nExample:\n"
+                   "checkaggregates on",
+                   cSendCmdToServer,
+                   cSrvCheckAggregates,
+                   {AbstractModeManager::ModeType::GAME},
+                   {});
+    cl.addCommand("pollgoals",
+                   "'pollgoals' checks every goal at each turn instead of only the goals whose events (creature died, "
+                   "room destroyed, tiles claimed, gold mined) happened. Goals changing without any event are logged.\n\nExample:\n"
+                   "pollgoals on",
+                   cSendCmdToServer,
+                   cSrvPollGoals,
+                   {AbstractModeManager::ModeType::GAME},
+                   {});
     cl.addCommand("listmeshanims",
                    "'listmeshanims' lists all the animations for the given mesh.",
                    cListMeshAnims,
@@ -697,6 +865,26 @@ void addConsoleCommands(ConsoleInterface& cl)
                    },
                    Command::cStubServer,
                    {AbstractModeManager::ModeType::GAME, AbstractModeManager::ModeType::EDITOR});
+    cl.addCommand("gameconfig",
+                   "'gameconfig' displays or changes a rooms/traps/spells configuration value (as defined in rooms.cfg, "
+                   "traps.cfg and spells.cfg). The new value is used immediately by the server. Note that values cached "
+                   "when an object is created (like trap reload times) are only used for new objects.\n\nExample:\n"
+                   "gameconfig rooms CasinoFee => Displays the casino fee\n"
+                   "gameconfig rooms CasinoFee 0.5 => Sets the casino fee to 0.5",
+                   cSendCmdToServer,
+                   cSrvGameConfig,
+                   {AbstractModeManager::ModeType::GAME, AbstractModeManager::ModeType::EDITOR});
+    cl.addCommand("trace",
+                   "'trace' records the time spent in the main parts of the client and server frames. The trace is "
+                   "written in the Chrome trace format (that can be opened with chrome://tracing or Perfetto) in the "
+                   "user data directory. A dedicated server records its trace when launched with --trace and writes it when "
+                   "it receives SIGUSR1 (without --trace, the first SIGUSR1 starts recording and the next one writes it).\n\nExample:\n"
+                   "trace start => Starts recording\n"
+                   "trace stop => Stops recording\n"
+                   "trace dump mytrace.json => Writes what was recorded to mytrace.json (trace.json by default)",
+                   cTrace,
+                   Command::cStubServer,
+                   {AbstractModeManager::ModeType::GAME, AbstractModeManager::ModeType::EDITOR});
     cl.addCommand("unlockskills",
                    "Unlock all skills for every seats\n"
                    "unlockskills",
@@ -77,6 +77,9 @@ GameMode::GameMode(ModeManager *modeManager):
     mCurrentSkillType(SkillType::nullSkillType),
     mCurrentSkillProgress(0.0),
     mPreviousMousePosition(MouseMoveEvent{0, 0}),
+    mViewportTileX(-1),
+    mViewportTileY(-1),
+    mViewportRadius(-1),
     directionKeyPressed(false),
     config(ConfigManager::getSingleton())
 {
@@ -1143,6 +1146,7 @@ void GameMode::onFrameStarted(const Ogre::FrameEvent& evt)
         return;
     }
     player->frameStarted(evt.timeSinceLastFrame);
+    refreshCameraViewport();
 
     if((mSkillCurrentCompletion.mProgressBar != nullptr) &&
        (mSkillCurrentCompletion.mCompletenessDisplayed < mSkillCurrentCompletion.mCompleteness))
@@ -1165,6 +1169,29 @@ void GameMode::onFrameEnded(const Ogre::FrameEvent& evt)
 {
 }
 
+void GameMode::refreshCameraViewport()
+{
+    if(!ODClient::getSingleton().isConnected())
+        return;
+
+    // The higher the camera, the more tiles are seen. We add a margin so that tiles entering the
+    // screen are already up to date
+    const int32_t viewportMargin = 3;
+    CameraManager* cameraManager = ODFrameListener::getSingleton().getCameraManager();
+    Ogre::Vector3 target = cameraManager->getCameraViewTarget();
+    int32_t tileX = Helper::round(target.x);
+    int32_t tileY = Helper::round(target.y);
+    int32_t radius = static_cast<int32_t>(cameraManager->getActiveCameraNode()->getPosition().z) + viewportMargin;
+    if((tileX == mViewportTileX) && (tileY == mViewportTileY) && (radius == mViewportRadius))
+        return;
+
+    mViewportTileX = tileX;
+    mViewportTileY = tileY;
+    mViewportRadius = radius;
+    ODClient::getSingleton().queueClientNotification(ClientNotificationType::setCameraViewport,
+        tileX, tileY, radius);
+}
+
 void GameMode::popupExit(bool pause)
 {
     if(pause)
@@ -234,6 +234,15 @@ private:
 
     MouseMoveEvent mPreviousMousePosition;
 
+    //! \brief Last camera viewport sent to the server (in tiles)
+    int32_t mViewportTileX;
+    int32_t mViewportTileY;
+    int32_t mViewportRadius;
+
+    //! \brief Tells the server where the camera is looking at if it moved since the last time. The server
+    //! uses it to prioritize the updates near the camera
+    void refreshCameraViewport();
+
     //! \brief Set the help window (quite long) text.
     void setHelpWindowText();
 
@@ -443,6 +443,11 @@ void MenuModeConfigureSeats::fireSeatConfigurationToServer()
     ODClient::getSingleton().queueClientNotification(notif);
 }
 
+void MenuModeConfigureSeats::setLoadingProgress(float progress)
+{
+    displayLoadingProgress(getModeManager().getGui().getGuiSheet(Gui::guiSheet::configureSeats)->getChild("LoadingText"), progress);
+}
+
 void MenuModeConfigureSeats::activatePlayerConfig()
 {
     mIsActivePlayerConfig = true;
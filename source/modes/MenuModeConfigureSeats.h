@@ -56,6 +56,8 @@ public:
     void activatePlayerConfig();
     void refreshSeatConfiguration(ODPacket& packet);
 
+    void setLoadingProgress(float progress) override;
+
 private:
     bool mIsActivePlayerConfig;
     std::vector<int> mSeatIds;
@@ -281,3 +281,8 @@ bool MenuModeEditorLoad::updateDescription(const CEGUI::EventArgs&)
     descTxt->setText(description);
     return true;
 }
+
+void MenuModeEditorLoad::setLoadingProgress(float progress)
+{
+    displayLoadingProgress(getModeManager().getGui().getGuiSheet(Gui::editorLoadMenu)->getChild(Gui::EDM_TEXT_LOADING), progress);
+}
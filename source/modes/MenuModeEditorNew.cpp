@@ -218,3 +218,8 @@ bool MenuModeEditorNew::launchSelectedButtonPressed(const CEGUI::EventArgs&)
     window->getChild(TEXT_LOADING)->setText("The level was created successfully.");
     return true;
 }
+
+void MenuModeEditorNew::setLoadingProgress(float progress)
+{
+    displayLoadingProgress(getModeManager().getGui().getGuiSheet(Gui::editorNewMenu)->getChild(TEXT_LOADING), progress);
+}
@@ -230,3 +230,8 @@ bool MenuModeLoad::updateDescription(const CEGUI::EventArgs&)
 
     return true;
 }
+
+void MenuModeLoad::setLoadingProgress(float progress)
+{
+    displayLoadingProgress(getModeManager().getGui().getGuiSheet(Gui::loadSavedGameMenu)->getChild("LoadingText"), progress);
+}
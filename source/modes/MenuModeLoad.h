@@ -29,6 +29,8 @@ public:
     //! Used to call the corresponding Gui Sheet.
     void activate() final override;
 
+    void setLoadingProgress(float progress) override;
+
     bool launchSelectedButtonPressed(const CEGUI::EventArgs&);
     bool deleteSelectedButtonPressed(const CEGUI::EventArgs&);
     bool updateDescription(const CEGUI::EventArgs&);
@@ -257,3 +257,8 @@ bool MenuModeReplay::checkReplayValid(const std::string& replayFileName, std::st
 
     return true;
 }
+
+void MenuModeReplay::setLoadingProgress(float progress)
+{
+    displayLoadingProgress(getModeManager().getGui().getGuiSheet(Gui::replayMenu)->getChild(Gui::REM_TEXT_LOADING), progress);
+}
@@ -93,6 +93,8 @@ std::string ClientNotification::typeString(ClientNotificationType type)
             return "editorCreateFighter";
         case ClientNotificationType::editorAskCreateMapLight:
             return "editorAskCreateMapLight";
+        case ClientNotificationType::setCameraViewport:
+            return "setCameraViewport";
         default:
             OD_LOG_ERR("Unknown enum for ClientNotificationType="
                 + Helper::toString(static_cast<int>(type)));
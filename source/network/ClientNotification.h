@@ -62,7 +62,10 @@ enum class ClientNotificationType
     editorAskDestroyTrapTiles,
     editorCreateWorker,
     editorCreateFighter,
-    editorAskCreateMapLight
+    editorAskCreateMapLight,
+
+    // Appended so that the values sent by older clients keep their meaning
+    setCameraViewport
 };
 
 ODPacket& operator<<(ODPacket& os, const ClientNotificationType& nt);
@@ -39,12 +39,14 @@
 #include "network/ServerNotification.h"
 #include "render/ODFrameListener.h"
 #include "render/RenderManager.h"
+#include "render/ResourcePreloader.h"
 #include "sound/MusicPlayer.h"
 #include "sound/SoundEffectsManager.h"
 #include "spells/SpellType.h"
 #include "utils/ConfigManager.h"
 #include "utils/Helper.h"
 #include "utils/LogManager.h"
+#include "utils/Tracing.h"
 #include "ODApplication.h"
 
 #include <boost/lexical_cast.hpp>
@@ -55,7 +57,9 @@ template<> ODClient* Ogre::Singleton<ODClient>::msSingleton = nullptr;
 
 ODClient::ODClient() :
     ODSocketClient(),
-    mIsPlayerConfig(false)
+    mIsPlayerConfig(false),
+    mStartSeatId(-1),
+    mStartServerMode(ServerMode::ModeNone)
 {
 }
 
@@ -80,6 +84,7 @@ bool ODClient::processMessage(ServerNotificationType cmd, ODPacket& packetReceiv
         return false;
 
     OD_LOG_DBG("processMessage type=" + ServerNotification::typeString(cmd));
+    OD_TRACE_SCOPE_DYNAMIC("ODClient::processMessage " + ServerNotification::typeString(cmd));
     switch(cmd)
     {
         case ServerNotificationType::loadLevel:
@@ -337,51 +342,16 @@ bool ODClient::processMessage(ServerNotificationType cmd, ODPacket& packetReceiv
             ServerMode serverMode;
             OD_ASSERT_TRUE(packetReceived >> serverMode);
 
-            // Now that the we have received all needed information, we can launch the requested mode
-            OD_LOG_INF("Starting game map");
-            gameMap->setGamePaused(false);
-            // Create ogre entities for the tiles, rooms, and creatures
-            gameMap->createAllEntities();
-
-            switch(serverMode)
-            {
-                case ServerMode::ModeGameSinglePlayer:
-                case ServerMode::ModeGameMultiPlayer:
-                case ServerMode::ModeGameLoaded:
-                    frameListener->getModeManager()->requestMode(AbstractModeManager::GAME);
-                    break;
-                case ServerMode::ModeEditor:
-                    frameListener->getModeManager()->requestMode(AbstractModeManager::EDITOR);
-                    break;
-                default:
-                    OD_LOG_ERR("Unknown server mode=" + Helper::toString(static_cast<int32_t>(serverMode)));
-            }
-
-            Seat* tempSeat = gameMap->getSeatById(seatId);
-            if(tempSeat == nullptr)
-            {
-                OD_LOG_ERR("seatId=" + Helper::toString(seatId));
-                return true;
-            }
-
-            // We reset the renderer
-            ODFrameListener::getSingleton().initGameRenderer();
-
-            // Move camera to starting position
-            Ogre::Real startX = static_cast<Ogre::Real>(tempSeat->mStartingX);
-            Ogre::Real startY = static_cast<Ogre::Real>(tempSeat->mStartingY);
-            // We make the temple appear in the center of the game view
-            startY = startY - 7.0f;
-            // Bound check
-            if (startY <= 0.0)
-                startY = 0.0;
-
-            frameListener->resetCamera(Ogre::Vector3(startX, startY, MAX_CAMERA_Z));
-            // If we are watching a replay, we force stopping the processing loop to
-            // allow changing mode (because there is no synchronization as there is no server)
-            if(getSource() == ODSource::file)
-                return false;
-            break;
+            // Before starting, we load the meshes and textures needed by the map so that they are not
+            // loaded while playing. The next messages will be processed once everything is loaded (they
+            // expect the game to be started) so we stop the processing loop
+            OD_LOG_INF("Preloading game map resources");
+            mStartSeatId = seatId;
+            mStartServerMode = serverMode;
+            mResourcePreloader.reset(new ResourcePreloader);
+            mResourcePreloader->addGameMapMeshes(*gameMap);
+            mResourcePreloader->start();
+            return false;
         }
 
         case ServerNotificationType::chat:
@@ -656,10 +626,14 @@ bool ODClient::processMessage(ServerNotificationType cmd, ODPacket& packetReceiv
         case ServerNotificationType::playSpatialSound:
         {
             std::string family;
-            int xPos;
-            int yPos;
+            int32_t xPos;
+            int32_t yPos;
             OD_ASSERT_TRUE(packetReceived >> family >> xPos >> yPos);
-            SoundEffectsManager::getSingleton().playSpatialSound(family, xPos, yPos);
+            // Older servers and replays do not send the number of merged sounds
+            uint32_t count = 1;
+            if(!packetReceived.endOfPacket())
+                OD_ASSERT_TRUE(packetReceived >> count);
+            SoundEffectsManager::getSingleton().playSpatialSound(family, xPos, yPos, count);
             break;
         }
 
@@ -1070,6 +1044,72 @@ void ODClient::disconnect(bool keepReplay)
     }
 
     mIsPlayerConfig = false;
+    mResourcePreloader.reset();
+}
+
+bool ODClient::processResourcePreloading(int32_t budgetMs)
+{
+    if(mResourcePreloader == nullptr)
+        return false;
+
+    bool isDone = mResourcePreloader->update(budgetMs);
+    // The game can be started from the seat configuration, saved game, editor or replay menus
+    ODFrameListener* frameListener = ODFrameListener::getSingletonPtr();
+    frameListener->getModeManager()->getCurrentMode()->setLoadingProgress(mResourcePreloader->getProgress());
+
+    if(!isDone)
+        return true;
+
+    mResourcePreloader.reset();
+    finishStartGameMode();
+    return true;
+}
+
+void ODClient::finishStartGameMode()
+{
+    ODFrameListener* frameListener = ODFrameListener::getSingletonPtr();
+    GameMap* gameMap = frameListener->getClientGameMap();
+
+    // Now that the we have received all needed information, we can launch the requested mode
+    OD_LOG_INF("Starting game map");
+    gameMap->setGamePaused(false);
+    // Create ogre entities for the tiles, rooms, and creatures
+    gameMap->createAllEntities();
+
+    switch(mStartServerMode)
+    {
+        case ServerMode::ModeGameSinglePlayer:
+        case ServerMode::ModeGameMultiPlayer:
+        case ServerMode::ModeGameLoaded:
+            frameListener->getModeManager()->requestMode(AbstractModeManager::GAME);
+            break;
+        case ServerMode::ModeEditor:
+            frameListener->getModeManager()->requestMode(AbstractModeManager::EDITOR);
+            break;
+        default:
+            OD_LOG_ERR("Unknown server mode=" + Helper::toString(static_cast<int32_t>(mStartServerMode)));
+    }
+
+    Seat* tempSeat = gameMap->getSeatById(mStartSeatId);
+    if(tempSeat == nullptr)
+    {
+        OD_LOG_ERR("seatId=" + Helper::toString(mStartSeatId));
+        return;
+    }
+
+    // We reset the renderer
+    ODFrameListener::getSingleton().initGameRenderer();
+
+    // Move camera to starting position
+    Ogre::Real startX = static_cast<Ogre::Real>(tempSeat->mStartingX);
+    Ogre::Real startY = static_cast<Ogre::Real>(tempSeat->mStartingY);
+    // We make the temple appear in the center of the game view
+    startY = startY - 7.0f;
+    // Bound check
+    if (startY <= 0.0)
+        startY = 0.0;
+
+    frameListener->resetCamera(Ogre::Vector3(startX, startY, MAX_CAMERA_Z));
 }
 
 void ODClient::notifyExit()
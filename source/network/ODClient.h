@@ -24,11 +24,15 @@
 #include <OgreSingleton.h>
 
 #include <deque>
+#include <memory>
 
 class GameMap;
 class ODPacket;
 class ChatMessage;
 class EventMessage;
+class ResourcePreloader;
+
+enum class ServerMode;
 
 class ODClient: public Ogre::Singleton<ODClient>,
     public ODSocketClient
@@ -85,6 +89,12 @@ class ODClient: public Ogre::Singleton<ODClient>,
     inline bool getIsPlayerConfig() const
     { return mIsPlayerConfig; }
 
+    //! \brief Loads the resources needed by the game map after the server asked to start the game during
+    //! at most budgetMs milliseconds. The game starts when everything is loaded. Returns true if resources
+    //! were being loaded. In this case, the server messages should not be processed during this frame
+    //! because they expect the game to be started
+    bool processResourcePreloading(int32_t budgetMs);
+
  protected:
     bool processMessage(ServerNotificationType cmd, ODPacket& packetReceived) override;
     void playerDisconnected() override;
@@ -96,6 +106,9 @@ class ODClient: public Ogre::Singleton<ODClient>,
     //! \brief Refreshes the player's goals + main data
     void refreshMainUI(const std::string& goalsString);
 
+    //! \brief Creates the entities and launches the game (or editor) mode once the resources are loaded
+    void finishStartGameMode();
+
     std::string mTmpReceivedString;
     std::string mLevelFilename;
 
@@ -104,6 +117,12 @@ class ODClient: public Ogre::Singleton<ODClient>,
     // true if the server told us we are allowed to configure the game. False otherwise
     bool mIsPlayerConfig;
 
+    //! \brief Loads the resources while the game is starting. nullptr otherwise
+    std::unique_ptr<ResourcePreloader> mResourcePreloader;
+    //! \brief Seat and mode received with startGameMode, used when the resources are loaded
+    int32_t mStartSeatId;
+    ServerMode mStartServerMode;
+
 };
 
 template<typename ...Args>
@@ -243,6 +243,21 @@ void ODPacket::clear()
     mPacket.clear();
 }
 
+uint32_t ODPacket::getDataSize() const
+{
+    return static_cast<uint32_t>(mPacket.getDataSize());
+}
+
+bool ODPacket::endOfPacket() const
+{
+    return mPacket.endOfPacket();
+}
+
+void ODPacket::append(const ODPacket& packet)
+{
+    mPacket.append(packet.mPacket.getData(), packet.mPacket.getDataSize());
+}
+
 void ODPacket::writePacket(int32_t timestamp, std::ofstream& os)
 {
     int32_t bufferSize = mPacket.getDataSize();
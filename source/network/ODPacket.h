@@ -125,6 +125,16 @@ class ODPacket
          */
         void clear();
 
+        //! \brief Returns the size of the data in the packet (in bytes)
+        uint32_t getDataSize() const;
+
+        //! \brief Returns true if all the data has been exported. Can be used to read optional
+        //! trailing fields sent by newer versions
+        bool endOfPacket() const;
+
+        //! \brief Appends the content of the given packet at the end of this one
+        void append(const ODPacket& packet);
+
         /*! \brief Writes the packet content to the given ofstream.
          */
         void writePacket(int32_t timestamp, std::ofstream& os);
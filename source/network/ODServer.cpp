@@ -35,6 +35,7 @@
 #include "network/ODClient.h"
 #include "network/ServerMode.h"
 #include "network/ServerNotification.h"
+#include "network/TurnScheduler.h"
 #include "rooms/RoomManager.h"
 #include "rooms/RoomType.h"
 #include "spells/SpellManager.h"
@@ -46,7 +47,10 @@
 #include "utils/Helper.h"
 #include "utils/LogManager.h"
 #include "utils/MasterServer.h"
+#include "utils/Metrics.h"
+#include "utils/MetricsExporter.h"
 #include "utils/ResourceManager.h"
+#include "utils/Tracing.h"
 #include "ODApplication.h"
 
 #include <SFML/Network.hpp>
@@ -57,6 +61,8 @@
 #include <boost/filesystem.hpp>
 #include <boost/lexical_cast.hpp>
 
+#include <algorithm>
+#include <cmath>
 
 const std::string SAVEGAME_SKIRMISH_PREFIX = "SK-";
 const std::string SAVEGAME_MULTIPLAYER_PREFIX = "MP-";
@@ -64,6 +70,18 @@ static const double MASTER_SERVER_UPDATE_PERIOD_MS = 30000.0;
 static const int32_t MASTER_SERVER_STATUS_PENDING = 0;
 static const int32_t MASTER_SERVER_STATUS_STARTED = 1;
 static const int32_t MASTER_SERVER_STATUS_FINISHED = 2;
+//! \brief Number of late turns the server will run back to back to catch up. If it is later
+//! than that, the older turns are dropped
+static const uint32_t MAX_CATCH_UP_TURNS = 5;
+
+//! \brief Ratio between the time simulated by a server turn and the turn length. It keeps the
+//! server slightly behind the clients (see serverThread)
+static const double SERVER_TURN_TIME_RATIO = 0.95;
+
+static double getTimeMs(const sf::Clock& clock)
+{
+    return static_cast<double>(clock.getElapsedTime().asMicroseconds()) / 1000.0;
+}
 
 template<> ODServer* Ogre::Singleton<ODServer>::msSingleton = nullptr;
 
@@ -75,7 +93,8 @@ ODServer::ODServer() :
     mSeatsConfigured(false),
     mPlayerConfig(nullptr),
     mConsoleInterface(std::bind(&ODServer::printConsoleMsg, this, std::placeholders::_1)),
-    mMasterServerGameStatusUpdateTime(0)
+    mMasterServerGameStatusUpdateTime(0),
+    mTurnLeadWindow(0)
 {
     ConsoleCommands::addConsoleCommands(mConsoleInterface);
 }
@@ -134,6 +153,22 @@ bool ODServer::startServer(const std::string& creator, const std::string& levelF
         return false;
     }
 
+    // The dedicated server can force its turn rate
+    ResourceManager& resMgr = ResourceManager::getSingleton();
+    if(resMgr.isServerMode() && (resMgr.getServerTurnsPerSecond() > 0.0))
+        ODApplication::turnsPerSecond = resMgr.getServerTurnsPerSecond();
+
+    mTurnLeadWindow = resMgr.getTurnLeadWindow();
+
+    // Metrics are also exported when a client hosts the game so that client side histograms
+    // (like the animation update time) can be compared on the same level
+    if(!resMgr.getMetricsFile().empty() || (resMgr.getMetricsPort() != 0))
+    {
+        uint32_t fileExportPeriod = static_cast<uint32_t>(ODApplication::turnsPerSecond);
+        mMetricsExporter.reset(new MetricsExporter(resMgr.getMetricsFile(), resMgr.getMetricsPort(),
+            resMgr.getMetricsAddress(), fileExportPeriod));
+    }
+
     // We configure what is fixed (fixed AI, faction or team). While iterating seats, we keep in mind if there is
     // at least a human only seat. If yes, we configure all player type choosable to AI. If not, we configure all player
     // type choosable to AI except the first one.
@@ -301,18 +336,52 @@ void ODServer::handleConsoleCommand(Player* player, GameMap* gameMap, const std:
     ODServer::getSingleton().queueServerNotification(serverNotification);
 }
 
-void ODServer::startNewTurn(double timeSinceLastTurn)
+int64_t ODServer::getClientTurnLag(ODSocketClient* client) const
 {
+    return mGameMap->getTurnNumber() - client->getLastTurnAck();
+}
+
+bool ODServer::startNewTurn(double timeSinceLastTurn)
+{
+    OD_TRACE_SCOPE("ODServer::startNewTurn");
     GameMap* gameMap = mGameMap;
     int64_t turn = gameMap->getTurnNumber();
 
-    // We wait until every client acknowledge the turn to start the next one. This way, we ensure
-    // synchronisation is not too bad
+    // In lockstep mode (no lead window), we wait until every client acknowledged the current turn to start
+    // the next one. Otherwise, the server does not wait for slow clients. A client lagging more than
+    // mTurnLeadWindow turns is skipped: it gets no state refresh until it is back within the window
+    if(mTurnLeadWindow == 0)
+    {
+        for (ODSocketClient* client : mSockClients)
+        {
+            if(getClientTurnLag(client) > 0)
+                return false;
+        }
+    }
+
+    static Metrics::Counter& laggingClientTurns = Metrics::getCounter("od_server_lagging_client_turns",
+        "Turns started while at least one client had not acknowledged the previous one");
+    bool hasLaggingClient = false;
     for (ODSocketClient* client : mSockClients)
     {
-        if(client->getLastTurnAck() != turn)
-            return;
+        int64_t lag = getClientTurnLag(client);
+        hasLaggingClient = hasLaggingClient || (lag > 0);
+        bool isBeyondLeadWindow = (mTurnLeadWindow > 0) && (lag > static_cast<int64_t>(mTurnLeadWindow));
+        if(isBeyondLeadWindow == client->isBeyondLeadWindow())
+            continue;
+
+        client->setBeyondLeadWindow(isBeyondLeadWindow);
+        std::string nick = (client->getPlayer() != nullptr) ? client->getPlayer()->getNick() : std::string("unknown");
+        if(isBeyondLeadWindow)
+        {
+            OD_LOG_WRN("Client " + nick + " is more than " + Helper::toString(mTurnLeadWindow) + " turns late, lastTurnAck="
+                + Helper::toString(client->getLastTurnAck()) + ", turn=" + Helper::toString(turn) + ". Skipping it until it catches up");
+        }
+        else
+            OD_LOG_INF("Client " + nick + " is back within the turn lead window");
     }
+    if(hasLaggingClient)
+        laggingClientTurns.increment();
 
     gameMap->setTurnNumber(++turn);
 
@@ -324,11 +393,26 @@ void ODServer::startNewTurn(double timeSinceLastTurn)
     if(mServerMode == ServerMode::ModeEditor)
         gameMap->updateVisibleEntities();
 
-    gameMap->updateAnimations(timeSinceLastTurn);
+    {
+        OD_TRACE_SCOPE("GameMap::updateAnimations");
+        gameMap->updateAnimations(timeSinceLastTurn);
+    }
 
-    // We notify the clients about what they got
+    // We notify the clients about what they got. These notifications only carry the latest state. Clients
+    // lagging behind would only process outdated ones so we skip them until the client catches up. We still
+    // refresh them once per lead window as long as they stay within it
     for (ODSocketClient* sock : mSockClients)
     {
+        if(sock->isBeyondLeadWindow())
+            continue;
+
+        if((getClientTurnLag(sock) > 1) &&
+           (turn - sock->getLastStateRefreshTurn() <= static_cast<int64_t>(mTurnLeadWindow)))
+        {
+            continue;
+        }
+
+        sock->setLastStateRefreshTurn(turn);
         Player* player = sock->getPlayer();
         // For now, only the player whose seat changed is notified. If we need it, we could send the event to every player
         // so that they can see how far from the goals the other players are
@@ -364,15 +448,24 @@ void ODServer::startNewTurn(double timeSinceLastTurn)
         }
     }
 
-    gameMap->updateVisibleEntities();
+    {
+        OD_TRACE_SCOPE("GameMap::updateVisibleEntities");
+        gameMap->updateVisibleEntities();
+    }
     switch(mServerMode)
     {
         case ServerMode::ModeGameSinglePlayer:
         case ServerMode::ModeGameMultiPlayer:
         case ServerMode::ModeGameLoaded:
         {
-            gameMap->doTurn(timeSinceLastTurn);
-            gameMap->doPlayerAITurn(timeSinceLastTurn);
+            {
+                OD_TRACE_SCOPE("GameMap::doTurn");
+                gameMap->doTurn(timeSinceLastTurn);
+            }
+            {
+                OD_TRACE_SCOPE("GameMap::doPlayerAITurn");
+                gameMap->doPlayerAITurn(timeSinceLastTurn);
+            }
             break;
         }
         case ServerMode::ModeEditor:
@@ -386,21 +479,44 @@ void ODServer::startNewTurn(double timeSinceLastTurn)
             break;
     }
 
+    OD_TRACE_SCOPE("GameMap::refreshEntities");
     gameMap->fireRefreshEntities();
     gameMap->processDeletionQueues();
+    return true;
 }
 
 void ODServer::serverThread()
 {
+    Tracing::setThreadName("Server");
     GameMap* gameMap = mGameMap;
     sf::Clock clock;
-    double turnLengthMs = 1000.0 / ODApplication::turnsPerSecond;
+    TurnScheduler scheduler(ODApplication::turnsPerSecond, MAX_CATCH_UP_TURNS);
+    scheduler.setMaxSpeed(ResourceManager::getSingleton().isServerMode()
+        && ResourceManager::getSingleton().getServerMaxSpeed());
+    double turnLengthMs = scheduler.getTurnLengthMs();
+    // When the server started waiting for a client to acknowledge a turn (negative if not waiting)
+    double stallStartMs = -1.0;
     bool isClientConnected = true;
     while(isConnected() && isClientConnected)
     {
-        // doTask should return after the length of 1 turn even if their are communications. When
-        // it returns, we can launch next turn.
-        doTask(static_cast<int32_t>(turnLengthMs));
+        // doTask should return when the next turn is due even if their are communications. When
+        // it returns, we can launch next turn. Note that doTask waits forever if called with 0
+        {
+            OD_TRACE_SCOPE("ODServer::doTask");
+            if(stallStartMs >= 0.0)
+            {
+                // The turn is overdue but a client did not acknowledge the previous one. We block until
+                // a client message arrives (or for one turn at most) and try again to start the turn
+                doTask(std::max(1, static_cast<int32_t>(std::ceil(turnLengthMs))), true);
+            }
+            else
+            {
+                double waitMs = turnLengthMs;
+                if(gameMap->getTurnNumber() != -1)
+                    waitMs = scheduler.getTimeBeforeNextTurnMs(getTimeMs(clock));
+                doTask(std::max(1, static_cast<int32_t>(std::ceil(waitMs))));
+            }
+        }
         // If all the clients are disconnected during a game, we close the server
         if((mServerState == ServerState::StateGame) &&
            (mSockClients.empty()))
@@ -485,6 +601,8 @@ void ODServer::serverThread()
                     if(seat->getGold() > 0)
                         gameMap->addGoldToSeat(seat->getGold(), seat->getId());
                 }
+
+                scheduler.reset(getTimeMs(clock));
             }
             else
             {
@@ -502,17 +620,81 @@ void ODServer::serverThread()
             }
         }
 
-        // After starting a new turn, we should process server notifications
-        // before processing client messages. Otherwise, we could have weird issues
-        // like allow picking up a dead creature for example.
-        // We make sure the server time is a little bit late regarding the clients to
-        // make sure server is not more advanced than clients. We do that because it is better for clients
-        // to wait for server. If server is in advance, he might send commands before the
-        // creatures arrive at their destination. That could result in weird issues like
-        // creatures going through walls.
-        startNewTurn(static_cast<double>(clock.restart().asSeconds()) * 0.95);
+        static Metrics::Histogram& turnTime = Metrics::getTimerHistogram("od_server_turn_ms",
+            "Time spent computing a turn and sending its notifications (ms)");
+        static Metrics::Histogram& turnLag = Metrics::getTimerHistogram("od_server_turn_lag_ms",
+            "How late the turns started compared to the fixed turn rate (ms)");
+        static Metrics::Counter& catchUpTurns = Metrics::getCounter("od_server_catch_up_turns",
+            "Turns run back to back to catch up with the turn rate");
+        static Metrics::Counter& droppedTurns = Metrics::getCounter("od_server_dropped_turns",
+            "Late turns dropped because the server could not catch up");
+        static Metrics::Histogram& ackStall = Metrics::getTimerHistogram("od_server_ack_stall_ms",
+            "Time the server waited for a client to acknowledge a turn in lockstep mode (ms)");
+
+        uint64_t nbTurnsDropped = scheduler.getNbTurnsDropped();
+        uint32_t nbTurnsDue = scheduler.getNbTurnsDue(getTimeMs(clock));
+        if(scheduler.getNbTurnsDropped() != nbTurnsDropped)
+        {
+            uint64_t nbDropped = scheduler.getNbTurnsDropped() - nbTurnsDropped;
+            droppedTurns.increment(nbDropped);
+            OD_LOG_WRN("Server too late, dropping " + Helper::toString(nbDropped) + " turns");
+        }
 
-        processServerNotifications();
+        // Each turn simulates the same amount of time whatever the time it took to compute the previous
+        // one. If we are late, we run the missed turns back to back. Note that in lockstep mode, a turn
+        // cannot start before every client acknowledged the previous one. In that case, we will try again
+        // after having processed the client messages.
+        for(uint32_t i = 0; i < nbTurnsDue; ++i)
+        {
+            double lagMs = scheduler.getLagMs(getTimeMs(clock));
+
+            // After starting a new turn, we should process server notifications
+            // before processing client messages. Otherwise, we could have weird issues
+            // like allow picking up a dead creature for example.
+            // We make sure the server time is a little bit late regarding the clients to
+            // make sure server is not more advanced than clients. We do that because it is better for clients
+            // to wait for server. If server is in advance, he might send commands before the
+            // creatures arrive at their destination. That could result in weird issues like
+            // creatures going through walls. That is why the time simulated by each turn is slightly
+            // shorter than the turn length. Note that turns are still started at the configured rate.
+            // If no turn could be started, nothing is timed or sent. The notifications queued meanwhile
+            // are sent with the next turn
+            double turnStartMs = getTimeMs(clock);
+            bool isTurnStarted;
+            {
+                OD_TRACE_SCOPE("ODServer::turn");
+
+                isTurnStarted = startNewTurn(scheduler.getTurnLengthSeconds() * SERVER_TURN_TIME_RATIO);
+                if(isTurnStarted)
+                    processServerNotifications();
+            }
+
+            if(!isTurnStarted)
+            {
+                if(stallStartMs < 0.0)
+                    stallStartMs = getTimeMs(clock);
+                break;
+            }
+
+            if(stallStartMs >= 0.0)
+            {
+                ackStall.observe(getTimeMs(clock) - stallStartMs);
+                stallStartMs = -1.0;
+            }
+
+            double turnEndMs = getTimeMs(clock);
+            turnTime.observe(turnEndMs - turnStartMs);
+            scheduler.turnStarted(turnEndMs);
+            turnLag.observe(lagMs);
+            if(i > 0)
+                catchUpTurns.increment();
+
+            Metrics::endTurn();
+            if(mMetricsExporter != nullptr)
+                mMetricsExporter->update();
+
+            Tracing::dumpIfRequested();
+        }
     }
 
     if(!mMasterServerGameId.empty())
@@ -524,8 +706,18 @@ void ODServer::serverThread()
 
 void ODServer::processServerNotifications()
 {
+    static Metrics::Histogram& processTime = Metrics::getTimerHistogram("od_server_process_notifications_ms",
+        "Time spent in ODServer::processServerNotifications (ms)");
+    static Metrics::Counter& nbNotifications = Metrics::getCounter("od_server_notifications",
+        "Server notifications processed");
+    Metrics::ScopedTimer timer(processTime);
+    OD_TRACE_SCOPE("ODServer::processServerNotifications");
+
     GameMap* gameMap = mGameMap;
 
+    // The spatial sounds fired during the turn are merged before being sent
+    gameMap->flushSpatialSounds();
+
     bool running = true;
 
     while (running)
@@ -544,6 +736,7 @@ void ODServer::processServerNotifications()
             continue;
         }
 
+        nbNotifications.increment();
         OD_LOG_DBG("processServerNotifications type=" + ServerNotification::typeString(event->mType));
         switch (event->mType)
         {
@@ -1436,6 +1629,20 @@ bool ODServer::processClientNotifications(ODSocketClient* clientSocket)
             break;
         }
 
+        case ClientNotificationType::setCameraViewport:
+        {
+            int32_t tileX;
+            int32_t tileY;
+            int32_t radius;
+            OD_ASSERT_TRUE(packetReceived >> tileX >> tileY >> radius);
+            Player* player = clientSocket->getPlayer();
+            if((player == nullptr) || (player->getSeat() == nullptr))
+                break;
+
+            player->getSeat()->getInterest().setViewport(tileX, tileY, radius);
+            break;
+        }
+
         case ClientNotificationType::askSaveMap:
         {
             Player* player = clientSocket->getPlayer();
@@ -1910,6 +2117,7 @@ void ODServer::stopServer()
     mSeatsConfigured = false;
     mDisconnectedPlayers.clear();
     mPlayerConfig = nullptr;
+    mMetricsExporter.reset();
 
     // Now that the server is stopped, we can remove all pending messages
     while(!mServerNotificationQueue.empty())
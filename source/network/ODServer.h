@@ -23,8 +23,11 @@
 
 #include <OgreSingleton.h>
 
+#include <memory>
+
 class ServerNotification;
 class GameMap;
+class MetricsExporter;
 
 enum class ServerMode;
 
@@ -119,13 +122,25 @@ private:
     std::string mMasterServerGameId;
     double mMasterServerGameStatusUpdateTime;
 
+    //! \brief Number of turns a client can lag behind the server before it is skipped. With 0, the server
+    //! waits for every client to acknowledge a turn before starting the next one
+    uint32_t mTurnLeadWindow;
+
+    //! \brief Exports the performance metrics. Only created when --metricsfile or --metricsport is given
+    //! (dedicated server or client hosting the game)
+    std::unique_ptr<MetricsExporter> mMetricsExporter;
+
     void printConsoleMsg(const std::string& text);
 
     ODSocketClient* getClientFromPlayer(Player* player);
     ODSocketClient* getClientFromPlayerId(int32_t playerId);
 
-    //! \brief Called when a new turn started.
-    void startNewTurn(double timeSinceLastTurn);
+    //! \brief Returns how many turns the given client is late compared to the server
+    int64_t getClientTurnLag(ODSocketClient* client) const;
+
+    //! \brief Called when a new turn should start. Returns false if the turn could not be started
+    //! because a client did not acknowledge the previous one yet
+    bool startNewTurn(double timeSinceLastTurn);
 
     /*! \brief Monitors mServerNotificationQueue for new events and informs the clients about them.
      *
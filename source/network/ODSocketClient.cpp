@@ -21,10 +21,17 @@
 
 #include "utils/Helper.h"
 #include "utils/LogManager.h"
+#include "utils/Metrics.h"
 
 #include <boost/date_time/posix_time/posix_time.hpp>
 #include <boost/filesystem.hpp>
 
+namespace
+{
+    //! \brief How long the receive thread waits for data before checking if it should stop
+    const int32_t RECEIVE_WAIT_MS = 50;
+}
+
 bool ODSocketClient::connect(const std::string& host, const int port, uint32_t timeout, const std::string& outputReplayFilename)
 {
     mSource = ODSource::none;
@@ -46,6 +53,11 @@ bool ODSocketClient::connect(const std::string& host, const int port, uint32_t t
     mReplayOutputStream.open(mOutputReplayFilename, std::ios::out | std::ios::binary);
     mGameClock.restart();
     mSource = ODSource::network;
+
+    mHasReceiveError = false;
+    mIsReceiving = true;
+    mReceiveThread.reset(new sf::Thread(&ODSocketClient::receiveThread, this));
+    mReceiveThread->launch();
     return true;
 }
 
@@ -72,6 +84,9 @@ void ODSocketClient::disconnect(bool keepReplay)
         }
         case ODSource::network:
         {
+            // The receive thread uses the socket and the replay stream
+            stopReceiveThread();
+
             // Remove any remaining client sockets from the socket selector,
             // if there is any left.
             mSockSelector.clear();
@@ -105,11 +120,9 @@ bool ODSocketClient::isDataAvailable()
         }
         case ODSource::network:
         {
-            // There is only 1 socket in the selector so it should be ready if
-            // wait returns true but it doesn't hurt to return isReady...
-            if(!mSockSelector.wait(sf::milliseconds(5)))
-                return false;
-            return mSockSelector.isReady(mSockClient);
+            // The socket is read by the receive thread
+            sf::Lock lock(mReceivedMessagesLock);
+            return !mReceivedMessages.empty();
         }
         case ODSource::file:
         {
@@ -201,16 +214,53 @@ bool ODSocketClient::isConnected()
     return mSource != ODSource::none;
 }
 
-void ODSocketClient::processClientSocketMessages()
+void ODSocketClient::processClientSocketMessages(int32_t budgetMs)
 {
+    static Metrics::Histogram& applyTime = Metrics::getTimerHistogram("od_client_message_apply_ms",
+        "Time spent per frame applying the messages received from the server");
+    static Metrics::Counter& deferredFrames = Metrics::getCounter("od_client_deferred_message_frames",
+        "Frames where some received messages were left for the next frame to respect the time budget");
+    Metrics::ScopedTimer timer(applyTime);
+
     // If we receive message for a new turn, after processing every message,
     // we will refresh what is needed
-    // We loop until no more data is available
-    while(isConnected() && processOneClientSocketMessage());
+    // We loop until no more data is available or the budget is spent. We always process at
+    // least one message so that we keep up with the server even if messages are slow to apply
+    sf::Clock clock;
+    bool isFirstMessage = true;
+    while(isConnected())
+    {
+        if(!isFirstMessage && (budgetMs >= 0) && (clock.getElapsedTime().asMilliseconds() >= budgetMs))
+        {
+            if(isDataAvailable())
+                deferredFrames.increment();
+            break;
+        }
+
+        if(!processOneClientSocketMessage())
+            break;
+
+        isFirstMessage = false;
+    }
 }
 
 bool ODSocketClient::processOneClientSocketMessage()
 {
+    if(mSource == ODSource::network)
+    {
+        ReceivedMessage message;
+        if(!popReceivedMessage(message))
+        {
+            // We only notify once when the connection is lost
+            if(mHasReceiveError.exchange(false))
+                playerDisconnected();
+
+            return false;
+        }
+
+        return processMessage(message.mType, message.mPacket);
+    }
+
     if(!isDataAvailable())
         return false;
 
@@ -229,3 +279,66 @@ bool ODSocketClient::processOneClientSocketMessage()
 
     return processMessage(serverCommand, packetReceived);
 }
+
+bool ODSocketClient::popReceivedMessage(ReceivedMessage& message)
+{
+    sf::Lock lock(mReceivedMessagesLock);
+    if(mReceivedMessages.empty())
+        return false;
+
+    message = mReceivedMessages.front();
+    mReceivedMessages.pop_front();
+    return true;
+}
+
+void ODSocketClient::receiveThread()
+{
+    static Metrics::Counter& receivedBytes = Metrics::getCounter("od_client_received_bytes",
+        "Bytes received from the server");
+    while(mIsReceiving)
+    {
+        // There is only 1 socket in the selector so it should be ready if
+        // wait returns true but it doesn't hurt to check isReady...
+        if(!mSockSelector.wait(sf::milliseconds(RECEIVE_WAIT_MS)) || !mSockSelector.isReady(mSockClient))
+            continue;
+
+        ReceivedMessage message;
+        sf::Socket::Status status = mSockClient.receive(message.mPacket.mPacket);
+        if(status != sf::Socket::Done)
+        {
+            if(status == sf::Socket::Disconnected)
+                OD_LOG_WRN("Socket disconnected");
+            else
+                OD_LOG_ERR("Could not receive data from server status=" + Helper::toString(status));
+
+            mHasReceiveError = true;
+            return;
+        }
+
+        receivedBytes.increment(message.mPacket.mPacket.getDataSize());
+        message.mPacket.writePacket(mGameClock.getElapsedTime().asMilliseconds(),
+            mReplayOutputStream);
+
+        if(!(message.mPacket >> message.mType))
+        {
+            OD_LOG_ERR("Could not read the type of a message from server");
+            continue;
+        }
+
+        sf::Lock lock(mReceivedMessagesLock);
+        mReceivedMessages.push_back(message);
+    }
+}
+
+void ODSocketClient::stopReceiveThread()
+{
+    if(mReceiveThread == nullptr)
+        return;
+
+    mIsReceiving = false;
+    mReceiveThread->wait();
+    mReceiveThread.reset();
+
+    sf::Lock lock(mReceivedMessagesLock);
+    mReceivedMessages.clear();
+}
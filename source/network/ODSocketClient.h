@@ -21,7 +21,11 @@
 #include "network/ODPacket.h"
 
 #include <SFML/Network.hpp>
+#include <SFML/System.hpp>
 
+#include <atomic>
+#include <deque>
+#include <memory>
 #include <string>
 #include <cstdint>
 #include <fstream>
@@ -49,11 +53,15 @@ class ODSocketClient
             mSource(ODSource::none),
             mPlayer(nullptr),
             mLastTurnAck(-1),
-            mPendingTimestamp(-1)
+            mLastStateRefreshTurn(-1),
+            mIsBeyondLeadWindow(false),
+            mPendingTimestamp(-1),
+            mIsReceiving(false),
+            mHasReceiveError(false)
         {}
 
         virtual ~ODSocketClient()
-        {}
+        { stopReceiveThread(); }
 
         // Client initialization
         bool isConnected();
@@ -61,14 +69,23 @@ class ODSocketClient
         //! \brief Disconnect the client and tell whether to keep the replay file.
         virtual void disconnect(bool keepReplay = false);
 
-        /*! \brief This function should be called periodically. It will
+        /*! \brief This function should be called periodically. It processes the messages
+         * received from the server. If budgetMs is >= 0, it stops once budgetMs milliseconds
+         * have been spent (after at least one message) and the remaining messages are processed
+         * during the next call.
          */
-        void processClientSocketMessages();
+        void processClientSocketMessages(int32_t budgetMs = -1);
 
         Player* getPlayer() { return mPlayer; }
         void setPlayer(Player* player) { mPlayer = player; }
         int64_t getLastTurnAck() { return mLastTurnAck; }
         void setLastTurnAck(int64_t lastTurnAck) { mLastTurnAck = lastTurnAck; }
+        //! \brief Last turn the server sent the state refreshes (seat, creature infos, ...) to this client
+        int64_t getLastStateRefreshTurn() { return mLastStateRefreshTurn; }
+        void setLastStateRefreshTurn(int64_t turn) { mLastStateRefreshTurn = turn; }
+        //! \brief Whether this client lags more turns than the server turn lead window allows
+        bool isBeyondLeadWindow() { return mIsBeyondLeadWindow; }
+        void setBeyondLeadWindow(bool isBeyondLeadWindow) { mIsBeyondLeadWindow = isBeyondLeadWindow; }
         const std::string& getState() {return mState;}
         bool isDataAvailable();
         int32_t getGameTimeMillis()
@@ -109,13 +126,28 @@ class ODSocketClient
         {}
 
     private :
+        //! \brief A message received by the receive thread with its type already read
+        struct ReceivedMessage
+        {
+            ServerNotificationType mType;
+            ODPacket mPacket;
+        };
+
         bool processOneClientSocketMessage();
 
+        //! \brief When connected to a server, receives the messages, writes them to the replay
+        //! and queues them for the main thread so that it never waits for the network
+        void receiveThread();
+        void stopReceiveThread();
+        bool popReceivedMessage(ReceivedMessage& message);
+
         ODSource mSource;
         sf::SocketSelector mSockSelector;
         sf::TcpSocket mSockClient;
         Player* mPlayer;
         int64_t mLastTurnAck;
+        int64_t mLastStateRefreshTurn;
+        bool mIsBeyondLeadWindow;
         std::string mState;
 
         sf::Clock mGameClock;
@@ -124,6 +156,13 @@ class ODSocketClient
         ODPacket mPendingPacket;
         int32_t mPendingTimestamp;
 
+        std::unique_ptr<sf::Thread> mReceiveThread;
+        std::atomic<bool> mIsReceiving;
+        //! \brief Set by the receive thread when the connection is lost
+        std::atomic<bool> mHasReceiveError;
+        sf::Mutex mReceivedMessagesLock;
+        std::deque<ReceivedMessage> mReceivedMessages;
+
         //! \brief the replay filename being written. Used to later optionally delete it
         //! if asked to.
         std::string mOutputReplayFilename;
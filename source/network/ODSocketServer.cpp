@@ -63,7 +63,7 @@ bool ODSocketServer::isConnected()
     return mIsConnected;
 }
 
-void ODSocketServer::doTask(int timeoutMs)
+void ODSocketServer::doTask(int timeoutMs, bool returnOnClientMessage)
 {
     mClockMainTask.restart();
     while((timeoutMs == 0) ||
@@ -120,6 +120,9 @@ void ODSocketServer::doTask(int timeoutMs)
                     ++it;
                 }
             }
+
+            if(returnOnClientMessage)
+                return;
         }
     }
 }
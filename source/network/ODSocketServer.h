@@ -60,8 +60,9 @@ class ODSocketServer
          * a message. If so, calls notifyClientMessage with the client socket.
          * If timeoutMs = 0, this function will never return. Otherwise, it will always return after
          * timeoutMs milliseconds, even if new clients connected or clients are sending messages.
+         * If returnOnClientMessage is true, it also returns as soon as client messages have been processed.
          */
-        void doTask(int timeoutMs);
+        void doTask(int timeoutMs, bool returnOnClientMessage = false);
         std::vector<ODSocketClient*> mSockClients;
         virtual void serverThread() = 0;
         sf::Thread* mThread;
@@ -0,0 +1,83 @@
+/*
+ *  Copyright (C) 2011-2016  OpenDungeons Team
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "network/TurnScheduler.h"
+
+#include <algorithm>
+#include <cmath>
+
+TurnScheduler::TurnScheduler(double turnsPerSecond, uint32_t maxCatchUpTurns) :
+    mTurnLengthMs(1000.0 / turnsPerSecond),
+    mMaxCatchUpTurns(maxCatchUpTurns),
+    mIsMaxSpeed(false),
+    mNextTurnMs(0.0),
+    mNbTurnsDropped(0)
+{
+}
+
+void TurnScheduler::reset(double nowMs)
+{
+    mNextTurnMs = nowMs;
+}
+
+double TurnScheduler::getTimeBeforeNextTurnMs(double nowMs) const
+{
+    if(mIsMaxSpeed)
+        return 0.0;
+
+    return std::max(mNextTurnMs - nowMs, 0.0);
+}
+
+uint32_t TurnScheduler::getNbTurnsDue(double nowMs)
+{
+    if(mIsMaxSpeed)
+        return 1;
+
+    if(nowMs < mNextTurnMs)
+        return 0;
+
+    // The turn scheduled at mNextTurnMs is due. We add the ones that should have started since
+    uint64_t nbTurns = 1 + static_cast<uint64_t>(std::floor((nowMs - mNextTurnMs) / mTurnLengthMs));
+    uint64_t maxTurns = static_cast<uint64_t>(mMaxCatchUpTurns) + 1;
+    if(nbTurns <= maxTurns)
+        return static_cast<uint32_t>(nbTurns);
+
+    // We are too late. We forget the oldest turns
+    uint64_t nbDropped = nbTurns - maxTurns;
+    mNbTurnsDropped += nbDropped;
+    mNextTurnMs += static_cast<double>(nbDropped) * mTurnLengthMs;
+    return static_cast<uint32_t>(maxTurns);
+}
+
+void TurnScheduler::turnStarted(double nowMs)
+{
+    if(mIsMaxSpeed)
+    {
+        mNextTurnMs = nowMs;
+        return;
+    }
+
+    mNextTurnMs += mTurnLengthMs;
+}
+
+double TurnScheduler::getLagMs(double nowMs) const
+{
+    if(mIsMaxSpeed)
+        return 0.0;
+
+    return std::max(nowMs - mNextTurnMs, 0.0);
+}
@@ -0,0 +1,82 @@
+/*
+ *  Copyright (C) 2011-2016  OpenDungeons Team
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TURNSCHEDULER_H
+#define TURNSCHEDULER_H
+
+#include <cstdint>
+
+//! \brief Decides when the server should start its turns. Turns are scheduled at a fixed rate
+//! independently of how long computing them takes: if the server falls behind (slow turn, clients
+//! acknowledging late, ...), the missed turns are run back to back until it caught up. To avoid
+//! running a long burst of turns after a stall, at most maxCatchUpTurns late turns are kept and
+//! the older ones are dropped.
+//! In max speed mode, turns are started as soon as possible. That is meant for AI only games and
+//! tests where nobody watches the game in real time.
+//! Times are given in milliseconds by the caller so that the scheduler does not depend on a clock.
+class TurnScheduler
+{
+public:
+    TurnScheduler(double turnsPerSecond, uint32_t maxCatchUpTurns);
+
+    //! \brief Schedules the next turn now and forgets the lag. Should be called when the game starts
+    void reset(double nowMs);
+
+    //! \brief Returns how long we can wait (for client messages) before the next turn should
+    //! start. Returns 0 if a turn is already late
+    double getTimeBeforeNextTurnMs(double nowMs) const;
+
+    //! \brief Returns how many turns should have been started at the given time (turns dropped
+    //! because of the catch-up limit are not counted)
+    uint32_t getNbTurnsDue(double nowMs);
+
+    //! \brief Should be called each time a turn is started. The next turn is scheduled one turn
+    //! length after the previous one and not after the current time so that late turns are caught up
+    void turnStarted(double nowMs);
+
+    //! \brief Returns how late the next turn is (0 if it is not due yet)
+    double getLagMs(double nowMs) const;
+
+    //! \brief The time simulated by each turn. It does not depend on the time it took to compute
+    //! the previous turn
+    inline double getTurnLengthSeconds() const
+    { return mTurnLengthMs / 1000.0; }
+
+    inline double getTurnLengthMs() const
+    { return mTurnLengthMs; }
+
+    inline uint64_t getNbTurnsDropped() const
+    { return mNbTurnsDropped; }
+
+    inline bool isMaxSpeed() const
+    { return mIsMaxSpeed; }
+
+    inline void setMaxSpeed(bool isMaxSpeed)
+    { mIsMaxSpeed = isMaxSpeed; }
+
+private:
+    double mTurnLengthMs;
+    uint32_t mMaxCatchUpTurns;
+    bool mIsMaxSpeed;
+
+    //! \brief Time when the next turn should start
+    double mNextTurnMs;
+
+    uint64_t mNbTurnsDropped;
+};
+
+#endif // TURNSCHEDULER_H
@@ -0,0 +1,248 @@
+/*
+ *  Copyright (C) 2011-2016  OpenDungeons Team
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "render/CreatureInstancingManager.h"
+
+#include "utils/Helper.h"
+#include "utils/LogManager.h"
+
+#include <OgreBone.h>
+#include <OgreException.h>
+#include <OgreInstancedEntity.h>
+#include <OgreInstanceManager.h>
+#include <OgreMaterialManager.h>
+#include <OgreMeshManager.h>
+#include <OgreSceneManager.h>
+#include <OgreSceneNode.h>
+#include <OgreSkeletonInstance.h>
+#include <OgreSubMesh.h>
+
+const std::string CreatureInstancingManager::MATERIAL_SUFFIX = "/HWInstancingVTF";
+
+const uint32_t CreatureInstancingManager::INSTANCES_PER_BATCH = 80;
+
+namespace
+{
+    //! \brief The bone matrices are read from a texture by the vertex shader so that every
+    //! instance of a batch can play its own animation
+    const Ogre::InstanceManager::InstancingTechnique CREATURE_INSTANCING_TECHNIQUE = Ogre::InstanceManager::HWInstancingVTF;
+    const Ogre::uint16 CREATURE_INSTANCING_FLAGS = Ogre::IM_VTFBESTFIT;
+}
+
+CreatureInstancingManager::CreatureInstancingManager(Ogre::SceneManager* sceneManager) :
+    mSceneManager(sceneManager)
+{
+}
+
+CreatureInstancingManager::~CreatureInstancingManager()
+{
+    while(!mInstances.empty())
+        destroyInstance(mInstances.begin()->first);
+
+    for(std::pair<const std::string, MeshInstancing>& p : mMeshes)
+    {
+        for(const std::string& managerName : p.second.mManagerNames)
+            mSceneManager->destroyInstanceManager(managerName);
+    }
+}
+
+bool CreatureInstancingManager::canBeInstanced(const std::string& meshName)
+{
+    auto it = mMeshes.find(meshName);
+    if(it != mMeshes.end())
+        return it->second.mCanBeInstanced;
+
+    MeshInstancing& mesh = mMeshes[meshName];
+    prepareMesh(meshName, mesh);
+    return mesh.mCanBeInstanced;
+}
+
+void CreatureInstancingManager::prepareMesh(const std::string& meshName, MeshInstancing& mesh)
+{
+    try
+    {
+        Ogre::MeshPtr meshPtr = Ogre::MeshManager::getSingleton().load(meshName,
+            Ogre::ResourceGroupManager::AUTODETECT_RESOURCE_GROUP_NAME);
+        const std::string& groupName = meshPtr->getGroup();
+        for(unsigned short i = 0; i < meshPtr->getNumSubMeshes(); ++i)
+        {
+            std::string materialName = meshPtr->getSubMesh(i)->getMaterialName() + MATERIAL_SUFFIX;
+            Ogre::MaterialPtr material = Ogre::MaterialManager::getSingleton().getByName(materialName);
+#if defined(OGRE_VERSION) && OGRE_VERSION < 0x10A00
+            if(material.isNull())
+#else
+            if(!material)
+#endif
+            {
+                OD_LOG_INF("Mesh " + meshName + " is not instanced because material " + materialName + " does not exist");
+                return;
+            }
+
+            if(mSceneManager->getNumInstancesPerBatch(meshName, groupName, materialName, CREATURE_INSTANCING_TECHNIQUE,
+                INSTANCES_PER_BATCH, CREATURE_INSTANCING_FLAGS, i) == 0)
+            {
+                OD_LOG_INF("Mesh " + meshName + " is not instanced because the render system cannot instance submesh "
+                    + Helper::toString(i));
+                return;
+            }
+
+            mesh.mMaterialNames.push_back(materialName);
+        }
+
+        for(unsigned short i = 0; i < meshPtr->getNumSubMeshes(); ++i)
+        {
+            std::string managerName = "CreatureInstancing_" + meshName + "_" + Helper::toString(i);
+            mSceneManager->createInstanceManager(managerName, meshName, groupName, CREATURE_INSTANCING_TECHNIQUE,
+                INSTANCES_PER_BATCH, CREATURE_INSTANCING_FLAGS, i);
+            mesh.mManagerNames.push_back(managerName);
+        }
+    }
+    catch(const Ogre::Exception& e)
+    {
+        OD_LOG_WRN("Mesh " + meshName + " is not instanced, error=" + e.getDescription());
+        for(const std::string& managerName : mesh.mManagerNames)
+            mSceneManager->destroyInstanceManager(managerName);
+
+        mesh.mManagerNames.clear();
+        return;
+    }
+
+    mesh.mCanBeInstanced = !mesh.mManagerNames.empty();
+}
+
+Ogre::InstancedEntity* CreatureInstancingManager::createInstance(const std::string& meshName, Ogre::SceneNode* node)
+{
+    const MeshInstancing& mesh = mMeshes[meshName];
+    Ogre::InstancedEntity* master = nullptr;
+    std::vector<Ogre::InstancedEntity*> slaves;
+    for(uint32_t i = 0; i < mesh.mManagerNames.size(); ++i)
+    {
+        Ogre::InstancedEntity* instance = mSceneManager->createInstancedEntity(mesh.mMaterialNames[i], mesh.mManagerNames[i]);
+        node->attachObject(instance);
+        if(master == nullptr)
+        {
+            master = instance;
+            continue;
+        }
+
+        // The skeleton is shared so that it is only animated once
+        master->shareTransformWith(instance);
+        slaves.push_back(instance);
+    }
+
+    if(master == nullptr)
+    {
+        OD_LOG_ERR("Cannot instance mesh=" + meshName);
+        return nullptr;
+    }
+
+    Instance& instance = mInstances[master];
+    instance.mMeshName = meshName;
+    instance.mSlaves = slaves;
+    return master;
+}
+
+void CreatureInstancingManager::destroyInstance(Ogre::InstancedEntity* instance)
+{
+    auto it = mInstances.find(instance);
+    if(it == mInstances.end())
+    {
+        OD_LOG_ERR("Unknown instance=" + instance->getName());
+        return;
+    }
+
+    detachObjectsFromBones(instance);
+
+    instance->stopSharingTransform();
+    for(Ogre::InstancedEntity* slave : it->second.mSlaves)
+    {
+        slave->detachFromParent();
+        mSceneManager->destroyInstancedEntity(slave);
+    }
+    instance->detachFromParent();
+    mSceneManager->destroyInstancedEntity(instance);
+    mInstances.erase(it);
+}
+
+const std::string& CreatureInstancingManager::getMeshName(Ogre::InstancedEntity* instance) const
+{
+    return mInstances.at(instance).mMeshName;
+}
+
+void CreatureInstancingManager::attachObjectToBone(Ogre::InstancedEntity* instance, const std::string& boneName,
+    Ogre::MovableObject* object, const Ogre::Quaternion& offsetOrientation)
+{
+    AttachedObject& attachedObject = mAttachedObjects[object];
+    attachedObject.mInstance = instance;
+    attachedObject.mNode = instance->getParentSceneNode()->createChildSceneNode();
+    attachedObject.mBoneName = boneName;
+    attachedObject.mOffsetOrientation = offsetOrientation;
+    attachedObject.mNode->attachObject(object);
+}
+
+void CreatureInstancingManager::detachObjectFromBone(Ogre::MovableObject* object)
+{
+    auto it = mAttachedObjects.find(object);
+    if(it == mAttachedObjects.end())
+        return;
+
+    Ogre::SceneNode* node = it->second.mNode;
+    node->detachObject(object);
+    node->getParentSceneNode()->removeChild(node);
+    mSceneManager->destroySceneNode(node);
+    mAttachedObjects.erase(it);
+}
+
+std::vector<CreatureInstancingManager::BoneAttachment> CreatureInstancingManager::detachObjectsFromBones(
+    Ogre::InstancedEntity* instance)
+{
+    std::vector<BoneAttachment> attachments;
+    for(const std::pair<Ogre::MovableObject* const, AttachedObject>& p : mAttachedObjects)
+    {
+        if(p.second.mInstance != instance)
+            continue;
+
+        BoneAttachment attachment;
+        attachment.mBoneName = p.second.mBoneName;
+        attachment.mObject = p.first;
+        attachment.mOffsetOrientation = p.second.mOffsetOrientation;
+        attachments.push_back(attachment);
+    }
+
+    for(const BoneAttachment& attachment : attachments)
+        detachObjectFromBone(attachment.mObject);
+
+    return attachments;
+}
+
+void CreatureInstancingManager::updateBoneAttachments()
+{
+    for(std::pair<Ogre::MovableObject* const, AttachedObject>& p : mAttachedObjects)
+    {
+        AttachedObject& attachedObject = p.second;
+        // Hidden creatures are not animated
+        if(!attachedObject.mNode->isInSceneGraph())
+            continue;
+
+        // The bones are placed relative to the instance which is attached to the parent node with no offset,
+        // like the tag points entities use
+        Ogre::Bone* bone = attachedObject.mInstance->getSkeleton()->getBone(attachedObject.mBoneName);
+        attachedObject.mNode->setPosition(bone->_getDerivedPosition());
+        attachedObject.mNode->setOrientation(bone->_getDerivedOrientation() * attachedObject.mOffsetOrientation);
+    }
+}
@@ -0,0 +1,132 @@
+/*
+ *  Copyright (C) 2011-2016  OpenDungeons Team
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef CREATUREINSTANCINGMANAGER_H
+#define CREATUREINSTANCINGMANAGER_H
+
+#include <OgreQuaternion.h>
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace Ogre
+{
+class InstancedEntity;
+class MovableObject;
+class SceneManager;
+class SceneNode;
+} //End namespace Ogre
+
+//! \brief Displays the creatures with Ogre hardware instancing so that the creatures sharing a mesh
+//! are drawn by a few batches instead of one entity each. Each submesh of an instanced mesh has its
+//! own Ogre::InstanceManager. The instances of the other submeshes share the transform and skeleton
+//! of the one of the first submesh, which is the one returned by createInstance.
+//! A mesh is only instanced if each of its submesh materials has a variant named after the material
+//! with MATERIAL_SUFFIX (with the vertex shader reading the bone matrices from a texture) and if the
+//! render system supports it. Otherwise, the caller should create a plain entity.
+class CreatureInstancingManager
+{
+public:
+    //! \brief Suffix of the materials used by the instanced submeshes
+    static const std::string MATERIAL_SUFFIX;
+
+    //! \brief Number of instances drawn by one batch at most
+    static const uint32_t INSTANCES_PER_BATCH;
+
+    //! \brief Object attached to a bone of an instance
+    struct BoneAttachment
+    {
+        std::string mBoneName;
+        Ogre::MovableObject* mObject;
+        Ogre::Quaternion mOffsetOrientation;
+    };
+
+    CreatureInstancingManager(Ogre::SceneManager* sceneManager);
+    ~CreatureInstancingManager();
+
+    //! \brief Returns true if the given mesh can be instanced. The instance managers of the mesh
+    //! are created the first time it is checked
+    bool canBeInstanced(const std::string& meshName);
+
+    //! \brief Creates the instances of the submeshes of the given mesh and attaches them to the given node.
+    //! canBeInstanced should have returned true for the mesh. Returns the instance driving the others
+    Ogre::InstancedEntity* createInstance(const std::string& meshName, Ogre::SceneNode* node);
+
+    //! \brief Destroys the instances created by createInstance. The objects still attached to its
+    //! bones are detached but not destroyed
+    void destroyInstance(Ogre::InstancedEntity* instance);
+
+    const std::string& getMeshName(Ogre::InstancedEntity* instance) const;
+
+    //! \brief Instances cannot have objects attached to their bones like entities. The object is attached
+    //! to a child node of the instance node that follows the bone in updateBoneAttachments
+    void attachObjectToBone(Ogre::InstancedEntity* instance, const std::string& boneName,
+        Ogre::MovableObject* object, const Ogre::Quaternion& offsetOrientation);
+
+    //! \brief Detaches the given object if it was attached by attachObjectToBone. Other objects are ignored
+    void detachObjectFromBone(Ogre::MovableObject* object);
+
+    //! \brief Detaches every object attached to the bones of the given instance and returns them so that
+    //! they can be attached to an entity replacing the instance
+    std::vector<BoneAttachment> detachObjectsFromBones(Ogre::InstancedEntity* instance);
+
+    //! \brief Moves the objects attached to bones where the bones were placed by the last rendered frame.
+    //! Should be called once per frame
+    void updateBoneAttachments();
+
+private:
+    //! \brief Instance managers of a mesh (one per submesh)
+    struct MeshInstancing
+    {
+        MeshInstancing() :
+            mCanBeInstanced(false)
+        {}
+
+        bool mCanBeInstanced;
+        std::vector<std::string> mManagerNames;
+        std::vector<std::string> mMaterialNames;
+    };
+
+    struct Instance
+    {
+        std::string mMeshName;
+        //! \brief Instances of the other submeshes sharing the transform of the first one
+        std::vector<Ogre::InstancedEntity*> mSlaves;
+    };
+
+    struct AttachedObject
+    {
+        Ogre::InstancedEntity* mInstance;
+        Ogre::SceneNode* mNode;
+        std::string mBoneName;
+        Ogre::Quaternion mOffsetOrientation;
+    };
+
+    Ogre::SceneManager* mSceneManager;
+
+    std::map<std::string, MeshInstancing> mMeshes;
+    std::map<Ogre::InstancedEntity*, Instance> mInstances;
+    std::map<Ogre::MovableObject*, AttachedObject> mAttachedObjects;
+
+    //! \brief Checks the materials and creates the instance managers of the given mesh
+    void prepareMesh(const std::string& meshName, MeshInstancing& mesh);
+};
+
+#endif // CREATUREINSTANCINGMANAGER_H
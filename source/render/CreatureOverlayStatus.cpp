@@ -20,11 +20,12 @@
 #include "entities/Creature.h"
 #include "game/Seat.h"
 #include "render/MovableTextOverlay.h"
+#include "render/OverlayProjector.h"
 #include "render/RenderManager.h"
 #include "utils/Helper.h"
 #include "utils/LogManager.h"
 
-#include <OgreEntity.h>
+#include <OgreMovableObject.h>
 
 const std::string CREATURE_OVERLAY_STATUS_PREFIX = "CreatureOverlayStatus_";
 
@@ -35,9 +36,14 @@ enum class CreatureOverlays
     nbCreatureOverlays
 };
 
-CreatureOverlayStatus::CreatureOverlayStatus(Creature* creature, Ogre::Entity* ent,
-        Ogre::Camera* cam) :
+CreatureOverlayStatus::CreatureOverlayStatus(Creature* creature, Ogre::MovableObject* ent,
+        OverlayProjector& projector) :
     mCreature(creature),
+    mEntity(ent),
+    mProjector(projector),
+    mAnchorId(projector.addAnchor()),
+    mIsDisplayed(false),
+    mSeat(nullptr),
     mMovableTextOverlay(nullptr),
     mHealthValue(0),
     mLevel(0),
@@ -45,8 +51,7 @@ CreatureOverlayStatus::CreatureOverlayStatus(Creature* creature, Ogre::Entity* e
     mStatus(0),
     mOverlayIds(std::vector<uint32_t>(static_cast<uint32_t>(CreatureOverlays::nbCreatureOverlays), 0))
 {
-    mMovableTextOverlay = new MovableTextOverlay(creature->getName(),
-        ent, cam);
+    mMovableTextOverlay = new MovableTextOverlay(creature->getName());
 
     uint32_t healthId = mMovableTextOverlay->createChildOverlay("MedievalSharp", 16, Ogre::ColourValue::White, "");
     mOverlayIds[static_cast<uint32_t>(CreatureOverlays::health)] = healthId;
@@ -69,6 +74,7 @@ CreatureOverlayStatus::CreatureOverlayStatus(Creature* creature, Ogre::Entity* e
 CreatureOverlayStatus::~CreatureOverlayStatus()
 {
     delete mMovableTextOverlay;
+    mProjector.removeAnchor(mAnchorId);
 }
 
 void CreatureOverlayStatus::displayHealthOverlay(Ogre::Real timeToDisplay)
@@ -184,5 +190,30 @@ void CreatureOverlayStatus::update(Ogre::Real timeSincelastFrame)
     updateHealth();
     updateStatus(timeSincelastFrame);
 
-    mMovableTextOverlay->update(timeSincelastFrame);
+    mIsDisplayed = mMovableTextOverlay->update(timeSincelastFrame);
+    if(!mIsDisplayed)
+        return;
+
+    const Ogre::AxisAlignedBox& box = mEntity->getWorldBoundingBox();
+    if(!box.isFinite())
+    {
+        mIsDisplayed = false;
+        mMovableTextOverlay->setScreenPosition(false, 0.0, 0.0);
+        return;
+    }
+
+    // The overlays are displayed above the head of the creature
+    Ogre::Vector3 head = box.getCenter();
+    head.z = box.getMaximum().z;
+    mProjector.setAnchorPosition(mAnchorId, static_cast<float>(head.x), static_cast<float>(head.y),
+        static_cast<float>(head.z));
+}
+
+void CreatureOverlayStatus::updateScreenPosition()
+{
+    if(!mIsDisplayed)
+        return;
+
+    mMovableTextOverlay->setScreenPosition(mProjector.isOnScreen(mAnchorId),
+        mProjector.getScreenX(mAnchorId), mProjector.getScreenY(mAnchorId));
 }
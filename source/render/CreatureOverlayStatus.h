@@ -24,29 +24,49 @@
 
 class Creature;
 class MovableTextOverlay;
+class OverlayProjector;
 class Seat;
 
 namespace Ogre
 {
-    class Entity;
-    class Camera;
+    class MovableObject;
 }
 
+//! \brief Overlays displayed above a creature (level, health and mood). The position of their
+//! anchor is projected on the screen with the anchors of every other creature by the given
+//! OverlayProjector (see RenderManager::updateCreatureOverlays)
 class CreatureOverlayStatus
 {
 public:
-    CreatureOverlayStatus(Creature* creature, Ogre::Entity* ent,
-        Ogre::Camera* cam);
+    //! \brief ent is the entity or instance displaying the creature. The overlays are placed above it
+    CreatureOverlayStatus(Creature* creature, Ogre::MovableObject* ent,
+        OverlayProjector& projector);
     ~CreatureOverlayStatus();
 
+    //! \brief Called when the creature is displayed by another entity
+    inline void setEntity(Ogre::MovableObject* ent)
+    { mEntity = ent; }
+
     void displayHealthOverlay(Ogre::Real timeToDisplay);
+
+    //! \brief Updates the displayed values and the anchor position. The values are only sent to
+    //! the overlays when they change
     void update(Ogre::Real timeSincelastFrame);
 
+    //! \brief Moves the overlays where the anchor was projected. Should be called after the
+    //! projector has projected the anchors updated by update()
+    void updateScreenPosition();
+
 private:
     void updateHealth();
     void updateStatus(Ogre::Real timeSincelastFrame);
 
     Creature* mCreature;
+    Ogre::MovableObject* mEntity;
+    OverlayProjector& mProjector;
+    uint32_t mAnchorId;
+    //! \brief true if at least one overlay is displayed and the anchor position is valid
+    bool mIsDisplayed;
     Seat* mSeat;
     MovableTextOverlay* mMovableTextOverlay;
     uint32_t mHealthValue;
@@ -0,0 +1,129 @@
+/*
+ *  Copyright (C) 2011-2016  OpenDungeons Team
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "render/EntityInstancingManager.h"
+
+#include "game/Seat.h"
+#include "render/MaterialVariantCache.h"
+#include "render/MeshGeometryCache.h"
+#include "render/TileChunkGeometry.h"
+#include "render/TileChunkManager.h"
+#include "utils/Helper.h"
+
+#include <OgreManualObject.h>
+#include <OgreMath.h>
+#include <OgreSceneManager.h>
+#include <OgreSceneNode.h>
+
+const uint32_t EntityInstancingManager::BATCH_SIZE = 64;
+
+EntityInstancingManager::EntityInstancingManager(Ogre::SceneManager* sceneManager, Ogre::SceneNode* parentNode,
+        MaterialVariantCache& materialVariants, MeshGeometryCache& meshGeometries) :
+    mSceneManager(sceneManager),
+    mParentNode(parentNode),
+    mMaterialVariants(materialVariants),
+    mMeshGeometries(meshGeometries),
+    // Batches cover the same area as the tile chunks so that they are culled together
+    mGroups(BATCH_SIZE, static_cast<float>(TileChunkManager::CHUNK_SIZE))
+{
+}
+
+EntityInstancingManager::~EntityInstancingManager()
+{
+    for(uint32_t i = 0; i < mBatchObjects.size(); ++i)
+    {
+        if(mBatchObjects[i] == nullptr)
+            continue;
+
+        mBatchNodes[i]->detachObject(mBatchObjects[i]);
+        mSceneManager->destroyManualObject(mBatchObjects[i]);
+        mSceneManager->destroySceneNode(mBatchNodes[i]);
+    }
+}
+
+uint32_t EntityInstancingManager::addInstance(const std::string& meshName, const Seat* seatColor,
+    const InstanceGroups::InstanceData& data)
+{
+    return mGroups.addInstance(meshName, seatColor, data);
+}
+
+void EntityInstancingManager::removeInstance(uint32_t instanceId)
+{
+    mGroups.removeInstance(instanceId);
+}
+
+void EntityInstancingManager::setPosition(uint32_t instanceId, float x, float y, float z)
+{
+    mGroups.setPosition(instanceId, x, y, z);
+}
+
+void EntityInstancingManager::updateDirtyBatches()
+{
+    for(uint32_t batchIndex : mGroups.getDirtyBatches())
+        rebuildBatch(batchIndex);
+
+    mGroups.clearDirtyBatches();
+}
+
+void EntityInstancingManager::rebuildBatch(uint32_t batchIndex)
+{
+    const InstanceGroups::Batch& batch = mGroups.getBatch(batchIndex);
+    const std::vector<MeshGeometryCache::SubMeshGeometry>& subMeshes = mMeshGeometries.getMeshGeometry(batch.mMeshName);
+    const std::string& colorId = (batch.mSeatColor != nullptr) ? batch.mSeatColor->getColorId()
+        : MaterialVariantCache::NO_COLOR;
+    TileChunkGeometry geometry;
+    for(uint32_t instanceId : batch.mInstances)
+    {
+        const InstanceGroups::InstanceData& data = mGroups.getInstance(instanceId);
+        // Objects are only rotated around the z axis (like the node roll of non instanced objects)
+        Ogre::Radian angle = Ogre::Degree(data.mRotationAngle);
+        float cosAngle = static_cast<float>(Ogre::Math::Cos(angle));
+        float sinAngle = static_cast<float>(Ogre::Math::Sin(angle));
+        const float rotation[9] =
+        {
+            cosAngle, -sinAngle, 0.0f,
+            sinAngle, cosAngle, 0.0f,
+            0.0f, 0.0f, 1.0f
+        };
+
+        for(const MeshGeometryCache::SubMeshGeometry& subMesh : subMeshes)
+        {
+            const std::string& materialName = mMaterialVariants.getVariant(subMesh.mMaterialId, colorId, false, true);
+            geometry.addMesh(materialName, subMesh.mGeometry, rotation, data.mX, data.mY, data.mZ);
+        }
+    }
+
+    if(batchIndex >= mBatchObjects.size())
+    {
+        mBatchObjects.resize(batchIndex + 1, nullptr);
+        mBatchNodes.resize(batchIndex + 1, nullptr);
+    }
+
+    // Empty batches keep their object since they will likely be filled again
+    if(mBatchObjects[batchIndex] == nullptr)
+    {
+        if(geometry.isEmpty())
+            return;
+
+        std::string name = "InstanceBatch_" + Helper::toString(batchIndex);
+        mBatchObjects[batchIndex] = mSceneManager->createManualObject(name);
+        mBatchNodes[batchIndex] = mParentNode->createChildSceneNode(name + "_node");
+        mBatchNodes[batchIndex]->attachObject(mBatchObjects[batchIndex]);
+    }
+
+    MeshGeometryCache::fillManualObject(*mBatchObjects[batchIndex], geometry);
+}
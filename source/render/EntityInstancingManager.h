@@ -0,0 +1,81 @@
+/*
+ *  Copyright (C) 2011-2016  OpenDungeons Team
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef ENTITYINSTANCINGMANAGER_H
+#define ENTITYINSTANCINGMANAGER_H
+
+#include "render/InstanceGroups.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+class MaterialVariantCache;
+class MeshGeometryCache;
+class Seat;
+
+namespace Ogre
+{
+class ManualObject;
+class SceneManager;
+class SceneNode;
+} //End namespace Ogre
+
+//! \brief Displays the static objects that appear many times (room objects, gold heaps, ...) without
+//! creating an entity per object. Instances are grouped by InstanceGroups and the meshes of a batch are
+//! merged into one object, rebuilt only when one of its instances changes. A batch only holds instances
+//! of the same tile chunk so Ogre frustum culling hides the batches out of view, the instances are never
+//! hidden one by one. Objects that need an entity (animated, transparent, carried, ...) should not be instanced.
+class EntityInstancingManager
+{
+public:
+    //! \brief Number of instances merged in the same object at most
+    static const uint32_t BATCH_SIZE;
+
+    //! \brief materialVariants and meshGeometries should outlive the EntityInstancingManager
+    EntityInstancingManager(Ogre::SceneManager* sceneManager, Ogre::SceneNode* parentNode,
+        MaterialVariantCache& materialVariants, MeshGeometryCache& meshGeometries);
+    ~EntityInstancingManager();
+
+    //! \brief Adds an instance of the given mesh. If seatColor is not null, the materials are
+    //! colourized for this seat. Returns the id of the instance
+    uint32_t addInstance(const std::string& meshName, const Seat* seatColor, const InstanceGroups::InstanceData& data);
+
+    void removeInstance(uint32_t instanceId);
+
+    void setPosition(uint32_t instanceId, float x, float y, float z);
+
+    //! \brief Rebuilds the batches that changed. Should be called once per frame
+    void updateDirtyBatches();
+
+private:
+    Ogre::SceneManager* mSceneManager;
+    Ogre::SceneNode* mParentNode;
+    MaterialVariantCache& mMaterialVariants;
+    MeshGeometryCache& mMeshGeometries;
+
+    InstanceGroups mGroups;
+
+    //! \brief Merged object of each batch (indexed like the batches of mGroups). Created when
+    //! the batch is first built
+    std::vector<Ogre::ManualObject*> mBatchObjects;
+    std::vector<Ogre::SceneNode*> mBatchNodes;
+
+    void rebuildBatch(uint32_t batchIndex);
+};
+
+#endif // ENTITYINSTANCINGMANAGER_H
@@ -0,0 +1,168 @@
+/*
+ *  Copyright (C) 2011-2016  OpenDungeons Team
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "render/InstanceGroups.h"
+
+#include <cmath>
+
+InstanceGroups::InstanceGroups(uint32_t batchSize, float chunkSize) :
+    mBatchSize(batchSize),
+    mChunkSize(chunkSize)
+{
+}
+
+int32_t InstanceGroups::getChunkCoord(float coord) const
+{
+    return static_cast<int32_t>(std::floor(coord / mChunkSize));
+}
+
+uint32_t InstanceGroups::findBatch(const std::string& meshName, const Seat* seatColor, float x, float y)
+{
+    // We look for a batch with room left for this mesh and color in the chunk
+    int32_t chunkX = getChunkCoord(x);
+    int32_t chunkY = getChunkCoord(y);
+    std::vector<uint32_t>& batches = mBatchesByKey[std::make_tuple(meshName, seatColor, chunkX, chunkY)];
+    for(uint32_t index : batches)
+    {
+        if(mBatches[index].mInstances.size() < mBatchSize)
+            return index;
+    }
+
+    uint32_t batchIndex = static_cast<uint32_t>(mBatches.size());
+    mBatches.push_back(Batch());
+    mBatches.back().mMeshName = meshName;
+    mBatches.back().mSeatColor = seatColor;
+    mBatches.back().mChunkX = chunkX;
+    mBatches.back().mChunkY = chunkY;
+    mIsBatchDirty.push_back(false);
+    batches.push_back(batchIndex);
+    return batchIndex;
+}
+
+void InstanceGroups::addToBatch(uint32_t instanceId, uint32_t batchIndex)
+{
+    Batch& batch = mBatches[batchIndex];
+    Instance& instance = mInstances[instanceId];
+    instance.mBatch = batchIndex;
+    instance.mIndexInBatch = static_cast<uint32_t>(batch.mInstances.size());
+    batch.mInstances.push_back(instanceId);
+    setDirty(batchIndex);
+}
+
+void InstanceGroups::removeFromBatch(uint32_t instanceId)
+{
+    Instance& instance = mInstances[instanceId];
+    Batch& batch = mBatches[instance.mBatch];
+    // Order within a batch does not matter. We move the last instance in place of the removed one
+    uint32_t lastId = batch.mInstances.back();
+    batch.mInstances[instance.mIndexInBatch] = lastId;
+    mInstances[lastId].mIndexInBatch = instance.mIndexInBatch;
+    batch.mInstances.pop_back();
+    setDirty(instance.mBatch);
+}
+
+uint32_t InstanceGroups::addInstance(const std::string& meshName, const Seat* seatColor, const InstanceData& data)
+{
+    uint32_t batchIndex = findBatch(meshName, seatColor, data.mX, data.mY);
+
+    uint32_t instanceId;
+    if(mFreeInstanceIds.empty())
+    {
+        instanceId = static_cast<uint32_t>(mInstances.size());
+        mInstances.push_back(Instance());
+    }
+    else
+    {
+        instanceId = mFreeInstanceIds.back();
+        mFreeInstanceIds.pop_back();
+    }
+
+    Instance& instance = mInstances[instanceId];
+    instance.mData = data;
+    instance.mIsUsed = true;
+    addToBatch(instanceId, batchIndex);
+    return instanceId;
+}
+
+void InstanceGroups::removeInstance(uint32_t instanceId)
+{
+    if(!hasInstance(instanceId))
+        return;
+
+    removeFromBatch(instanceId);
+    mInstances[instanceId].mIsUsed = false;
+    mFreeInstanceIds.push_back(instanceId);
+}
+
+void InstanceGroups::setPosition(uint32_t instanceId, float x, float y, float z)
+{
+    if(!hasInstance(instanceId))
+        return;
+
+    Instance& instance = mInstances[instanceId];
+    InstanceData& data = instance.mData;
+    if((data.mX == x) && (data.mY == y) && (data.mZ == z))
+        return;
+
+    data.mX = x;
+    data.mY = y;
+    data.mZ = z;
+    const Batch& batch = mBatches[instance.mBatch];
+    if((batch.mChunkX == getChunkCoord(x)) && (batch.mChunkY == getChunkCoord(y)))
+    {
+        setDirty(instance.mBatch);
+        return;
+    }
+
+    // The instance left its chunk
+    std::string meshName = batch.mMeshName;
+    const Seat* seatColor = batch.mSeatColor;
+    removeFromBatch(instanceId);
+    addToBatch(instanceId, findBatch(meshName, seatColor, x, y));
+}
+
+bool InstanceGroups::hasInstance(uint32_t instanceId) const
+{
+    return (instanceId < mInstances.size()) && mInstances[instanceId].mIsUsed;
+}
+
+const InstanceGroups::InstanceData& InstanceGroups::getInstance(uint32_t instanceId) const
+{
+    return mInstances[instanceId].mData;
+}
+
+uint32_t InstanceGroups::getInstanceBatch(uint32_t instanceId) const
+{
+    return mInstances[instanceId].mBatch;
+}
+
+void InstanceGroups::setDirty(uint32_t batchIndex)
+{
+    if(mIsBatchDirty[batchIndex])
+        return;
+
+    mIsBatchDirty[batchIndex] = true;
+    mDirtyBatches.push_back(batchIndex);
+}
+
+void InstanceGroups::clearDirtyBatches()
+{
+    for(uint32_t batchIndex : mDirtyBatches)
+        mIsBatchDirty[batchIndex] = false;
+
+    mDirtyBatches.clear();
+}
@@ -0,0 +1,135 @@
+/*
+ *  Copyright (C) 2011-2016  OpenDungeons Team
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef INSTANCEGROUPS_H
+#define INSTANCEGROUPS_H
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <tuple>
+#include <vector>
+
+class Seat;
+
+//! \brief Sorts the instances of the meshes displayed many times in batches. Instances sharing
+//! the same mesh and seat color and standing in the same square chunk of chunkSize x chunkSize
+//! are put in the same batches of at most batchSize instances so that a batch can be drawn at
+//! once and culled as a whole when its chunk is out of view. When an instance changes, only its
+//! batch has to be rebuilt. This does not depend on the renderer so that it can be tested without a GPU.
+class InstanceGroups
+{
+public:
+    //! \brief What is needed to display an instance
+    struct InstanceData
+    {
+        InstanceData() :
+            mX(0.0f), mY(0.0f), mZ(0.0f),
+            mRotationAngle(0.0f)
+        {}
+
+        float mX;
+        float mY;
+        float mZ;
+        //! \brief Rotation around the z axis in degrees
+        float mRotationAngle;
+    };
+
+    struct Batch
+    {
+        std::string mMeshName;
+        const Seat* mSeatColor;
+        //! \brief Coordinates of the chunk containing the instances
+        int32_t mChunkX;
+        int32_t mChunkY;
+        //! \brief Ids of the instances in the batch
+        std::vector<uint32_t> mInstances;
+    };
+
+    InstanceGroups(uint32_t batchSize, float chunkSize);
+
+    //! \brief Adds an instance and returns its id
+    uint32_t addInstance(const std::string& meshName, const Seat* seatColor, const InstanceData& data);
+
+    //! \brief Removes the given instance. Unknown ids are ignored, like in setPosition
+    void removeInstance(uint32_t instanceId);
+
+    //! \brief Moves the given instance. If it leaves its chunk, it is moved to a batch of
+    //! the new chunk and both batches are rebuilt
+    void setPosition(uint32_t instanceId, float x, float y, float z);
+
+    bool hasInstance(uint32_t instanceId) const;
+
+    const InstanceData& getInstance(uint32_t instanceId) const;
+
+    //! \brief Returns the batch of the given instance
+    uint32_t getInstanceBatch(uint32_t instanceId) const;
+
+    inline uint32_t getNbBatches() const
+    { return static_cast<uint32_t>(mBatches.size()); }
+
+    inline const Batch& getBatch(uint32_t batchIndex) const
+    { return mBatches[batchIndex]; }
+
+    //! \brief Batches that changed since the last call to clearDirtyBatches
+    inline const std::vector<uint32_t>& getDirtyBatches() const
+    { return mDirtyBatches; }
+
+    void clearDirtyBatches();
+
+private:
+    struct Instance
+    {
+        Instance() :
+            mBatch(0),
+            mIndexInBatch(0),
+            mIsUsed(false)
+        {}
+
+        InstanceData mData;
+        uint32_t mBatch;
+        uint32_t mIndexInBatch;
+        bool mIsUsed;
+    };
+
+    uint32_t mBatchSize;
+    float mChunkSize;
+
+    //! \brief Instances indexed by id. Ids of removed instances are reused
+    std::vector<Instance> mInstances;
+    std::vector<uint32_t> mFreeInstanceIds;
+
+    std::vector<Batch> mBatches;
+    //! \brief Batches indexed by mesh name, seat color and chunk coordinates
+    std::map<std::tuple<std::string, const Seat*, int32_t, int32_t>, std::vector<uint32_t>> mBatchesByKey;
+
+    std::vector<uint32_t> mDirtyBatches;
+    std::vector<bool> mIsBatchDirty;
+
+    void setDirty(uint32_t batchIndex);
+
+    //! \brief Returns a batch with room left for the given mesh, color and position. A new
+    //! batch is created if needed
+    uint32_t findBatch(const std::string& meshName, const Seat* seatColor, float x, float y);
+
+    void addToBatch(uint32_t instanceId, uint32_t batchIndex);
+    void removeFromBatch(uint32_t instanceId);
+
+    int32_t getChunkCoord(float coord) const;
+};
+
+#endif // INSTANCEGROUPS_H
@@ -0,0 +1,106 @@
+/*
+ *  Copyright (C) 2011-2016  OpenDungeons Team
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "render/MaterialVariantCache.h"
+
+#include "utils/Metrics.h"
+
+namespace
+{
+    //! \brief A variant is either plain, marked for digging or without vision
+    const uint32_t NB_FLAGS = 3;
+
+    //! \brief Separates the base material name from the variant description
+    const std::string VARIANT_SEPARATOR = "##";
+}
+
+const std::string MaterialVariantCache::NO_COLOR;
+
+MaterialVariantCache::MaterialVariantCache(VariantBuilder builder) :
+    mBuilder(builder),
+    mColorIds(1, NO_COLOR),
+    mNbMisses(0)
+{
+}
+
+uint32_t MaterialVariantCache::getMaterialId(const std::string& materialName)
+{
+    // Most names are base materials or variants we built and are found directly
+    auto it = mMaterialIds.find(materialName);
+    if(it != mMaterialIds.end())
+        return it->second;
+
+    // If the material is a variant we do not know, we use the base material
+    std::size_t index = materialName.find(VARIANT_SEPARATOR);
+    if(index != std::string::npos)
+    {
+        uint32_t materialId = getMaterialId(materialName.substr(0, index));
+        mMaterialIds[materialName] = materialId;
+        return materialId;
+    }
+
+    uint32_t materialId = static_cast<uint32_t>(mMaterials.size());
+    mMaterials.push_back(Material());
+    mMaterials.back().mName = materialName;
+    mMaterialIds[materialName] = materialId;
+    return materialId;
+}
+
+uint32_t MaterialVariantCache::getColorIndex(const std::string& colorId)
+{
+    for(uint32_t colorIndex = 0; colorIndex < mColorIds.size(); ++colorIndex)
+    {
+        if(mColorIds[colorIndex] == colorId)
+            return colorIndex;
+    }
+
+    mColorIds.push_back(colorId);
+    return static_cast<uint32_t>(mColorIds.size() - 1);
+}
+
+const std::string& MaterialVariantCache::getVariant(uint32_t materialId, const std::string& colorId,
+    bool markedForDigging, bool playerHasVision)
+{
+    Material& material = mMaterials[materialId];
+    if(colorId.empty() && !markedForDigging && playerHasVision)
+        return material.mName;
+
+    uint32_t flags = 0;
+    if(markedForDigging)
+        flags = 1;
+    else if(!playerHasVision)
+        flags = 2;
+
+    uint32_t index = getColorIndex(colorId) * NB_FLAGS + flags;
+    if(index >= material.mVariants.size())
+        material.mVariants.resize(index + 1);
+
+    const std::string& variant = material.mVariants[index];
+    if(!variant.empty())
+        return variant;
+
+    static Metrics::Counter& misses = Metrics::getCounter("od_material_variant_misses",
+        "Material variants (seat color, digging, vision) that had to be built");
+    misses.increment();
+    ++mNbMisses;
+    // The builder gets a copy of the name as it could add materials to the cache
+    std::string variantName = mBuilder(std::string(material.mName), colorId, markedForDigging, playerHasVision);
+    mMaterialIds[variantName] = materialId;
+    std::string& builtVariant = mMaterials[materialId].mVariants[index];
+    builtVariant = variantName;
+    return builtVariant;
+}
@@ -0,0 +1,83 @@
+/*
+ *  Copyright (C) 2011-2016  OpenDungeons Team
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MATERIALVARIANTCACHE_H
+#define MATERIALVARIANTCACHE_H
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+//! \brief Remembers the variants of the materials (colourized with a seat color, marked for
+//! digging or without vision) so that they are only built once. Base materials are given an id
+//! and a variant is then found by indexing tables with the material id, color and flags.
+//! Variants are keyed by the seat color id (and not the seat) because the seat colors depend
+//! on the level and the built materials are named after the color.
+//! Building a missing variant (cloning the material) is done by the given builder.
+class MaterialVariantCache
+{
+public:
+    //! \brief Color id to use for the variants that are not colourized
+    static const std::string NO_COLOR;
+
+    //! \brief Builds the variant of the given material and returns its name. colorId is
+    //! NO_COLOR if the variant should not be colourized
+    typedef std::function<std::string(const std::string& materialName, const std::string& colorId,
+        bool markedForDigging, bool playerHasVision)> VariantBuilder;
+
+    MaterialVariantCache(VariantBuilder builder);
+
+    //! \brief Returns the id of the given material. If the name is the one of a variant, the
+    //! id of its base material is returned
+    uint32_t getMaterialId(const std::string& materialName);
+
+    inline const std::string& getMaterialName(uint32_t materialId) const
+    { return mMaterials[materialId].mName; }
+
+    //! \brief Returns the name of the wanted variant of the given material. It is built if needed
+    const std::string& getVariant(uint32_t materialId, const std::string& colorId, bool markedForDigging,
+        bool playerHasVision);
+
+    inline uint64_t getNbMisses() const
+    { return mNbMisses; }
+
+private:
+    struct Material
+    {
+        std::string mName;
+        //! \brief Variant names indexed by color index * NB_FLAGS + flags. Empty if not built yet
+        std::vector<std::string> mVariants;
+    };
+
+    VariantBuilder mBuilder;
+    std::vector<Material> mMaterials;
+
+    //! \brief Ids of the base materials and of the variants already built
+    std::unordered_map<std::string, uint32_t> mMaterialIds;
+
+    //! \brief Colors used by the variants. The index 0 is NO_COLOR. There are only a few colors
+    //! so a linear search is faster than a map
+    std::vector<std::string> mColorIds;
+
+    uint64_t mNbMisses;
+
+    uint32_t getColorIndex(const std::string& colorId);
+};
+
+#endif // MATERIALVARIANTCACHE_H
@@ -0,0 +1,152 @@
+/*
+ *  Copyright (C) 2011-2016  OpenDungeons Team
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "render/MeshGeometryCache.h"
+
+#include "render/MaterialVariantCache.h"
+#include "utils/Helper.h"
+#include "utils/LogManager.h"
+
+#include <OgreHardwareIndexBuffer.h>
+#include <OgreHardwareVertexBuffer.h>
+#include <OgreManualObject.h>
+#include <OgreMesh.h>
+#include <OgreMeshManager.h>
+#include <OgreResourceGroupManager.h>
+#include <OgreSubMesh.h>
+#include <OgreVertexIndexData.h>
+
+namespace
+{
+    //! \brief Reads the given element of each vertex as nbFloats floats
+    void readVertexElement(const Ogre::VertexData& vertexData, Ogre::VertexElementSemantic semantic,
+        uint32_t nbFloats, std::vector<float>& values)
+    {
+        const Ogre::VertexElement* elem = vertexData.vertexDeclaration->findElementBySemantic(semantic);
+        if(elem == nullptr)
+            return;
+
+        // We only handle float elements with at least the wanted number of floats
+        if((Ogre::VertexElement::getBaseType(elem->getType()) != Ogre::VET_FLOAT1) ||
+           (Ogre::VertexElement::getTypeCount(elem->getType()) < nbFloats))
+        {
+            return;
+        }
+
+        Ogre::HardwareVertexBufferSharedPtr buffer = vertexData.vertexBufferBinding->getBuffer(elem->getSource());
+        unsigned char* vertex = static_cast<unsigned char*>(buffer->lock(Ogre::HardwareBuffer::HBL_READ_ONLY));
+        vertex += vertexData.vertexStart * buffer->getVertexSize();
+        values.reserve(vertexData.vertexCount * nbFloats);
+        for(size_t i = 0; i < vertexData.vertexCount; ++i, vertex += buffer->getVertexSize())
+        {
+            float* pReal;
+            elem->baseVertexPointerToElement(vertex, &pReal);
+            for(uint32_t j = 0; j < nbFloats; ++j)
+                values.push_back(pReal[j]);
+        }
+        buffer->unlock();
+    }
+
+    void readIndices(const Ogre::IndexData& indexData, std::vector<uint32_t>& indices)
+    {
+        Ogre::HardwareIndexBufferSharedPtr buffer = indexData.indexBuffer;
+        indices.reserve(indexData.indexCount);
+        const void* data = buffer->lock(Ogre::HardwareBuffer::HBL_READ_ONLY);
+        if(buffer->getType() == Ogre::HardwareIndexBuffer::IT_32BIT)
+        {
+            const uint32_t* pIndex = static_cast<const uint32_t*>(data) + indexData.indexStart;
+            indices.assign(pIndex, pIndex + indexData.indexCount);
+        }
+        else
+        {
+            const uint16_t* pIndex = static_cast<const uint16_t*>(data) + indexData.indexStart;
+            for(size_t i = 0; i < indexData.indexCount; ++i)
+                indices.push_back(pIndex[i]);
+        }
+        buffer->unlock();
+    }
+}
+
+MeshGeometryCache::MeshGeometryCache(MaterialVariantCache& materialVariants) :
+    mMaterialVariants(materialVariants)
+{
+}
+
+const std::vector<MeshGeometryCache::SubMeshGeometry>& MeshGeometryCache::getMeshGeometry(const std::string& meshName)
+{
+    auto it = mMeshGeometries.find(meshName);
+    if(it != mMeshGeometries.end())
+        return it->second;
+
+    std::vector<SubMeshGeometry>& subMeshes = mMeshGeometries[meshName];
+    Ogre::MeshPtr mesh = Ogre::MeshManager::getSingleton().load(meshName,
+        Ogre::ResourceGroupManager::AUTODETECT_RESOURCE_GROUP_NAME);
+
+    // Tile and room object materials use normal maps
+    unsigned short src, dest;
+    if (!mesh->suggestTangentVectorBuildParams(Ogre::VES_TANGENT, src, dest))
+        mesh->buildTangentVectors(Ogre::VES_TANGENT, src, dest);
+
+    for(unsigned short i = 0; i < mesh->getNumSubMeshes(); ++i)
+    {
+        const Ogre::SubMesh* subMesh = mesh->getSubMesh(i);
+        if(subMesh->operationType != Ogre::RenderOperation::OT_TRIANGLE_LIST)
+        {
+            OD_LOG_WRN("Submesh " + Helper::toString(i) + " of mesh " + meshName + " is not a triangle list and will not be displayed");
+            continue;
+        }
+
+        const Ogre::VertexData* vertexData = subMesh->useSharedVertices ? mesh->sharedVertexData : subMesh->vertexData;
+        if((vertexData == nullptr) || (subMesh->indexData == nullptr) || (subMesh->indexData->indexCount == 0))
+            continue;
+
+        SubMeshGeometry subMeshGeometry;
+        subMeshGeometry.mMaterialId = mMaterialVariants.getMaterialId(subMesh->getMaterialName());
+        TileMeshGeometry& geometry = subMeshGeometry.mGeometry;
+        readVertexElement(*vertexData, Ogre::VES_POSITION, 3, geometry.mPositions);
+        readVertexElement(*vertexData, Ogre::VES_NORMAL, 3, geometry.mNormals);
+        readVertexElement(*vertexData, Ogre::VES_TANGENT, 3, geometry.mTangents);
+        readVertexElement(*vertexData, Ogre::VES_TEXTURE_COORDINATES, 2, geometry.mTexCoords);
+        readIndices(*subMesh->indexData, geometry.mIndices);
+        subMeshes.push_back(subMeshGeometry);
+    }
+
+    return subMeshes;
+}
+
+void MeshGeometryCache::fillManualObject(Ogre::ManualObject& object, const TileChunkGeometry& geometry)
+{
+    object.clear();
+    for(const std::pair<const std::string, TileMeshGeometry>& section : geometry.getSections())
+    {
+        const TileMeshGeometry& mesh = section.second;
+        object.begin(section.first, Ogre::RenderOperation::OT_TRIANGLE_LIST);
+        object.estimateVertexCount(mesh.getNbVertices());
+        object.estimateIndexCount(mesh.mIndices.size());
+        for(uint32_t i = 0; i < mesh.getNbVertices(); ++i)
+        {
+            object.position(mesh.mPositions[i * 3], mesh.mPositions[i * 3 + 1], mesh.mPositions[i * 3 + 2]);
+            object.normal(mesh.mNormals[i * 3], mesh.mNormals[i * 3 + 1], mesh.mNormals[i * 3 + 2]);
+            object.tangent(mesh.mTangents[i * 3], mesh.mTangents[i * 3 + 1], mesh.mTangents[i * 3 + 2]);
+            object.textureCoord(mesh.mTexCoords[i * 2], mesh.mTexCoords[i * 2 + 1]);
+        }
+        for(uint32_t index : mesh.mIndices)
+            object.index(index);
+
+        object.end();
+    }
+}
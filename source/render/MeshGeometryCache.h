@@ -0,0 +1,60 @@
+/*
+ *  Copyright (C) 2011-2016  OpenDungeons Team
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MESHGEOMETRYCACHE_H
+#define MESHGEOMETRYCACHE_H
+
+#include "render/TileChunkGeometry.h"
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+class MaterialVariantCache;
+
+namespace Ogre
+{
+class ManualObject;
+} //End namespace Ogre
+
+//! \brief Keeps the geometry of the meshes merged by the renderer (tile chunks, instanced
+//! objects) so that the vertex buffers of a mesh are only read once.
+class MeshGeometryCache
+{
+public:
+    //! \brief Geometry extracted from a submesh with the id of its material (see MaterialVariantCache)
+    struct SubMeshGeometry
+    {
+        uint32_t mMaterialId;
+        TileMeshGeometry mGeometry;
+    };
+
+    MeshGeometryCache(MaterialVariantCache& materialVariants);
+
+    //! \brief Returns the geometry of the submeshes of the given mesh. The mesh is loaded if needed
+    const std::vector<SubMeshGeometry>& getMeshGeometry(const std::string& meshName);
+
+    //! \brief Replaces the content of the given object by the given geometry (one section per material)
+    static void fillManualObject(Ogre::ManualObject& object, const TileChunkGeometry& geometry);
+
+private:
+    MaterialVariantCache& mMaterialVariants;
+    std::map<std::string, std::vector<SubMeshGeometry>> mMeshGeometries;
+};
+
+#endif // MESHGEOMETRYCACHE_H
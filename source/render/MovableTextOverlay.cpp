@@ -20,7 +20,6 @@
 #include "utils/Helper.h"
 #include "utils/LogManager.h"
 
-#include <OgreCamera.h>
 #include <OgrePrerequisites.h>
 #include <Overlay/OgreFont.h>
 #include <Overlay/OgreFontManager.h>
@@ -38,6 +37,11 @@ ChildOverlay::ChildOverlay(const Ogre::String& fontName, Ogre::Real charHeight,
     mForcedHeight(-1),
     mCharHeight(charHeight),
     mTimeToDisplay(0),
+    mIsShown(false),
+    mAreaX(0),
+    mAreaY(0),
+    mAreaWidth(0),
+    mAreaHeight(0),
     // FIXME: Move FontManager usage to ResourceManager somehow and dehardcode "GUI"?
     mFont(Ogre::FontManager::getSingleton().getByName(fontName, "GUI"))
 {
@@ -102,11 +106,11 @@ void ChildOverlay::displayOverlay(Ogre::Real time)
 
     if((mTimeToDisplay == 0) && (time != 0))
     {
-        mOverlayContainer->show();
+        setShown(true);
     }
     else if((mTimeToDisplay != 0) && (time == 0))
     {
-        mOverlayContainer->hide();
+        setShown(false);
     }
 
     mTimeToDisplay = time;
@@ -140,28 +144,52 @@ void ChildOverlay::update(Ogre::Real timeSincelastFrame)
     }
 
     mTimeToDisplay = 0.0;
-    mOverlayContainer->hide();
+    setShown(false);
 }
 
 void ChildOverlay::setOnScreen(bool onScreen)
 {
-    if(onScreen && isDisplayed())
+    setShown(onScreen && isDisplayed());
+}
+
+void ChildOverlay::setShown(bool shown)
+{
+    if(shown == mIsShown)
+        return;
+
+    mIsShown = shown;
+    if(mIsShown)
         mOverlayContainer->show();
     else
         mOverlayContainer->hide();
 }
 
+void ChildOverlay::setArea(Ogre::Real x, Ogre::Real y, Ogre::Real width, Ogre::Real height)
+{
+    // Moving an overlay element rebuilds its geometry so we only do it when needed
+    if((x != mAreaX) || (y != mAreaY))
+    {
+        mAreaX = x;
+        mAreaY = y;
+        mOverlayContainer->setPosition(x, y);
+    }
+
+    if((width != mAreaWidth) || (height != mAreaHeight))
+    {
+        mAreaWidth = width;
+        mAreaHeight = height;
+        mOverlayContainer->setDimensions(width, height);
+    }
+}
+
 bool ChildOverlay::isDisplayed()
 {
     return mTimeToDisplay != 0.0;
 }
 
-MovableTextOverlay::MovableTextOverlay(const Ogre::String& name, const Ogre::MovableObject* followedMov,
-        Ogre::Camera* camera) :
+MovableTextOverlay::MovableTextOverlay(const Ogre::String& name) :
     mName(name),
-    mFollowedMov(followedMov),
-    mOverlay(nullptr),
-    mCamera(camera)
+    mOverlay(nullptr)
 {
     // create an overlay that we can use for later
     Ogre::OverlayManager& overlayManager = Ogre::OverlayManager::getSingleton();
@@ -192,6 +220,8 @@ uint32_t MovableTextOverlay::createChildOverlay(const Ogre::String& fontName, Og
     childOverlay.mOverlayContainer = static_cast<Ogre::OverlayContainer*>(overlayManager.createOverlayElement(
         "Panel", mName + Helper::toString(id) + "_OvC"));
     childOverlay.mOverlayContainer->setDimensions(0.0, 0.0);
+    // Hidden until displayOverlay is called (see mIsShown)
+    childOverlay.mOverlayContainer->hide();
 
     mOverlay->add2D(childOverlay.mOverlayContainer);
 
@@ -265,33 +295,6 @@ void MovableTextOverlay::setMaterialName(uint32_t childOverlayId, const Ogre::St
     childOverlay.setMaterialName(materialName);
 }
 
-bool MovableTextOverlay::computeOverlayPositionHead(Ogre::Vector2& position)
-{
-    // the AABB of the target
-    const Ogre::AxisAlignedBox& AABB = mFollowedMov->getWorldBoundingBox();
-    if (!mCamera->isVisible(AABB))
-        return false;
-
-    const Ogre::Vector3 farLeftTop = AABB.getCorner(Ogre::AxisAlignedBox::NEAR_RIGHT_TOP);
-    const Ogre::Vector3 nearRightTop = AABB.getCorner(Ogre::AxisAlignedBox::NEAR_LEFT_BOTTOM);
-
-    const Ogre::Vector3 centerTop = (farLeftTop + nearRightTop) * 0.5;
-
-    // Is the camera facing that point?
-    Ogre::Plane cameraPlane(Ogre::Vector3(mCamera->getDerivedOrientation().zAxis()), mCamera->getDerivedPosition());
-    if(cameraPlane.getSide(centerTop) != Ogre::Plane::NEGATIVE_SIDE)
-        return false;
-
-    // Transform 3D point to screen
-    Ogre::Vector3 screenPosition = mCamera->getProjectionMatrix() * (mCamera->getViewMatrix() * centerTop);
-
-    // We transform from coordinate space [-1, 1] to [0, 1]
-    position.x = 0.5 + (screenPosition.x * 0.5);
-    position.y = 0.5 - (screenPosition.y * 0.5);
-
-    return true;
-}
-
 void MovableTextOverlay::displayOverlay(uint32_t childOverlayId, Ogre::Real time)
 {
     if(childOverlayId >= mChildOverlays.size())
@@ -304,7 +307,7 @@ void MovableTextOverlay::displayOverlay(uint32_t childOverlayId, Ogre::Real time
     childOverlay.displayOverlay(time);
 }
 
-void MovableTextOverlay::update(Ogre::Real timeSincelastFrame)
+bool MovableTextOverlay::update(Ogre::Real timeSincelastFrame)
 {
     bool displayed = false;
     for(ChildOverlay& childOverlay : mChildOverlays)
@@ -317,11 +320,12 @@ void MovableTextOverlay::update(Ogre::Real timeSincelastFrame)
         displayed = true;
     }
 
-    if(!displayed)
-        return;
+    return displayed;
+}
 
-    Ogre::Vector2 screenPosition;
-    if(!computeOverlayPositionHead(screenPosition))
+void MovableTextOverlay::setScreenPosition(bool isOnScreen, Ogre::Real x, Ogre::Real y)
+{
+    if(!isOnScreen)
     {
         for(ChildOverlay& childOverlay : mChildOverlays)
             childOverlay.setOnScreen(false);
@@ -329,20 +333,20 @@ void MovableTextOverlay::update(Ogre::Real timeSincelastFrame)
         return;
     }
 
+    Ogre::OverlayManager& overlayManager = Ogre::OverlayManager::getSingleton();
+    Ogre::Real viewportWidth = overlayManager.getViewportWidth();
+    Ogre::Real viewportHeight = overlayManager.getViewportHeight();
     for(ChildOverlay& childOverlay : mChildOverlays)
     {
         childOverlay.setOnScreen(true);
         if(!childOverlay.isDisplayed())
             continue;
 
-        Ogre::Real relTextWidth = childOverlay.getWidth();
-        Ogre::Real relTextHeight = childOverlay.getHeight();
-        relTextWidth /= Ogre::OverlayManager::getSingleton().getViewportWidth();
-        relTextHeight /= Ogre::OverlayManager::getSingleton().getViewportHeight();
+        Ogre::Real relTextWidth = childOverlay.getWidth() / viewportWidth;
+        Ogre::Real relTextHeight = childOverlay.getHeight() / viewportHeight;
 
-        screenPosition.y -= relTextHeight;
-        Ogre::Real xPos = screenPosition.x - (relTextWidth * 0.5);
-        childOverlay.mOverlayContainer->setPosition(xPos, screenPosition.y);
-        childOverlay.mOverlayContainer->setDimensions(relTextWidth, relTextHeight);
+        y -= relTextHeight;
+        Ogre::Real xPos = x - (relTextWidth * 0.5);
+        childOverlay.setArea(xPos, y, relTextWidth, relTextHeight);
     }
 }
@@ -56,6 +56,12 @@ private:
     //! \brief Called to notify if the overlay is visible by the current camera or not
     void setOnScreen(bool onScreen);
 
+    //! \brief Shows or hides the container if its state changed
+    void setShown(bool shown);
+
+    //! \brief Sets the position and size of the container (relative to the screen) if they changed
+    void setArea(Ogre::Real x, Ogre::Real y, Ogre::Real width, Ogre::Real height);
+
     bool isDisplayed();
 
     Ogre::Real getWidth();
@@ -88,6 +94,13 @@ private:
 
     Ogre::Real mTimeToDisplay;
 
+    //! Current state of the container. Kept to avoid updating it when nothing changed
+    bool mIsShown;
+    Ogre::Real mAreaX;
+    Ogre::Real mAreaY;
+    Ogre::Real mAreaWidth;
+    Ogre::Real mAreaHeight;
+
     //! Font used to display the text
     Ogre::FontPtr mFont;
 };
@@ -95,8 +108,9 @@ private:
 class MovableTextOverlay
 {
 public:
-    MovableTextOverlay(const Ogre::String& name, const Ogre::MovableObject *followedMov,
-        Ogre::Camera* camera);
+    //! The overlay does not follow its entity by itself. The position where it should be displayed
+    //! is given to setScreenPosition (see CreatureOverlayStatus)
+    MovableTextOverlay(const Ogre::String& name);
 
     virtual ~MovableTextOverlay();
 
@@ -117,21 +131,19 @@ public:
 
     //! Displays the overlay during time seconds. If time < 0, the overlay will be always displayed
     void displayOverlay(uint32_t childOverlayId, Ogre::Real time);
-    void update(Ogre::Real timeSincelastFrame);
 
-private:
-    //! Computes the position of the head of the followed entity in the screen coordinates. Returns true if
-    //! the entity is on screen and position contains the position where the text should be displayed and false otherwise
-    bool computeOverlayPositionHead(Ogre::Vector2& position);
+    //! Updates the display time of the child overlays. Returns true if at least one is displayed
+    bool update(Ogre::Real timeSincelastFrame);
+
+    //! Displays the child overlays above the given position (in relative screen coordinates). If isOnScreen
+    //! is false, they are hidden
+    void setScreenPosition(bool isOnScreen, Ogre::Real x, Ogre::Real y);
 
+private:
     const Ogre::String mName;
-    const Ogre::MovableObject* mFollowedMov;
 
     Ogre::Overlay* mOverlay;
 
-    //! The camera used to display the scene
-    const Ogre::Camera* mCamera;
-
     std::vector<ChildOverlay> mChildOverlays;
 };
 #endif // MOVABLETEXTOVERLAY_H
@@ -38,6 +38,9 @@
 #include "utils/Helper.h"
 #include "utils/LogManager.h"
 #include "utils/MakeUnique.h"
+#include "utils/Metrics.h"
+#include "utils/ResourceManager.h"
+#include "utils/Tracing.h"
 
 #include <OgreCamera.h>
 #include <OgreRenderWindow.h>
@@ -90,6 +93,7 @@ ODFrameListener::ODFrameListener(const std::string& mainSceneFileName, Ogre::Ren
     OD_LOG_INF("Creating frame listener...");
 
     mRenderManager->createScene(mCameraManager.getViewport());
+    mGameMap->getAnimationScheduler().setEnabled(!ResourceManager::getSingleton().getNoAnimationLod());
 
     mRenderManager->getSceneManager()->addRenderQueueListener(this);
     //Set initial mouse clipping size
@@ -153,16 +157,24 @@ void ODFrameListener::exitApplication()
 
 void ODFrameListener::updateAnimations(Ogre::Real timeSinceLastFrame)
 {
+    OD_TRACE_SCOPE("ODFrameListener::updateAnimations");
     updateMenuScene(timeSinceLastFrame);
     MusicPlayer::getSingleton().update(static_cast<float>(timeSinceLastFrame));
     mRenderManager->updateRenderAnimations(timeSinceLastFrame);
     mGameMap->processDeletionQueues();
 
+    static Metrics::Histogram& updateTime = Metrics::getTimerHistogram("od_client_update_animations_ms",
+        "Time spent per frame updating the moves and animations of the entities");
+    Metrics::ScopedTimer timer(updateTime);
+    Ogre::Vector3 viewTarget = mCameraManager.getCameraViewTarget();
+    mGameMap->getAnimationScheduler().setViewTarget(Helper::round(viewTarget.x), Helper::round(viewTarget.y));
     mGameMap->updateAnimations(timeSinceLastFrame);
+    mRenderManager->updateCreatureOverlays(*mGameMap);
 }
 
 bool ODFrameListener::frameRenderingQueued(const Ogre::FrameEvent& evt)
 {
+    OD_TRACE_SCOPE("ODFrameListener::frameRenderingQueued");
     CEGUI::MouseCursor& mouseCursor = CEGUI::System::getSingleton().getDefaultGUIContext().getMouseCursor();
     CEGUI::Vector2<float> mousePos = mouseCursor.getDisplayIndependantPosition();
     RenderManager::getSingleton().moveCursor(mousePos.d_x, mousePos.d_y);
@@ -176,7 +188,10 @@ bool ODFrameListener::frameRenderingQueued(const Ogre::FrameEvent& evt)
     CEGUI::System::getSingleton().injectTimePulse(evt.timeSinceLastFrame);
     CEGUI::System::getSingleton().getDefaultGUIContext().injectTimePulse(evt.timeSinceLastFrame);
 
-    mModeManager->update(evt);
+    {
+        OD_TRACE_SCOPE("ModeManager::update");
+        mModeManager->update(evt);
+    }
 
     int64_t currentTurn = mGameMap->getTurnNumber();
 
@@ -186,13 +201,19 @@ bool ODFrameListener::frameRenderingQueued(const Ogre::FrameEvent& evt)
         updateAnimations(evt.timeSinceLastFrame);
     }
 
-    mCameraManager.updateCameraFrameTime(evt.timeSinceLastFrame);
-    mCameraManager.onFrameStarted();
+    {
+        OD_TRACE_SCOPE("CameraManager::onFrameStarted");
+        mCameraManager.updateCameraFrameTime(evt.timeSinceLastFrame);
+        mCameraManager.onFrameStarted();
+    }
 
-    SoundEffectsManager::getSingleton().updateListener(
-        evt.timeSinceLastFrame,
-        mCameraManager.getActiveCameraPosition(),
-        mCameraManager.getActiveCameraOrientation());
+    {
+        OD_TRACE_SCOPE("SoundEffectsManager::updateListener");
+        SoundEffectsManager::getSingleton().updateListener(
+            evt.timeSinceLastFrame,
+            mCameraManager.getActiveCameraPosition(),
+            mCameraManager.getActiveCameraOrientation());
+    }
 
     if((currentTurn != -1) && (mGameMap->getGamePaused()) && (!mExitRequested))
         return true;
@@ -207,15 +228,30 @@ bool ODFrameListener::frameRenderingQueued(const Ogre::FrameEvent& evt)
 
     printDebugInfo();
 
-    mGameMap.get()->processDeletionQueues();
-    ODClient::getSingleton().processClientSocketMessages();
-    ODClient::getSingleton().processClientNotifications();
+    {
+        OD_TRACE_SCOPE("GameMap::processDeletionQueues");
+        mGameMap.get()->processDeletionQueues();
+    }
+    {
+        // While the game is starting, the message budget is used to load its resources
+        OD_TRACE_SCOPE("ODClient::processClientSocketMessages");
+        int32_t budgetMs = static_cast<int32_t>(ResourceManager::getSingleton().getClientMessageBudgetMs());
+        if(!ODClient::getSingleton().processResourcePreloading(budgetMs))
+            ODClient::getSingleton().processClientSocketMessages(budgetMs);
+    }
+    {
+        OD_TRACE_SCOPE("ODClient::processClientNotifications");
+        ODClient::getSingleton().processClientNotifications();
+    }
+
+    Tracing::dumpIfRequested();
 
     return mContinue;
 }
 
 bool ODFrameListener::frameEnded(const Ogre::FrameEvent& evt)
 {
+    OD_TRACE_SCOPE("ODFrameListener::frameEnded");
     AbstractApplicationMode* currentMode = mModeManager->getCurrentMode();
     currentMode->onFrameEnded(evt);
 
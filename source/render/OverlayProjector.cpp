@@ -0,0 +1,163 @@
+/*
+ *  Copyright (C) 2011-2016  OpenDungeons Team
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "render/OverlayProjector.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+
+namespace
+{
+    const uint32_t INVALID_INDEX = 0xFFFFFFFF;
+
+    //! \brief Anchors closer than that to the camera plane are not projected
+    const float MIN_CLIP_W = 0.0001f;
+}
+
+OverlayProjector::OverlayProjector()
+{
+}
+
+uint32_t OverlayProjector::addAnchor()
+{
+    uint32_t anchorId;
+    if(mFreeIds.empty())
+    {
+        anchorId = static_cast<uint32_t>(mIndexById.size());
+        mIndexById.push_back(INVALID_INDEX);
+    }
+    else
+    {
+        anchorId = mFreeIds.back();
+        mFreeIds.pop_back();
+    }
+
+    mIndexById[anchorId] = static_cast<uint32_t>(mIdByIndex.size());
+    mIdByIndex.push_back(anchorId);
+    mX.push_back(0.0f);
+    mY.push_back(0.0f);
+    mZ.push_back(0.0f);
+    mScreenX.push_back(0.0f);
+    mScreenY.push_back(0.0f);
+    mIsOnScreen.push_back(0);
+    return anchorId;
+}
+
+void OverlayProjector::removeAnchor(uint32_t anchorId)
+{
+    if(!hasAnchor(anchorId))
+        return;
+
+    // We move the last anchor in place of the removed one
+    uint32_t index = mIndexById[anchorId];
+    uint32_t lastIndex = static_cast<uint32_t>(mIdByIndex.size() - 1);
+    uint32_t lastId = mIdByIndex[lastIndex];
+    mX[index] = mX[lastIndex];
+    mY[index] = mY[lastIndex];
+    mZ[index] = mZ[lastIndex];
+    mScreenX[index] = mScreenX[lastIndex];
+    mScreenY[index] = mScreenY[lastIndex];
+    mIsOnScreen[index] = mIsOnScreen[lastIndex];
+    mIdByIndex[index] = lastId;
+    mIndexById[lastId] = index;
+
+    mX.pop_back();
+    mY.pop_back();
+    mZ.pop_back();
+    mScreenX.pop_back();
+    mScreenY.pop_back();
+    mIsOnScreen.pop_back();
+    mIdByIndex.pop_back();
+
+    mIndexById[anchorId] = INVALID_INDEX;
+    mFreeIds.push_back(anchorId);
+}
+
+void OverlayProjector::setAnchorPosition(uint32_t anchorId, float x, float y, float z)
+{
+    if(!hasAnchor(anchorId))
+        return;
+
+    uint32_t index = mIndexById[anchorId];
+    mX[index] = x;
+    mY[index] = y;
+    mZ[index] = z;
+}
+
+bool OverlayProjector::hasAnchor(uint32_t anchorId) const
+{
+    return (anchorId < mIndexById.size()) && (mIndexById[anchorId] != INVALID_INDEX);
+}
+
+void OverlayProjector::project(const float* viewProjMatrix, float margin)
+{
+    const float m00 = viewProjMatrix[0], m01 = viewProjMatrix[1], m02 = viewProjMatrix[2], m03 = viewProjMatrix[3];
+    const float m10 = viewProjMatrix[4], m11 = viewProjMatrix[5], m12 = viewProjMatrix[6], m13 = viewProjMatrix[7];
+    const float m30 = viewProjMatrix[12], m31 = viewProjMatrix[13], m32 = viewProjMatrix[14], m33 = viewProjMatrix[15];
+    // Normalized device coordinates go from -1 to 1 so the margin is doubled
+    const float limit = 1.0f + 2.0f * margin;
+
+    const float* x = mX.data();
+    const float* y = mY.data();
+    const float* z = mZ.data();
+    float* screenX = mScreenX.data();
+    float* screenY = mScreenY.data();
+    uint32_t* isOnScreen = mIsOnScreen.data();
+    const size_t nbAnchors = mIdByIndex.size();
+    // The loop has no branch so that it can be vectorized: anchors behind the camera get
+    // meaningless (possibly infinite) coordinates but a negative score
+    for(size_t i = 0; i < nbAnchors; ++i)
+    {
+        float clipX = m00 * x[i] + m01 * y[i] + m02 * z[i] + m03;
+        float clipY = m10 * x[i] + m11 * y[i] + m12 * z[i] + m13;
+        float clipW = m30 * x[i] + m31 * y[i] + m32 * z[i] + m33;
+        float invW = 1.0f / clipW;
+        float ndcX = clipX * invW;
+        float ndcY = clipY * invW;
+        float extent = std::max(std::fabs(ndcX), std::fabs(ndcY));
+        float score = std::min(clipW - MIN_CLIP_W, limit - extent);
+        isOnScreen[i] = static_cast<uint32_t>(score >= 0.0f);
+        // We transform from coordinate space [-1, 1] to [0, 1]
+        screenX[i] = 0.5f + ndcX * 0.5f;
+        screenY[i] = 0.5f - ndcY * 0.5f;
+    }
+}
+
+bool OverlayProjector::isOnScreen(uint32_t anchorId) const
+{
+    if(!hasAnchor(anchorId))
+        return false;
+
+    return mIsOnScreen[mIndexById[anchorId]] != 0;
+}
+
+float OverlayProjector::getScreenX(uint32_t anchorId) const
+{
+    if(!hasAnchor(anchorId))
+        return 0.0f;
+
+    return mScreenX[mIndexById[anchorId]];
+}
+
+float OverlayProjector::getScreenY(uint32_t anchorId) const
+{
+    if(!hasAnchor(anchorId))
+        return 0.0f;
+
+    return mScreenY[mIndexById[anchorId]];
+}
@@ -0,0 +1,75 @@
+/*
+ *  Copyright (C) 2011-2016  OpenDungeons Team
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef OVERLAYPROJECTOR_H
+#define OVERLAYPROJECTOR_H
+
+#include <cstdint>
+#include <vector>
+
+//! \brief Projects on the screen the anchor points of the overlays following entities (like the
+//! creature status). Positions are stored in separate arrays so that every anchor can be
+//! projected in a single loop the compiler can vectorize instead of one matrix product per
+//! overlay. This does not depend on the renderer so that it can be tested without a GPU.
+class OverlayProjector
+{
+public:
+    OverlayProjector();
+
+    //! \brief Adds an anchor and returns its id. Ids of removed anchors are reused
+    uint32_t addAnchor();
+
+    //! \brief Removes the given anchor. Unknown ids are ignored, like in setAnchorPosition
+    void removeAnchor(uint32_t anchorId);
+
+    void setAnchorPosition(uint32_t anchorId, float x, float y, float z);
+
+    bool hasAnchor(uint32_t anchorId) const;
+
+    //! \brief Projects every anchor with the given view projection matrix (4x4, row major like
+    //! Ogre::Matrix4). Anchors behind the camera or farther than margin (in screen size ratio)
+    //! from the screen borders are considered off screen
+    void project(const float* viewProjMatrix, float margin);
+
+    //! \brief Results of the last call to project
+    bool isOnScreen(uint32_t anchorId) const;
+
+    //! \brief Position in relative screen coordinates: (0, 0) is the top left corner and (1, 1)
+    //! the bottom right one
+    float getScreenX(uint32_t anchorId) const;
+    float getScreenY(uint32_t anchorId) const;
+
+    inline uint32_t getNbAnchors() const
+    { return static_cast<uint32_t>(mIdByIndex.size()); }
+
+private:
+    //! \brief Anchor positions packed by index. Removing an anchor moves the last one in its place
+    std::vector<float> mX;
+    std::vector<float> mY;
+    std::vector<float> mZ;
+    std::vector<float> mScreenX;
+    std::vector<float> mScreenY;
+    //! \brief Not uint8_t because char stores may alias the positions, which prevents vectorizing
+    std::vector<uint32_t> mIsOnScreen;
+
+    std::vector<uint32_t> mIdByIndex;
+    //! \brief Index of the anchors by id. Free ids are set to an invalid index
+    std::vector<uint32_t> mIndexById;
+    std::vector<uint32_t> mFreeIds;
+};
+
+#endif // OVERLAYPROJECTOR_H
@@ -33,18 +33,28 @@
 #include "game/Seat.h"
 #include "gamemap/GameMap.h"
 #include "gamemap/TileSet.h"
+#include "render/CreatureInstancingManager.h"
 #include "render/CreatureOverlayStatus.h"
+#include "render/EntityInstancingManager.h"
+#include "render/MaterialVariantCache.h"
+#include "render/MeshGeometryCache.h"
+#include "render/OverlayProjector.h"
+#include "render/TileChunkManager.h"
 #include "rooms/Room.h"
+#include "utils/ConfigManager.h"
 #include "utils/Helper.h"
 #include "utils/LogManager.h"
+#include "utils/Metrics.h"
 #include "utils/ResourceManager.h"
 
 #include <OgreBone.h>
 #include <OgreCamera.h>
 #include <OgreCompositorManager.h>
 #include <OgreEntity.h>
+#include <OgreInstancedEntity.h>
 #include <OgreMaterialManager.h>
 #include <OgreMesh.h>
+#include <OgreMeshManager.h>
 #include <OgreMovableObject.h>
 #include <OgreParticleSystem.h>
 #include <OgrePrerequisites.h>
@@ -79,6 +89,10 @@ const Ogre::Real KEEPER_HAND_CREATURE_PICKED_SCALE = 0.05f;
 
 const Ogre::ColourValue BASE_AMBIENT_VALUE = Ogre::ColourValue(0.3f, 0.3f, 0.3f);
 
+//! \brief Creature overlays are still displayed when their anchor is this close (in screen size ratio)
+//! to the screen borders, like when a creature is partially on screen
+const float CREATURE_OVERLAY_SCREEN_MARGIN = 0.05f;
+
 RenderManager::RenderManager(Ogre::OverlaySystem* overlaySystem) :
     mHandAnimationState(nullptr),
     mViewport(nullptr),
@@ -97,7 +111,17 @@ RenderManager::RenderManager(Ogre::OverlaySystem* overlaySystem) :
 
     mCreatureSceneNode = mSceneManager->getRootSceneNode()->createChildSceneNode("Creature_scene_node");
     mTileSceneNode = mSceneManager->getRootSceneNode()->createChildSceneNode("Tile_scene_node");
+    mMaterialVariants.reset(new MaterialVariantCache(
+        [this](const std::string& materialName, const std::string& colorId, bool markedForDigging, bool playerHasVision)
+        {
+            return createColourizedMaterial(materialName, colorId, markedForDigging, playerHasVision);
+        }));
+    mMeshGeometries.reset(new MeshGeometryCache(*mMaterialVariants));
+    mTileChunks.reset(new TileChunkManager(mSceneManager, mTileSceneNode, *mMaterialVariants, *mMeshGeometries));
     mRoomSceneNode = mSceneManager->getRootSceneNode()->createChildSceneNode("Room_scene_node");
+    mInstancing.reset(new EntityInstancingManager(mSceneManager, mRoomSceneNode, *mMaterialVariants, *mMeshGeometries));
+    mCreatureInstancing.reset(new CreatureInstancingManager(mSceneManager));
+    mCreatureOverlayProjector.reset(new OverlayProjector);
     mLightSceneNode = mSceneManager->getRootSceneNode()->createChildSceneNode("Light_scene_node");
     mMainMenuSceneNode = mSceneManager->getRootSceneNode()->createChildSceneNode("MainMenu_scene_node");
 }
@@ -170,6 +194,39 @@ void RenderManager::initGameRenderer(GameMap* gameMap)
         dummyNode->attachObject(dummyEnt);
         mDummyEntities.push_back(dummyNode);
     }
+
+    prepareTileMaterials(*gameMap);
+}
+
+void RenderManager::prepareTileMaterials(const GameMap& gameMap)
+{
+    const TileSet* tileSet = gameMap.getTileSet();
+    if(tileSet == nullptr)
+    {
+        OD_LOG_WRN("No tileset loaded, tile materials will be built when needed");
+        return;
+    }
+
+    uint64_t nbMisses = mMaterialVariants->getNbMisses();
+    for(uint32_t i = static_cast<uint32_t>(TileVisual::nullTileVisual) + 1; i < static_cast<uint32_t>(TileVisual::countTileVisual); ++i)
+    {
+        TileVisual tileVisual = static_cast<TileVisual>(i);
+        // Only claimed tiles are colorized with the seat color (see Tile::shouldColorTileMesh)
+        bool isClaimed = (tileVisual == TileVisual::claimedGround) || (tileVisual == TileVisual::claimedFull);
+        for(const TileSetValue& tileSetValue : tileSet->getTileValues(tileVisual))
+        {
+            if(!isClaimed)
+            {
+                mTileChunks->prepareMaterials(tileSetValue.getMeshName(), tileSetValue.getMaterialName(), nullptr);
+                continue;
+            }
+
+            for(const Seat* seat : gameMap.getSeats())
+                mTileChunks->prepareMaterials(tileSetValue.getMeshName(), tileSetValue.getMaterialName(), seat);
+        }
+    }
+
+    OD_LOG_INF("Prepared " + Helper::toString(mMaterialVariants->getNbMisses() - nbMisses) + " tile materials");
 }
 
 void RenderManager::stopGameRenderer(GameMap*)
@@ -183,6 +240,8 @@ void RenderManager::stopGameRenderer(GameMap*)
         mSceneManager->destroyLight(mHandLight);
         mHandLight = nullptr;
     }
+
+    mTileChunks->clear();
 }
 
 void RenderManager::triggerCompositor(const std::string& compositorName)
@@ -436,6 +495,11 @@ const Ogre::Vector3& RenderManager::getMenuEntityScale(Ogre::SceneNode* node)
 
 void RenderManager::updateRenderAnimations(Ogre::Real timeSinceLastFrame)
 {
+    mTileChunks->updateDirtyChunks();
+    mInstancing->updateDirtyBatches();
+    // The weapons of instanced creatures follow the bones placed by the previous frame
+    mCreatureInstancing->updateBoneAttachments();
+
     if(mHandAnimationState != nullptr)
     {
         mHandAnimationState->addTime(timeSinceLastFrame);
@@ -447,6 +511,29 @@ void RenderManager::updateRenderAnimations(Ogre::Real timeSinceLastFrame)
     }
 }
 
+void RenderManager::updateCreatureOverlays(GameMap& gameMap)
+{
+    static Metrics::Histogram& overlayTime = Metrics::getTimerHistogram("od_client_creature_overlays_ms",
+        "Time spent per frame projecting and moving the creature overlays");
+    Metrics::ScopedTimer timer(overlayTime);
+
+    const Ogre::Camera* camera = mViewport->getCamera();
+    Ogre::Matrix4 viewProj = camera->getProjectionMatrix() * camera->getViewMatrix();
+    float viewProjMatrix[16];
+    for(int row = 0; row < 4; ++row)
+    {
+        for(int col = 0; col < 4; ++col)
+            viewProjMatrix[row * 4 + col] = static_cast<float>(viewProj[row][col]);
+    }
+    mCreatureOverlayProjector->project(viewProjMatrix, CREATURE_OVERLAY_SCREEN_MARGIN);
+
+    for(Creature* creature : gameMap.getCreatures())
+    {
+        if(creature->getOverlayStatus() != nullptr)
+            creature->getOverlayStatus()->updateScreenPosition();
+    }
+}
+
 void RenderManager::rrRefreshTile(const Tile& tile, const GameMap& gameMap, const Player& localPlayer)
 {
     if (tile.getEntityNode() == nullptr)
@@ -480,74 +567,23 @@ void RenderManager::rrRefreshTile(const Tile& tile, const GameMap& gameMap, cons
         meshName = tileSetValue.getMeshName();
     }
 
-    Ogre::Entity* tileMeshEnt = nullptr;
-    const std::string tileMeshName = tileName + "_tileMesh";
-    if(mSceneManager->hasEntity(tileMeshName))
-    {
-        tileMeshEnt = mSceneManager->getEntity(tileMeshName);
-        if(tileMeshEnt->getMesh()->getName().compare(meshName) != 0)
-        {
-            // Unlink and delete the old mesh
-            mSceneManager->getSceneNode(tileMeshName + "_node")->detachObject(tileMeshEnt);
-            mSceneManager->destroyEntity(tileMeshEnt);
-            tileMeshEnt = nullptr;
-        }
-    }
-
-    Ogre::SceneNode* tileMeshNode = nullptr;
-    std::string tileMeshNodeName = tileMeshName + "_node";
-    if(mSceneManager->hasSceneNode(tileMeshNodeName))
-        tileMeshNode = mSceneManager->getSceneNode(tileMeshNodeName);
-
-    if((tileMeshEnt == nullptr) && !meshName.empty())
-    {
-        tileMeshEnt = mSceneManager->createEntity(tileMeshName, meshName);
-        // If the node does not exist, we create it
-        if(tileMeshNode == nullptr)
-            tileMeshNode = tile.getEntityNode()->createChildSceneNode(tileMeshNodeName);
-        // Link the tile mesh back to the relevant scene node so OGRE will render it
-        tileMeshNode->attachObject(tileMeshEnt);
-
-        Ogre::MeshPtr meshPtr = tileMeshEnt->getMesh();
-        unsigned short src, dest;
-        if (!meshPtr->suggestTangentVectorBuildParams(Ogre::VES_TANGENT, src, dest))
-        {
-            meshPtr->buildTangentVectors(Ogre::VES_TANGENT, src, dest);
-        }
-    }
-
-    // We rescale and set the orientation that may have changed
-    if(tileMeshNode != nullptr)
-    {
-        tileMeshNode->resetOrientation();
+    // The tileset meshes are merged by chunks of tiles
+    Ogre::Quaternion q;
+    if(tileSetValue.getRotationX() != 0.0f)
+        q = q * Ogre::Quaternion(Ogre::Degree(tileSetValue.getRotationX()), Ogre::Vector3::UNIT_X);
 
-        // We rotate depending on the tileset
-        Ogre::Quaternion q;
-        if(tileSetValue.getRotationX() != 0.0f)
-            q = q * Ogre::Quaternion(Ogre::Degree(tileSetValue.getRotationX()), Ogre::Vector3::UNIT_X);
+    if(tileSetValue.getRotationY() != 0.0f)
+        q = q * Ogre::Quaternion(Ogre::Degree(tileSetValue.getRotationY()), Ogre::Vector3::UNIT_Y);
 
-        if(tileSetValue.getRotationY() != 0.0f)
-            q = q * Ogre::Quaternion(Ogre::Degree(tileSetValue.getRotationY()), Ogre::Vector3::UNIT_Y);
+    if(tileSetValue.getRotationZ() != 0.0f)
+        q = q * Ogre::Quaternion(Ogre::Degree(tileSetValue.getRotationZ()), Ogre::Vector3::UNIT_Z);
 
-        if(tileSetValue.getRotationZ() != 0.0f)
-            q = q * Ogre::Quaternion(Ogre::Degree(tileSetValue.getRotationZ()), Ogre::Vector3::UNIT_Z);
+    Seat* seatColor = nullptr;
+    if(tile.shouldColorTileMesh())
+        seatColor = tile.getSeat();
 
-        if(q != Ogre::Quaternion::IDENTITY)
-            tileMeshNode->rotate(q);
-    }
-
-    if(tileMeshEnt != nullptr)
-    {
-        // We replace the material if required by the tileset
-        if(!tileSetValue.getMaterialName().empty())
-            tileMeshEnt->setMaterialName(tileSetValue.getMaterialName());
-
-        Seat* seatColor = nullptr;
-        if(tile.shouldColorTileMesh())
-            seatColor = tile.getSeat();
-
-        colourizeEntity(tileMeshEnt, seatColor, isMarked, vision);
-    }
+    mTileChunks->setTileMesh(tile.getX(), tile.getY(), meshName, tileSetValue.getMaterialName(), q,
+        seatColor, isMarked, vision);
 
     // We display the custom mesh if there is one
     const std::string customMeshName = tileName + "_customMesh";
@@ -626,19 +662,7 @@ void RenderManager::rrDestroyTile(Tile& tile)
         mSceneManager->destroyEntity(selectorEnt);
     }
 
-    const std::string tileMeshName = tileName + "_tileMesh";
-    if(mSceneManager->hasSceneNode(tileMeshName + "_node"))
-    {
-        Ogre::SceneNode* tileMeshNode = mSceneManager->getSceneNode(tileMeshName + "_node");
-        if(mSceneManager->hasEntity(tileMeshName))
-        {
-            Ogre::Entity* ent = mSceneManager->getEntity(tileMeshName);
-            tileMeshNode->detachObject(ent);
-            mSceneManager->destroyEntity(ent);
-        }
-        tile.getEntityNode()->removeChild(tileMeshNode);
-        mSceneManager->destroySceneNode(tileMeshNode);
-    }
+    mTileChunks->removeTile(tile.getX(), tile.getY());
 
     const std::string customMeshName = tileName + "_customMesh";
     if(mSceneManager->hasSceneNode(customMeshName + "_node"))
@@ -687,6 +711,11 @@ void RenderManager::rrTemporalMarkTile(Tile* curTile)
     ent->setVisible(bb);
 }
 
+void RenderManager::rrCullTile(const Tile& tile, bool isCulled)
+{
+    mTileChunks->setTileInView(tile.getX(), tile.getY(), !isCulled);
+}
+
 void RenderManager::rrDetachEntity(GameEntity* entity)
 {
     Ogre::SceneNode* node = entity->getEntityNode();
@@ -709,7 +738,18 @@ void RenderManager::rrCreateRenderedMovableEntity(RenderedMovableEntity* rendere
     node->setPosition(renderedMovableEntity->getPosition());
     node->roll(Ogre::Degree(renderedMovableEntity->getRotationAngle()));
     Ogre::Entity* ent = nullptr;
-    if(!meshName.empty())
+    if(!meshName.empty() && renderedMovableEntity->canBeInstanced() &&
+       (renderedMovableEntity->getOpacity() >= 1.0f))
+    {
+        // The node is kept for particle effects and in case the object needs its entity later
+        InstanceGroups::InstanceData data;
+        data.mX = static_cast<float>(renderedMovableEntity->getPosition().x);
+        data.mY = static_cast<float>(renderedMovableEntity->getPosition().y);
+        data.mZ = static_cast<float>(renderedMovableEntity->getPosition().z);
+        data.mRotationAngle = static_cast<float>(renderedMovableEntity->getRotationAngle());
+        mInstancedEntities[renderedMovableEntity] = mInstancing->addInstance(meshName + ".mesh", nullptr, data);
+    }
+    else if(!meshName.empty())
     {
         ent = mSceneManager->createEntity(tempString, meshName + ".mesh");
         node->attachObject(ent);
@@ -726,12 +766,7 @@ void RenderManager::rrCreateRenderedMovableEntity(RenderedMovableEntity* rendere
         if(posTile == nullptr)
             return;
 
-        std::string tileName = posTile->getOgreNamePrefix() + posTile->getName();
-        if (!mSceneManager->hasEntity(tileName))
-            return;
-
-        Ogre::Entity* entity = mSceneManager->getEntity(tileName);
-        entity->setVisible(false);
+        mTileChunks->setTileMeshVisible(posTile->getX(), posTile->getY(), false);
     }
 
     if ((ent != nullptr) && (renderedMovableEntity->getOpacity() < 1.0f))
@@ -743,6 +778,12 @@ void RenderManager::rrDestroyRenderedMovableEntity(RenderedMovableEntity* curRen
     std::string tempString = curRenderedMovableEntity->getOgreNamePrefix()
                              + curRenderedMovableEntity->getName();
     Ogre::SceneNode* node = curRenderedMovableEntity->getEntityNode();
+    auto it = mInstancedEntities.find(curRenderedMovableEntity);
+    if(it != mInstancedEntities.end())
+    {
+        mInstancing->removeInstance(it->second);
+        mInstancedEntities.erase(it);
+    }
     if(mSceneManager->hasEntity(tempString))
     {
         Ogre::Entity* ent = mSceneManager->getEntity(tempString);
@@ -760,52 +801,48 @@ void RenderManager::rrDestroyRenderedMovableEntity(RenderedMovableEntity* curRen
         if(posTile == nullptr)
             return;
 
-        std::string tileName = posTile->getOgreNamePrefix() + posTile->getName();
-        if (!mSceneManager->hasEntity(tileName))
-            return;
-
-        Ogre::Entity* entity = mSceneManager->getEntity(tileName);
+        bool isVisible = true;
         if (posTile->getCoveringBuilding() != nullptr)
-            entity->setVisible(posTile->getCoveringBuilding()->shouldDisplayGroundTile());
-        else
-            entity->setVisible(true);
+            isVisible = posTile->getCoveringBuilding()->shouldDisplayGroundTile();
+
+        mTileChunks->setTileMeshVisible(posTile->getX(), posTile->getY(), isVisible);
     }
 }
 
 void RenderManager::rrUpdateEntityOpacity(RenderedMovableEntity* entity)
 {
-    std::string entStr = entity->getOgreNamePrefix() + entity->getName();
-    Ogre::Entity* ogreEnt = mSceneManager->hasEntity(entStr) ? mSceneManager->getEntity(entStr) : nullptr;
-    if (ogreEnt == nullptr)
+    // Instanced objects are always opaque
+    if(entity->getOpacity() < 1.0f)
+        stopInstancing(entity);
+
+    if(mInstancedEntities.count(entity) == 0)
     {
-        OD_LOG_INF("Update opacity: Couldn't find entity: " + entStr);
-        return;
-    }
+        std::string entStr = entity->getOgreNamePrefix() + entity->getName();
+        Ogre::Entity* ogreEnt = mSceneManager->hasEntity(entStr) ? mSceneManager->getEntity(entStr) : nullptr;
+        if (ogreEnt == nullptr)
+        {
+            OD_LOG_INF("Update opacity: Couldn't find entity: " + entStr);
+            return;
+        }
 
-    setEntityOpacity(ogreEnt, entity->getOpacity());
+        setEntityOpacity(ogreEnt, entity->getOpacity());
+    }
 
     // We add the tile if it is required and the opacity is 1. Otherwise, we show it (in case the trap gets deactivated)
     bool tileVisible = (!entity->getHideCoveredTile() || (entity->getOpacity() < 1.0f));
     Tile* posTile = entity->getPositionTile();
     if(posTile != nullptr)
-    {
-        std::string tileName = posTile->getOgreNamePrefix() + posTile->getName();
-        if (mSceneManager->hasEntity(tileName))
-        {
-            Ogre::Entity* ogreEntity = mSceneManager->getEntity(tileName);
-            ogreEntity->setVisible(tileVisible);
-        }
-    }
+        mTileChunks->setTileMeshVisible(posTile->getX(), posTile->getY(), tileVisible);
 }
 
 void RenderManager::rrCreateCreature(Creature* curCreature)
 {
     const std::string& meshName = curCreature->getDefinition()->getMeshName();
 
-    // Load the mesh for the creature
+    // Load the mesh for the creature. The tangents are built before the mesh is instanced
     std::string creatureName = curCreature->getOgreNamePrefix() + curCreature->getName();
-    Ogre::Entity* ent = mSceneManager->createEntity(creatureName, meshName);
-    Ogre::MeshPtr meshPtr = ent->getMesh();
+    Ogre::MeshPtr meshPtr = Ogre::MeshManager::getSingleton().load(meshName,
+        Ogre::ResourceGroupManager::AUTODETECT_RESOURCE_GROUP_NAME);
     unsigned short src, dest;
     if (!meshPtr->suggestTangentVectorBuildParams(Ogre::VES_TANGENT, src, dest))
     {
@@ -815,11 +852,24 @@ void RenderManager::rrCreateCreature(Creature* curCreature)
     Ogre::SceneNode* node = mCreatureSceneNode->createChildSceneNode(creatureName + "_node");
     curCreature->setEntityNode(node);
     node->setPosition(curCreature->getPosition());
-    node->attachObject(ent);
     curCreature->setParentSceneNode(node->getParentSceneNode());
 
-    Ogre::Camera* cam = mViewport->getCamera();
-    CreatureOverlayStatus* creatureOverlay = new CreatureOverlayStatus(curCreature, ent, cam);
+    // Creatures sharing a mesh are drawn by the same batches when the mesh can be instanced
+    Ogre::InstancedEntity* instance = nullptr;
+    if(mCreatureInstancing->canBeInstanced(meshName))
+        instance = mCreatureInstancing->createInstance(meshName, node);
+
+    Ogre::MovableObject* creatureObject = instance;
+    if(instance != nullptr)
+        mInstancedCreatures[curCreature] = instance;
+    else
+    {
+        Ogre::Entity* ent = mSceneManager->createEntity(creatureName, meshName);
+        node->attachObject(ent);
+        creatureObject = ent;
+    }
+
+    CreatureOverlayStatus* creatureOverlay = new CreatureOverlayStatus(curCreature, creatureObject, *mCreatureOverlayProjector);
     curCreature->setOverlayStatus(creatureOverlay);
 
     creatureOverlay->displayHealthOverlay(mCreatureTextOverlayDisplayed ? -1.0 : 0.0);
@@ -833,6 +883,19 @@ void RenderManager::rrDestroyCreature(Creature* curCreature)
         curCreature->setOverlayStatus(nullptr);
     }
 
+    auto it = mInstancedCreatures.find(curCreature);
+    if(it != mInstancedCreatures.end())
+    {
+        Ogre::SceneNode* creatureNode = curCreature->getEntityNode();
+        mCreatureInstancing->destroyInstance(it->second);
+        mInstancedCreatures.erase(it);
+        mCreatureSceneNode->removeChild(creatureNode);
+        curCreature->setParentSceneNode(nullptr);
+        curCreature->setEntityNode(nullptr);
+        mSceneManager->destroySceneNode(creatureNode->getName());
+        return;
+    }
+
     std::string creatureName = curCreature->getOgreNamePrefix() + curCreature->getName();
     if (mSceneManager->hasEntity(creatureName))
     {
@@ -849,6 +912,7 @@ void RenderManager::rrDestroyCreature(Creature* curCreature)
 
 void RenderManager::rrOrientEntityToward(MovableGameEntity* gameEntity, const Ogre::Vector3& direction)
 {
+    stopInstancing(gameEntity);
     Ogre::SceneNode* node = mSceneManager->getSceneNode(gameEntity->getOgreNamePrefix() + gameEntity->getName() + "_node");
     Ogre::Vector3 tempVector = node->getOrientation() * Ogre::Vector3::NEGATIVE_UNIT_Y;
 
@@ -878,17 +942,26 @@ void RenderManager::rrScaleCreature(Creature& creature)
 
 void RenderManager::rrCreateWeapon(Creature* curCreature, const Weapon* curWeapon, const std::string& hand)
 {
-    Ogre::Entity* ent = mSceneManager->getEntity(curCreature->getOgreNamePrefix() + curCreature->getName());
+    std::string creatureName = curCreature->getOgreNamePrefix() + curCreature->getName();
+    auto it = mInstancedCreatures.find(curCreature);
+    Ogre::Entity* ent = nullptr;
+    Ogre::SkeletonInstance* skeleton = nullptr;
+    if(it != mInstancedCreatures.end())
+        skeleton = it->second->getSkeleton();
+    else
+    {
+        ent = mSceneManager->getEntity(creatureName);
+        skeleton = ent->getSkeleton();
+    }
+
     std::string weaponName = curWeapon->getOgreNamePrefix() + hand;
-    if(!ent->getSkeleton()->hasBone(weaponName))
+    if((skeleton == nullptr) || !skeleton->hasBone(weaponName))
     {
-        OD_LOG_WRN("Tried to add weapons to entity \"" + ent->getName() + " \" using model \"" +
-                              ent->getMesh()->getName() + "\" that is missing the required bone \"" +
+        OD_LOG_WRN("Tried to add weapons to entity \"" + creatureName + " \" using model \"" +
+                              curCreature->getMeshName() + "\" that is missing the required bone \"" +
                               curWeapon->getOgreNamePrefix() + hand + "\"");
         return;
     }
-    Ogre::Bone* weaponBone = ent->getSkeleton()->getBone(
-                                curWeapon->getOgreNamePrefix() + hand);
     Ogre::Entity* weaponEntity = mSceneManager->createEntity(curWeapon->getOgreNamePrefix()
                                 + hand + "_" + curCreature->getName(),
                                 curWeapon->getMeshName());
@@ -898,7 +971,13 @@ void RenderManager::rrCreateWeapon(Creature* curCreature, const Weapon* curWeapo
     rotationQuaternion.FromAngleAxis(Ogre::Degree(-90.0), Ogre::Vector3(1.0,
                                     0.0, 0.0));
 
-    ent->attachObjectToBone(weaponBone->getName(), weaponEntity,
+    if(ent == nullptr)
+    {
+        mCreatureInstancing->attachObjectToBone(it->second, weaponName, weaponEntity, rotationQuaternion);
+        return;
+    }
+
+    ent->attachObjectToBone(weaponName, weaponEntity,
                             rotationQuaternion);
 }
 
@@ -908,6 +987,7 @@ void RenderManager::rrDestroyWeapon(Creature* curCreature, const Weapon* curWeap
     if(mSceneManager->hasEntity(weaponEntityName))
     {
         Ogre::Entity* weaponEntity = mSceneManager->getEntity(weaponEntityName);
+        mCreatureInstancing->detachObjectFromBone(weaponEntity);
         weaponEntity->detachFromParent();
         mSceneManager->destroyEntity(weaponEntity);
     }
@@ -989,6 +1069,9 @@ void RenderManager::rrDestroyMapLightVisualIndicator(MapLight* curMapLight)
 
 void RenderManager::rrPickUpEntity(GameEntity* curEntity, Player* localPlayer)
 {
+    stopInstancing(curEntity);
+    // Instances are drawn with their batch which cannot be in the keeper hand render queue
+    stopCreatureInstancing(curEntity);
     Ogre::Entity* ent = mSceneManager->getEntity("keeperHandEnt");
     if(ent->hasAnimationState("Pickup"))
         mHandAnimationState = setEntityAnimation(ent, "Pickup", false);
@@ -1136,21 +1219,16 @@ void RenderManager::rrDestroySeatVisionVisualDebug(int seatId, Tile* tile)
 
 void RenderManager::rrSetObjectAnimationState(MovableGameEntity* curAnimatedObject, const std::string& animation, bool loop)
 {
-    std::string objectName = curAnimatedObject->getOgreNamePrefix()
-        + curAnimatedObject->getName();
-    if (!mSceneManager->hasEntity(objectName))
-        return;
-
-    Ogre::Entity* objectEntity = mSceneManager->getEntity(objectName);
-
+    stopInstancing(curAnimatedObject);
     // Can't animate entities without skeleton
-    if (!objectEntity->hasSkeleton())
+    Ogre::AnimationStateSet* animationSet = getEntityAnimationStates(curAnimatedObject);
+    if (animationSet == nullptr)
         return;
 
     std::string anim = animation;
 
     // Handle the case where this entity does not have the requested animation.
-    while (!objectEntity->getSkeleton()->hasAnimation(anim))
+    while (!animationSet->hasAnimationState(anim))
     {
         // Try to change the unexisting animation to a close existing one.
         if (anim == EntityAnimation::sleep_anim)
@@ -1179,10 +1257,10 @@ void RenderManager::rrSetObjectAnimationState(MovableGameEntity* curAnimatedObje
         }
     }
 
-    if (!objectEntity->getSkeleton()->hasAnimation(anim))
+    if (!animationSet->hasAnimationState(anim))
         return;
 
-    Ogre::AnimationState* animState = setEntityAnimation(objectEntity, anim, loop);
+    Ogre::AnimationState* animState = setEntityAnimation(animationSet, anim, loop);
     curAnimatedObject->setAnimationState(animState);
 }
 void RenderManager::rrMoveEntity(GameEntity* entity, const Ogre::Vector3& position)
@@ -1194,6 +1272,13 @@ void RenderManager::rrMoveEntity(GameEntity* entity, const Ogre::Vector3& positi
     }
 
     entity->getEntityNode()->setPosition(position);
+
+    auto it = mInstancedEntities.find(entity);
+    if(it != mInstancedEntities.end())
+    {
+        mInstancing->setPosition(it->second, static_cast<float>(position.x),
+            static_cast<float>(position.y), static_cast<float>(position.z));
+    }
 }
 
 void RenderManager::rrMoveMapLightFlicker(MapLight* mapLight, const Ogre::Vector3& position)
@@ -1284,20 +1369,25 @@ void RenderManager::colourizeEntity(Ogre::Entity *ent, const Seat* seat, bool ma
     {
         Ogre::SubEntity *tempSubEntity = ent->getSubEntity(i);
 
-        std::string materialName = tempSubEntity->getMaterialName();
-        // If the material name have been modified, we restore the original name
-        std::size_t index = materialName.find("##");
-        if(index != std::string::npos)
-            materialName = materialName.substr(0, index);
-
-        materialName = colourizeMaterial(materialName, seat, markedForDigging, playerHasVision);
-        tempSubEntity->setMaterialName(materialName);
+        // If the material name have been modified, the cache finds the original material
+        const std::string& currentName = tempSubEntity->getMaterialName();
+        const std::string& materialName = colourizeMaterial(currentName, seat, markedForDigging, playerHasVision);
+        if(materialName != currentName)
+            tempSubEntity->setMaterialName(materialName);
     }
 }
 
-std::string RenderManager::colourizeMaterial(const std::string& materialName, const Seat* seat, bool markedForDigging, bool playerHasVision)
+const std::string& RenderManager::colourizeMaterial(const std::string& materialName, const Seat* seat, bool markedForDigging, bool playerHasVision)
 {
-    if (seat == nullptr && !markedForDigging && playerHasVision)
+    const std::string& colorId = (seat != nullptr) ? seat->getColorId() : MaterialVariantCache::NO_COLOR;
+    return mMaterialVariants->getVariant(mMaterialVariants->getMaterialId(materialName), colorId,
+        markedForDigging, playerHasVision);
+}
+
+std::string RenderManager::createColourizedMaterial(const std::string& materialName, const std::string& colorId, bool markedForDigging, bool playerHasVision)
+{
+    bool colourized = !colorId.empty();
+    if (!colourized && !markedForDigging && playerHasVision)
         return materialName;
 
     std::stringstream tempSS;
@@ -1307,8 +1397,8 @@ std::string RenderManager::colourizeMaterial(const std::string& materialName, co
     tempSS << materialName << "##";
 
     // Create the material name.
-    if(seat != nullptr)
-        tempSS << "Color_" << seat->getColorId() << "_" ;
+    if(colourized)
+        tempSS << "Color_" << colorId << "_" ;
     else
         tempSS << "Color_null_" ;
 
@@ -1331,10 +1421,6 @@ std::string RenderManager::colourizeMaterial(const std::string& materialName, co
 
     // If not yet, then do so
 
-    // Check to see if we find a seat with the requested color, if not then just use the original, uncolored material.
-    if (seat == nullptr && !markedForDigging && playerHasVision)
-        return materialName;
-
     Ogre::MaterialPtr oldMaterial = Ogre::MaterialManager::getSingleton().getByName(materialName);
 
     //std::cout << "\nMaterial does not exist, creating a new one.";
@@ -1377,11 +1463,11 @@ std::string RenderManager::colourizeMaterial(const std::string& materialName, co
             pass->setAmbient(color);
             pass->setDiffuse(color);
         }
-        if (seat != nullptr)
+        if (colourized)
         {
             // Color the material with the Seat's color.
             Ogre::Pass* pass = technique->getPass(technique->getNumPasses() - 1);
-            Ogre::ColourValue color = seat->getColorValue();
+            Ogre::ColourValue color = ConfigManager::getSingleton().getColorFromId(colorId);
             color.a = 1.0;
             pass->setAmbient(color);
             pass->setDiffuse(color);
@@ -1394,10 +1480,10 @@ std::string RenderManager::colourizeMaterial(const std::string& materialName, co
 
 void RenderManager::rrCarryEntity(Creature* carrier, GameEntity* carried)
 {
-    Ogre::Entity* carrierEnt = mSceneManager->getEntity(carrier->getOgreNamePrefix() + carrier->getName());
-    Ogre::Entity* carriedEnt = mSceneManager->getEntity(carried->getOgreNamePrefix() + carried->getName());
-    Ogre::SceneNode* carrierNode = mSceneManager->getSceneNode(carrierEnt->getName() + "_node");
-    Ogre::SceneNode* carriedNode = mSceneManager->getSceneNode(carriedEnt->getName() + "_node");
+    stopInstancing(carried);
+    // Instanced creatures have no entity so we use the nodes directly
+    Ogre::SceneNode* carrierNode = carrier->getEntityNode();
+    Ogre::SceneNode* carriedNode = carried->getEntityNode();
     carried->setParentNodeDetachFlags(
         EntityParentNodeAttach::DETACH_CARRIED, true);
     carriedNode->setInheritScale(false);
@@ -1408,10 +1494,9 @@ void RenderManager::rrCarryEntity(Creature* carrier, GameEntity* carried)
 
 void RenderManager::rrReleaseCarriedEntity(Creature* carrier, GameEntity* carried)
 {
-    Ogre::Entity* carrierEnt = mSceneManager->getEntity(carrier->getOgreNamePrefix() + carrier->getName());
-    Ogre::Entity* carriedEnt = mSceneManager->getEntity(carried->getOgreNamePrefix() + carried->getName());
-    Ogre::SceneNode* carrierNode = mSceneManager->getSceneNode(carrierEnt->getName() + "_node");
-    Ogre::SceneNode* carriedNode = mSceneManager->getSceneNode(carriedEnt->getName() + "_node");
+    stopInstancing(carried);
+    Ogre::SceneNode* carrierNode = carrier->getEntityNode();
+    Ogre::SceneNode* carriedNode = carried->getEntityNode();
     carrierNode->removeChild(carriedNode);
     carried->setParentNodeDetachFlags(
         EntityParentNodeAttach::DETACH_CARRIED, false);
@@ -1640,9 +1725,93 @@ void RenderManager::changeRenderQueueRecursive(Ogre::SceneNode* node, uint8_t re
     }
 }
 
+void RenderManager::stopInstancing(const GameEntity* entity)
+{
+    auto it = mInstancedEntities.find(entity);
+    if(it == mInstancedEntities.end())
+        return;
+
+    mInstancing->removeInstance(it->second);
+    mInstancedEntities.erase(it);
+
+    Ogre::Entity* ent = mSceneManager->createEntity(entity->getOgreNamePrefix() + entity->getName(),
+        entity->getMeshName() + ".mesh");
+    entity->getEntityNode()->attachObject(ent);
+}
+
+void RenderManager::stopCreatureInstancing(GameEntity* entity)
+{
+    auto it = mInstancedCreatures.find(entity);
+    if(it == mInstancedCreatures.end())
+        return;
+
+    Ogre::InstancedEntity* instance = it->second;
+    mInstancedCreatures.erase(it);
+
+    // We keep playing the current animation where it was
+    const Ogre::AnimationState* playedState = nullptr;
+    Ogre::AnimationStateSet* instanceStates = instance->hasSkeleton() ? instance->getAllAnimationStates() : nullptr;
+    if(instanceStates != nullptr)
+    {
+        for(Ogre::AnimationStateIterator asi =
+            instanceStates->getAnimationStateIterator(); asi.hasMoreElements(); asi.moveNext())
+        {
+            if(!asi.peekNextValue()->getEnabled())
+                continue;
+
+            playedState = asi.peekNextValue();
+            break;
+        }
+    }
+    std::string animation = (playedState != nullptr) ? playedState->getAnimationName() : std::string();
+    Ogre::Real timePosition = (playedState != nullptr) ? playedState->getTimePosition() : 0;
+    bool loop = (playedState != nullptr) ? playedState->getLoop() : true;
+
+    std::vector<CreatureInstancingManager::BoneAttachment> attachments = mCreatureInstancing->detachObjectsFromBones(instance);
+    std::string meshName = mCreatureInstancing->getMeshName(instance);
+    mCreatureInstancing->destroyInstance(instance);
+
+    Ogre::Entity* ent = mSceneManager->createEntity(entity->getOgreNamePrefix() + entity->getName(), meshName);
+    entity->getEntityNode()->attachObject(ent);
+    for(const CreatureInstancingManager::BoneAttachment& attachment : attachments)
+        ent->attachObjectToBone(attachment.mBoneName, attachment.mObject, attachment.mOffsetOrientation);
+
+    // Only creatures are instanced
+    Creature* creature = static_cast<Creature*>(entity);
+    if(creature->getOverlayStatus() != nullptr)
+        creature->getOverlayStatus()->setEntity(ent);
+
+    Ogre::AnimationState* animState = nullptr;
+    if(!animation.empty())
+    {
+        animState = setEntityAnimation(ent, animation, loop);
+        if(animState != nullptr)
+            animState->setTimePosition(timePosition);
+    }
+    creature->setAnimationState(animState);
+}
+
+Ogre::AnimationStateSet* RenderManager::getEntityAnimationStates(const GameEntity* entity)
+{
+    auto it = mInstancedCreatures.find(entity);
+    if(it != mInstancedCreatures.end())
+        return it->second->hasSkeleton() ? it->second->getAllAnimationStates() : nullptr;
+
+    std::string objectName = entity->getOgreNamePrefix() + entity->getName();
+    if(!mSceneManager->hasEntity(objectName))
+        return nullptr;
+
+    Ogre::Entity* objectEntity = mSceneManager->getEntity(objectName);
+    return objectEntity->hasSkeleton() ? objectEntity->getAllAnimationStates() : nullptr;
+}
+
 Ogre::AnimationState* RenderManager::setEntityAnimation(Ogre::Entity* ent, const std::string& animation, bool loop)
 {
-    Ogre::AnimationStateSet* animationSet = ent->getAllAnimationStates();
+    return setEntityAnimation(ent->getAllAnimationStates(), animation, loop);
+}
+
+Ogre::AnimationState* RenderManager::setEntityAnimation(Ogre::AnimationStateSet* animationSet, const std::string& animation, bool loop)
+{
     if(animationSet == nullptr)
         return nullptr;
 
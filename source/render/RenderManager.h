@@ -26,22 +26,31 @@
 #include <OgreSingleton.h>
 #include <OgreMath.h>
 #include <cstdint>
+#include <map>
+#include <memory>
 
 class GameMap;
 class Building;
+class CreatureInstancingManager;
 class Seat;
 class Tile;
 class GameEntity;
 class MovableGameEntity;
+class EntityInstancingManager;
 class MapLight;
+class MaterialVariantCache;
+class MeshGeometryCache;
 class Creature;
 class Player;
 class RenderedMovableEntity;
+class OverlayProjector;
+class TileChunkManager;
 class Weapon;
 
 namespace Ogre
 {
 class AnimationState;
+class AnimationStateSet;
 class OverlaySystem;
 class SceneManager;
 class SceneNode;
@@ -66,6 +75,10 @@ public:
     //! \brief Loop through the render requests in the queue and process them
     void updateRenderAnimations(Ogre::Real timeSinceLastFrame);
 
+    //! \brief Projects the anchors of the creature overlays in one pass and moves the overlays.
+    //! Should be called after the creatures are updated
+    void updateCreatureOverlays(GameMap& gameMap);
+
     //! \brief Initialize the renderer when a new game (Game or Editor) is launched
     void initGameRenderer(GameMap* gameMap);
     void stopGameRenderer(GameMap*);
@@ -100,6 +113,9 @@ public:
     void rrCreateTile(Tile& tile, const GameMap& gameMap, const Player& localPlayer);
     void rrDestroyTile(Tile& tile);
     void rrTemporalMarkTile(Tile* curTile);
+    //! \brief Called when the tile culling shows or hides a tile. The ground meshes are merged by
+    //! chunks so a chunk is only hidden when none of its tiles is shown
+    void rrCullTile(const Tile& tile, bool isCulled);
     void rrDetachEntity(GameEntity* curEntity);
     void rrAttachEntity(GameEntity* curEntity);
     void rrCreateRenderedMovableEntity(RenderedMovableEntity* curRenderedMovableEntity);
@@ -186,7 +202,16 @@ private:
     //! \note If the material (wall tiles only) is marked for digging, a yellow color is added
     //! to the given color.
     //! \returns The new material name according to the current colorization.
-    std::string colourizeMaterial(const std::string& materialName, const Seat* seat, bool markedForDigging, bool playerHasVision);
+    const std::string& colourizeMaterial(const std::string& materialName, const Seat* seat, bool markedForDigging, bool playerHasVision);
+
+    //! \brief Clones the given material and colorizes it with the given seat color (if not empty).
+    //! Called by mMaterialVariants the first time a variant is needed
+    //! \returns The name of the created material.
+    std::string createColourizedMaterial(const std::string& materialName, const std::string& colorId, bool markedForDigging, bool playerHasVision);
+
+    //! \brief Builds the colorized tile materials that can be used on the given map so that
+    //! no material is cloned while playing
+    void prepareTileMaterials(const GameMap& gameMap);
 
     //! \brief Colorize an entity with the team corresponding color.
     //! \Note: if the entity is marked for digging (wall tiles only), then a yellow color
@@ -197,8 +222,22 @@ private:
     //! \returns The new material name according to the current opacity.
     std::string setMaterialOpacity(const std::string& materialName, float opacity);
 
+    //! \brief If the given entity is displayed by mInstancing, removes its instance and creates
+    //! its own Ogre entity. Should be called before using the Ogre entity of a RenderedMovableEntity
+    void stopInstancing(const GameEntity* entity);
+
+    //! \brief If the given creature is displayed by mCreatureInstancing, replaces its instance by an
+    //! Ogre entity playing the same animation and holding the same weapons. Should be called before
+    //! changing the render queue of the creature. The creature is not instanced again afterwards
+    void stopCreatureInstancing(GameEntity* entity);
+
+    //! \brief Returns the animations of the entity or instance displaying the given entity or nullptr
+    //! if it has no skeleton
+    Ogre::AnimationStateSet* getEntityAnimationStates(const GameEntity* entity);
+
     //! \brief Disables all animations of the given entity and starts the given one
     Ogre::AnimationState* setEntityAnimation(Ogre::Entity* ent, const std::string& animation, bool loop);
+    Ogre::AnimationState* setEntityAnimation(Ogre::AnimationStateSet* animationSet, const std::string& animation, bool loop);
 
     //! \brief The main scene manager reference. Don't delete it.
     Ogre::SceneManager* mSceneManager;
@@ -210,6 +249,30 @@ private:
     Ogre::SceneNode* mLightSceneNode;
     Ogre::SceneNode* mMainMenuSceneNode;
 
+    //! \brief Colorized materials already built
+    std::unique_ptr<MaterialVariantCache> mMaterialVariants;
+
+    //! \brief Geometry of the meshes merged by mTileChunks and mInstancing
+    std::unique_ptr<MeshGeometryCache> mMeshGeometries;
+
+    //! \brief Displays the tileset meshes of the tiles merged by chunks
+    std::unique_ptr<TileChunkManager> mTileChunks;
+
+    //! \brief Displays the static room objects without an entity per object
+    std::unique_ptr<EntityInstancingManager> mInstancing;
+
+    //! \brief Instance ids of the entities displayed by mInstancing
+    std::map<const GameEntity*, uint32_t> mInstancedEntities;
+
+    //! \brief Displays the creatures whose mesh has instancing materials
+    std::unique_ptr<CreatureInstancingManager> mCreatureInstancing;
+
+    //! \brief Instances of the creatures displayed by mCreatureInstancing
+    std::map<const GameEntity*, Ogre::InstancedEntity*> mInstancedCreatures;
+
+    //! \brief Projects the anchors of the creature overlays
+    std::unique_ptr<OverlayProjector> mCreatureOverlayProjector;
+
     Ogre::AnimationState* mHandAnimationState;
 
     Ogre::Viewport* mViewport;
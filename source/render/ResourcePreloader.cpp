@@ -0,0 +1,281 @@
+/*
+ *  Copyright (C) 2011-2016  OpenDungeons Team
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "render/ResourcePreloader.h"
+
+#include "entities/CreatureDefinition.h"
+#include "entities/Tile.h"
+#include "gamemap/GameMap.h"
+#include "gamemap/TileSet.h"
+#include "utils/LogManager.h"
+
+#include <OgreMaterialManager.h>
+#include <OgreMesh.h>
+#include <OgreMeshManager.h>
+#include <OgrePass.h>
+#include <OgreResourceGroupManager.h>
+#include <OgreSubMesh.h>
+#include <OgreTechnique.h>
+#include <OgreTextureManager.h>
+#include <OgreTextureUnitState.h>
+
+#include <algorithm>
+
+namespace
+{
+    //! \brief Time the prepare thread waits when there is nothing to prepare
+    const int32_t PREPARE_WAIT_MS = 5;
+}
+
+ResourcePreloader::ResourcePreloader() :
+    mNbPrepared(0),
+    mNbLoaded(0),
+    mProgress(0.0f),
+    mIsPreparing(false)
+{
+}
+
+ResourcePreloader::~ResourcePreloader()
+{
+    stopPrepareThread();
+}
+
+void ResourcePreloader::addGameMapMeshes(GameMap& gameMap)
+{
+    const TileSet* tileSet = gameMap.getTileSet();
+    if(tileSet != nullptr)
+    {
+        for(uint32_t i = static_cast<uint32_t>(TileVisual::nullTileVisual) + 1; i < static_cast<uint32_t>(TileVisual::countTileVisual); ++i)
+        {
+            for(const TileSetValue& tileSetValue : tileSet->getTileValues(static_cast<TileVisual>(i)))
+            {
+                addMesh(tileSetValue.getMeshName());
+                if(tileSetValue.getMaterialName().empty())
+                    continue;
+
+                Ogre::MaterialPtr material = Ogre::MaterialManager::getSingleton().getByName(tileSetValue.getMaterialName());
+#if defined(OGRE_VERSION) && OGRE_VERSION < 0x10A00
+                if(!material.isNull())
+#else
+                if(material)
+#endif
+                    addMaterialTextures(*material);
+            }
+        }
+    }
+
+    for(unsigned int i = 0; i < gameMap.numClassDescriptions(); ++i)
+    {
+        const CreatureDefinition* def = gameMap.getClassDescription(i);
+        if(def != nullptr)
+            addMesh(def->getMeshName());
+    }
+}
+
+void ResourcePreloader::addMesh(const std::string& meshName)
+{
+    if(meshName.empty() || (mResourceNames.count(meshName) > 0))
+        return;
+
+    Ogre::ResourcePtr mesh = Ogre::MeshManager::getSingleton().createOrRetrieve(meshName,
+        Ogre::ResourceGroupManager::AUTODETECT_RESOURCE_GROUP_NAME).first;
+    addResource(meshName, mesh, true);
+}
+
+void ResourcePreloader::addResource(const std::string& name, const Ogre::ResourcePtr& resource, bool isMesh)
+{
+    mResourceNames.insert(name);
+    // Resources already loaded (for example by the main menu) do not need anything
+#if defined(OGRE_VERSION) && OGRE_VERSION < 0x10A00
+    if(resource.isNull() || resource->isLoaded())
+#else
+    if(!resource || resource->isLoaded())
+#endif
+        return;
+
+    sf::Lock lock(mResourcesLock);
+    mResources.push_back(resource);
+    mIsMesh.push_back(isMesh);
+}
+
+void ResourcePreloader::addMaterialTextures(Ogre::Material& material)
+{
+    Ogre::TextureManager& textureManager = Ogre::TextureManager::getSingleton();
+    for(unsigned short i = 0; i < material.getNumTechniques(); ++i)
+    {
+        Ogre::Technique* technique = material.getTechnique(i);
+        for(unsigned short j = 0; j < technique->getNumPasses(); ++j)
+        {
+            Ogre::Pass* pass = technique->getPass(j);
+            for(unsigned short k = 0; k < pass->getNumTextureUnitStates(); ++k)
+            {
+                const Ogre::TextureUnitState* textureUnit = pass->getTextureUnitState(k);
+                for(unsigned int frame = 0; frame < textureUnit->getNumFrames(); ++frame)
+                {
+                    const Ogre::String& textureName = textureUnit->getFrameTextureName(frame);
+                    if(textureName.empty() || (mResourceNames.count(textureName) > 0))
+                        continue;
+
+                    // The texture has to be created with the parameters the texture unit will use or
+                    // it would be created with the wrong ones when the material is loaded
+                    Ogre::ResourcePtr texture = textureManager.createOrRetrieve(textureName, material.getGroup(),
+                        false, nullptr, nullptr, textureUnit->getTextureType(), textureUnit->getNumMipmaps(),
+                        textureUnit->getGamma(), textureUnit->getIsAlpha(), textureUnit->getDesiredFormat(),
+                        textureUnit->isHardwareGammaEnabled()).first;
+                    addResource(textureName, texture, false);
+                }
+            }
+        }
+    }
+}
+
+void ResourcePreloader::start()
+{
+    // The resource managers are only locked when OGRE_THREAD_SUPPORT is 1 or 2. With 3, Ogre does not
+    // lock anything and the prepare thread would race the rendering thread, so resources are loaded
+    // synchronously by update() like when there is no thread support
+#if (OGRE_THREAD_SUPPORT == 1) || (OGRE_THREAD_SUPPORT == 2)
+    if(mPrepareThread != nullptr)
+        return;
+
+    mIsPreparing = true;
+    mPrepareThread.reset(new sf::Thread(&ResourcePreloader::prepareThread, this));
+    mPrepareThread->launch();
+#endif
+}
+
+void ResourcePreloader::prepareThread()
+{
+    while(mIsPreparing)
+    {
+        Ogre::ResourcePtr resource;
+        {
+            sf::Lock lock(mResourcesLock);
+            if(mNbPrepared < mResources.size())
+                resource = mResources[mNbPrepared];
+        }
+
+#if defined(OGRE_VERSION) && OGRE_VERSION < 0x10A00
+        if(resource.isNull())
+#else
+        if(!resource)
+#endif
+        {
+            sf::sleep(sf::milliseconds(PREPARE_WAIT_MS));
+            continue;
+        }
+
+        try
+        {
+            resource->prepare(true);
+        }
+        catch(const Ogre::Exception&)
+        {
+            // The resource will be loaded from the rendering thread which will report the error
+        }
+
+        sf::Lock lock(mResourcesLock);
+        ++mNbPrepared;
+    }
+}
+
+void ResourcePreloader::stopPrepareThread()
+{
+    if(mPrepareThread == nullptr)
+        return;
+
+    mIsPreparing = false;
+    mPrepareThread->wait();
+    mPrepareThread.reset();
+}
+
+bool ResourcePreloader::update(int32_t budgetMs)
+{
+    // Like the server messages, we always load at least one resource so that loading ends even with a small budget
+    sf::Clock clock;
+    bool isFirstResource = true;
+    while(isFirstResource || (budgetMs < 0) || (clock.getElapsedTime().asMilliseconds() < budgetMs))
+    {
+        isFirstResource = false;
+        Ogre::ResourcePtr resource;
+        bool isMesh;
+        {
+            sf::Lock lock(mResourcesLock);
+            if(mNbLoaded >= mResources.size())
+                break;
+
+            // Without the prepare thread, load() reads the files itself
+            if((mPrepareThread != nullptr) && (mNbLoaded >= mNbPrepared))
+                break;
+
+            resource = mResources[mNbLoaded];
+            isMesh = mIsMesh[mNbLoaded];
+        }
+
+        try
+        {
+            resource->load();
+            if(isMesh)
+                meshLoaded(static_cast<Ogre::Mesh&>(*resource));
+        }
+        catch(const Ogre::Exception& e)
+        {
+            OD_LOG_ERR("Could not preload resource=" + resource->getName() + ", error=" + e.getDescription());
+        }
+
+        // The resource is released. It stays loaded in its manager
+        sf::Lock lock(mResourcesLock);
+        mResources[mNbLoaded] = Ogre::ResourcePtr();
+        ++mNbLoaded;
+    }
+
+    bool isDone;
+    {
+        sf::Lock lock(mResourcesLock);
+        isDone = (mNbLoaded >= mResources.size());
+        // Textures are added when meshes are loaded so the total can grow. We do not want the progress to go back
+        if(!mResources.empty())
+            mProgress = std::max(mProgress, static_cast<float>(mNbLoaded) / static_cast<float>(mResources.size()));
+    }
+
+    if(!isDone)
+        return false;
+
+    mProgress = 1.0f;
+    stopPrepareThread();
+    return true;
+}
+
+void ResourcePreloader::meshLoaded(Ogre::Mesh& mesh)
+{
+    // Most materials use normal maps
+    unsigned short src, dest;
+    if (!mesh.suggestTangentVectorBuildParams(Ogre::VES_TANGENT, src, dest))
+        mesh.buildTangentVectors(Ogre::VES_TANGENT, src, dest);
+
+    for(unsigned short i = 0; i < mesh.getNumSubMeshes(); ++i)
+    {
+        const std::string& materialName = mesh.getSubMesh(i)->getMaterialName();
+        Ogre::MaterialPtr material = Ogre::MaterialManager::getSingleton().getByName(materialName);
+#if defined(OGRE_VERSION) && OGRE_VERSION < 0x10A00
+        if(!material.isNull())
+#else
+        if(material)
+#endif
+            addMaterialTextures(*material);
+    }
+}
@@ -0,0 +1,99 @@
+/*
+ *  Copyright (C) 2011-2016  OpenDungeons Team
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef RESOURCEPRELOADER_H
+#define RESOURCEPRELOADER_H
+
+#include <OgreResource.h>
+
+#include <SFML/System.hpp>
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+
+class GameMap;
+
+namespace Ogre
+{
+class Material;
+class Mesh;
+} //End namespace Ogre
+
+//! \brief Loads the meshes and textures needed by a game map before the game starts so that
+//! they are not loaded when the first entities using them are displayed.
+//! Reading and decoding the files (Ogre's prepare step) is done on a background thread when
+//! Ogre is built with thread support. Uploading to the GPU and building the tangents is done
+//! on the rendering thread by update() within a time budget so that the loading screen stays
+//! responsive.
+class ResourcePreloader
+{
+public:
+    ResourcePreloader();
+
+    //! \brief Waits for the background thread if it is running
+    ~ResourcePreloader();
+
+    //! \brief Adds the meshes used by the tiles and creatures of the given game map
+    void addGameMapMeshes(GameMap& gameMap);
+
+    //! \brief Adds the given mesh. The textures used by its materials will be added when it is loaded
+    void addMesh(const std::string& meshName);
+
+    //! \brief Starts preparing the added resources on the background thread
+    void start();
+
+    //! \brief Loads the prepared resources during at most budgetMs milliseconds.
+    //! Returns true when every resource is loaded
+    bool update(int32_t budgetMs);
+
+    //! \brief Returns the loaded ratio (between 0 and 1)
+    inline float getProgress() const
+    { return mProgress; }
+
+private:
+    //! \brief Resources to prepare and load in order. Textures are added on the
+    //! rendering thread when the meshes using them are loaded
+    std::vector<Ogre::ResourcePtr> mResources;
+    std::vector<bool> mIsMesh;
+    //! \brief Names of the resources already added
+    std::set<std::string> mResourceNames;
+    //! \brief Protects mResources and mNbPrepared
+    sf::Mutex mResourcesLock;
+    uint32_t mNbPrepared;
+    uint32_t mNbLoaded;
+    float mProgress;
+
+    std::unique_ptr<sf::Thread> mPrepareThread;
+    std::atomic<bool> mIsPreparing;
+
+    void prepareThread();
+    void stopPrepareThread();
+
+    void addResource(const std::string& name, const Ogre::ResourcePtr& resource, bool isMesh);
+
+    //! \brief Adds the textures used by the given material
+    void addMaterialTextures(Ogre::Material& material);
+
+    //! \brief Builds the tangents needed by normal mapping and adds the textures of the mesh materials
+    void meshLoaded(Ogre::Mesh& mesh);
+};
+
+#endif // RESOURCEPRELOADER_H
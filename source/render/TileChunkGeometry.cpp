@@ -0,0 +1,65 @@
+/*
+ *  Copyright (C) 2011-2016  OpenDungeons Team
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "render/TileChunkGeometry.h"
+
+namespace
+{
+    void addRotated(std::vector<float>& dest, const float rotation[9], const float* vect)
+    {
+        for(uint32_t i = 0; i < 3; ++i)
+            dest.push_back(rotation[i * 3] * vect[0] + rotation[i * 3 + 1] * vect[1] + rotation[i * 3 + 2] * vect[2]);
+    }
+}
+
+void TileChunkGeometry::addMesh(const std::string& materialName, const TileMeshGeometry& mesh, const float rotation[9],
+    float x, float y, float z)
+{
+    uint32_t nbVertices = mesh.getNbVertices();
+    if((nbVertices == 0) || mesh.mIndices.empty())
+        return;
+
+    bool hasNormals = (mesh.mNormals.size() == nbVertices * 3);
+    bool hasTangents = (mesh.mTangents.size() == nbVertices * 3);
+    bool hasTexCoords = (mesh.mTexCoords.size() == nbVertices * 2);
+    const float defaultNormal[3] = { 0.0f, 0.0f, 1.0f };
+    const float defaultTangent[3] = { 1.0f, 0.0f, 0.0f };
+
+    TileMeshGeometry& section = mSections[materialName];
+    uint32_t firstVertex = section.getNbVertices();
+    for(uint32_t i = 0; i < nbVertices; ++i)
+    {
+        addRotated(section.mPositions, rotation, &mesh.mPositions[i * 3]);
+        float* position = &section.mPositions[section.mPositions.size() - 3];
+        position[0] += x;
+        position[1] += y;
+        position[2] += z;
+
+        addRotated(section.mNormals, rotation, hasNormals ? &mesh.mNormals[i * 3] : defaultNormal);
+        addRotated(section.mTangents, rotation, hasTangents ? &mesh.mTangents[i * 3] : defaultTangent);
+        section.mTexCoords.push_back(hasTexCoords ? mesh.mTexCoords[i * 2] : 0.0f);
+        section.mTexCoords.push_back(hasTexCoords ? mesh.mTexCoords[i * 2 + 1] : 0.0f);
+    }
+
+    for(uint32_t index : mesh.mIndices)
+        section.mIndices.push_back(firstVertex + index);
+}
+
+void TileChunkGeometry::clear()
+{
+    mSections.clear();
+}
@@ -0,0 +1,67 @@
+/*
+ *  Copyright (C) 2011-2016  OpenDungeons Team
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TILECHUNKGEOMETRY_H
+#define TILECHUNKGEOMETRY_H
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+//! \brief Vertices and triangles of a mesh. Each vertex has a position, a normal, a tangent
+//! and texture coordinates (the arrays are flat: 3 floats per position/normal/tangent and 2 per
+//! texture coordinates). Normals, tangents or texture coordinates can be left empty if the
+//! mesh does not have them.
+struct TileMeshGeometry
+{
+    std::vector<float> mPositions;
+    std::vector<float> mNormals;
+    std::vector<float> mTangents;
+    std::vector<float> mTexCoords;
+    std::vector<uint32_t> mIndices;
+
+    inline uint32_t getNbVertices() const
+    { return static_cast<uint32_t>(mPositions.size() / 3); }
+};
+
+//! \brief Merges the meshes of the tiles of a chunk into one geometry per material. This is
+//! done on the CPU and does not depend on the renderer so that it can be tested without a GPU.
+//! In the merged geometry, every vertex has a normal, a tangent and texture coordinates (default
+//! values are used for the meshes that do not have them).
+class TileChunkGeometry
+{
+public:
+    //! \brief Adds the given mesh rotated by the given row major 3x3 rotation matrix and moved
+    //! to the given position
+    void addMesh(const std::string& materialName, const TileMeshGeometry& mesh, const float rotation[9],
+        float x, float y, float z);
+
+    void clear();
+
+    inline bool isEmpty() const
+    { return mSections.empty(); }
+
+    //! \brief The merged geometry sorted by material name
+    inline const std::map<std::string, TileMeshGeometry>& getSections() const
+    { return mSections; }
+
+private:
+    std::map<std::string, TileMeshGeometry> mSections;
+};
+
+#endif // TILECHUNKGEOMETRY_H
@@ -0,0 +1,295 @@
+/*
+ *  Copyright (C) 2011-2016  OpenDungeons Team
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "render/TileChunkManager.h"
+
+#include "game/Seat.h"
+#include "render/MaterialVariantCache.h"
+#include "render/MeshGeometryCache.h"
+#include "utils/Helper.h"
+
+#include <OgreManualObject.h>
+#include <OgreMatrix3.h>
+#include <OgreSceneManager.h>
+#include <OgreSceneNode.h>
+
+const int32_t TileChunkManager::CHUNK_SIZE = 16;
+
+namespace
+{
+    //! \brief Material id of the tiles that use the materials of their mesh
+    const uint32_t NO_MATERIAL = 0xFFFFFFFF;
+}
+
+bool TileChunkManager::TileMesh::operator==(const TileMesh& other) const
+{
+    return (mMeshName == other.mMeshName) &&
+        (mMaterialId == other.mMaterialId) &&
+        (mOrientation == other.mOrientation) &&
+        (mSeatColor == other.mSeatColor) &&
+        (mMarkedForDigging == other.mMarkedForDigging) &&
+        (mPlayerHasVision == other.mPlayerHasVision);
+}
+
+TileChunkManager::TileChunkManager(Ogre::SceneManager* sceneManager, Ogre::SceneNode* parentNode,
+        MaterialVariantCache& materialVariants, MeshGeometryCache& meshGeometries) :
+    mSceneManager(sceneManager),
+    mParentNode(parentNode),
+    mMaterialVariants(materialVariants),
+    mMeshGeometries(meshGeometries)
+{
+}
+
+TileChunkManager::~TileChunkManager()
+{
+    clear();
+}
+
+void TileChunkManager::clear()
+{
+    for(std::pair<const std::pair<int32_t, int32_t>, Chunk>& p : mChunks)
+    {
+        Chunk& chunk = p.second;
+        if(chunk.mObject == nullptr)
+            continue;
+
+        chunk.mNode->detachObject(chunk.mObject);
+        mSceneManager->destroyManualObject(chunk.mObject);
+        mSceneManager->destroySceneNode(chunk.mNode);
+    }
+    mChunks.clear();
+    mDirtyChunks.clear();
+    mHiddenTiles.clear();
+    mTilesInView.clear();
+    mNbTilesInView.clear();
+}
+
+TileChunkManager::Chunk& TileChunkManager::getChunk(int32_t x, int32_t y, std::pair<int32_t, int32_t>& chunkCoords)
+{
+    chunkCoords = std::make_pair(x / CHUNK_SIZE, y / CHUNK_SIZE);
+    return mChunks[chunkCoords];
+}
+
+TileChunkManager::Chunk* TileChunkManager::findChunk(int32_t x, int32_t y, std::pair<int32_t, int32_t>& chunkCoords)
+{
+    chunkCoords = std::make_pair(x / CHUNK_SIZE, y / CHUNK_SIZE);
+    auto it = mChunks.find(chunkCoords);
+    if(it == mChunks.end())
+        return nullptr;
+
+    return &it->second;
+}
+
+void TileChunkManager::setDirty(Chunk& chunk, const std::pair<int32_t, int32_t>& chunkCoords)
+{
+    if(chunk.mIsDirty)
+        return;
+
+    chunk.mIsDirty = true;
+    mDirtyChunks.push_back(chunkCoords);
+}
+
+void TileChunkManager::setTileMesh(int32_t x, int32_t y, const std::string& meshName, const std::string& materialName,
+    const Ogre::Quaternion& orientation, const Seat* seatColor, bool markedForDigging, bool playerHasVision)
+{
+    if(meshName.empty())
+    {
+        removeTileMesh(x, y);
+        return;
+    }
+
+    TileMesh tileMesh;
+    tileMesh.mMeshName = meshName;
+    tileMesh.mMaterialId = materialName.empty() ? NO_MATERIAL : mMaterialVariants.getMaterialId(materialName);
+    tileMesh.mOrientation = orientation;
+    tileMesh.mSeatColor = seatColor;
+    tileMesh.mMarkedForDigging = markedForDigging;
+    tileMesh.mPlayerHasVision = playerHasVision;
+
+    std::pair<int32_t, int32_t> chunkCoords;
+    Chunk& chunk = getChunk(x, y, chunkCoords);
+    std::pair<int32_t, int32_t> tileCoords(x, y);
+    auto it = chunk.mTiles.find(tileCoords);
+    // Tiles are refreshed for many reasons. We only rebuild the chunk if what is displayed changed
+    if((it != chunk.mTiles.end()) && (it->second == tileMesh))
+        return;
+
+    chunk.mTiles[tileCoords] = tileMesh;
+    setDirty(chunk, chunkCoords);
+}
+
+void TileChunkManager::removeTileMesh(int32_t x, int32_t y)
+{
+    std::pair<int32_t, int32_t> chunkCoords;
+    Chunk* chunk = findChunk(x, y, chunkCoords);
+    if((chunk == nullptr) || (chunk->mTiles.erase(std::make_pair(x, y)) == 0))
+        return;
+
+    setDirty(*chunk, chunkCoords);
+}
+
+void TileChunkManager::removeTile(int32_t x, int32_t y)
+{
+    mHiddenTiles.erase(std::make_pair(x, y));
+    setTileInView(x, y, false);
+    removeTileMesh(x, y);
+}
+
+void TileChunkManager::setTileInView(int32_t x, int32_t y, bool isInView)
+{
+    std::pair<int32_t, int32_t> tileCoords(x, y);
+    bool isChanged = isInView ? mTilesInView.insert(tileCoords).second : (mTilesInView.erase(tileCoords) > 0);
+    if(!isChanged)
+        return;
+
+    std::pair<int32_t, int32_t> chunkCoords;
+    Chunk* chunk = findChunk(x, y, chunkCoords);
+    uint32_t& nbTilesInView = mNbTilesInView[chunkCoords];
+    nbTilesInView = isInView ? nbTilesInView + 1 : nbTilesInView - 1;
+    // The chunk is only shown or hidden when its first tile comes in view or its last one leaves it
+    if((chunk == nullptr) || (chunk->mObject == nullptr) || (nbTilesInView > 1))
+        return;
+
+    chunk->mObject->setVisible(nbTilesInView > 0);
+}
+
+bool TileChunkManager::isChunkInView(const std::pair<int32_t, int32_t>& chunkCoords) const
+{
+    auto it = mNbTilesInView.find(chunkCoords);
+    return (it != mNbTilesInView.end()) && (it->second > 0);
+}
+
+void TileChunkManager::setTileMeshVisible(int32_t x, int32_t y, bool isVisible)
+{
+    std::pair<int32_t, int32_t> tileCoords(x, y);
+    bool isChanged = isVisible ? (mHiddenTiles.erase(tileCoords) > 0) : mHiddenTiles.insert(tileCoords).second;
+    if(!isChanged)
+        return;
+
+    std::pair<int32_t, int32_t> chunkCoords;
+    Chunk* chunk = findChunk(x, y, chunkCoords);
+    if((chunk != nullptr) && (chunk->mTiles.count(tileCoords) > 0))
+        setDirty(*chunk, chunkCoords);
+}
+
+void TileChunkManager::prepareMaterials(const std::string& meshName, const std::string& materialName, const Seat* seatColor)
+{
+    if(meshName.empty())
+        return;
+
+    std::vector<uint32_t> materialIds;
+    if(!materialName.empty())
+        materialIds.push_back(mMaterialVariants.getMaterialId(materialName));
+    else
+    {
+        for(const MeshGeometryCache::SubMeshGeometry& subMesh : mMeshGeometries.getMeshGeometry(meshName))
+            materialIds.push_back(subMesh.mMaterialId);
+    }
+
+    const std::string& colorId = (seatColor != nullptr) ? seatColor->getColorId() : MaterialVariantCache::NO_COLOR;
+    for(uint32_t materialId : materialIds)
+    {
+        mMaterialVariants.getVariant(materialId, colorId, false, true);
+        mMaterialVariants.getVariant(materialId, colorId, true, true);
+        mMaterialVariants.getVariant(materialId, colorId, false, false);
+    }
+}
+
+void TileChunkManager::updateDirtyChunks()
+{
+    for(const std::pair<int32_t, int32_t>& chunkCoords : mDirtyChunks)
+    {
+        auto it = mChunks.find(chunkCoords);
+        if(it == mChunks.end())
+            continue;
+
+        Chunk& chunk = it->second;
+        chunk.mIsDirty = false;
+        rebuildChunk(chunkCoords, chunk);
+    }
+    mDirtyChunks.clear();
+}
+
+void TileChunkManager::computeChunkGeometry(const Chunk& chunk, TileChunkGeometry& geometry)
+{
+    geometry.clear();
+    for(const std::pair<const std::pair<int32_t, int32_t>, TileMesh>& p : chunk.mTiles)
+    {
+        if(mHiddenTiles.count(p.first) > 0)
+            continue;
+
+        const TileMesh& tileMesh = p.second;
+        const std::string& colorId = (tileMesh.mSeatColor != nullptr) ? tileMesh.mSeatColor->getColorId()
+            : MaterialVariantCache::NO_COLOR;
+        Ogre::Matrix3 rotationMatrix;
+        tileMesh.mOrientation.ToRotationMatrix(rotationMatrix);
+        float rotation[9];
+        for(uint32_t row = 0; row < 3; ++row)
+        {
+            for(uint32_t col = 0; col < 3; ++col)
+                rotation[row * 3 + col] = static_cast<float>(rotationMatrix[row][col]);
+        }
+
+        for(const MeshGeometryCache::SubMeshGeometry& subMesh : mMeshGeometries.getMeshGeometry(tileMesh.mMeshName))
+        {
+            // The tileset can replace the mesh material
+            uint32_t materialId = (tileMesh.mMaterialId == NO_MATERIAL) ? subMesh.mMaterialId : tileMesh.mMaterialId;
+            const std::string& materialName = mMaterialVariants.getVariant(materialId, colorId,
+                tileMesh.mMarkedForDigging, tileMesh.mPlayerHasVision);
+            geometry.addMesh(materialName, subMesh.mGeometry, rotation,
+                static_cast<float>(p.first.first), static_cast<float>(p.first.second), 0.0f);
+        }
+    }
+}
+
+void TileChunkManager::rebuildChunk(const std::pair<int32_t, int32_t>& chunkCoords, Chunk& chunk)
+{
+    TileChunkGeometry geometry;
+    computeChunkGeometry(chunk, geometry);
+
+    if(geometry.isEmpty())
+    {
+        // If every tile of the chunk is hidden, we keep the tile meshes so that they can be shown again
+        if(!chunk.mTiles.empty())
+        {
+            if(chunk.mObject != nullptr)
+                chunk.mObject->clear();
+
+            return;
+        }
+
+        if(chunk.mObject != nullptr)
+        {
+            chunk.mNode->detachObject(chunk.mObject);
+            mSceneManager->destroyManualObject(chunk.mObject);
+            mSceneManager->destroySceneNode(chunk.mNode);
+        }
+        mChunks.erase(chunkCoords);
+        return;
+    }
+
+    if(chunk.mObject == nullptr)
+    {
+        std::string name = "TileChunk_" + Helper::toString(chunkCoords.first) + "_" + Helper::toString(chunkCoords.second);
+        chunk.mObject = mSceneManager->createManualObject(name);
+        chunk.mNode = mParentNode->createChildSceneNode(name + "_node");
+        chunk.mNode->attachObject(chunk.mObject);
+        chunk.mObject->setVisible(isChunkInView(chunkCoords));
+    }
+
+    MeshGeometryCache::fillManualObject(*chunk.mObject, geometry);
+}
@@ -0,0 +1,141 @@
+/*
+ *  Copyright (C) 2011-2016  OpenDungeons Team
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TILECHUNKMANAGER_H
+#define TILECHUNKMANAGER_H
+
+#include "render/TileChunkGeometry.h"
+
+#include <OgreQuaternion.h>
+
+#include <cstdint>
+#include <map>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+class MaterialVariantCache;
+class MeshGeometryCache;
+class Seat;
+
+namespace Ogre
+{
+class ManualObject;
+class SceneManager;
+class SceneNode;
+} //End namespace Ogre
+
+//! \brief Renders the tileset meshes of the tiles by chunks of CHUNK_SIZE x CHUNK_SIZE tiles. The
+//! meshes of a chunk are merged into one object with one section per material instead of having an
+//! entity per tile. When a tile changes, its chunk is rebuilt during the next frame.
+//! Tile culling hides a chunk when none of its tiles is in view.
+class TileChunkManager
+{
+public:
+    //! \brief Width (in tiles) of the square chunks
+    static const int32_t CHUNK_SIZE;
+
+    //! \brief materialVariants gives the material to use depending on the seat color, digging
+    //! mark and vision of the tile. It and meshGeometries should outlive the TileChunkManager
+    TileChunkManager(Ogre::SceneManager* sceneManager, Ogre::SceneNode* parentNode,
+        MaterialVariantCache& materialVariants, MeshGeometryCache& meshGeometries);
+    ~TileChunkManager();
+
+    //! \brief Sets the mesh displayed on the given tile. If materialName is not empty, it
+    //! replaces the materials of the mesh. If meshName is empty, nothing is displayed
+    void setTileMesh(int32_t x, int32_t y, const std::string& meshName, const std::string& materialName,
+        const Ogre::Quaternion& orientation, const Seat* seatColor, bool markedForDigging, bool playerHasVision);
+
+    void removeTileMesh(int32_t x, int32_t y);
+
+    //! \brief Sets if the given tile is in view (see CullingManager). The chunks with no tile in view are hidden
+    void setTileInView(int32_t x, int32_t y, bool isInView);
+
+    //! \brief Removes the mesh of the given tile and forgets if it was hidden or in view. Should be called
+    //! when the tile is destroyed
+    void removeTile(int32_t x, int32_t y);
+
+    //! \brief Destroys every chunk. Should be called when the map is unloaded
+    void clear();
+
+    //! \brief Hides or shows the mesh of the given tile (for example when an object covers it).
+    //! This is kept when the tile mesh changes
+    void setTileMeshVisible(int32_t x, int32_t y, bool isVisible);
+
+    //! \brief Builds the variants (plain, marked for digging and without vision) for the given seat
+    //! of the materials used by the given mesh so that they are ready when a tile uses them
+    void prepareMaterials(const std::string& meshName, const std::string& materialName, const Seat* seatColor);
+
+    //! \brief Rebuilds the chunks that changed. Should be called once per frame
+    void updateDirtyChunks();
+
+private:
+    //! \brief What is displayed on a tile
+    struct TileMesh
+    {
+        std::string mMeshName;
+        //! \brief Id of the material replacing the mesh materials or NO_MATERIAL
+        uint32_t mMaterialId;
+        Ogre::Quaternion mOrientation;
+        const Seat* mSeatColor;
+        bool mMarkedForDigging;
+        bool mPlayerHasVision;
+
+        bool operator==(const TileMesh& other) const;
+    };
+
+    struct Chunk
+    {
+        Chunk() :
+            mObject(nullptr),
+            mNode(nullptr),
+            mIsDirty(false)
+        {}
+
+        //! \brief Tile meshes indexed by tile coordinates
+        std::map<std::pair<int32_t, int32_t>, TileMesh> mTiles;
+        Ogre::ManualObject* mObject;
+        Ogre::SceneNode* mNode;
+        bool mIsDirty;
+    };
+
+    Ogre::SceneManager* mSceneManager;
+    Ogre::SceneNode* mParentNode;
+    MaterialVariantCache& mMaterialVariants;
+    MeshGeometryCache& mMeshGeometries;
+
+    std::map<std::pair<int32_t, int32_t>, Chunk> mChunks;
+    std::vector<std::pair<int32_t, int32_t>> mDirtyChunks;
+
+    //! \brief Tiles with a mesh that should not be displayed
+    std::set<std::pair<int32_t, int32_t>> mHiddenTiles;
+
+    //! \brief Tiles in view and their number in each chunk
+    std::set<std::pair<int32_t, int32_t>> mTilesInView;
+    std::map<std::pair<int32_t, int32_t>, uint32_t> mNbTilesInView;
+
+    Chunk& getChunk(int32_t x, int32_t y, std::pair<int32_t, int32_t>& chunkCoords);
+    //! \brief Returns the chunk of the given tile or nullptr if it has none
+    Chunk* findChunk(int32_t x, int32_t y, std::pair<int32_t, int32_t>& chunkCoords);
+    void setDirty(Chunk& chunk, const std::pair<int32_t, int32_t>& chunkCoords);
+    bool isChunkInView(const std::pair<int32_t, int32_t>& chunkCoords) const;
+    void rebuildChunk(const std::pair<int32_t, int32_t>& chunkCoords, Chunk& chunk);
+    void computeChunkGeometry(const Chunk& chunk, TileChunkGeometry& geometry);
+};
+
+#endif // TILECHUNKMANAGER_H
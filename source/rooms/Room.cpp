@@ -25,6 +25,7 @@
 #include "game/Player.h"
 #include "game/Seat.h"
 #include "gamemap/GameMap.h"
+#include "goals/Goal.h"
 #include "modes/InputCommand.h"
 #include "modes/InputManager.h"
 #include "network/ODClient.h"
@@ -42,7 +43,11 @@
 
 Room::Room(GameMap* gameMap):
     Building(gameMap),
-    mNumActiveSpots(0)
+    mNumActiveSpots(0),
+    mIsInGameMap(false),
+    mSeatCountingRoom(nullptr),
+    mGoldStoredCounted(0),
+    mGoldStorageCounted(0)
 {
 }
 
@@ -66,12 +71,16 @@ void Room::addToGameMap()
 {
     getGameMap()->addRoom(this);
     getGameMap()->addActiveObject(this);
+    mIsInGameMap = true;
+    refreshSeatAggregates();
 }
 
 void Room::removeFromGameMap()
 {
     fireEntityRemoveFromGameMap();
     getGameMap()->removeRoom(this);
+    mIsInGameMap = false;
+    refreshSeatAggregates();
     setIsOnMap(false);
     for(Seat* seat : getGameMap()->getSeats())
     {
@@ -85,6 +94,17 @@ void Room::removeFromGameMap()
     getGameMap()->removeActiveObject(this);
 }
 
+bool Room::removeCoveredTile(Tile* t)
+{
+    if(!Building::removeCoveredTile(t))
+        return false;
+
+    refreshSeatAggregates();
+    // The room may have been destroyed
+    getGameMap()->notifyGoalEvent(Goal::roomsChanged);
+    return true;
+}
+
 void Room::absorbRoom(Room *r)
 {
     OD_LOG_INF(getGameMap()->serverStr() + "Room=" + getName() + " is absorbing room=" + r->getName());
@@ -131,11 +151,57 @@ void Room::absorbRoom(Room *r)
     r->mCoveredTilesDestroyed.insert(r->mCoveredTilesDestroyed.end(), r->mCoveredTiles.begin(), r->mCoveredTiles.end());
     r->mCoveredTiles.clear();
 
+    refreshSeatAggregates();
+    r->refreshSeatAggregates();
+    getGameMap()->notifyGoalEvent(Goal::roomsChanged);
+
     // We fire the dead event so that if there are creatures heading for this room or
     // whatever, we release them before the remove from gamemap event
     r->fireEntityDead();
 }
 
+void Room::refreshSeatAggregates()
+{
+    if(!getIsOnServerMap())
+        return;
+
+    Seat* seat = mIsInGameMap ? getSeat() : nullptr;
+    int goldStored = 0;
+    int goldStorage = 0;
+    if(seat != nullptr)
+    {
+        goldStored = getTotalGoldStored();
+        goldStorage = getTotalGoldStorage();
+    }
+
+    if(seat != mSeatCountingRoom)
+    {
+        if(mSeatCountingRoom != nullptr)
+        {
+            mSeatCountingRoom->getAggregates().goldChanged(-mGoldStoredCounted, -mGoldStorageCounted);
+            mSeatCountingRoom->getAggregates().roomRemoved(*this);
+        }
+
+        mSeatCountingRoom = seat;
+        mGoldStoredCounted = 0;
+        mGoldStorageCounted = 0;
+        if(mSeatCountingRoom != nullptr)
+            mSeatCountingRoom->getAggregates().roomAdded(*this);
+
+        getGameMap()->notifyGoalEvent(Goal::roomsChanged);
+    }
+
+    if(mSeatCountingRoom == nullptr)
+        return;
+
+    if((goldStored == mGoldStoredCounted) && (goldStorage == mGoldStorageCounted))
+        return;
+
+    mSeatCountingRoom->getAggregates().goldChanged(goldStored - mGoldStoredCounted, goldStorage - mGoldStorageCounted);
+    mGoldStoredCounted = goldStored;
+    mGoldStorageCounted = goldStorage;
+}
+
 void Room::handleCreatureUsingAbsorbedRoom(Creature& creature)
 {
     // If the job room is absorbed, we force the creatures working in the old rooms to search
@@ -675,6 +741,8 @@ void Room::repairRoom()
     }
 
     updateActiveSpots();
+    refreshSeatAggregates();
+    getGameMap()->notifyGoalEvent(Goal::roomsChanged);
 }
 
 bool Room::sortForMapSave(Room* r1, Room* r2)
@@ -694,18 +762,7 @@ bool Room::sortForMapSave(Room* r1, Room* r2)
 void Room::fireRoomSound(Tile& tile, const std::string& soundFamily)
 {
     std::string sound = "Rooms/" + soundFamily;
-    for(Seat* seat : tile.getSeatsWithVision())
-    {
-        if(seat->getPlayer() == nullptr)
-            continue;
-        if(!seat->getPlayer()->getIsHuman())
-            continue;
-
-        ServerNotification *serverNotification = new ServerNotification(
-            ServerNotificationType::playSpatialSound, seat->getPlayer());
-        serverNotification->mPacket << sound << tile.getX() << tile.getY();
-        ODServer::getSingleton().queueServerNotification(serverNotification);
-    }
+    tile.getGameMap()->fireSpatialSound(tile.getSeatsWithVision(), sound, tile.getX(), tile.getY());
 }
 
 bool Room::importRoomFromStream(Room& room, std::istream& is)
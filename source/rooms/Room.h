@@ -50,6 +50,8 @@ public:
     virtual void addToGameMap() override;
     virtual void removeFromGameMap() override;
 
+    virtual bool removeCoveredTile(Tile* t) override;
+
     virtual void absorbRoom(Room* r);
 
     //! \brief By default, we consider that creatures using the room are working and
@@ -126,6 +128,10 @@ public:
     virtual int withdrawGold(int gold)
     { return 0; }
 
+    //! \brief Server side. Updates the rooms and gold counts of the seats if the room changed
+    //! seat, stored gold or size or was added/removed from the game map since the last call
+    void refreshSeatAggregates();
+
     virtual void creatureDropped(Creature& creature) override;
 
     virtual bool isInContainment(Creature& creature)
@@ -169,6 +175,14 @@ protected:
     //! \brief This function will be called when reordering room is needed (for example if another room has been absorbed)
     static void reorderRoomTiles(std::vector<Tile*>& tiles);
 private :
+    //! \brief True between addToGameMap and removeFromGameMap
+    bool mIsInGameMap;
+
+    //! \brief Seat whose aggregates include this room and the gold counted in them. Used on server side only
+    Seat* mSeatCountingRoom;
+    int mGoldStoredCounted;
+    int mGoldStorageCounted;
+
     void activeSpotCheckChange(ActiveSpotPlace place, const std::vector<Tile*>& originalSpotTiles,
         const std::vector<Tile*>& newSpotTiles);
 
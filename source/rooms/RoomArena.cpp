@@ -49,7 +49,7 @@ class RoomArenaFactory : public RoomFactory
     { return RoomArenaNameDisplay; }
 
     int getCostPerTile() const override
-    { return ConfigManager::getSingleton().getRoomConfigInt32("ArenaCostPerTile"); }
+    { return ConfigManager::getSingleton().getRoomsConfig().mArenaCostPerTile; }
 
     void checkBuildRoom(GameMap* gameMap, const InputManager& inputManager, InputCommand& inputCommand) const override
     {
@@ -137,7 +137,7 @@ bool RoomArena::hasOpenCreatureSpot(Creature* c)
         return false;
 
     // We allow using arena only if level is not too high
-    if (c->getLevel() >= ConfigManager::getSingleton().getRoomConfigUInt32("ArenaMaxTrainingLevel"))
+    if (c->getLevel() >= ConfigManager::getSingleton().getRoomsConfig().mArenaMaxTrainingLevel)
         return false;
 
     return true;
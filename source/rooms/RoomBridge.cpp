@@ -352,6 +352,7 @@ void RoomBridge::claimForSeat(Seat* seat, Tile* tile, double danceRate)
     OD_LOG_INF("Bridge=" + getName() + " claimed by seat id=" + Helper::toString(seat->getId()));
     mClaimedValue = static_cast<double>(numCoveredTiles());
     setSeat(seat);
+    refreshSeatAggregates();
 
     for(Tile* tile : mCoveredTiles)
         tile->claimTile(seat);
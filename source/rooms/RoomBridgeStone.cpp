@@ -47,7 +47,7 @@ class RoomBridgeStoneFactory : public BridgeRoomFactory
     { return RoomBridgeStoneNameDisplay; }
 
     int getCostPerTile() const override
-    { return ConfigManager::getSingleton().getRoomConfigInt32("StoneBridgeCostPerTile"); }
+    { return ConfigManager::getSingleton().getRoomsConfig().mStoneBridgeCostPerTile; }
 
     void checkBuildRoom(GameMap* gameMap, const InputManager& inputManager, InputCommand& inputCommand) const override
     {
@@ -47,7 +47,7 @@ class RoomBridgeWoodenFactory : public BridgeRoomFactory
     { return RoomBridgeWoodenNameDisplay; }
 
     int getCostPerTile() const override
-    { return ConfigManager::getSingleton().getRoomConfigInt32("WoodenBridgeCostPerTile"); }
+    { return ConfigManager::getSingleton().getRoomsConfig().mWoodenBridgeCostPerTile; }
 
     void checkBuildRoom(GameMap* gameMap, const InputManager& inputManager, InputCommand& inputCommand) const override
     {
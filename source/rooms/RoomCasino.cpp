@@ -54,7 +54,7 @@ class RoomCasinoFactory : public RoomFactory
     { return RoomCasinoNameDisplay; }
 
     int getCostPerTile() const override
-    { return ConfigManager::getSingleton().getRoomConfigInt32("CasinoCostPerTile"); }
+    { return ConfigManager::getSingleton().getRoomsConfig().mCasinoCostPerTile; }
 
     void checkBuildRoom(GameMap* gameMap, const InputManager& inputManager, InputCommand& inputCommand) const override
     {
@@ -375,11 +375,12 @@ void RoomCasino::doUpkeep()
         // TODO: we could use the wall active spots to change feePercent/bets
 
         // We set anim for both creatures
-        uint32_t cooldown = Random::Uint(ConfigManager::getSingleton().getRoomConfigUInt32("CasinoCooldownWorkMin"),
-            ConfigManager::getSingleton().getRoomConfigUInt32("CasinoCooldownWorkMax"));
-        double feePercent = std::min(ConfigManager::getSingleton().getRoomConfigDouble("CasinoFee"), 1.0);
-        double wakefullness = ConfigManager::getSingleton().getRoomConfigDouble("CasinoWakefulnessPerWork");
-        int32_t creatureBet = ConfigManager::getSingleton().getRoomConfigInt32("CasinoBet");
+        const RoomsConfig& roomsConfig = ConfigManager::getSingleton().getRoomsConfig();
+        uint32_t cooldown = Random::Uint(roomsConfig.mCasinoCooldownWorkMin,
+            roomsConfig.mCasinoCooldownWorkMax);
+        double feePercent = std::min(roomsConfig.mCasinoFee, 1.0);
+        double wakefullness = roomsConfig.mCasinoWakefulnessPerWork;
+        int32_t creatureBet = roomsConfig.mCasinoBet;
         creatureBet = std::min(creatureBet, p.second.mCreature1.mCreature->getGoldCarried());
         creatureBet = std::min(creatureBet, p.second.mCreature2.mCreature->getGoldCarried());
         int32_t totalBet = 0;
@@ -50,7 +50,7 @@ class RoomCryptFactory : public RoomFactory
     { return RoomCryptNameDisplay; }
 
     int getCostPerTile() const override
-    { return ConfigManager::getSingleton().getRoomConfigInt32("CryptCostPerTile"); }
+    { return ConfigManager::getSingleton().getRoomsConfig().mCryptCostPerTile; }
 
     void checkBuildRoom(GameMap* gameMap, const InputManager& inputManager, InputCommand& inputCommand) const override
     {
@@ -219,11 +219,11 @@ void RoomCrypt::doUpkeep()
         ConfigManager& configManager = ConfigManager::getSingleton();
 
         ++p.second.second;
-        if(p.second.second < configManager.getRoomConfigInt32("CryptRotNbTurns"))
+        if(p.second.second < configManager.getRoomsConfig().mCryptRotNbTurns)
             continue;
 
         // We add the rotten creature points to the room and release the active spot
-        double coef = 1.0 + static_cast<double>(mNumActiveSpots - mCentralActiveSpotTiles.size()) * configManager.getRoomConfigDouble("CryptBonusWallActiveSpot");
+        double coef = 1.0 + static_cast<double>(mNumActiveSpots - mCentralActiveSpotTiles.size()) * configManager.getRoomsConfig().mCryptBonusWallActiveSpot;
         Creature* c = p.second.first;
         mRottenPoints += static_cast<int32_t>(c->getMaxHp() * coef);
 
@@ -234,13 +234,13 @@ void RoomCrypt::doUpkeep()
 
         int32_t maxCreatures = configManager.getMaxCreaturesPerSeatAbsolute();
         int32_t numCreatures = getGameMap()->getCreaturesBySeat(getSeat()).size();
-        int32_t cryptPointsForSpawn = configManager.getRoomConfigInt32("CryptPointsForSpawn");
+        int32_t cryptPointsForSpawn = configManager.getRoomsConfig().mCryptPointsForSpawn;
         if((numCreatures < maxCreatures) &&
            (mRottenPoints >= cryptPointsForSpawn))
         {
             Tile* tileSpawn = p.first;
             mRottenPoints -= cryptPointsForSpawn;
-            const std::string& className = configManager.getRoomConfigString("CryptSpawnClass");
+            const std::string& className = configManager.getRoomsConfig().mCryptSpawnClass;
             const CreatureDefinition* classToSpawn = getGameMap()->getClassDescription(className);
             if(classToSpawn == nullptr)
             {
@@ -50,7 +50,7 @@ class RoomDormitoryFactory : public RoomFactory
     { return RoomDormitoryNameDisplay; }
 
     int getCostPerTile() const override
-    { return ConfigManager::getSingleton().getRoomConfigInt32("DormitoryCostPerTile"); }
+    { return ConfigManager::getSingleton().getRoomsConfig().mDormitoryCostPerTile; }
 
     void checkBuildRoom(GameMap* gameMap, const InputManager& inputManager, InputCommand& inputCommand) const override
     {
@@ -51,7 +51,7 @@ class RoomLibraryFactory : public RoomFactory
     { return RoomLibraryNameDisplay; }
 
     int getCostPerTile() const override
-    { return ConfigManager::getSingleton().getRoomConfigInt32("LibraryCostPerTile"); }
+    { return ConfigManager::getSingleton().getRoomsConfig().mLibraryCostPerTile; }
 
     void checkBuildRoom(GameMap* gameMap, const InputManager& inputManager, InputCommand& inputCommand) const override
     {
@@ -324,7 +324,7 @@ void RoomLibrary::doUpkeep()
 
 bool RoomLibrary::useRoom(Creature& creature, bool forced)
 {
-    int32_t skillEntityPoints = ConfigManager::getSingleton().getRoomConfigInt32("LibrarySkillPointsBook");
+    int32_t skillEntityPoints = ConfigManager::getSingleton().getRoomsConfig().mLibrarySkillPointsBook;
     auto it = mCreaturesSpots.find(&creature);
     if(it == mCreaturesSpots.end())
     {
@@ -374,10 +374,11 @@ bool RoomLibrary::useRoom(Creature& creature, bool forced)
     OD_ASSERT_TRUE_MSG(creatureRoomAffinity.getRoomType() == getType(), "name=" + getName() + ", creature=" + creature.getName()
         + ", creatureRoomAffinityType=" + Helper::toString(static_cast<int>(creatureRoomAffinity.getRoomType())));
 
-    int32_t pointsEarned = static_cast<int32_t>(creatureRoomAffinity.getEfficiency() * ConfigManager::getSingleton().getRoomConfigDouble("LibraryPointsPerWork"));
-    creature.jobDone(ConfigManager::getSingleton().getRoomConfigDouble("LibraryWakefulnessPerWork"));
-    creature.setJobCooldown(Random::Uint(ConfigManager::getSingleton().getRoomConfigUInt32("LibraryCooldownWorkMin"),
-        ConfigManager::getSingleton().getRoomConfigUInt32("LibraryCooldownWorkMax")));
+    const RoomsConfig& roomsConfig = ConfigManager::getSingleton().getRoomsConfig();
+    int32_t pointsEarned = static_cast<int32_t>(creatureRoomAffinity.getEfficiency() * roomsConfig.mLibraryPointsPerWork);
+    creature.jobDone(roomsConfig.mLibraryWakefulnessPerWork);
+    creature.setJobCooldown(Random::Uint(roomsConfig.mLibraryCooldownWorkMin,
+        roomsConfig.mLibraryCooldownWorkMax));
 
     // We check if we have enough points to create a skill entity
     mSkillPoints += pointsEarned;
@@ -148,6 +148,7 @@ void RoomPortal::claimForSeat(Seat* seat, Tile* tile, double danceRate)
 
     mClaimedValue = static_cast<double>(numCoveredTiles());
     setSeat(seat);
+    refreshSeatAggregates();
 
     for(Tile* tile : mCoveredTiles)
         tile->claimTile(seat);
@@ -216,8 +217,8 @@ void RoomPortal::doUpkeep()
         --mSpawnCreatureCountdown;
         return;
     }
-    mSpawnCreatureCountdown = Random::Uint(ConfigManager::getSingleton().getRoomConfigUInt32("PortalCooldownSpawnMin"),
-        ConfigManager::getSingleton().getRoomConfigUInt32("PortalCooldownSpawnMax"));
+    mSpawnCreatureCountdown = Random::Uint(ConfigManager::getSingleton().getRoomsConfig().mPortalCooldownSpawnMin,
+        ConfigManager::getSingleton().getRoomsConfig().mPortalCooldownSpawnMax);
 
     if (mCoveredTiles.empty())
         return;
@@ -52,7 +52,7 @@ class RoomTortureFactory : public RoomFactory
     { return RoomTortureNameDisplay; }
 
     int getCostPerTile() const override
-    { return ConfigManager::getSingleton().getRoomConfigInt32("TortureCostPerTile"); }
+    { return ConfigManager::getSingleton().getRoomsConfig().mTortureCostPerTile; }
 
     void checkBuildRoom(GameMap* gameMap, const InputManager& inputManager, InputCommand& inputCommand) const override
     {
@@ -297,7 +297,7 @@ void RoomTorture::doUpkeep()
             break;
         }
         creature->increaseTurnsTorture();
-        double damage = config.getRoomConfigDouble("TortureDamagePerTurn");
+        double damage = config.getRoomsConfig().mTortureDamagePerTurn;
         creature->takeDamage(this, damage, 0.0, 0.0, 0.0, tileCreature, false);
         break;
     }
@@ -328,7 +328,7 @@ bool RoomTorture::useRoom(Creature& creature, bool forced)
         p.second.mIsReady = true;
 
         if((getSeat() != creature.getSeat()) &&
-           (Random::Double(0.0, 1.0) <= config.getRoomConfigDouble("TortureRallyPercent")))
+           (Random::Double(0.0, 1.0) <= config.getRoomsConfig().mTortureRallyPercent))
         {
             // The creature changes side
             creature.changeSeat(getSeat());
@@ -349,8 +349,8 @@ bool RoomTorture::useRoom(Creature& creature, bool forced)
         }
 
         // We start the fire effect and we set job cooldown
-        uint32_t nbTurns = Random::Uint(config.getRoomConfigUInt32("TortureSessionLengthMin"),
-            config.getRoomConfigUInt32("TortureSessionLengthMax"));
+        uint32_t nbTurns = Random::Uint(config.getRoomsConfig().mTortureSessionLengthMin,
+            config.getRoomsConfig().mTortureSessionLengthMax);
         creature.setJobCooldown(nbTurns);
 
         BuildingObject* obj = getBuildingObjectFromTile(tileCreature);
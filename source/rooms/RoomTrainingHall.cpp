@@ -47,7 +47,7 @@ class RoomTrainingHallFactory : public RoomFactory
     { return RoomTrainingHallNameDisplay; }
 
     int getCostPerTile() const override
-    { return ConfigManager::getSingleton().getRoomConfigInt32("TrainHallCostPerTile"); }
+    { return ConfigManager::getSingleton().getRoomsConfig().mTrainHallCostPerTile; }
 
     void checkBuildRoom(GameMap* gameMap, const InputManager& inputManager, InputCommand& inputCommand) const override
     {
@@ -266,7 +266,7 @@ void RoomTrainingHall::refreshCreaturesDummies()
 
 bool RoomTrainingHall::hasOpenCreatureSpot(Creature* c)
 {
-    if (c->getLevel() >= ConfigManager::getSingleton().getRoomConfigUInt32("TrainHallMaxTrainingLevel"))
+    if (c->getLevel() >= ConfigManager::getSingleton().getRoomsConfig().mTrainHallMaxTrainingLevel)
         return false;
 
     // We accept all creatures as soon as there are free dummies
@@ -389,14 +389,15 @@ bool RoomTrainingHall::useRoom(Creature& creature, bool forced)
         + ", creatureRoomAffinityType=" + Helper::toString(static_cast<int>(creatureRoomAffinity.getRoomType())));
 
     // We add a bonus per wall active spots
-    double coef = 1.0 + static_cast<double>(mNumActiveSpots - mCentralActiveSpotTiles.size()) * ConfigManager::getSingleton().getRoomConfigDouble("TrainHallBonusWallActiveSpot");
-    double expReceived = creatureRoomAffinity.getEfficiency() * ConfigManager::getSingleton().getRoomConfigDouble("TrainHallXpPerAttack");
+    const RoomsConfig& roomsConfig = ConfigManager::getSingleton().getRoomsConfig();
+    double coef = 1.0 + static_cast<double>(mNumActiveSpots - mCentralActiveSpotTiles.size()) * roomsConfig.mTrainHallBonusWallActiveSpot;
+    double expReceived = creatureRoomAffinity.getEfficiency() * roomsConfig.mTrainHallXpPerAttack;
     expReceived *= coef;
 
     creature.receiveExp(expReceived);
-    creature.jobDone(ConfigManager::getSingleton().getRoomConfigDouble("TrainHallWakefulnessPerAttack"));
-    creature.setJobCooldown(Random::Uint(ConfigManager::getSingleton().getRoomConfigUInt32("TrainHallCooldownHitMin"),
-        ConfigManager::getSingleton().getRoomConfigUInt32("TrainHallCooldownHitMax")));
+    creature.jobDone(roomsConfig.mTrainHallWakefulnessPerAttack);
+    creature.setJobCooldown(Random::Uint(roomsConfig.mTrainHallCooldownHitMin,
+        roomsConfig.mTrainHallCooldownHitMax));
 
     return false;
 }
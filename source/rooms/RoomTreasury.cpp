@@ -56,7 +56,7 @@ class RoomTreasuryFactory : public RoomFactory
     { return RoomTreasuryNameDisplay; }
 
     int getCostPerTile() const override
-    { return ConfigManager::getSingleton().getRoomConfigInt32("TreasuryCostPerTile"); }
+    { return ConfigManager::getSingleton().getRoomsConfig().mTreasuryCostPerTile; }
 
     void checkBuildRoom(GameMap* gameMap, const InputManager& inputManager, InputCommand& inputCommand) const override
     {
@@ -344,6 +344,7 @@ int RoomTreasury::depositGold(int gold, Tile *tile)
         return wasDeposited;
 
     mGoldChanged = true;
+    refreshSeatAggregates();
 
     // Tells the client to play a deposit gold sound. For now, we only send it to the players
     // with vision on tile
@@ -377,6 +378,7 @@ int RoomTreasury::withdrawGold(int gold)
         }
     }
 
+    refreshSeatAggregates();
     return withdrawlAmount;
 }
 
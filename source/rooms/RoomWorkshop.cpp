@@ -53,7 +53,7 @@ class RoomWorkshopFactory : public RoomFactory
     { return RoomWorkshopNameDisplay; }
 
     int getCostPerTile() const override
-    { return ConfigManager::getSingleton().getRoomConfigInt32("WorkshopCostPerTile"); }
+    { return ConfigManager::getSingleton().getRoomsConfig().mWorkshopCostPerTile; }
 
     void checkBuildRoom(GameMap* gameMap, const InputManager& inputManager, InputCommand& inputCommand) const override
     {
@@ -471,10 +471,11 @@ bool RoomWorkshop::useRoom(Creature& creature, bool forced)
     OD_ASSERT_TRUE_MSG(creatureRoomAffinity.getRoomType() == getType(), "name=" + getName() + ", creature=" + creature.getName()
         + ", creatureRoomAffinityType=" + Helper::toString(static_cast<int>(creatureRoomAffinity.getRoomType())));
 
-    mPoints += static_cast<int32_t>(creatureRoomAffinity.getEfficiency() * ConfigManager::getSingleton().getRoomConfigDouble("WorkshopPointsPerWork"));
-    creature.jobDone(ConfigManager::getSingleton().getRoomConfigDouble("WorkshopWakefulnessPerWork"));
-    creature.setJobCooldown(Random::Uint(ConfigManager::getSingleton().getRoomConfigUInt32("WorkshopCooldownWorkMin"),
-        ConfigManager::getSingleton().getRoomConfigUInt32("WorkshopCooldownWorkMax")));
+    const RoomsConfig& roomsConfig = ConfigManager::getSingleton().getRoomsConfig();
+    mPoints += static_cast<int32_t>(creatureRoomAffinity.getEfficiency() * roomsConfig.mWorkshopPointsPerWork);
+    creature.jobDone(roomsConfig.mWorkshopWakefulnessPerWork);
+    creature.setJobCooldown(Random::Uint(roomsConfig.mWorkshopCooldownWorkMin,
+        roomsConfig.mWorkshopCooldownWorkMax));
 
     return false;
 }
@@ -26,6 +26,15 @@
 
 #include <OgreQuaternion.h>
 
+#include <algorithm>
+#include <cmath>
+
+//! \brief Identical spatial sounds received in the same square of tiles during a frame are played once
+const int32_t SPATIAL_SOUND_REGION_SIZE = 4;
+
+//! \brief Maximum number of spatial sounds playing at the same time
+const uint32_t MAX_SPATIAL_VOICES = 16;
+
 // class GameSound
 GameSound::GameSound(const std::string& filename, bool spatialSound):
     mSound(nullptr),
@@ -82,20 +91,6 @@ GameSound::~GameSound()
 
 void GameSound::play(float x, float y, float z)
 {
-    // Check whether the sound is spatial
-    if (mSound->getAttenuation() > 0.0f)
-    {
-        // Check the distance against the listener height and cull the sound accordingly.
-        // This permits to hear only the sound of the area seen in game,
-        // and avoid glitches in heard sounds.
-        sf::Vector3f lis = sf::Listener::getPosition();
-        float distance2 = (lis.x - x) * (lis.x - x) + (lis.y - y) * (lis.y - y);
-        double height2 = (lis.z * lis.z) + (lis.z * lis.z);
-
-        if (distance2 > height2)
-            return;
-    }
-
     mSound->setPosition(x, y, z);
     mSound->play();
 }
@@ -103,7 +98,8 @@ void GameSound::play(float x, float y, float z)
 // SoundEffectsManager class
 template<> SoundEffectsManager* Ogre::Singleton<SoundEffectsManager>::msSingleton = nullptr;
 
-SoundEffectsManager::SoundEffectsManager()
+SoundEffectsManager::SoundEffectsManager() :
+    mPendingSpatialSounds(SPATIAL_SOUND_REGION_SIZE)
 {
     const std::string& soundFolderPath = ResourceManager::getSingleton().getSoundPath();
     // We read the spatial sound directory
@@ -182,6 +178,8 @@ void SoundEffectsManager::updateListener(float timeSinceLastFrame,
     Ogre::Vector3 vDir = orientation.zAxis();
     sf::Listener::setDirection(-vDir.x, -vDir.y, -vDir.z);
 
+    playPendingSpatialSounds(position);
+
     // We launch the next pending relative sound if any
     if(mRelativeSoundQueue.empty())
         return;
@@ -198,8 +196,7 @@ void SoundEffectsManager::updateListener(float timeSinceLastFrame,
     mRelativeSoundQueue[0]->play();
 }
 
-void SoundEffectsManager::playSpatialSound(const std::string& family,
-        float XPos, float YPos, float height)
+void SoundEffectsManager::playSpatialSound(const std::string& family, int32_t tileX, int32_t tileY, uint32_t count)
 {
     auto it = mSpatialSounds.find(family);
     if(it == mSpatialSounds.end())
@@ -208,15 +205,42 @@ void SoundEffectsManager::playSpatialSound(const std::string& family,
         return;
     }
 
-    std::vector<GameSound*>& sounds = it->second;
-    if(sounds.empty())
+    if(it->second.empty())
     {
         OD_LOG_ERR("No sound found for sound family=" + family);
         return;
     }
 
-    unsigned int soundId = Random::Uint(0, sounds.size() - 1);
-    sounds[soundId]->play(XPos, YPos, height);
+    mPendingSpatialSounds.addSound(nullptr, family, tileX, tileY, count);
+}
+
+void SoundEffectsManager::playPendingSpatialSounds(const Ogre::Vector3& listenerPosition)
+{
+    if(mPendingSpatialSounds.isEmpty())
+        return;
+
+    mPlayingSpatialSounds.erase(std::remove_if(mPlayingSpatialSounds.begin(), mPlayingSpatialSounds.end(),
+        [](GameSound* sound) { return !sound->isPlaying(); }), mPlayingSpatialSounds.end());
+
+    // We only hear the sounds of the area seen in game (the distance is checked against the listener
+    // height). When too many sounds are fired at once, we keep the ones merging the most sounds
+    uint32_t nbVoices = MAX_SPATIAL_VOICES - std::min(MAX_SPATIAL_VOICES, static_cast<uint32_t>(mPlayingSpatialSounds.size()));
+    float maxDistance = std::sqrt(2.0f) * std::abs(static_cast<float>(listenerPosition.z));
+    std::vector<SpatialSoundCoalescer::SoundEvent> events;
+    mPendingSpatialSounds.flush(events);
+    SpatialSoundCoalescer::selectSounds(events, static_cast<float>(listenerPosition.x),
+        static_cast<float>(listenerPosition.y), maxDistance, nbVoices);
+
+    for(const SpatialSoundCoalescer::SoundEvent& event : events)
+    {
+        // The family was checked when the sound was received
+        std::vector<GameSound*>& sounds = mSpatialSounds[event.mSound];
+        unsigned int soundId = Random::Uint(0, sounds.size() - 1);
+        GameSound* sound = sounds[soundId];
+        sound->play(static_cast<float>(event.mX), static_cast<float>(event.mY), TILE_ZPOS);
+        if(std::find(mPlayingSpatialSounds.begin(), mPlayingSpatialSounds.end(), sound) == mPlayingSpatialSounds.end())
+            mPlayingSpatialSounds.push_back(sound);
+    }
 }
 
 void SoundEffectsManager::playRelativeSound(const std::string& family)
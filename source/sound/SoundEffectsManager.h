@@ -18,6 +18,8 @@
 #ifndef SOUNDEFFECTSMANAGER_H_
 #define SOUNDEFFECTSMANAGER_H_
 
+#include "sound/SpatialSoundCoalescer.h"
+
 #include <OgreSingleton.h>
 #include <OgreVector3.h>
 #include <SFML/Audio.hpp>
@@ -116,9 +118,10 @@ public:
     void updateListener(float timeSinceLastFrame,
         const Ogre::Vector3& position, const Ogre::Quaternion& orientation);
 
-    //! \brief Plays a spatial sound at the given tile position.
-    void playSpatialSound(const std::string& family,
-        float XPos, float YPos, float height = TILE_ZPOS);
+    //! \brief Plays a spatial sound at the given tile position. count is the number of identical sounds
+    //! the server merged in this one. The sound is played by the next updateListener, merged with the
+    //! identical ones nearby and only if there is a free voice
+    void playSpatialSound(const std::string& family, int32_t tileX, int32_t tileY, uint32_t count = 1);
 
     //! \brief Proxy used for sounds that aren't spatial and can be heard everywhere.
     void playRelativeSound(const std::string& family);
@@ -141,6 +144,16 @@ private:
     //! \brief Stores the relative sounds to play. Once a sound has stopped playing, the next one will start
     std::vector<GameSound*> mRelativeSoundQueue;
 
+    //! \brief Spatial sounds received since the last updateListener
+    SpatialSoundCoalescer mPendingSpatialSounds;
+
+    //! \brief Spatial sounds that were playing during the last updateListener
+    std::vector<GameSound*> mPlayingSpatialSounds;
+
+    //! \brief Plays the most important pending spatial sounds audible from the given listener position
+    //! within the free voices
+    void playPendingSpatialSounds(const Ogre::Vector3& listenerPosition);
+
     //! \brief Returns a game sounds from the cache.
     //! \param filename The sound filename.
     //! \param spatialSound Whether the sound is a spatial sound.
@@ -0,0 +1,100 @@
+/*
+ *  Copyright (C) 2011-2016  OpenDungeons Team
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "sound/SpatialSoundCoalescer.h"
+
+#include <algorithm>
+
+namespace
+{
+    //! \brief Region containing the given coordinate. Works for negative coordinates too
+    int32_t getRegion(int32_t coord, int32_t regionSize)
+    {
+        if(coord >= 0)
+            return coord / regionSize;
+
+        return -((-coord - 1) / regionSize) - 1;
+    }
+}
+
+SpatialSoundCoalescer::SpatialSoundCoalescer(int32_t regionSize) :
+    mRegionSize(std::max(regionSize, 1))
+{
+}
+
+void SpatialSoundCoalescer::addSound(const Player* player, const std::string& sound, int32_t x, int32_t y, uint32_t count)
+{
+    std::tuple<const Player*, std::string, int32_t, int32_t> key(player, sound,
+        getRegion(x, mRegionSize), getRegion(y, mRegionSize));
+    auto it = mEventIndexes.find(key);
+    if(it != mEventIndexes.end())
+    {
+        mEvents[it->second].mCount += count;
+        return;
+    }
+
+    mEventIndexes[key] = static_cast<uint32_t>(mEvents.size());
+    SoundEvent event;
+    event.mPlayer = player;
+    event.mSound = sound;
+    event.mX = x;
+    event.mY = y;
+    event.mCount = count;
+    mEvents.push_back(event);
+}
+
+void SpatialSoundCoalescer::clear()
+{
+    mEvents.clear();
+    mEventIndexes.clear();
+}
+
+void SpatialSoundCoalescer::flush(std::vector<SoundEvent>& events)
+{
+    events.clear();
+    events.swap(mEvents);
+    mEventIndexes.clear();
+}
+
+void SpatialSoundCoalescer::selectSounds(std::vector<SoundEvent>& events, float listenerX, float listenerY,
+    float maxDistance, uint32_t nbVoices)
+{
+    auto distanceSquared = [listenerX, listenerY](const SoundEvent& event)
+    {
+        float diffX = static_cast<float>(event.mX) - listenerX;
+        float diffY = static_cast<float>(event.mY) - listenerY;
+        return diffX * diffX + diffY * diffY;
+    };
+
+    float maxDistanceSquared = maxDistance * maxDistance;
+    events.erase(std::remove_if(events.begin(), events.end(), [&](const SoundEvent& event)
+        {
+            return distanceSquared(event) > maxDistanceSquared;
+        }), events.end());
+
+    if(events.size() <= nbVoices)
+        return;
+
+    std::stable_sort(events.begin(), events.end(), [&](const SoundEvent& a, const SoundEvent& b)
+        {
+            if(a.mCount != b.mCount)
+                return a.mCount > b.mCount;
+
+            return distanceSquared(a) < distanceSquared(b);
+        });
+    events.resize(nbVoices);
+}
@@ -0,0 +1,76 @@
+/*
+ *  Copyright (C) 2011-2016  OpenDungeons Team
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SPATIALSOUNDCOALESCER_H
+#define SPATIALSOUNDCOALESCER_H
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <tuple>
+#include <vector>
+
+class Player;
+
+//! \brief Merges the identical spatial sounds fired close to each other during a turn (on the server)
+//! or a frame (on the client) into one sound event with a count. During big fights, dozens of identical
+//! hit sounds can be fired at the same time and only one of them can be heard anyway.
+//! This does not depend on the sound system so that it can be tested without audio.
+class SpatialSoundCoalescer
+{
+public:
+    struct SoundEvent
+    {
+        //! \brief Player that should hear the sound. Not used on the client
+        const Player* mPlayer;
+        std::string mSound;
+        //! \brief Tile where the first merged sound was fired
+        int32_t mX;
+        int32_t mY;
+        //! \brief Number of sounds merged in this event
+        uint32_t mCount;
+    };
+
+    //! \brief Sounds fired in the same square of regionSize tiles are merged
+    SpatialSoundCoalescer(int32_t regionSize);
+
+    void addSound(const Player* player, const std::string& sound, int32_t x, int32_t y, uint32_t count = 1);
+
+    inline bool isEmpty() const
+    { return mEvents.empty(); }
+
+    //! \brief Forgets the sounds not flushed yet
+    void clear();
+
+    //! \brief Fills events with the merged sounds (in the order they were first fired) and forgets them
+    void flush(std::vector<SoundEvent>& events);
+
+    //! \brief Voice budget: removes the events farther than maxDistance from the listener and keeps
+    //! at most nbVoices events, the ones merging the most sounds first, then the closest
+    static void selectSounds(std::vector<SoundEvent>& events, float listenerX, float listenerY,
+        float maxDistance, uint32_t nbVoices);
+
+private:
+    int32_t mRegionSize;
+
+    std::vector<SoundEvent> mEvents;
+
+    //! \brief Index in mEvents of the events by player, sound and region
+    std::map<std::tuple<const Player*, std::string, int32_t, int32_t>, uint32_t> mEventIndexes;
+};
+
+#endif // SPATIALSOUNDCOALESCER_H
@@ -23,8 +23,6 @@
 #include "game/Seat.h"
 #include "gamemap/GameMap.h"
 #include "network/ODPacket.h"
-#include "network/ODServer.h"
-#include "network/ServerNotification.h"
 #include "sound/SoundEffectsManager.h"
 #include "spells/SpellSummonWorker.h"
 #include "spells/SpellCallToWar.h"
@@ -186,18 +184,7 @@ std::string Spell::formatCastSpell(SpellType type, uint32_t price)
 void Spell::fireSpellSound(Tile& tile, const std::string& soundFamily)
 {
     std::string sound = "Spells/" + soundFamily;
-    for(Seat* seat : tile.getSeatsWithVision())
-    {
-        if(seat->getPlayer() == nullptr)
-            continue;
-        if(!seat->getPlayer()->getIsHuman())
-            continue;
-
-        ServerNotification *serverNotification = new ServerNotification(
-            ServerNotificationType::playSpatialSound, seat->getPlayer());
-        serverNotification->mPacket << sound << tile.getX() << tile.getY();
-        ODServer::getSingleton().queueServerNotification(serverNotification);
-    }
+    tile.getGameMap()->fireSpatialSound(tile.getSeatsWithVision(), sound, tile.getX(), tile.getY());
 }
 
 void Spell::exportHeadersToStream(std::ostream& os) const
@@ -70,7 +70,7 @@ static SpellRegister reg(new SpellCallToWarFactory);
 
 SpellCallToWar::SpellCallToWar(GameMap* gameMap) :
     Spell(gameMap, SpellManager::getSpellNameFromSpellType(SpellType::callToWar), "WarBanner", 0.0,
-        ConfigManager::getSingleton().getSpellConfigInt32("CallToWarNbTurnsMax"))
+        ConfigManager::getSingleton().getSpellsConfig().mCallToWarNbTurnsMax)
 {
     mPrevAnimationState = "Loop";
     mPrevAnimationStateLoop = true;
@@ -110,7 +110,7 @@ void SpellCallToWar::checkSpellCast(GameMap* gameMap, const InputManager& inputM
         return;
 
     int32_t playerMana = static_cast<int32_t>(player->getSeat()->getMana());
-    int32_t price = ConfigManager::getSingleton().getSpellConfigInt32("CallToWarPrice");
+    int32_t price = ConfigManager::getSingleton().getSpellsConfig().mCallToWarPrice;
     if(inputManager.mCommandState == InputCommandState::infoOnly)
     {
         if(playerMana < price)
@@ -153,7 +153,7 @@ bool SpellCallToWar::castSpell(GameMap* gameMap, Player* player, ODPacket& packe
         return false;
 
     int32_t playerMana = static_cast<int32_t>(player->getSeat()->getMana());
-    int32_t manaCost = ConfigManager::getSingleton().getSpellConfigInt32("CallToWarPrice");
+    int32_t manaCost = ConfigManager::getSingleton().getSpellsConfig().mCallToWarPrice;
     if(playerMana < manaCost)
         return false;
 
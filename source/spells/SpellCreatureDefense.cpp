@@ -76,7 +76,7 @@ static SpellRegister reg(new SpellCreatureDefenseFactory);
 void SpellCreatureDefense::checkSpellCast(GameMap* gameMap, const InputManager& inputManager, InputCommand& inputCommand)
 {
     Player* player = gameMap->getLocalPlayer();
-    int32_t pricePerTarget = ConfigManager::getSingleton().getSpellConfigInt32("CreatureDefensePrice");
+    int32_t pricePerTarget = ConfigManager::getSingleton().getSpellsConfig().mCreatureDefensePrice;
     int32_t playerMana = static_cast<int32_t>(player->getSeat()->getMana());
     if(inputManager.mCommandState == InputCommandState::infoOnly)
     {
@@ -194,13 +194,13 @@ bool SpellCreatureDefense::castSpell(GameMap* gameMap, Player* player, ODPacket&
         return false;
     }
 
-    int32_t pricePerTarget = ConfigManager::getSingleton().getSpellConfigInt32("CreatureDefensePrice");
+    int32_t pricePerTarget = ConfigManager::getSingleton().getSpellsConfig().mCreatureDefensePrice;
 
     if(!player->getSeat()->takeMana(pricePerTarget))
         return false;
 
-    uint32_t duration = ConfigManager::getSingleton().getSpellConfigUInt32("CreatureDefenseDuration");
-    double value = ConfigManager::getSingleton().getSpellConfigDouble("CreatureDefenseValue");
+    uint32_t duration = ConfigManager::getSingleton().getSpellsConfig().mCreatureDefenseDuration;
+    double value = ConfigManager::getSingleton().getSpellsConfig().mCreatureDefenseValue;
     CreatureEffectDefense* effect = new CreatureEffectDefense(duration, value, 0.0, 0.0, "SpellCreatureDefense");
     creature->addCreatureEffect(effect);
 
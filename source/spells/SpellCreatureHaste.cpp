@@ -75,7 +75,7 @@ static SpellRegister reg(new SpellCreatureHasteFactory);
 void SpellCreatureHaste::checkSpellCast(GameMap* gameMap, const InputManager& inputManager, InputCommand& inputCommand)
 {
     Player* player = gameMap->getLocalPlayer();
-    int32_t pricePerTarget = ConfigManager::getSingleton().getSpellConfigInt32("CreatureHastePrice");
+    int32_t pricePerTarget = ConfigManager::getSingleton().getSpellsConfig().mCreatureHastePrice;
     int32_t playerMana = static_cast<int32_t>(player->getSeat()->getMana());
     if(inputManager.mCommandState == InputCommandState::infoOnly)
     {
@@ -193,13 +193,13 @@ bool SpellCreatureHaste::castSpell(GameMap* gameMap, Player* player, ODPacket& p
         return false;
     }
 
-    int32_t pricePerTarget = ConfigManager::getSingleton().getSpellConfigInt32("CreatureHastePrice");
+    int32_t pricePerTarget = ConfigManager::getSingleton().getSpellsConfig().mCreatureHastePrice;
 
     if(!player->getSeat()->takeMana(pricePerTarget))
         return false;
 
-    uint32_t duration = ConfigManager::getSingleton().getSpellConfigUInt32("CreatureHasteDuration");
-    double value = ConfigManager::getSingleton().getSpellConfigDouble("CreatureHasteValue");
+    uint32_t duration = ConfigManager::getSingleton().getSpellsConfig().mCreatureHasteDuration;
+    double value = ConfigManager::getSingleton().getSpellsConfig().mCreatureHasteValue;
     CreatureEffectSpeedChange* effect = new CreatureEffectSpeedChange(duration, value, "SpellCreatureHaste");
     creature->addCreatureEffect(effect);
 
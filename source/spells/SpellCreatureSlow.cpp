@@ -75,7 +75,7 @@ static SpellRegister reg(new SpellCreatureSlowFactory);
 void SpellCreatureSlow::checkSpellCast(GameMap* gameMap, const InputManager& inputManager, InputCommand& inputCommand)
 {
     Player* player = gameMap->getLocalPlayer();
-    int32_t pricePerTarget = ConfigManager::getSingleton().getSpellConfigInt32("CreatureSlowPrice");
+    int32_t pricePerTarget = ConfigManager::getSingleton().getSpellsConfig().mCreatureSlowPrice;
     int32_t playerMana = static_cast<int32_t>(player->getSeat()->getMana());
     if(inputManager.mCommandState == InputCommandState::infoOnly)
     {
@@ -193,13 +193,13 @@ bool SpellCreatureSlow::castSpell(GameMap* gameMap, Player* player, ODPacket& pa
         return false;
     }
 
-    int32_t pricePerTarget = ConfigManager::getSingleton().getSpellConfigInt32("CreatureSlowPrice");
+    int32_t pricePerTarget = ConfigManager::getSingleton().getSpellsConfig().mCreatureSlowPrice;
 
     if(!player->getSeat()->takeMana(pricePerTarget))
         return false;
 
-    uint32_t duration = ConfigManager::getSingleton().getSpellConfigUInt32("CreatureSlowDuration");
-    double value = ConfigManager::getSingleton().getSpellConfigDouble("CreatureSlowValue");
+    uint32_t duration = ConfigManager::getSingleton().getSpellsConfig().mCreatureSlowDuration;
+    double value = ConfigManager::getSingleton().getSpellsConfig().mCreatureSlowValue;
     CreatureEffectSpeedChange* effect = new CreatureEffectSpeedChange(duration, value, "SpellCreatureSlow");
     creature->addCreatureEffect(effect);
 
@@ -75,7 +75,7 @@ static SpellRegister reg(new SpellCreatureStrengthFactory);
 void SpellCreatureStrength::checkSpellCast(GameMap* gameMap, const InputManager& inputManager, InputCommand& inputCommand)
 {
     Player* player = gameMap->getLocalPlayer();
-    int32_t pricePerTarget = ConfigManager::getSingleton().getSpellConfigInt32("CreatureStrengthPrice");
+    int32_t pricePerTarget = ConfigManager::getSingleton().getSpellsConfig().mCreatureStrengthPrice;
     int32_t playerMana = static_cast<int32_t>(player->getSeat()->getMana());
     if(inputManager.mCommandState == InputCommandState::infoOnly)
     {
@@ -193,13 +193,13 @@ bool SpellCreatureStrength::castSpell(GameMap* gameMap, Player* player, ODPacket
         return false;
     }
 
-    int32_t pricePerTarget = ConfigManager::getSingleton().getSpellConfigInt32("CreatureStrengthPrice");
+    int32_t pricePerTarget = ConfigManager::getSingleton().getSpellsConfig().mCreatureStrengthPrice;
 
     if(!player->getSeat()->takeMana(pricePerTarget))
         return false;
 
-    uint32_t duration = ConfigManager::getSingleton().getSpellConfigUInt32("CreatureStrengthDuration");
-    double value = ConfigManager::getSingleton().getSpellConfigDouble("CreatureStrengthValue");
+    uint32_t duration = ConfigManager::getSingleton().getSpellsConfig().mCreatureStrengthDuration;
+    double value = ConfigManager::getSingleton().getSpellsConfig().mCreatureStrengthValue;
     CreatureEffectStrengthChange* effect = new CreatureEffectStrengthChange(duration, value, "SpellCreatureStrength");
     creature->addCreatureEffect(effect);
 
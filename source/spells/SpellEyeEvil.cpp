@@ -70,7 +70,7 @@ static SpellRegister reg(new SpellEyeEvilFactory);
 
 SpellEyeEvil::SpellEyeEvil(GameMap* gameMap) :
     Spell(gameMap, SpellManager::getSpellNameFromSpellType(getSpellType()), "FlyingSkull", 0.0,
-        ConfigManager::getSingleton().getSpellConfigInt32("EyeEvilNbTurns"))
+        ConfigManager::getSingleton().getSpellsConfig().mEyeEvilNbTurns)
 {
     mPrevAnimationState = "Triggered";
     mPrevAnimationStateLoop = true;
@@ -82,7 +82,7 @@ SpellEyeEvil::~SpellEyeEvil()
 
 void SpellEyeEvil::computeVisibleTiles()
 {
-    uint32_t radius = ConfigManager::getSingleton().getSpellConfigUInt32("EyeEvilRadiusTiles");
+    uint32_t radius = ConfigManager::getSingleton().getSpellsConfig().mEyeEvilRadiusTiles;
     Tile* posTile = getPositionTile();
     if(posTile == nullptr)
     {
@@ -104,7 +104,7 @@ void SpellEyeEvil::checkSpellCast(GameMap* gameMap, const InputManager& inputMan
         return;
 
     int32_t playerMana = static_cast<int32_t>(player->getSeat()->getMana());
-    int32_t price = ConfigManager::getSingleton().getSpellConfigInt32("EyeEvilPrice");
+    int32_t price = ConfigManager::getSingleton().getSpellsConfig().mEyeEvilPrice;
     if(inputManager.mCommandState == InputCommandState::infoOnly)
     {
         if(playerMana < price)
@@ -147,7 +147,7 @@ bool SpellEyeEvil::castSpell(GameMap* gameMap, Player* player, ODPacket& packet)
         return false;
 
     int32_t playerMana = static_cast<int32_t>(player->getSeat()->getMana());
-    int32_t manaCost = ConfigManager::getSingleton().getSpellConfigInt32("EyeEvilPrice");
+    int32_t manaCost = ConfigManager::getSingleton().getSpellsConfig().mEyeEvilPrice;
     if(playerMana < manaCost)
         return false;
 
@@ -97,9 +97,9 @@ void SpellSummonWorker::checkSpellCast(GameMap* gameMap, const InputManager& inp
     gameMap->playerSelects(targets, inputManager.mXPos, inputManager.mYPos, inputManager.mLStartDragX,
         inputManager.mLStartDragY, SelectionTileAllowed::groundClaimedAllied, SelectionEntityWanted::tiles, player);
 
-    int32_t nbFreeWorkers = ConfigManager::getSingleton().getSpellConfigInt32("SummonWorkerNbFree");
+    int32_t nbFreeWorkers = ConfigManager::getSingleton().getSpellsConfig().mSummonWorkerNbFree;
     int32_t nbWorkers = player->getSeat()->getNumCreaturesWorkers();
-    int32_t pricePerWorker = ConfigManager::getSingleton().getSpellConfigInt32("SummonWorkerBasePrice");
+    int32_t pricePerWorker = ConfigManager::getSingleton().getSpellsConfig().mSummonWorkerBasePrice;
     if(nbWorkers > nbFreeWorkers)
         pricePerWorker *= std::pow(2, nbWorkers - nbFreeWorkers);
 
@@ -187,9 +187,9 @@ bool SpellSummonWorker::summonWorkersOnTiles(GameMap* gameMap, Player* player, c
         return false;
     }
 
-    int32_t nbFreeWorkers = ConfigManager::getSingleton().getSpellConfigInt32("SummonWorkerNbFree");
+    int32_t nbFreeWorkers = ConfigManager::getSingleton().getSpellsConfig().mSummonWorkerNbFree;
     int32_t nbWorkers = player->getSeat()->getNumCreaturesWorkers();
-    int32_t pricePerWorker = ConfigManager::getSingleton().getSpellConfigInt32("SummonWorkerBasePrice");
+    int32_t pricePerWorker = ConfigManager::getSingleton().getSpellsConfig().mSummonWorkerBasePrice;
     if(nbWorkers > nbFreeWorkers)
         pricePerWorker *= std::pow(2, nbWorkers - nbFreeWorkers);
 
@@ -238,11 +238,11 @@ bool SpellSummonWorker::summonWorkersOnTiles(GameMap* gameMap, Player* player, c
 int32_t SpellSummonWorker::getNextWorkerPriceForPlayer(GameMap* gameMap, Player* player)
 {
     int32_t nbWorkers = player->getSeat()->getNumCreaturesWorkers();
-    int32_t nbFreeWorkers = ConfigManager::getSingleton().getSpellConfigInt32("SummonWorkerNbFree");
+    int32_t nbFreeWorkers = ConfigManager::getSingleton().getSpellsConfig().mSummonWorkerNbFree;
     if(nbWorkers < nbFreeWorkers)
         return 0;
 
-    int32_t price = ConfigManager::getSingleton().getSpellConfigInt32("SummonWorkerBasePrice");
+    int32_t price = ConfigManager::getSingleton().getSpellsConfig().mSummonWorkerBasePrice;
     price *= std::pow(2, nbWorkers - nbFreeWorkers);
 
     return price;
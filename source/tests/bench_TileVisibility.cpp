@@ -0,0 +1,151 @@
+/*
+ *  Copyright (C) 2011-2016  OpenDungeons Team
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+//! \brief Benchmark of the tile culling without renderer. A camera is moved along synthetic paths
+//! over a large map and, for each frame, the tiles whose culling state changed are computed
+//! with TileVisibility and with a full scan of the map testing each tile against the footprint.
+//! Usage: bench-TileVisibility [mapSize] [nbFrames]
+
+#include "camera/TileVisibility.h"
+
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace
+{
+    //! \brief Footprint on the ground of a camera at (x, y, height) looking forward in the
+    //! direction given by angle (in radians). The footprint is wider far from the camera
+    std::vector<TileVisibility::Point> computeFootprint(double x, double y, double height, double angle)
+    {
+        const double nearDist = 0.3 * height;
+        const double farDist = 1.6 * height;
+        const double nearHalfWidth = 0.6 * height;
+        const double farHalfWidth = 1.2 * height;
+        double dirX = std::cos(angle);
+        double dirY = std::sin(angle);
+        std::vector<TileVisibility::Point> points;
+        points.push_back(TileVisibility::Point{x + dirX * nearDist - dirY * nearHalfWidth, y + dirY * nearDist + dirX * nearHalfWidth});
+        points.push_back(TileVisibility::Point{x + dirX * nearDist + dirY * nearHalfWidth, y + dirY * nearDist - dirX * nearHalfWidth});
+        points.push_back(TileVisibility::Point{x + dirX * farDist + dirY * farHalfWidth, y + dirY * farDist - dirX * farHalfWidth});
+        points.push_back(TileVisibility::Point{x + dirX * farDist - dirY * farHalfWidth, y + dirY * farDist + dirX * farHalfWidth});
+        return points;
+    }
+
+    //! \brief Returns true if the center of the tile is in the convex polygon (vertices in order)
+    bool isInFootprint(const std::vector<TileVisibility::Point>& points, double x, double y)
+    {
+        bool hasPositive = false;
+        bool hasNegative = false;
+        for(size_t i = 0; i < points.size(); ++i)
+        {
+            const TileVisibility::Point& a = points[i];
+            const TileVisibility::Point& b = points[(i + 1) % points.size()];
+            double cross = (b.mX - a.mX) * (y - a.mY) - (b.mY - a.mY) * (x - a.mX);
+            if(cross > 0.0)
+                hasPositive = true;
+            else if(cross < 0.0)
+                hasNegative = true;
+        }
+        return !(hasPositive && hasNegative);
+    }
+
+    typedef std::function<std::vector<TileVisibility::Point>(uint32_t frame)> CameraPath;
+
+    void runPath(const std::string& name, const CameraPath& path, int32_t mapSize, uint32_t nbFrames)
+    {
+        // Full scan of the map each frame, like when every tile is tested
+        std::vector<bool> visible(static_cast<size_t>(mapSize * mapSize), false);
+        uint64_t nbChangesFullScan = 0;
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        for(uint32_t frame = 0; frame < nbFrames; ++frame)
+        {
+            std::vector<TileVisibility::Point> points = path(frame);
+            for(int32_t y = 0; y < mapSize; ++y)
+            {
+                for(int32_t x = 0; x < mapSize; ++x)
+                {
+                    bool isVisible = isInFootprint(points, static_cast<double>(x), static_cast<double>(y));
+                    if(visible[x + y * mapSize] == isVisible)
+                        continue;
+
+                    visible[x + y * mapSize] = isVisible;
+                    ++nbChangesFullScan;
+                }
+            }
+        }
+        double fullScanMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+        TileVisibility visibility;
+        visibility.reset(mapSize, mapSize);
+        std::vector<std::pair<int32_t, int32_t>> shownTiles;
+        std::vector<std::pair<int32_t, int32_t>> hiddenTiles;
+        uint64_t nbChanges = 0;
+        start = std::chrono::steady_clock::now();
+        for(uint32_t frame = 0; frame < nbFrames; ++frame)
+        {
+            visibility.computeVisibleTiles(path(frame));
+            visibility.getChangedTiles(shownTiles, hiddenTiles);
+            nbChanges += shownTiles.size() + hiddenTiles.size();
+        }
+        double bitsetMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+        std::cout << name << ": full scan " << fullScanMs / nbFrames << " ms/frame (" << nbChangesFullScan
+            << " changes), TileVisibility " << bitsetMs / nbFrames << " ms/frame (" << nbChanges << " changes)"
+            << std::endl;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    int32_t mapSize = (argc > 1) ? std::atoi(argv[1]) : 400;
+    uint32_t nbFrames = (argc > 2) ? static_cast<uint32_t>(std::atoi(argv[2])) : 1000;
+    if((mapSize <= 0) || (nbFrames == 0))
+    {
+        std::cerr << "Usage: " << argv[0] << " [mapSize] [nbFrames]" << std::endl;
+        return 1;
+    }
+
+    double center = static_cast<double>(mapSize) / 2.0;
+    const double pi = std::acos(-1.0);
+    std::cout << "Map " << mapSize << "x" << mapSize << ", " << nbFrames << " frames" << std::endl;
+
+    runPath("Pan", [&](uint32_t frame)
+    {
+        double x = 10.0 + std::fmod(frame * 0.2, static_cast<double>(mapSize) - 20.0);
+        return computeFootprint(x, center, 12.0, pi / 2.0);
+    }, mapSize, nbFrames);
+
+    runPath("Orbit", [&](uint32_t frame)
+    {
+        double angle = frame * 0.01;
+        return computeFootprint(center + std::cos(angle) * center / 2.0, center + std::sin(angle) * center / 2.0,
+            15.0, angle + pi / 2.0);
+    }, mapSize, nbFrames);
+
+    runPath("Zoom", [&](uint32_t frame)
+    {
+        double height = 8.0 + 20.0 * (1.0 + std::sin(frame * 0.02)) / 2.0;
+        return computeFootprint(center, center, height, pi / 2.0);
+    }, mapSize, nbFrames);
+
+    return 0;
+}
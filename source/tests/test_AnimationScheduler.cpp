@@ -0,0 +1,71 @@
+/*
+ *  Copyright (C) 2011-2016  OpenDungeons Team
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#define BOOST_TEST_MODULE AnimationScheduler
+#include "BoostTestTargetConfig.h"
+
+#include "gamemap/AnimationScheduler.h"
+
+BOOST_AUTO_TEST_CASE(test_Levels)
+{
+    AnimationScheduler scheduler;
+    // Without view target, every entity on screen is near
+    BOOST_CHECK(scheduler.getLevel(true, 50, 50) == AnimationScheduler::Level::nearCamera);
+    BOOST_CHECK(scheduler.getLevel(false, 50, 50) == AnimationScheduler::Level::offScreen);
+
+    scheduler.setViewTarget(10, 10);
+    BOOST_CHECK(scheduler.getLevel(true, 12, 8) == AnimationScheduler::Level::nearCamera);
+    BOOST_CHECK(scheduler.getLevel(true, 40, 10) == AnimationScheduler::Level::farFromCamera);
+    BOOST_CHECK(scheduler.getLevel(false, 10, 10) == AnimationScheduler::Level::offScreen);
+
+    scheduler.setEnabled(false);
+    BOOST_CHECK(scheduler.getLevel(false, 40, 10) == AnimationScheduler::Level::nearCamera);
+}
+
+BOOST_AUTO_TEST_CASE(test_UpdateRates)
+{
+    AnimationScheduler scheduler;
+    scheduler.setViewTarget(0, 0);
+    uint32_t nbNear = 0;
+    uint32_t nbFar = 0;
+    uint32_t nbOffScreen = 0;
+    const uint32_t nbFrames = 30;
+    for(uint32_t frame = 0; frame < nbFrames; ++frame)
+    {
+        scheduler.startFrame();
+        if(scheduler.isAnimationUpdated(true, 1, 1))
+            ++nbNear;
+        if(scheduler.isAnimationUpdated(true, 30, 30))
+            ++nbFar;
+        if(scheduler.isAnimationUpdated(false, 1, 1))
+            ++nbOffScreen;
+    }
+
+    BOOST_CHECK(nbNear == nbFrames);
+    BOOST_CHECK(nbFar == nbFrames / 3);
+    BOOST_CHECK(nbOffScreen == 0);
+
+    // Far entities on neighbour tiles are not all updated during the same frame
+    scheduler.startFrame();
+    uint32_t nbUpdated = 0;
+    for(int32_t x = 30; x < 33; ++x)
+    {
+        if(scheduler.isAnimationUpdated(true, x, 30))
+            ++nbUpdated;
+    }
+    BOOST_CHECK(nbUpdated == 1);
+}
@@ -0,0 +1,195 @@
+/*
+ *  Copyright (C) 2011-2016  OpenDungeons Team
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#define BOOST_TEST_MODULE ConfigParams
+#include "BoostTestTargetConfig.h"
+
+#include "utils/ConfigParams.h"
+#include "utils/LogManager.h"
+#include "utils/LogSinkConsole.h"
+
+#include <algorithm>
+
+namespace
+{
+struct TestConfig : public ConfigParamRegistry
+{
+    TestConfig() :
+        mUInt(7),
+        mInt(-7),
+        mDouble(0.5)
+    {
+        registerParam("UInt", mUInt);
+        registerParam("Int", mInt);
+        registerParam("Double", mDouble);
+        registerParam("String", mString);
+    }
+
+    uint32_t mUInt;
+    int32_t mInt;
+    double mDouble;
+    std::string mString;
+};
+}
+
+BOOST_AUTO_TEST_CASE(test_Registration)
+{
+    LogManager logMgr;
+    logMgr.addSink(std::unique_ptr<LogSink>(new LogSinkConsole()));
+
+    TestConfig config;
+    std::vector<std::string> expected = { "Double", "Int", "String", "UInt" };
+    BOOST_CHECK(config.getParamNames() == expected);
+
+    // Nothing is set until a value is given
+    BOOST_CHECK(config.getUnsetParams() == expected);
+
+    BOOST_CHECK(config.setValue("Int", "12"));
+    BOOST_CHECK(config.setValue("String", "Kobold"));
+    expected = { "Double", "UInt" };
+    BOOST_CHECK(config.getUnsetParams() == expected);
+}
+
+BOOST_AUTO_TEST_CASE(test_Lookup)
+{
+    LogManager logMgr;
+    logMgr.addSink(std::unique_ptr<LogSink>(new LogSinkConsole()));
+
+    TestConfig config;
+    BOOST_CHECK(config.setValue("UInt", "42"));
+    BOOST_CHECK(config.setValue("Int", "-3"));
+    BOOST_CHECK(config.setValue("Double", "2.25"));
+    BOOST_CHECK(config.setValue("String", "Kobold"));
+
+    // The fields are set directly
+    BOOST_CHECK(config.mUInt == 42);
+    BOOST_CHECK(config.mInt == -3);
+    BOOST_CHECK(config.mDouble == 2.25);
+    BOOST_CHECK(config.mString == "Kobold");
+
+    std::string value;
+    BOOST_CHECK(config.getValue("UInt", value));
+    BOOST_CHECK(value == "42");
+    BOOST_CHECK(config.getValue("Int", value));
+    BOOST_CHECK(value == "-3");
+    BOOST_CHECK(config.getValue("String", value));
+    BOOST_CHECK(value == "Kobold");
+    BOOST_CHECK(config.getUInt32("UInt") == 42);
+
+    // Changes to the fields are seen by the registry
+    config.mUInt = 5;
+    BOOST_CHECK(config.getUInt32("UInt") == 5);
+
+    // Unknown parameters
+    value = "unchanged";
+    BOOST_CHECK(!config.getValue("Unknown", value));
+    BOOST_CHECK(value == "unchanged");
+    BOOST_CHECK(!config.setValue("Unknown", "1"));
+    BOOST_CHECK(config.getUInt32("Unknown") == 0);
+    // Existing parameter with another type
+    BOOST_CHECK(config.getUInt32("Int") == 0);
+}
+
+BOOST_AUTO_TEST_CASE(test_BadValues)
+{
+    LogManager logMgr;
+    logMgr.addSink(std::unique_ptr<LogSink>(new LogSinkConsole()));
+
+    TestConfig config;
+    BOOST_CHECK(!config.setValue("UInt", "abc"));
+    BOOST_CHECK(!config.setValue("UInt", ""));
+    BOOST_CHECK(!config.setValue("UInt", "4294967296"));
+    BOOST_CHECK(!config.setValue("Int", "-"));
+    BOOST_CHECK(!config.setValue("Int", "2147483648"));
+    BOOST_CHECK(!config.setValue("Double", "x1.5"));
+    BOOST_CHECK(!config.setValue("String", ""));
+
+    // Invalid values do not change the fields nor mark them as set
+    BOOST_CHECK(config.mUInt == 7);
+    BOOST_CHECK(config.mInt == -7);
+    BOOST_CHECK(config.mDouble == 0.5);
+    BOOST_CHECK(config.getUnsetParams().size() == 4);
+
+    // Bounds are accepted
+    BOOST_CHECK(config.setValue("UInt", "4294967295"));
+    BOOST_CHECK(config.mUInt == 4294967295u);
+    BOOST_CHECK(config.setValue("Int", "-2147483648"));
+    BOOST_CHECK(config.mInt == INT32_MIN);
+}
+
+BOOST_AUTO_TEST_CASE(test_RoomsConfig)
+{
+    LogManager logMgr;
+    logMgr.addSink(std::unique_ptr<LogSink>(new LogSinkConsole()));
+
+    // The game configs are registries: a parameter from the file sets the matching field
+    RoomsConfig rooms;
+    std::vector<std::string> names = rooms.getParamNames();
+    BOOST_CHECK(std::find(names.begin(), names.end(), "PrisonCostPerTile") != names.end());
+    BOOST_CHECK(rooms.setValue("PrisonCostPerTile", "150"));
+    BOOST_CHECK(rooms.mPrisonCostPerTile == 150);
+    BOOST_CHECK(rooms.setValue("PrisonDamagePerTurn", "1.5"));
+    BOOST_CHECK(rooms.mPrisonDamagePerTurn == 1.5);
+    BOOST_CHECK(!rooms.setValue("PrisonSpawnClass", ""));
+}
+
+BOOST_AUTO_TEST_CASE(test_CopyValues)
+{
+    LogManager logMgr;
+    logMgr.addSink(std::unique_ptr<LogSink>(new LogSinkConsole()));
+
+    TestConfig config;
+    BOOST_CHECK(config.setValue("UInt", "42"));
+    BOOST_CHECK(config.setValue("Double", "0.125"));
+    BOOST_CHECK(config.setValue("String", "Kobold"));
+
+    TestConfig copy;
+    copy.copyValuesFrom(config);
+    BOOST_CHECK(copy.mUInt == 42);
+    BOOST_CHECK(copy.mInt == -7);
+    BOOST_CHECK(copy.mDouble == 0.125);
+    BOOST_CHECK(copy.mString == "Kobold");
+
+    // What was set is copied too
+    std::vector<std::string> expected = { "Int" };
+    BOOST_CHECK(copy.getUnsetParams() == expected);
+}
+
+BOOST_AUTO_TEST_CASE(test_ConfigSnapshots)
+{
+    LogManager logMgr;
+    logMgr.addSink(std::unique_ptr<LogSink>(new LogSinkConsole()));
+
+    ConfigSnapshots<TestConfig> snapshots;
+    BOOST_CHECK(snapshots.getLoadedConfig().setValue("UInt", "42"));
+    BOOST_CHECK(snapshots.get().mUInt == 42);
+
+    // A change publishes a new config. The previous one is not modified so that a thread reading
+    // it is not disturbed
+    const TestConfig& previous = snapshots.get();
+    BOOST_CHECK(snapshots.setValue("UInt", "43"));
+    BOOST_CHECK(snapshots.get().mUInt == 43);
+    BOOST_CHECK(previous.mUInt == 42);
+    BOOST_CHECK(&snapshots.get() != &previous);
+
+    // Nothing is published if the value is invalid
+    const TestConfig& current = snapshots.get();
+    BOOST_CHECK(!snapshots.setValue("UInt", "abc"));
+    BOOST_CHECK(!snapshots.setValue("Unknown", "1"));
+    BOOST_CHECK(&snapshots.get() == &current);
+    BOOST_CHECK(current.mUInt == 43);
+}
@@ -0,0 +1,145 @@
+/*
+ *  Copyright (C) 2011-2016  OpenDungeons Team
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#define BOOST_TEST_MODULE InstanceGroups
+#include "BoostTestTargetConfig.h"
+
+#include "render/InstanceGroups.h"
+
+#include <algorithm>
+
+namespace
+{
+    InstanceGroups::InstanceData buildInstance(float x, float y)
+    {
+        InstanceGroups::InstanceData data;
+        data.mX = x;
+        data.mY = y;
+        return data;
+    }
+
+    bool batchContains(const InstanceGroups::Batch& batch, uint32_t instanceId)
+    {
+        return std::find(batch.mInstances.begin(), batch.mInstances.end(), instanceId) != batch.mInstances.end();
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_GroupByMeshAndColor)
+{
+    InstanceGroups groups(2, 8.0f);
+    const Seat* seat = reinterpret_cast<const Seat*>(&groups);
+    uint32_t gold1 = groups.addInstance("Gold.mesh", nullptr, buildInstance(1.0f, 1.0f));
+    uint32_t gold2 = groups.addInstance("Gold.mesh", nullptr, buildInstance(2.0f, 1.0f));
+    uint32_t bed = groups.addInstance("Bed.mesh", nullptr, buildInstance(3.0f, 1.0f));
+    uint32_t coloredGold = groups.addInstance("Gold.mesh", seat, buildInstance(4.0f, 1.0f));
+    // The first batch of gold is full so a new one is used
+    uint32_t gold3 = groups.addInstance("Gold.mesh", nullptr, buildInstance(5.0f, 1.0f));
+
+    BOOST_CHECK(groups.getNbBatches() == 4);
+    BOOST_CHECK(groups.getInstanceBatch(gold1) == groups.getInstanceBatch(gold2));
+    BOOST_CHECK(groups.getInstanceBatch(gold1) != groups.getInstanceBatch(bed));
+    BOOST_CHECK(groups.getInstanceBatch(gold1) != groups.getInstanceBatch(coloredGold));
+    BOOST_CHECK(groups.getInstanceBatch(gold1) != groups.getInstanceBatch(gold3));
+    const InstanceGroups::Batch& goldBatch = groups.getBatch(groups.getInstanceBatch(gold1));
+    BOOST_CHECK(goldBatch.mMeshName == "Gold.mesh");
+    BOOST_CHECK(goldBatch.mSeatColor == nullptr);
+    BOOST_CHECK(groups.getBatch(groups.getInstanceBatch(coloredGold)).mSeatColor == seat);
+    BOOST_CHECK(groups.getDirtyBatches().size() == 4);
+
+    // Removing an instance frees room in its batch
+    groups.clearDirtyBatches();
+    groups.removeInstance(gold1);
+    BOOST_CHECK(!groups.hasInstance(gold1));
+    BOOST_CHECK(groups.getDirtyBatches().size() == 1);
+    BOOST_CHECK(batchContains(goldBatch, gold2));
+    uint32_t gold4 = groups.addInstance("Gold.mesh", nullptr, buildInstance(6.0f, 1.0f));
+    BOOST_CHECK(groups.getInstanceBatch(gold4) == groups.getInstanceBatch(gold2));
+    BOOST_CHECK(groups.getNbBatches() == 4);
+    BOOST_CHECK(groups.getInstance(gold4).mX == 6.0f);
+}
+
+BOOST_AUTO_TEST_CASE(test_RemoveKeepsBatchConsistent)
+{
+    InstanceGroups groups(8, 8.0f);
+    std::vector<uint32_t> ids;
+    for(uint32_t i = 0; i < 5; ++i)
+        ids.push_back(groups.addInstance("Gold.mesh", nullptr, buildInstance(static_cast<float>(i), 0.0f)));
+
+    // Removing in any order should keep the other instances in the batch
+    groups.removeInstance(ids[1]);
+    groups.removeInstance(ids[4]);
+    groups.removeInstance(ids[0]);
+    const InstanceGroups::Batch& batch = groups.getBatch(0);
+    BOOST_CHECK(batch.mInstances.size() == 2);
+    BOOST_CHECK(batchContains(batch, ids[2]));
+    BOOST_CHECK(batchContains(batch, ids[3]));
+    groups.removeInstance(ids[3]);
+    groups.removeInstance(ids[2]);
+    BOOST_CHECK(batch.mInstances.empty());
+}
+
+BOOST_AUTO_TEST_CASE(test_DirtyBatches)
+{
+    InstanceGroups groups(8, 8.0f);
+    uint32_t gold = groups.addInstance("Gold.mesh", nullptr, buildInstance(1.0f, 1.0f));
+    uint32_t bed = groups.addInstance("Bed.mesh", nullptr, buildInstance(2.0f, 1.0f));
+    groups.clearDirtyBatches();
+
+    // Nothing changes
+    groups.setPosition(gold, 1.0f, 1.0f, 0.0f);
+    BOOST_CHECK(groups.getDirtyBatches().empty());
+
+    groups.setPosition(gold, 1.0f, 2.0f, 0.0f);
+    BOOST_REQUIRE(groups.getDirtyBatches().size() == 1);
+    BOOST_CHECK(groups.getDirtyBatches()[0] == groups.getInstanceBatch(gold));
+    BOOST_CHECK(groups.getInstance(gold).mY == 2.0f);
+
+    groups.setPosition(bed, 3.0f, 1.0f, 0.0f);
+    BOOST_CHECK(groups.getDirtyBatches().size() == 2);
+    groups.clearDirtyBatches();
+    BOOST_CHECK(groups.getDirtyBatches().empty());
+}
+
+BOOST_AUTO_TEST_CASE(test_GroupByChunk)
+{
+    InstanceGroups groups(8, 8.0f);
+    uint32_t gold1 = groups.addInstance("Gold.mesh", nullptr, buildInstance(1.0f, 1.0f));
+    uint32_t gold2 = groups.addInstance("Gold.mesh", nullptr, buildInstance(7.5f, 7.5f));
+    uint32_t farGold = groups.addInstance("Gold.mesh", nullptr, buildInstance(9.0f, 1.0f));
+    BOOST_CHECK(groups.getNbBatches() == 2);
+    BOOST_CHECK(groups.getInstanceBatch(gold1) == groups.getInstanceBatch(gold2));
+    BOOST_CHECK(groups.getInstanceBatch(gold1) != groups.getInstanceBatch(farGold));
+    const InstanceGroups::Batch& farBatch = groups.getBatch(groups.getInstanceBatch(farGold));
+    BOOST_CHECK(farBatch.mChunkX == 1);
+    BOOST_CHECK(farBatch.mChunkY == 0);
+
+    // Moving an instance to another chunk moves it to the batch of this chunk
+    groups.clearDirtyBatches();
+    uint32_t oldBatch = groups.getInstanceBatch(gold2);
+    groups.setPosition(gold2, 10.0f, 2.0f, 0.0f);
+    BOOST_CHECK(groups.getInstanceBatch(gold2) == groups.getInstanceBatch(farGold));
+    BOOST_CHECK(groups.getDirtyBatches().size() == 2);
+    BOOST_CHECK(batchContains(groups.getBatch(oldBatch), gold1));
+    BOOST_CHECK(!batchContains(groups.getBatch(oldBatch), gold2));
+    BOOST_CHECK(batchContains(groups.getBatch(groups.getInstanceBatch(gold2)), gold2));
+
+    // Moving in a chunk with no batch yet creates one
+    groups.setPosition(gold1, -1.0f, 1.0f, 0.0f);
+    BOOST_CHECK(groups.getNbBatches() == 3);
+    BOOST_CHECK(groups.getBatch(groups.getInstanceBatch(gold1)).mChunkX == -1);
+    BOOST_CHECK(groups.getBatch(oldBatch).mInstances.empty());
+}
@@ -0,0 +1,105 @@
+/*
+ *  Copyright (C) 2011-2016  OpenDungeons Team
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#define BOOST_TEST_MODULE MaterialVariantCache
+#include "BoostTestTargetConfig.h"
+
+#include "render/MaterialVariantCache.h"
+
+namespace
+{
+    //! \brief Builds the variant names the same way as RenderManager and counts the calls
+    struct TestBuilder
+    {
+        uint32_t mNbCalls = 0;
+
+        std::string build(const std::string& materialName, const std::string& colorId,
+            bool markedForDigging, bool playerHasVision)
+        {
+            ++mNbCalls;
+            std::string name = materialName + "##";
+            if(!colorId.empty())
+                name += "Color_" + colorId + "_";
+            if(markedForDigging)
+                name += "dig_";
+            else if(!playerHasVision)
+                name += "novision_";
+            return name;
+        }
+    };
+
+    MaterialVariantCache::VariantBuilder makeBuilder(TestBuilder& builder)
+    {
+        return [&builder](const std::string& materialName, const std::string& colorId,
+            bool markedForDigging, bool playerHasVision)
+        {
+            return builder.build(materialName, colorId, markedForDigging, playerHasVision);
+        };
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_MaterialIds)
+{
+    TestBuilder builder;
+    MaterialVariantCache cache(makeBuilder(builder));
+    uint32_t wallId = cache.getMaterialId("Wall");
+    uint32_t groundId = cache.getMaterialId("Ground");
+    BOOST_CHECK(wallId != groundId);
+    BOOST_CHECK(cache.getMaterialId("Wall") == wallId);
+    BOOST_CHECK(cache.getMaterialName(wallId) == "Wall");
+
+    // Variants give the id of their base material, whether they were built by the cache or not
+    const std::string& variant = cache.getVariant(wallId, "1", false, true);
+    BOOST_CHECK(cache.getMaterialId(variant) == wallId);
+    BOOST_CHECK(cache.getMaterialId("Ground##Color_7_dig_") == groundId);
+    BOOST_CHECK(builder.mNbCalls == 1);
+}
+
+BOOST_AUTO_TEST_CASE(test_VariantsAreBuiltOnce)
+{
+    TestBuilder builder;
+    MaterialVariantCache cache(makeBuilder(builder));
+    uint32_t wallId = cache.getMaterialId("Wall");
+
+    // The plain material is not a variant
+    BOOST_CHECK(cache.getVariant(wallId, MaterialVariantCache::NO_COLOR, false, true) == "Wall");
+    BOOST_CHECK(builder.mNbCalls == 0);
+
+    BOOST_CHECK(cache.getVariant(wallId, "1", false, true) == "Wall##Color_1_");
+    BOOST_CHECK(cache.getVariant(wallId, "1", true, true) == "Wall##Color_1_dig_");
+    BOOST_CHECK(cache.getVariant(wallId, "1", false, false) == "Wall##Color_1_novision_");
+    BOOST_CHECK(cache.getVariant(wallId, MaterialVariantCache::NO_COLOR, true, true) == "Wall##dig_");
+    BOOST_CHECK(builder.mNbCalls == 4);
+    BOOST_CHECK(cache.getNbMisses() == 4);
+
+    BOOST_CHECK(cache.getVariant(wallId, "1", false, true) == "Wall##Color_1_");
+    BOOST_CHECK(cache.getVariant(wallId, "1", true, true) == "Wall##Color_1_dig_");
+    BOOST_CHECK(builder.mNbCalls == 4);
+}
+
+BOOST_AUTO_TEST_CASE(test_VariantsKeyedByColor)
+{
+    // Seats can have different colors from one level to the other. The variants only depend
+    // on the color
+    TestBuilder builder;
+    MaterialVariantCache cache(makeBuilder(builder));
+    uint32_t wallId = cache.getMaterialId("Wall");
+    BOOST_CHECK(cache.getVariant(wallId, "1", false, true) == "Wall##Color_1_");
+    BOOST_CHECK(cache.getVariant(wallId, "3", false, true) == "Wall##Color_3_");
+    BOOST_CHECK(cache.getVariant(wallId, "1", false, true) == "Wall##Color_1_");
+    BOOST_CHECK(builder.mNbCalls == 2);
+}
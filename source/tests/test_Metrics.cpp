@@ -0,0 +1,78 @@
+/*
+ *  Copyright (C) 2011-2016  OpenDungeons Team
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#define BOOST_TEST_MODULE Metrics
+#include "BoostTestTargetConfig.h"
+
+#include "utils/Metrics.h"
+
+#include <string>
+
+BOOST_AUTO_TEST_CASE(test_Counter)
+{
+    Metrics::Counter& counter = Metrics::getCounter("test_counter", "Test counter");
+    BOOST_CHECK(&counter == &Metrics::getCounter("test_counter", "Test counter"));
+
+    counter.increment();
+    counter.increment(4);
+    BOOST_CHECK(counter.getValue() == 5);
+    BOOST_CHECK(counter.getLastTurnValue() == 0);
+
+    Metrics::endTurn();
+    BOOST_CHECK(counter.getLastTurnValue() == 5);
+
+    counter.increment(2);
+    Metrics::endTurn();
+    BOOST_CHECK(counter.getValue() == 7);
+    BOOST_CHECK(counter.getLastTurnValue() == 2);
+}
+
+BOOST_AUTO_TEST_CASE(test_Histogram)
+{
+    Metrics::Histogram histogram("test_histogram", "Test histogram", {1.0, 10.0});
+    histogram.observe(0.5);
+    histogram.observe(1.0);
+    histogram.observe(5.0);
+    histogram.observe(50.0);
+    BOOST_CHECK(histogram.getCount() == 4);
+    BOOST_CHECK(histogram.getBucketCount(0) == 2);
+    BOOST_CHECK(histogram.getBucketCount(1) == 1);
+    BOOST_CHECK(histogram.getBucketCount(2) == 1);
+    BOOST_CHECK_CLOSE(histogram.getSum(), 56.5, 0.0001);
+
+    histogram.endTurn();
+    histogram.observe(2.0);
+    histogram.endTurn();
+    BOOST_CHECK(histogram.getLastTurnCount() == 1);
+    BOOST_CHECK_CLOSE(histogram.getLastTurnSum(), 2.0, 0.0001);
+}
+
+BOOST_AUTO_TEST_CASE(test_Export)
+{
+    Metrics::Histogram& histogram = Metrics::getTimerHistogram("test_timer_ms", "Test timer");
+    {
+        Metrics::ScopedTimer timer(histogram);
+    }
+    BOOST_CHECK(histogram.getCount() == 1);
+
+    std::string text = Metrics::exportText();
+    BOOST_CHECK(text.find("# TYPE test_counter_total counter\n") != std::string::npos);
+    BOOST_CHECK(text.find("test_counter_total 7\n") != std::string::npos);
+    BOOST_CHECK(text.find("# TYPE test_timer_ms histogram\n") != std::string::npos);
+    BOOST_CHECK(text.find("test_timer_ms_bucket{le=\"+Inf\"} 1\n") != std::string::npos);
+    BOOST_CHECK(text.find("test_timer_ms_count 1\n") != std::string::npos);
+}
@@ -0,0 +1,115 @@
+/*
+ *  Copyright (C) 2011-2016  OpenDungeons Team
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#define BOOST_TEST_MODULE MiniMapRaster
+#include "BoostTestTargetConfig.h"
+
+#include "gamemap/MiniMapRaster.h"
+
+namespace
+{
+    const MiniMapRaster::Colour RED(0xFF, 0x00, 0x00);
+    const MiniMapRaster::Colour BLACK(0x00, 0x00, 0x00);
+}
+
+BOOST_AUTO_TEST_CASE(test_FillRect)
+{
+    MiniMapRaster raster(10, 8);
+    // At creation, the whole raster has to be uploaded
+    BOOST_REQUIRE(raster.getDirtyRects().size() == 1);
+    BOOST_CHECK(raster.getDirtyRects()[0].mXMax == 10);
+    BOOST_CHECK(raster.getDirtyRects()[0].mYMax == 8);
+    raster.clearDirtyRects();
+
+    raster.fillRect(MiniMapRaster::Rect(2, 4, 3, 5), RED);
+    BOOST_CHECK(raster.getPixel(2, 3) == RED);
+    BOOST_CHECK(raster.getPixel(3, 4) == RED);
+    BOOST_CHECK(raster.getPixel(4, 4) == BLACK);
+    BOOST_CHECK(raster.getPixel(3, 5) == BLACK);
+
+    // Pixels are stored as RGBA
+    const uint8_t* pixel = raster.getPixels() + (2 + 3 * 10) * 4;
+    BOOST_CHECK(pixel[0] == 0xFF);
+    BOOST_CHECK(pixel[1] == 0x00);
+    BOOST_CHECK(pixel[3] == 0xFF);
+
+    BOOST_REQUIRE(raster.getDirtyRects().size() == 1);
+    const MiniMapRaster::Rect& dirty = raster.getDirtyRects()[0];
+    BOOST_CHECK((dirty.mXMin == 2) && (dirty.mXMax == 4) && (dirty.mYMin == 3) && (dirty.mYMax == 5));
+
+    // Painting the same colour again does not dirty anything
+    raster.clearDirtyRects();
+    raster.fillRect(MiniMapRaster::Rect(2, 4, 3, 5), RED);
+    BOOST_CHECK(raster.getDirtyRects().empty());
+}
+
+BOOST_AUTO_TEST_CASE(test_DirtyRectsMerge)
+{
+    MiniMapRaster raster(100, 100);
+    raster.clearDirtyRects();
+
+    raster.fillRect(MiniMapRaster::Rect(0, 2, 0, 2), RED);
+    raster.fillRect(MiniMapRaster::Rect(50, 52, 50, 52), RED);
+    BOOST_CHECK(raster.getDirtyRects().size() == 2);
+
+    // Touching rectangles are merged
+    raster.fillRect(MiniMapRaster::Rect(2, 4, 0, 2), RED);
+    BOOST_REQUIRE(raster.getDirtyRects().size() == 2);
+    BOOST_CHECK(raster.getDirtyRects()[1].mXMin == 0);
+    BOOST_CHECK(raster.getDirtyRects()[1].mXMax == 4);
+
+    // Too many rectangles are merged in their bounding rectangle
+    for(uint32_t i = 0; i < 10; ++i)
+        raster.fillRect(MiniMapRaster::Rect(i * 10, i * 10 + 1, 90, 91), RED);
+
+    BOOST_CHECK(raster.getDirtyRects().size() < 8);
+    const MiniMapRaster::Rect& dirty = raster.getDirtyRects()[0];
+    BOOST_CHECK((dirty.mXMin == 0) && (dirty.mXMax >= 52) && (dirty.mYMin == 0) && (dirty.mYMax == 91));
+}
+
+BOOST_AUTO_TEST_CASE(test_OverlayOutline)
+{
+    MiniMapRaster raster(20, 20);
+    raster.fillRect(MiniMapRaster::Rect(0, 20, 0, 20), RED);
+    raster.clearDirtyRects();
+
+    std::vector<std::pair<int32_t, int32_t>> outline = { {2, 2}, {10, 2}, {10, 10}, {2, 10} };
+    raster.setOverlayOutline(outline, BLACK);
+    BOOST_CHECK(raster.getPixel(2, 2) == BLACK);
+    BOOST_CHECK(raster.getPixel(6, 2) == BLACK);
+    BOOST_CHECK(raster.getPixel(10, 6) == BLACK);
+    BOOST_CHECK(raster.getPixel(6, 6) == RED);
+    BOOST_REQUIRE(raster.getDirtyRects().size() == 1);
+    BOOST_CHECK(raster.getDirtyRects()[0].mXMax == 11);
+
+    // Tiles changing under the outline do not erase it
+    raster.fillRect(MiniMapRaster::Rect(0, 20, 0, 20), BLACK);
+    raster.fillRect(MiniMapRaster::Rect(0, 20, 0, 20), MiniMapRaster::Colour(0x00, 0xFF, 0x00));
+    BOOST_CHECK(raster.getPixel(6, 2) == BLACK);
+
+    // Moving the outline restores the tiles
+    outline = { {-50, 15}, {50, 15} };
+    raster.setOverlayOutline(outline, BLACK);
+    BOOST_CHECK(raster.getPixel(6, 2) == MiniMapRaster::Colour(0x00, 0xFF, 0x00));
+    BOOST_CHECK(raster.getPixel(0, 15) == BLACK);
+    BOOST_CHECK(raster.getPixel(19, 15) == BLACK);
+
+    // Outline fully outside of the raster
+    outline = { {-50, -5}, {50, -5} };
+    raster.setOverlayOutline(outline, BLACK);
+    BOOST_CHECK(raster.getPixel(0, 15) == MiniMapRaster::Colour(0x00, 0xFF, 0x00));
+}
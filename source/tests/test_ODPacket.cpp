@@ -54,3 +54,16 @@ BOOST_AUTO_TEST_CASE(test_ODPacket)
 
     }
 }
+
+BOOST_AUTO_TEST_CASE(test_ODPacketEndOfPacket)
+{
+    ODPacket packet;
+    BOOST_CHECK(packet.endOfPacket());
+    const int32_t inInt = 3;
+    packet << inInt;
+    BOOST_CHECK(!packet.endOfPacket());
+    int32_t outInt;
+    packet >> outInt;
+    BOOST_CHECK(packet.endOfPacket());
+    BOOST_CHECK(packet);
+}
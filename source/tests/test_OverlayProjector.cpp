@@ -0,0 +1,109 @@
+/*
+ *  Copyright (C) 2011-2016  OpenDungeons Team
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#define BOOST_TEST_MODULE OverlayProjector
+#include "BoostTestTargetConfig.h"
+
+#include "render/OverlayProjector.h"
+
+#include <cmath>
+
+namespace
+{
+    //! \brief Simple projection looking toward -z from the origin: x and y are divided by -z
+    const float VIEW_PROJ[16] = {
+        1.0f, 0.0f, 0.0f, 0.0f,
+        0.0f, 1.0f, 0.0f, 0.0f,
+        0.0f, 0.0f, -1.0f, 0.0f,
+        0.0f, 0.0f, -1.0f, 0.0f
+    };
+
+    bool isClose(float a, float b)
+    {
+        return std::fabs(a - b) < 0.0001f;
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_Project)
+{
+    OverlayProjector projector;
+    uint32_t center = projector.addAnchor();
+    uint32_t topLeft = projector.addAnchor();
+    uint32_t outside = projector.addAnchor();
+    uint32_t behind = projector.addAnchor();
+    projector.setAnchorPosition(center, 0.0f, 0.0f, -5.0f);
+    projector.setAnchorPosition(topLeft, -1.0f, 1.0f, -2.0f);
+    projector.setAnchorPosition(outside, 5.0f, 0.0f, -2.0f);
+    projector.setAnchorPosition(behind, 0.0f, 0.0f, 5.0f);
+    projector.project(VIEW_PROJ, 0.0f);
+
+    BOOST_CHECK(projector.isOnScreen(center));
+    BOOST_CHECK(isClose(projector.getScreenX(center), 0.5f));
+    BOOST_CHECK(isClose(projector.getScreenY(center), 0.5f));
+
+    // Screen y goes down
+    BOOST_CHECK(projector.isOnScreen(topLeft));
+    BOOST_CHECK(isClose(projector.getScreenX(topLeft), 0.25f));
+    BOOST_CHECK(isClose(projector.getScreenY(topLeft), 0.25f));
+
+    BOOST_CHECK(!projector.isOnScreen(outside));
+    BOOST_CHECK(!projector.isOnScreen(behind));
+}
+
+BOOST_AUTO_TEST_CASE(test_Margin)
+{
+    OverlayProjector projector;
+    // Projected at x = 1.1, just outside the right border
+    uint32_t anchor = projector.addAnchor();
+    projector.setAnchorPosition(anchor, 1.1f, 0.0f, -1.0f);
+    projector.project(VIEW_PROJ, 0.0f);
+    BOOST_CHECK(!projector.isOnScreen(anchor));
+
+    projector.project(VIEW_PROJ, 0.1f);
+    BOOST_CHECK(projector.isOnScreen(anchor));
+}
+
+BOOST_AUTO_TEST_CASE(test_RemoveAnchor)
+{
+    OverlayProjector projector;
+    uint32_t first = projector.addAnchor();
+    uint32_t second = projector.addAnchor();
+    uint32_t third = projector.addAnchor();
+    projector.setAnchorPosition(first, 0.0f, 0.0f, -1.0f);
+    projector.setAnchorPosition(second, 10.0f, 0.0f, -1.0f);
+    projector.setAnchorPosition(third, 0.5f, 0.0f, -1.0f);
+
+    // The last anchor is moved in place of the removed one and should keep its position
+    projector.removeAnchor(first);
+    BOOST_CHECK(!projector.hasAnchor(first));
+    BOOST_CHECK(projector.getNbAnchors() == 2);
+    projector.project(VIEW_PROJ, 0.0f);
+    BOOST_CHECK(!projector.isOnScreen(second));
+    BOOST_CHECK(projector.isOnScreen(third));
+    BOOST_CHECK(isClose(projector.getScreenX(third), 0.75f));
+
+    // Unknown ids are ignored
+    projector.removeAnchor(first);
+    projector.setAnchorPosition(first, 0.0f, 0.0f, -1.0f);
+    BOOST_CHECK(!projector.isOnScreen(first));
+    BOOST_CHECK(projector.getNbAnchors() == 2);
+
+    // Ids are reused
+    uint32_t fourth = projector.addAnchor();
+    BOOST_CHECK(fourth == first);
+    BOOST_CHECK(projector.getNbAnchors() == 3);
+}
@@ -0,0 +1,96 @@
+/*
+ *  Copyright (C) 2011-2016  OpenDungeons Team
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#define BOOST_TEST_MODULE SpatialSoundCoalescer
+#include "BoostTestTargetConfig.h"
+
+#include "sound/SpatialSoundCoalescer.h"
+
+BOOST_AUTO_TEST_CASE(test_MergeSameRegion)
+{
+    SpatialSoundCoalescer coalescer(4);
+    const Player* player1 = reinterpret_cast<const Player*>(&coalescer);
+    const Player* player2 = nullptr;
+    coalescer.addSound(player1, "Game/Dig", 1, 1);
+    coalescer.addSound(player1, "Game/Dig", 3, 2);
+    coalescer.addSound(player1, "Game/Dig", 2, 3, 2);
+    // Different region, sound or player
+    coalescer.addSound(player1, "Game/Dig", 4, 1);
+    coalescer.addSound(player1, "Game/Claim", 1, 1);
+    coalescer.addSound(player2, "Game/Dig", 1, 1);
+
+    BOOST_CHECK(!coalescer.isEmpty());
+    std::vector<SpatialSoundCoalescer::SoundEvent> events;
+    coalescer.flush(events);
+    BOOST_CHECK(coalescer.isEmpty());
+    BOOST_REQUIRE(events.size() == 4);
+
+    // Events are in the order they were first fired and use the first position
+    BOOST_CHECK(events[0].mPlayer == player1);
+    BOOST_CHECK(events[0].mSound == "Game/Dig");
+    BOOST_CHECK(events[0].mX == 1);
+    BOOST_CHECK(events[0].mY == 1);
+    BOOST_CHECK(events[0].mCount == 4);
+    BOOST_CHECK(events[1].mX == 4);
+    BOOST_CHECK(events[1].mCount == 1);
+    BOOST_CHECK(events[2].mSound == "Game/Claim");
+    BOOST_CHECK(events[3].mPlayer == player2);
+
+    // After a flush, sounds are not merged with the previous ones
+    coalescer.addSound(player1, "Game/Dig", 1, 1);
+    coalescer.flush(events);
+    BOOST_REQUIRE(events.size() == 1);
+    BOOST_CHECK(events[0].mCount == 1);
+}
+
+BOOST_AUTO_TEST_CASE(test_NegativeCoordinates)
+{
+    // -1 and 0 are not in the same region
+    SpatialSoundCoalescer coalescer(4);
+    coalescer.addSound(nullptr, "Game/Dig", -1, 0);
+    coalescer.addSound(nullptr, "Game/Dig", 0, 0);
+    coalescer.addSound(nullptr, "Game/Dig", -4, 0);
+    std::vector<SpatialSoundCoalescer::SoundEvent> events;
+    coalescer.flush(events);
+    BOOST_REQUIRE(events.size() == 2);
+    BOOST_CHECK(events[0].mCount == 2);
+}
+
+BOOST_AUTO_TEST_CASE(test_SelectSounds)
+{
+    SpatialSoundCoalescer coalescer(1);
+    coalescer.addSound(nullptr, "Far", 50, 0);
+    coalescer.addSound(nullptr, "Close", 1, 0);
+    coalescer.addSound(nullptr, "Medium", 5, 0);
+    coalescer.addSound(nullptr, "Many", 8, 0, 3);
+    std::vector<SpatialSoundCoalescer::SoundEvent> events;
+    coalescer.flush(events);
+
+    // Far is culled, then the event merging the most sounds and the closest one are kept
+    SpatialSoundCoalescer::selectSounds(events, 0.0f, 0.0f, 10.0f, 2);
+    BOOST_REQUIRE(events.size() == 2);
+    BOOST_CHECK(events[0].mSound == "Many");
+    BOOST_CHECK(events[1].mSound == "Close");
+
+    // With enough voices, only the distance matters
+    coalescer.addSound(nullptr, "Far", 50, 0);
+    coalescer.addSound(nullptr, "Close", 1, 0);
+    coalescer.flush(events);
+    SpatialSoundCoalescer::selectSounds(events, 0.0f, 0.0f, 10.0f, 8);
+    BOOST_REQUIRE(events.size() == 1);
+    BOOST_CHECK(events[0].mSound == "Close");
+}
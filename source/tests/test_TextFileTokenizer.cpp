@@ -0,0 +1,83 @@
+/*
+ *  Copyright (C) 2011-2016  OpenDungeons Team
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#define BOOST_TEST_MODULE TextFileTokenizer
+#include "BoostTestTargetConfig.h"
+
+#include "utils/LogManager.h"
+#include "utils/LogSinkConsole.h"
+#include "utils/TextFileTokenizer.h"
+
+#include <istream>
+
+BOOST_AUTO_TEST_CASE(test_TextFileTokenizer)
+{
+    LogManager logMgr;
+    logMgr.addSink(std::unique_ptr<LogSink>(new LogSinkConsole()));
+
+    const std::string content = "[Tiles] # Tiles section\n"
+        "12\t-3\t4.25#comment without space\n"
+        "Name\tSome level name # trailing comment\n"
+        "# Full line comment\n"
+        "stream 42\n"
+        "[/Tiles]";
+    TextFileTokenizer tokenizer(content);
+
+    boost::string_ref token;
+    BOOST_CHECK(tokenizer.nextToken(token));
+    BOOST_CHECK(token == "[Tiles]");
+
+    uint32_t u = 0;
+    int32_t i = 0;
+    double d = 0.0;
+    BOOST_CHECK(tokenizer.nextUInt32(u));
+    BOOST_CHECK(u == 12);
+    BOOST_CHECK(tokenizer.nextInt32(i));
+    BOOST_CHECK(i == -3);
+    BOOST_CHECK(tokenizer.nextDouble(d));
+    BOOST_CHECK(d == 4.25);
+
+    // The end of the line after the comment is consumed
+    BOOST_CHECK(tokenizer.nextLine(token));
+    BOOST_CHECK(token.empty());
+
+    BOOST_CHECK(tokenizer.nextLine(token));
+    BOOST_CHECK(token == "Name\tSome level name ");
+
+    // Streams built on the tokenizer share its read position
+    std::istream is(&tokenizer);
+    std::string str;
+    is >> str;
+    BOOST_CHECK(str == "stream");
+    BOOST_CHECK(tokenizer.nextInt32(i));
+    BOOST_CHECK(i == 42);
+
+    BOOST_CHECK(tokenizer.peekToken(token));
+    BOOST_CHECK(token == "[/Tiles]");
+    BOOST_CHECK(tokenizer.nextToken(token));
+    BOOST_CHECK(token == "[/Tiles]");
+    BOOST_CHECK(tokenizer.isEof());
+    BOOST_CHECK(!tokenizer.nextToken(token));
+
+    // Conversions
+    BOOST_CHECK(TextFileTokenizer::toDouble("0.35", d));
+    BOOST_CHECK(d == 0.35);
+    BOOST_CHECK(TextFileTokenizer::toDouble("-1e3", d));
+    BOOST_CHECK(d == -1000.0);
+    BOOST_CHECK(!TextFileTokenizer::toInt32("abc", i));
+    BOOST_CHECK(!TextFileTokenizer::toUInt32("4294967296", u));
+}
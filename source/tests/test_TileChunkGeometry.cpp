@@ -0,0 +1,124 @@
+/*
+ *  Copyright (C) 2011-2016  OpenDungeons Team
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#define BOOST_TEST_MODULE TileChunkGeometry
+#include "BoostTestTargetConfig.h"
+
+#include "render/TileChunkGeometry.h"
+
+namespace
+{
+    const float IDENTITY[9] = { 1.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 1.0f };
+
+    //! \brief Quad of size 1 centered on 0 with normals, tangents and texture coordinates
+    TileMeshGeometry buildQuad()
+    {
+        TileMeshGeometry quad;
+        quad.mPositions = { -0.5f, -0.5f, 0.0f, 0.5f, -0.5f, 0.0f, 0.5f, 0.5f, 0.0f, -0.5f, 0.5f, 0.0f };
+        quad.mNormals = { 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 1.0f };
+        quad.mTangents = { 1.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f };
+        quad.mTexCoords = { 0.0f, 0.0f, 1.0f, 0.0f, 1.0f, 1.0f, 0.0f, 1.0f };
+        quad.mIndices = { 0, 1, 2, 0, 2, 3 };
+        return quad;
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_MergeSameMaterial)
+{
+    TileMeshGeometry quad = buildQuad();
+    TileChunkGeometry chunk;
+    BOOST_CHECK(chunk.isEmpty());
+    chunk.addMesh("Dirt", quad, IDENTITY, 0.0f, 0.0f, 0.0f);
+    chunk.addMesh("Dirt", quad, IDENTITY, 3.0f, 2.0f, 0.0f);
+
+    BOOST_REQUIRE(chunk.getSections().size() == 1);
+    const TileMeshGeometry& section = chunk.getSections().at("Dirt");
+    BOOST_CHECK(section.getNbVertices() == 8);
+    BOOST_CHECK(section.mNormals.size() == 8 * 3);
+    BOOST_CHECK(section.mTangents.size() == 8 * 3);
+    BOOST_CHECK(section.mTexCoords.size() == 8 * 2);
+
+    // The indices of the second quad are shifted after the vertices of the first one
+    std::vector<uint32_t> expectedIndices = { 0, 1, 2, 0, 2, 3, 4, 5, 6, 4, 6, 7 };
+    BOOST_CHECK(section.mIndices == expectedIndices);
+
+    // The second quad is moved to its tile
+    BOOST_CHECK(section.mPositions[4 * 3] == 2.5f);
+    BOOST_CHECK(section.mPositions[4 * 3 + 1] == 1.5f);
+    BOOST_CHECK(section.mPositions[6 * 3] == 3.5f);
+    BOOST_CHECK(section.mPositions[6 * 3 + 1] == 2.5f);
+    BOOST_CHECK(section.mTexCoords[6 * 2] == 1.0f);
+    BOOST_CHECK(section.mTexCoords[6 * 2 + 1] == 1.0f);
+}
+
+BOOST_AUTO_TEST_CASE(test_SectionsByMaterial)
+{
+    TileMeshGeometry quad = buildQuad();
+    TileChunkGeometry chunk;
+    chunk.addMesh("Dirt", quad, IDENTITY, 0.0f, 0.0f, 0.0f);
+    chunk.addMesh("Claimed##Color_1_", quad, IDENTITY, 1.0f, 0.0f, 0.0f);
+    chunk.addMesh("Dirt", quad, IDENTITY, 2.0f, 0.0f, 0.0f);
+
+    BOOST_REQUIRE(chunk.getSections().size() == 2);
+    BOOST_CHECK(chunk.getSections().at("Dirt").getNbVertices() == 8);
+    BOOST_CHECK(chunk.getSections().at("Dirt").mIndices.size() == 12);
+    BOOST_CHECK(chunk.getSections().at("Claimed##Color_1_").getNbVertices() == 4);
+    BOOST_CHECK(chunk.getSections().at("Claimed##Color_1_").mIndices[5] == 3);
+
+    chunk.clear();
+    BOOST_CHECK(chunk.isEmpty());
+}
+
+BOOST_AUTO_TEST_CASE(test_Rotation)
+{
+    // 90 degrees around Z: x => y and y => -x
+    const float rotZ90[9] = { 0.0f, -1.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f };
+    TileMeshGeometry quad = buildQuad();
+    TileChunkGeometry chunk;
+    chunk.addMesh("Wall", quad, rotZ90, 5.0f, 5.0f, 1.0f);
+
+    const TileMeshGeometry& section = chunk.getSections().at("Wall");
+    // First vertex (-0.5, -0.5, 0) becomes (0.5, -0.5, 0) and is moved to (5.5, 4.5, 1)
+    BOOST_CHECK(section.mPositions[0] == 5.5f);
+    BOOST_CHECK(section.mPositions[1] == 4.5f);
+    BOOST_CHECK(section.mPositions[2] == 1.0f);
+    // Normals and tangents are rotated but not moved
+    BOOST_CHECK(section.mNormals[2] == 1.0f);
+    BOOST_CHECK(section.mTangents[0] == 0.0f);
+    BOOST_CHECK(section.mTangents[1] == 1.0f);
+}
+
+BOOST_AUTO_TEST_CASE(test_MissingAttributes)
+{
+    // Mesh without normals, tangents nor texture coordinates
+    TileMeshGeometry triangle;
+    triangle.mPositions = { 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f };
+    triangle.mIndices = { 0, 1, 2 };
+
+    TileChunkGeometry chunk;
+    chunk.addMesh("Rock", triangle, IDENTITY, 0.0f, 0.0f, 0.0f);
+    const TileMeshGeometry& section = chunk.getSections().at("Rock");
+    BOOST_CHECK(section.getNbVertices() == 3);
+    BOOST_CHECK(section.mNormals.size() == 9);
+    BOOST_CHECK(section.mNormals[2] == 1.0f);
+    BOOST_CHECK(section.mTangents[0] == 1.0f);
+    BOOST_CHECK(section.mTexCoords.size() == 6);
+
+    // Empty meshes are ignored
+    chunk.addMesh("Empty", TileMeshGeometry(), IDENTITY, 0.0f, 0.0f, 0.0f);
+    BOOST_CHECK(chunk.getSections().size() == 1);
+}
@@ -0,0 +1,123 @@
+/*
+ *  Copyright (C) 2011-2016  OpenDungeons Team
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#define BOOST_TEST_MODULE TileClaim
+#include "BoostTestTargetConfig.h"
+
+#include "entities/TileClaim.h"
+
+#include <cstdint>
+
+namespace
+{
+struct TestSeat
+{
+    TestSeat() :
+        mNbClaimedTiles(0)
+    {}
+
+    uint32_t mNbClaimedTiles;
+};
+
+//! \brief Claims like Tile::claimForSeat and counts like Tile::refreshSeatAggregates. Every seat
+//! is only allied with itself
+struct TestTile
+{
+    TestTile() :
+        mSeat(nullptr),
+        mClaimedPercentage(0.0),
+        mSeatCountingClaim(nullptr)
+    {}
+
+    void claimForSeat(TestSeat* seat, double rate)
+    {
+        if(TileClaim::applyStep(mClaimedPercentage, mSeat == seat, rate))
+            mSeat = seat;
+
+        refreshSeatAggregates();
+
+        if((mSeat == seat) && TileClaim::isClaimed(mClaimedPercentage))
+            mClaimedPercentage = 1.0;
+    }
+
+    void refreshSeatAggregates()
+    {
+        TestSeat* seat = TileClaim::isClaimed(mClaimedPercentage) ? mSeat : nullptr;
+        if(seat == mSeatCountingClaim)
+            return;
+
+        if(mSeatCountingClaim != nullptr)
+            --mSeatCountingClaim->mNbClaimedTiles;
+
+        mSeatCountingClaim = seat;
+        if(mSeatCountingClaim != nullptr)
+            ++mSeatCountingClaim->mNbClaimedTiles;
+    }
+
+    TestSeat* mSeat;
+    double mClaimedPercentage;
+    TestSeat* mSeatCountingClaim;
+};
+}
+
+BOOST_AUTO_TEST_CASE(test_ClaimStep)
+{
+    double percentage = 0.25;
+    BOOST_CHECK(!TileClaim::applyStep(percentage, true, 0.5));
+    BOOST_CHECK(percentage == 0.75);
+    BOOST_CHECK(!TileClaim::isClaimed(percentage));
+    BOOST_CHECK(!TileClaim::applyStep(percentage, true, 0.25));
+    BOOST_CHECK(TileClaim::isClaimed(percentage));
+
+    // An enemy step going below 0 gives the remaining percentage to the enemy
+    percentage = 0.25;
+    BOOST_CHECK(!TileClaim::applyStep(percentage, false, 0.125));
+    BOOST_CHECK(percentage == 0.125);
+    BOOST_CHECK(TileClaim::applyStep(percentage, false, 0.375));
+    BOOST_CHECK(percentage == 0.25);
+}
+
+BOOST_AUTO_TEST_CASE(test_PartialEnemyClaim)
+{
+    TestSeat owner;
+    TestSeat enemy;
+    TestTile tile;
+    tile.claimForSeat(&owner, 1.0);
+    BOOST_CHECK(tile.mSeat == &owner);
+    BOOST_CHECK(owner.mNbClaimedTiles == 1);
+
+    // The owner loses the tile as soon as the enemy starts claiming it
+    tile.claimForSeat(&enemy, 0.25);
+    BOOST_CHECK(tile.mSeat == &owner);
+    BOOST_CHECK(owner.mNbClaimedTiles == 0);
+    BOOST_CHECK(enemy.mNbClaimedTiles == 0);
+
+    // If the owner claims it back, it counts again
+    tile.claimForSeat(&owner, 0.25);
+    BOOST_CHECK(owner.mNbClaimedTiles == 1);
+    BOOST_CHECK(enemy.mNbClaimedTiles == 0);
+
+    // The enemy takes it over. It only counts once fully claimed
+    tile.claimForSeat(&enemy, 0.5);
+    tile.claimForSeat(&enemy, 0.75);
+    BOOST_CHECK(tile.mSeat == &enemy);
+    BOOST_CHECK(owner.mNbClaimedTiles == 0);
+    BOOST_CHECK(enemy.mNbClaimedTiles == 0);
+    tile.claimForSeat(&enemy, 0.75);
+    BOOST_CHECK(owner.mNbClaimedTiles == 0);
+    BOOST_CHECK(enemy.mNbClaimedTiles == 1);
+}
@@ -0,0 +1,155 @@
+/*
+ *  Copyright (C) 2011-2016  OpenDungeons Team
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#define BOOST_TEST_MODULE TileVisibility
+#include "BoostTestTargetConfig.h"
+
+#include "camera/TileVisibility.h"
+
+#include <algorithm>
+
+namespace
+{
+    std::vector<TileVisibility::Point> buildRectangle(double x1, double y1, double x2, double y2)
+    {
+        // Vertices are not given in order on purpose
+        std::vector<TileVisibility::Point> points;
+        points.push_back(TileVisibility::Point{x1, y1});
+        points.push_back(TileVisibility::Point{x2, y2});
+        points.push_back(TileVisibility::Point{x2, y1});
+        points.push_back(TileVisibility::Point{x1, y2});
+        return points;
+    }
+
+    uint32_t countVisible(const TileVisibility& visibility)
+    {
+        uint32_t nb = 0;
+        for(int32_t y = 0; y < visibility.getMapSizeY(); ++y)
+        {
+            for(int32_t x = 0; x < visibility.getMapSizeX(); ++x)
+            {
+                if(visibility.isVisible(x, y))
+                    ++nb;
+            }
+        }
+        return nb;
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_Rectangle)
+{
+    TileVisibility visibility;
+    visibility.reset(100, 70);
+    BOOST_CHECK(countVisible(visibility) == 0);
+
+    // Tiles are centered on their coordinates. Tiles 10 to 20 overlap [9.7, 20.2]
+    visibility.computeVisibleTiles(buildRectangle(9.7, 30.2, 20.2, 39.4));
+    BOOST_CHECK(countVisible(visibility) == 11 * 10);
+    BOOST_CHECK(visibility.isVisible(10, 30));
+    BOOST_CHECK(visibility.isVisible(20, 39));
+    BOOST_CHECK(!visibility.isVisible(9, 30));
+    BOOST_CHECK(!visibility.isVisible(21, 35));
+    BOOST_CHECK(!visibility.isVisible(15, 29));
+    BOOST_CHECK(!visibility.isVisible(15, 40));
+
+    // Footprints partially outside the map are clipped
+    visibility.computeVisibleTiles(buildRectangle(-10.0, -10.0, 1.0, 200.0));
+    BOOST_CHECK(countVisible(visibility) == 2 * 70);
+}
+
+BOOST_AUTO_TEST_CASE(test_FarFootprint)
+{
+    TileVisibility visibility;
+    visibility.reset(100, 70);
+
+    // Near the horizon, the footprint goes far beyond what an int32_t can hold
+    visibility.computeVisibleTiles(buildRectangle(-1.0e12, -1.0e12, 1.0e12, 1.0e12));
+    BOOST_CHECK(countVisible(visibility) == 100 * 70);
+
+    // Footprints entirely outside of the map show nothing, even near tile 0
+    visibility.computeVisibleTiles(buildRectangle(-1.0e12, -1.0e12, -3.0, -3.0));
+    BOOST_CHECK(countVisible(visibility) == 0);
+    visibility.computeVisibleTiles(buildRectangle(-1.0e12, 10.0, -3.0, 20.0));
+    BOOST_CHECK(countVisible(visibility) == 0);
+    visibility.computeVisibleTiles(buildRectangle(200.0, 10.0, 1.0e12, 20.0));
+    BOOST_CHECK(countVisible(visibility) == 0);
+}
+
+BOOST_AUTO_TEST_CASE(test_Trapezoid)
+{
+    // The footprint of a perspective camera is a trapezoid: wider far from the camera
+    TileVisibility visibility;
+    visibility.reset(64, 64);
+    std::vector<TileVisibility::Point> points;
+    points.push_back(TileVisibility::Point{30.0, 10.0});
+    points.push_back(TileVisibility::Point{34.0, 10.0});
+    points.push_back(TileVisibility::Point{20.0, 30.0});
+    points.push_back(TileVisibility::Point{44.0, 30.0});
+    visibility.computeVisibleTiles(points);
+    BOOST_CHECK(visibility.isVisible(32, 10));
+    BOOST_CHECK(!visibility.isVisible(25, 10));
+    BOOST_CHECK(visibility.isVisible(21, 30));
+    BOOST_CHECK(visibility.isVisible(43, 30));
+    BOOST_CHECK(!visibility.isVisible(32, 31));
+    // At mid height, the footprint goes from 25 to 39
+    BOOST_CHECK(visibility.isVisible(25, 20));
+    BOOST_CHECK(visibility.isVisible(39, 20));
+    BOOST_CHECK(!visibility.isVisible(23, 20));
+    BOOST_CHECK(!visibility.isVisible(41, 20));
+}
+
+BOOST_AUTO_TEST_CASE(test_ChangedTiles)
+{
+    TileVisibility visibility;
+    // Odd width so that rows do not start on word boundaries
+    visibility.reset(67, 50);
+    std::vector<std::pair<int32_t, int32_t>> shown;
+    std::vector<std::pair<int32_t, int32_t>> hidden;
+
+    visibility.computeVisibleTiles(buildRectangle(10.0, 10.0, 19.0, 19.0));
+    visibility.getChangedTiles(shown, hidden);
+    BOOST_CHECK(shown.size() == 100);
+    BOOST_CHECK(hidden.empty());
+
+    // Moving one tile right shows column 20 and hides column 10
+    visibility.computeVisibleTiles(buildRectangle(11.0, 10.0, 20.0, 19.0));
+    visibility.getChangedTiles(shown, hidden);
+    BOOST_REQUIRE(shown.size() == 10);
+    BOOST_REQUIRE(hidden.size() == 10);
+    for(const std::pair<int32_t, int32_t>& tile : shown)
+        BOOST_CHECK(tile.first == 20);
+    for(const std::pair<int32_t, int32_t>& tile : hidden)
+        BOOST_CHECK(tile.first == 10);
+    BOOST_CHECK(std::find(shown.begin(), shown.end(), std::make_pair(20, 19)) != shown.end());
+
+    // Same footprint: nothing changes
+    visibility.computeVisibleTiles(buildRectangle(11.0, 10.0, 20.0, 19.0));
+    visibility.getChangedTiles(shown, hidden);
+    BOOST_CHECK(shown.empty());
+    BOOST_CHECK(hidden.empty());
+
+    visibility.showAllTiles();
+    visibility.getChangedTiles(shown, hidden);
+    BOOST_CHECK(shown.size() == 67 * 50 - 100);
+    BOOST_CHECK(hidden.empty());
+    BOOST_CHECK(countVisible(visibility) == 67 * 50);
+
+    visibility.hideAllTiles();
+    visibility.getChangedTiles(shown, hidden);
+    BOOST_CHECK(shown.empty());
+    BOOST_CHECK(hidden.size() == 67 * 50);
+}
@@ -0,0 +1,90 @@
+/*
+ *  Copyright (C) 2011-2016  OpenDungeons Team
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#define BOOST_TEST_MODULE TurnScheduler
+#include "BoostTestTargetConfig.h"
+
+#include "network/TurnScheduler.h"
+
+BOOST_AUTO_TEST_CASE(test_OnTime)
+{
+    // 10 turns per second => 100 ms per turn
+    TurnScheduler scheduler(10.0, 3);
+    scheduler.reset(1000.0);
+    BOOST_CHECK(scheduler.getTurnLengthSeconds() == 0.1);
+    BOOST_CHECK(scheduler.getNbTurnsDue(1000.0) == 1);
+    scheduler.turnStarted(1010.0);
+
+    // The next turn is scheduled from when the previous one should have started
+    BOOST_CHECK(scheduler.getTimeBeforeNextTurnMs(1010.0) == 90.0);
+    BOOST_CHECK(scheduler.getNbTurnsDue(1050.0) == 0);
+    BOOST_CHECK(scheduler.getNbTurnsDue(1100.0) == 1);
+    BOOST_CHECK(scheduler.getLagMs(1100.0) == 0.0);
+    BOOST_CHECK(scheduler.getNbTurnsDropped() == 0);
+}
+
+BOOST_AUTO_TEST_CASE(test_CatchUp)
+{
+    TurnScheduler scheduler(10.0, 3);
+    scheduler.reset(0.0);
+    BOOST_CHECK(scheduler.getNbTurnsDue(0.0) == 1);
+    scheduler.turnStarted(0.0);
+
+    // A slow turn makes us miss 2 turns
+    BOOST_CHECK(scheduler.getNbTurnsDue(320.0) == 3);
+    BOOST_CHECK(scheduler.getLagMs(320.0) == 220.0);
+    BOOST_CHECK(scheduler.getTimeBeforeNextTurnMs(320.0) == 0.0);
+    scheduler.turnStarted(320.0);
+    scheduler.turnStarted(320.0);
+    scheduler.turnStarted(320.0);
+    BOOST_CHECK(scheduler.getNbTurnsDue(320.0) == 0);
+    BOOST_CHECK(scheduler.getTimeBeforeNextTurnMs(320.0) == 80.0);
+    BOOST_CHECK(scheduler.getNbTurnsDropped() == 0);
+}
+
+BOOST_AUTO_TEST_CASE(test_DropTurns)
+{
+    TurnScheduler scheduler(10.0, 3);
+    scheduler.reset(0.0);
+
+    // After a 1 second stall, we only run the last 3 late turns plus the current one
+    BOOST_CHECK(scheduler.getNbTurnsDue(1050.0) == 4);
+    BOOST_CHECK(scheduler.getNbTurnsDropped() == 7);
+    BOOST_CHECK(scheduler.getLagMs(1050.0) == 350.0);
+    for(uint32_t i = 0; i < 4; ++i)
+        scheduler.turnStarted(1050.0);
+
+    BOOST_CHECK(scheduler.getNbTurnsDue(1050.0) == 0);
+    BOOST_CHECK(scheduler.getTimeBeforeNextTurnMs(1050.0) == 50.0);
+}
+
+BOOST_AUTO_TEST_CASE(test_MaxSpeed)
+{
+    TurnScheduler scheduler(10.0, 3);
+    scheduler.setMaxSpeed(true);
+    scheduler.reset(0.0);
+    for(uint32_t i = 0; i < 10; ++i)
+    {
+        BOOST_CHECK(scheduler.getTimeBeforeNextTurnMs(static_cast<double>(i)) == 0.0);
+        BOOST_CHECK(scheduler.getNbTurnsDue(static_cast<double>(i)) == 1);
+        scheduler.turnStarted(static_cast<double>(i));
+    }
+
+    // Each turn still simulates the same amount of time
+    BOOST_CHECK(scheduler.getTurnLengthSeconds() == 0.1);
+    BOOST_CHECK(scheduler.getNbTurnsDropped() == 0);
+}
@@ -29,8 +29,6 @@
 #include "modes/InputCommand.h"
 #include "modes/InputManager.h"
 #include "network/ODClient.h"
-#include "network/ODServer.h"
-#include "network/ServerNotification.h"
 #include "traps/TrapManager.h"
 #include "traps/TrapType.h"
 #include "utils/ConfigManager.h"
@@ -103,6 +101,16 @@ void Trap::removeFromGameMap()
 
     removeAllBuildingObjects();
     getGameMap()->removeActiveObject(this);
+
+    for(std::pair<Tile* const, TileData*>& p : mTileData)
+    {
+        TrapTileData* trapTileData = static_cast<TrapTileData*>(p.second);
+        if(!trapTileData->isInTriggerIndex())
+            continue;
+
+        trapTileData->setInTriggerIndex(false);
+        getGameMap()->getTrapTriggerIndex().removeTrapTile(*this, *p.first, getTriggerRange());
+    }
 }
 
 void Trap::doUpkeep()
@@ -136,18 +144,31 @@ void Trap::doUpkeep()
         if(trapTileData->decreaseReloadTime())
             continue;
 
-        if(shoot(tile))
+        // If nothing entered the trigger zone since the last time we found nothing to shoot at,
+        // there is no need to look for a target
+        if(!trapTileData->isAwake())
+            continue;
+
+        if(!shoot(tile))
         {
-            trapTileData->setReloadTime(mReloadTime);
-            if(!trapTileData->decreaseShoot())
-                deactivate(tile);
+            if(getTriggerRange() >= 0)
+            {
+                // We make sure the trap tile is watched before sleeping
+                getTriggerZone(tile);
+                trapTileData->setAwake(false);
+            }
+            continue;
+        }
 
-            const std::vector<Seat*>& seats = tile->getSeatsWithVision();
-            trapTileData->seatsSawTriggering(seats);
+        trapTileData->setReloadTime(mReloadTime);
+        if(!trapTileData->decreaseShoot())
+            deactivate(tile);
 
-            for(Seat* seat : trapTileData->mSeatsVision)
-                seat->setVisibleBuildingOnTile(this, tile);
-        }
+        const std::vector<Seat*>& seats = tile->getSeatsWithVision();
+        trapTileData->seatsSawTriggering(seats);
+
+        for(Seat* seat : trapTileData->mSeatsVision)
+            seat->setVisibleBuildingOnTile(this, tile);
     }
 }
 
@@ -180,6 +201,11 @@ bool Trap::removeCoveredTile(Tile* t)
 
     TrapTileData* trapTileData = static_cast<TrapTileData*>(mTileData.at(t));
     trapTileData->setRemoveTrap(true);
+    if(trapTileData->isInTriggerIndex())
+    {
+        trapTileData->setInTriggerIndex(false);
+        getGameMap()->getTrapTriggerIndex().removeTrapTile(*this, *t, getTriggerRange());
+    }
 
     return true;
 }
@@ -248,6 +274,7 @@ void Trap::activate(Tile* tile)
     trapTileData->setActivated(true);
     trapTileData->setNbShootsBeforeDeactivation(mNbShootsBeforeDeactivation);
     trapTileData->setReloadTime(0);
+    trapTileData->setAwake(true);
 
     BuildingObject* entity = getBuildingObjectFromTile(tile);
     if (entity == nullptr)
@@ -271,6 +298,58 @@ void Trap::deactivate(Tile* tile)
     entity->setMeshOpacity(0.5f);
 }
 
+void Trap::wakeUpTrapTile(Tile* tile)
+{
+    auto it = mTileData.find(tile);
+    if(it == mTileData.end())
+    {
+        OD_LOG_ERR("trap=" + getName() + ", tile=" + Tile::displayAsString(tile));
+        return;
+    }
+
+    TrapTileData* trapTileData = static_cast<TrapTileData*>(it->second);
+    trapTileData->setAwake(true);
+}
+
+void Trap::triggerZoneChanged(Tile* tile)
+{
+    auto it = mTileData.find(tile);
+    if(it == mTileData.end())
+    {
+        OD_LOG_ERR("trap=" + getName() + ", tile=" + Tile::displayAsString(tile));
+        return;
+    }
+
+    // Creatures may already stand in the tiles that became visible
+    TrapTileData* trapTileData = static_cast<TrapTileData*>(it->second);
+    trapTileData->setTriggerZoneValid(false);
+    trapTileData->setAwake(true);
+}
+
+void Trap::computeTriggerZone(Tile* tile, std::vector<Tile*>& zone)
+{
+    zone.clear();
+    zone.push_back(tile);
+}
+
+const std::vector<Tile*>& Trap::getTriggerZone(Tile* tile)
+{
+    TrapTileData* trapTileData = static_cast<TrapTileData*>(mTileData.at(tile));
+    if(!trapTileData->isInTriggerIndex() && (getTriggerRange() >= 0))
+    {
+        trapTileData->setInTriggerIndex(true);
+        getGameMap()->getTrapTriggerIndex().addTrapTile(*this, *tile, getTriggerRange());
+    }
+
+    if(!trapTileData->isTriggerZoneValid())
+    {
+        trapTileData->setTriggerZoneValid(true);
+        computeTriggerZone(tile, trapTileData->mTriggerZone);
+    }
+
+    return trapTileData->mTriggerZone;
+}
+
 bool Trap::isActivated(Tile* tile) const
 {
     std::map<Tile*, TileData*>::const_iterator it = mTileData.find(tile);
@@ -639,18 +718,7 @@ bool Trap::shouldSetCoveringTileDirty(Seat* seat, Tile* tile)
 void Trap::fireTrapSound(Tile& tile, const std::string& soundFamily)
 {
     std::string sound = "Traps/" + soundFamily;
-    for(Seat* seat : tile.getSeatsWithVision())
-    {
-        if(seat->getPlayer() == nullptr)
-            continue;
-        if(!seat->getPlayer()->getIsHuman())
-            continue;
-
-        ServerNotification *serverNotification = new ServerNotification(
-            ServerNotificationType::playSpatialSound, seat->getPlayer());
-        serverNotification->mPacket << sound << tile.getX() << tile.getY();
-        ODServer::getSingleton().queueServerNotification(serverNotification);
-    }
+    tile.getGameMap()->fireSpatialSound(tile.getSeatsWithVision(), sound, tile.getX(), tile.getY());
 }
 
 bool Trap::importTrapFromStream(Trap& trap, std::istream& is)
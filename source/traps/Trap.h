@@ -52,7 +52,10 @@ public:
         mNbShootsBeforeDeactivation(0),
         mTrapEntity(nullptr),
         mIsWorking(false),
-        mRemoveTrap(false)
+        mRemoveTrap(false),
+        mIsAwake(true),
+        mIsTriggerZoneValid(false),
+        mIsInTriggerIndex(false)
     {}
 
     TrapTileData(const TrapTileData* trapTileData) :
@@ -63,7 +66,10 @@ public:
         mNbShootsBeforeDeactivation(trapTileData->mNbShootsBeforeDeactivation),
         mTrapEntity(trapTileData->mTrapEntity),
         mIsWorking(trapTileData->mIsWorking),
-        mRemoveTrap(trapTileData->mRemoveTrap)
+        mRemoveTrap(trapTileData->mRemoveTrap),
+        mIsAwake(true),
+        mIsTriggerZoneValid(false),
+        mIsInTriggerIndex(false)
     {}
 
     virtual ~TrapTileData()
@@ -140,6 +146,29 @@ public:
     inline void setRemoveTrap(bool removeTrap)
     { mRemoveTrap = removeTrap; }
 
+    //! \brief A trap tile sleeps when it found nothing to shoot at. It is woken up when a creature
+    //! enters its trigger zone
+    inline bool isAwake() const
+    { return mIsAwake; }
+
+    inline void setAwake(bool isAwake)
+    { mIsAwake = isAwake; }
+
+    inline bool isTriggerZoneValid() const
+    { return mIsTriggerZoneValid; }
+
+    inline void setTriggerZoneValid(bool isValid)
+    { mIsTriggerZoneValid = isValid; }
+
+    inline bool isInTriggerIndex() const
+    { return mIsInTriggerIndex; }
+
+    inline void setInTriggerIndex(bool isInIndex)
+    { mIsInTriggerIndex = isInIndex; }
+
+    //! \brief Tiles where a creature can trigger the trap tile. Only valid if isTriggerZoneValid
+    std::vector<Tile*> mTriggerZone;
+
     void fireSeatsSawTriggering();
     void seatSawTriggering(Seat* seat);
     void seatsSawTriggering(const std::vector<Seat*>& seats);
@@ -154,6 +183,9 @@ private:
     TrapEntity* mTrapEntity;
     bool mIsWorking;
     bool mRemoveTrap;
+    bool mIsAwake;
+    bool mIsTriggerZoneValid;
+    bool mIsInTriggerIndex;
 };
 
 /*! \class Trap Trap.h
@@ -182,6 +214,18 @@ public:
     virtual bool shoot(Tile* tile)
     { return true; }
 
+    //! \brief Distance (in tiles) within which creatures can trigger the trap. Traps with a range >= 0
+    //! only try to shoot when a creature entered their trigger zone since the last time they found
+    //! nothing to shoot at. Traps with a negative range (like doors) try to shoot every time they are reloaded
+    virtual int32_t getTriggerRange() const
+    { return -1; }
+
+    //! \brief Wakes up the given trap tile. Called when a creature enters its trigger zone
+    void wakeUpTrapTile(Tile* tile);
+
+    //! \brief Called when the vision within the trigger zone of the given trap tile changed
+    void triggerZoneChanged(Tile* tile);
+
     virtual bool isDoor() const
     { return false; }
 
@@ -233,6 +277,14 @@ protected:
     //! \brief Triggered when deactivated.
     virtual void deactivate(Tile* tile);
 
+    //! \brief Fills zone with the tiles where a creature can trigger the given trap tile. By default,
+    //! only the trap tile itself
+    virtual void computeTriggerZone(Tile* tile, std::vector<Tile*>& zone);
+
+    //! \brief Returns the trigger zone of the given trap tile. It is computed the first time and
+    //! then cached until the vision within the trap range changes
+    const std::vector<Tile*>& getTriggerZone(Tile* tile);
+
     uint32_t mNbShootsBeforeDeactivation;
     uint32_t mReloadTime;
     double mMinDamage;
@@ -46,7 +46,7 @@ class TrapBoulderFactory : public TrapFactory
     { return TrapBoulderNameDisplay; }
 
     int getCostPerTile() const override
-    { return ConfigManager::getSingleton().getTrapConfigInt32("BoulderCostPerTile"); }
+    { return ConfigManager::getSingleton().getTrapsConfig().mBoulderCostPerTile; }
 
     const std::string& getMeshName() const override
     {
@@ -114,16 +114,16 @@ static TrapRegister reg(new TrapBoulderFactory);
 TrapBoulder::TrapBoulder(GameMap* gameMap) :
     Trap(gameMap)
 {
-    mReloadTime = ConfigManager::getSingleton().getTrapConfigUInt32("BoulderReloadTurns");
-    mMinDamage = ConfigManager::getSingleton().getTrapConfigDouble("BoulderDamagePerHitMin");
-    mMaxDamage = ConfigManager::getSingleton().getTrapConfigDouble("BoulderDamagePerHitMax");
-    mNbShootsBeforeDeactivation = ConfigManager::getSingleton().getTrapConfigUInt32("BoulderNbShootsBeforeDeactivation");
+    mReloadTime = ConfigManager::getSingleton().getTrapsConfig().mBoulderReloadTurns;
+    mMinDamage = ConfigManager::getSingleton().getTrapsConfig().mBoulderDamagePerHitMin;
+    mMaxDamage = ConfigManager::getSingleton().getTrapsConfig().mBoulderDamagePerHitMax;
+    mNbShootsBeforeDeactivation = ConfigManager::getSingleton().getTrapsConfig().mBoulderNbShootsBeforeDeactivation;
     setMeshName("");
 }
 
 bool TrapBoulder::shoot(Tile* tile)
 {
-    std::vector<Tile*> tiles = tile->getAllNeighbors();
+    std::vector<Tile*> tiles = getTriggerZone(tile);
     for(std::vector<Tile*>::iterator it = tiles.begin(); it != tiles.end();)
     {
         Tile* tmpTile = *it;
@@ -150,7 +150,7 @@ bool TrapBoulder::shoot(Tile* tile)
     position.z = 0;
     direction.normalise();
     MissileBoulder* missile = new MissileBoulder(getGameMap(), getSeat(), getName(), "Boulder",
-        direction, ConfigManager::getSingleton().getTrapConfigDouble("BoulderSpeed"),
+        direction, ConfigManager::getSingleton().getTrapsConfig().mBoulderSpeed,
         Random::Double(mMinDamage, mMaxDamage), nullptr, true);
     missile->addToGameMap();
     missile->createMesh();
@@ -164,6 +164,11 @@ bool TrapBoulder::shoot(Tile* tile)
     return true;
 }
 
+void TrapBoulder::computeTriggerZone(Tile* tile, std::vector<Tile*>& zone)
+{
+    zone = tile->getAllNeighbors();
+}
+
 TrapEntity* TrapBoulder::getTrapEntity(Tile* tile)
 {
     return new TrapEntity(getGameMap(), *this, reg.getTrapFactory()->getMeshName(), tile, 0.0, false, isActivated(tile) ? 1.0f : 0.5f);
@@ -30,6 +30,10 @@ public:
     { return TrapType::boulder; }
 
     virtual bool shoot(Tile* tile) override;
+
+    //! \brief The boulder is launched toward a creature standing next to the trap
+    virtual int32_t getTriggerRange() const override
+    { return 1; }
     virtual bool isAttackable(Tile* tile, Seat* seat) const override
     {
         return false;
@@ -45,6 +49,9 @@ public:
     virtual TrapEntity* getTrapEntity(Tile* tile) override;
 
     static const TrapType mTrapType;
+
+protected:
+    virtual void computeTriggerZone(Tile* tile, std::vector<Tile*>& zone) override;
 };
 
 #endif // TRAPBOULDER_H
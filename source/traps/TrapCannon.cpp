@@ -47,7 +47,7 @@ class TrapCannonFactory : public TrapFactory
     { return TrapCannonNameDisplay; }
 
     int getCostPerTile() const override
-    { return ConfigManager::getSingleton().getTrapConfigInt32("CannonCostPerTile"); }
+    { return ConfigManager::getSingleton().getTrapsConfig().mCannonCostPerTile; }
 
     const std::string& getMeshName() const override
     {
@@ -118,18 +118,17 @@ TrapCannon::TrapCannon(GameMap* gameMap) :
     Trap(gameMap),
     mRange(0)
 {
-    mReloadTime = ConfigManager::getSingleton().getTrapConfigUInt32("CannonReloadTurns");
-    mRange = ConfigManager::getSingleton().getTrapConfigUInt32("CannonRange");
-    mMinDamage = ConfigManager::getSingleton().getTrapConfigDouble("CannonDamagePerHitMin");
-    mMaxDamage = ConfigManager::getSingleton().getTrapConfigDouble("CannonDamagePerHitMax");
-    mNbShootsBeforeDeactivation = ConfigManager::getSingleton().getTrapConfigUInt32("CannonNbShootsBeforeDeactivation");
+    mReloadTime = ConfigManager::getSingleton().getTrapsConfig().mCannonReloadTurns;
+    mRange = ConfigManager::getSingleton().getTrapsConfig().mCannonRange;
+    mMinDamage = ConfigManager::getSingleton().getTrapsConfig().mCannonDamagePerHitMin;
+    mMaxDamage = ConfigManager::getSingleton().getTrapsConfig().mCannonDamagePerHitMax;
+    mNbShootsBeforeDeactivation = ConfigManager::getSingleton().getTrapsConfig().mCannonNbShootsBeforeDeactivation;
     setMeshName("");
 }
 
 bool TrapCannon::shoot(Tile* tile)
 {
-    std::vector<Tile*> visibleTiles = getGameMap()->visibleTiles(tile->getX(), tile->getY(), mRange);
-    std::vector<GameEntity*> enemyObjects = getGameMap()->getVisibleCreatures(visibleTiles, getSeat(), true);
+    std::vector<GameEntity*> enemyObjects = getGameMap()->getVisibleCreatures(getTriggerZone(tile), getSeat(), true);
 
     if(enemyObjects.empty())
         return false;
@@ -149,7 +148,7 @@ bool TrapCannon::shoot(Tile* tile)
     direction = direction - position;
     direction.normalise();
     MissileOneHit* missile = new MissileOneHit(getGameMap(), getSeat(), getName(), "Cannonball",
-        "", direction, ConfigManager::getSingleton().getTrapConfigDouble("CannonSpeed"),
+        "", direction, ConfigManager::getSingleton().getTrapsConfig().mCannonSpeed,
         Random::Double(mMinDamage, mMaxDamage), 0.0, 0.0, nullptr, false, false, true);
     missile->addToGameMap();
     missile->createMesh();
@@ -164,6 +163,11 @@ bool TrapCannon::shoot(Tile* tile)
     return true;
 }
 
+void TrapCannon::computeTriggerZone(Tile* tile, std::vector<Tile*>& zone)
+{
+    zone = getGameMap()->visibleTiles(tile->getX(), tile->getY(), mRange);
+}
+
 TrapEntity* TrapCannon::getTrapEntity(Tile* tile)
 {
     return new TrapEntity(getGameMap(), *this, reg.getTrapFactory()->getMeshName(), tile, 90.0, false, isActivated(tile) ? 1.0f : 0.5f);
@@ -171,15 +175,15 @@ TrapEntity* TrapCannon::getTrapEntity(Tile* tile)
 
 double TrapCannon::getPhysicalDefense() const
 {
-    return ConfigManager::getSingleton().getTrapConfigUInt32("CannonPhyDef");
+    return ConfigManager::getSingleton().getTrapsConfig().mCannonPhyDef;
 }
 
 double TrapCannon::getMagicalDefense() const
 {
-    return ConfigManager::getSingleton().getTrapConfigUInt32("CannonMagDef");
+    return ConfigManager::getSingleton().getTrapsConfig().mCannonMagDef;
 }
 
 double TrapCannon::getElementDefense() const
 {
-    return ConfigManager::getSingleton().getTrapConfigUInt32("CannonEleDef");
+    return ConfigManager::getSingleton().getTrapsConfig().mCannonEleDef;
 }
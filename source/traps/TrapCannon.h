@@ -33,6 +33,9 @@ public:
 
     virtual bool shoot(Tile* tile) override;
 
+    virtual int32_t getTriggerRange() const override
+    { return static_cast<int32_t>(mRange); }
+
     virtual bool displayTileMesh() const override
     { return true; }
 
@@ -48,6 +51,10 @@ public:
 
     static const TrapType mTrapType;
 
+protected:
+    //! \brief The cannon can shoot at any creature it can see within its range
+    virtual void computeTriggerZone(Tile* tile, std::vector<Tile*>& zone) override;
+
 private:
     uint32_t mRange;
 };
@@ -54,7 +54,7 @@ class TrapDoorFactory : public TrapFactory
     { return TrapDoorNameDisplay; }
 
     int getCostPerTile() const override
-    { return ConfigManager::getSingleton().getTrapConfigInt32("WoodenDoorCostPerTile"); }
+    { return ConfigManager::getSingleton().getTrapsConfig().mWoodenDoorCostPerTile; }
 
     const std::string& getMeshName() const override
     {
@@ -784,13 +784,13 @@ int32_t TrapManager::getNeededWorkshopPointsPerTrap(TrapType trapType)
         case TrapType::nullTrapType:
             return 0;
         case TrapType::cannon:
-            return ConfigManager::getSingleton().getTrapConfigInt32("CannonWorkshopPointsPerTile");
+            return ConfigManager::getSingleton().getTrapsConfig().mCannonWorkshopPointsPerTile;
         case TrapType::spike:
-            return ConfigManager::getSingleton().getTrapConfigInt32("SpikeWorkshopPointsPerTile");
+            return ConfigManager::getSingleton().getTrapsConfig().mSpikeWorkshopPointsPerTile;
         case TrapType::boulder:
-            return ConfigManager::getSingleton().getTrapConfigInt32("BoulderWorkshopPointsPerTile");
+            return ConfigManager::getSingleton().getTrapsConfig().mBoulderWorkshopPointsPerTile;
         case TrapType::doorWooden:
-            return ConfigManager::getSingleton().getTrapConfigInt32("WoodenDoorPointsPerTile");
+            return ConfigManager::getSingleton().getTrapsConfig().mWoodenDoorPointsPerTile;
         default:
             OD_LOG_ERR("Asked for wrong trap type=" + getTrapNameFromTrapType(trapType));
             break;
@@ -45,7 +45,7 @@ class TrapSpikeFactory : public TrapFactory
     { return TrapSpikeNameDisplay; }
 
     int getCostPerTile() const override
-    { return ConfigManager::getSingleton().getTrapConfigInt32("SpikeCostPerTile"); }
+    { return ConfigManager::getSingleton().getTrapsConfig().mSpikeCostPerTile; }
 
     const std::string& getMeshName() const override
     {
@@ -113,17 +113,16 @@ static TrapRegister reg(new TrapSpikeFactory);
 TrapSpike::TrapSpike(GameMap* gameMap) :
     Trap(gameMap)
 {
-    mReloadTime = ConfigManager::getSingleton().getTrapConfigUInt32("SpikeReloadTurns");
-    mMinDamage = ConfigManager::getSingleton().getTrapConfigDouble("SpikeDamagePerHitMin");
-    mMaxDamage = ConfigManager::getSingleton().getTrapConfigDouble("SpikeDamagePerHitMax");
-    mNbShootsBeforeDeactivation = ConfigManager::getSingleton().getTrapConfigUInt32("SpikeNbShootsBeforeDeactivation");
+    mReloadTime = ConfigManager::getSingleton().getTrapsConfig().mSpikeReloadTurns;
+    mMinDamage = ConfigManager::getSingleton().getTrapsConfig().mSpikeDamagePerHitMin;
+    mMaxDamage = ConfigManager::getSingleton().getTrapsConfig().mSpikeDamagePerHitMax;
+    mNbShootsBeforeDeactivation = ConfigManager::getSingleton().getTrapsConfig().mSpikeNbShootsBeforeDeactivation;
     setMeshName("");
 }
 
 bool TrapSpike::shoot(Tile* tile)
 {
-    std::vector<Tile*> visibleTiles;
-    visibleTiles.push_back(tile);
+    const std::vector<Tile*>& visibleTiles = getTriggerZone(tile);
     std::vector<GameEntity*> enemyCreatures = getGameMap()->getVisibleCreatures(visibleTiles, getSeat(), true);
     if(enemyCreatures.empty())
         return false;
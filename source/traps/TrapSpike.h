@@ -30,6 +30,10 @@ public:
     { return TrapType::spike; }
 
     virtual bool shoot(Tile* tile) override;
+
+    //! \brief The spikes only hurt the creatures standing on the trap
+    virtual int32_t getTriggerRange() const override
+    { return 0; }
     virtual bool isAttackable(Tile* tile, Seat* seat) const override
     {
         return false;
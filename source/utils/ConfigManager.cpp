@@ -25,6 +25,7 @@
 #include "spawnconditions/SpawnCondition.h"
 #include "utils/Helper.h"
 #include "utils/LogManager.h"
+#include "utils/TextFileTokenizer.h"
 
 #include <boost/dynamic_bitset.hpp>
 #include <OgreRoot.h>
@@ -173,21 +174,18 @@ ConfigManager::~ConfigManager()
 
 bool ConfigManager::loadGlobalConfig(const std::string& configPath)
 {
-    std::stringstream configFile;
+    TextFileTokenizer configFile;
     std::string fileName = configPath + "global.cfg";
-    if(!Helper::readFileWithoutComments(fileName, configFile))
+    if(!configFile.open(fileName))
     {
         OD_LOG_ERR("Couldn't read " + fileName);
         return false;
     }
 
-    std::string nextParam;
+    boost::string_ref nextParam;
     uint32_t paramsOk = 0;
-    while(configFile.good())
+    while(configFile.nextToken(nextParam))
     {
-        if(!(configFile >> nextParam))
-            break;
-
         if(nextParam == "[SeatColors]")
         {
             if(!loadGlobalConfigSeatColors(configFile))
@@ -225,32 +223,26 @@ bool ConfigManager::loadGlobalConfig(const std::string& configPath)
     return true;
 }
 
-bool ConfigManager::loadGlobalConfigDefinitionFiles(std::stringstream& configFile)
+bool ConfigManager::loadGlobalConfigDefinitionFiles(TextFileTokenizer& configFile)
 {
-    std::string nextParam;
+    boost::string_ref nextParam;
     uint32_t filesOk = 0;
-    while(configFile.good())
+    while(configFile.nextToken(nextParam))
     {
-        if(!(configFile >> nextParam))
-            break;
-
         if(nextParam == "[/ConfigFiles]")
             break;
 
         if(nextParam != "[ConfigFile]")
         {
-            OD_LOG_ERR("Wrong parameter read nextParam=" + nextParam);
+            OD_LOG_ERR("Wrong parameter read nextParam=" + nextParam.to_string());
             return false;
         }
 
         uint32_t paramsOk = 0;
         std::string type;
         std::string fileName;
-        while(configFile.good())
+        while(configFile.nextToken(nextParam))
         {
-            if(!(configFile >> nextParam))
-                break;
-
             if(nextParam == "[/ConfigFile]")
             {
                 break;
@@ -258,14 +250,16 @@ bool ConfigManager::loadGlobalConfigDefinitionFiles(std::stringstream& configFil
 
             if(nextParam == "Type")
             {
-                configFile >> type;
+                configFile.nextToken(nextParam);
+                type = nextParam.to_string();
                 paramsOk |= 0x01;
                 continue;
             }
 
             if(nextParam == "Filename")
             {
-                configFile >> fileName;
+                configFile.nextToken(nextParam);
+                fileName = nextParam.to_string();
                 paramsOk |= 0x02;
                 continue;
             }
@@ -333,31 +327,25 @@ bool ConfigManager::loadGlobalConfigDefinitionFiles(std::stringstream& configFil
     return true;
 }
 
-bool ConfigManager::loadGlobalConfigSeatColors(std::stringstream& configFile)
+bool ConfigManager::loadGlobalConfigSeatColors(TextFileTokenizer& configFile)
 {
-    std::string nextParam;
-    while(configFile.good())
+    boost::string_ref nextParam;
+    while(configFile.nextToken(nextParam))
     {
-        if(!(configFile >> nextParam))
-            break;
-
         if(nextParam == "[/SeatColors]")
             break;
 
         if(nextParam != "[SeatColor]")
         {
-            OD_LOG_ERR("Wrong parameter read nextParam=" + nextParam);
+            OD_LOG_ERR("Wrong parameter read nextParam=" + nextParam.to_string());
             return false;
         }
 
         uint32_t paramsOk = 0;
         std::string id;
         Ogre::ColourValue colourValue;
-        while(configFile.good())
+        while(configFile.nextToken(nextParam))
         {
-            if(!(configFile >> nextParam))
-                break;
-
             if(nextParam == "[/SeatColor]")
             {
                 break;
@@ -365,49 +353,53 @@ bool ConfigManager::loadGlobalConfigSeatColors(std::stringstream& configFile)
 
             if(nextParam == "ID")
             {
-                configFile >> id;
+                configFile.nextToken(nextParam);
+                id = nextParam.to_string();
                 paramsOk |= 0x01;
                 continue;
             }
 
             if(nextParam == "ColorR")
             {
-                configFile >> nextParam;
-                float v = Helper::toFloat(nextParam);
+                configFile.nextToken(nextParam);
+                double v = 0.0;
+                TextFileTokenizer::toDouble(nextParam, v);
                 if(v < 0.0 || v > 1.0)
                 {
-                    OD_LOG_ERR("Wrong parameter read nextParam=" + nextParam);
+                    OD_LOG_ERR("Wrong parameter read nextParam=" + nextParam.to_string());
                     return false;
                 }
-                colourValue.r = v;
+                colourValue.r = static_cast<float>(v);
                 paramsOk |= 0x02;
                 continue;
             }
 
             if(nextParam == "ColorG")
             {
-                configFile >> nextParam;
-				float v = Helper::toFloat(nextParam);
+                configFile.nextToken(nextParam);
+                double v = 0.0;
+                TextFileTokenizer::toDouble(nextParam, v);
                 if(v < 0.0 || v > 1.0)
                 {
-                    OD_LOG_ERR("Wrong parameter read nextParam=" + nextParam);
+                    OD_LOG_ERR("Wrong parameter read nextParam=" + nextParam.to_string());
                     return false;
                 }
-                colourValue.g = v;
+                colourValue.g = static_cast<float>(v);
                 paramsOk |= 0x04;
                 continue;
             }
 
             if(nextParam == "ColorB")
             {
-                configFile >> nextParam;
-                float v = Helper::toFloat(nextParam);
+                configFile.nextToken(nextParam);
+                double v = 0.0;
+                TextFileTokenizer::toDouble(nextParam, v);
                 if(v < 0.0 || v > 1.0)
                 {
-                    OD_LOG_ERR("Wrong parameter read nextParam=" + nextParam);
+                    OD_LOG_ERR("Wrong parameter read nextParam=" + nextParam.to_string());
                     return false;
                 }
-                colourValue.b = v;
+                colourValue.b = static_cast<float>(v);
                 paramsOk |= 0x08;
                 continue;
             }
@@ -425,180 +417,157 @@ bool ConfigManager::loadGlobalConfigSeatColors(std::stringstream& configFile)
     return true;
 }
 
-bool ConfigManager::loadGlobalGameConfig(std::stringstream& configFile)
+bool ConfigManager::loadGlobalGameConfig(TextFileTokenizer& configFile)
 {
-    std::string nextParam;
+    boost::string_ref nextParam;
     uint32_t paramsOk = 0;
-    while(configFile.good())
+    while(configFile.nextToken(nextParam))
     {
-        if(!(configFile >> nextParam))
-            break;
-
         if(nextParam == "[/GameConfig]")
             break;
 
         if(nextParam == "NetworkPort")
         {
-            configFile >> nextParam;
-            mNetworkPort = Helper::toUInt32(nextParam);
+            configFile.nextUInt32(mNetworkPort);
             paramsOk |= 1;
         }
 
         if(nextParam == "ClientConnectionTimeout")
         {
-            configFile >> nextParam;
-            mClientConnectionTimeout = Helper::toUInt32(nextParam);
+            configFile.nextUInt32(mClientConnectionTimeout);
             // Not mandatory
         }
 
         if(nextParam == "CreatureDeathCounter")
         {
-            configFile >> nextParam;
-            mCreatureDeathCounter = Helper::toUInt32(nextParam);
+            configFile.nextUInt32(mCreatureDeathCounter);
             // Not mandatory
         }
 
         if(nextParam == "MaxCreaturesPerSeatAbsolute")
         {
-            configFile >> nextParam;
-            mMaxCreaturesPerSeatAbsolute = Helper::toUInt32(nextParam);
+            configFile.nextUInt32(mMaxCreaturesPerSeatAbsolute);
             // Not mandatory
         }
 
         if(nextParam == "MaxCreaturesPerSeatDefault")
         {
-            configFile >> nextParam;
-            mMaxCreaturesPerSeatDefault = Helper::toUInt32(nextParam);
+            configFile.nextUInt32(mMaxCreaturesPerSeatDefault);
             // Not mandatory
         }
 
         if(nextParam == "SlapDamagePercent")
         {
-            configFile >> nextParam;
-            mSlapDamagePercent = Helper::toDouble(nextParam);
+            configFile.nextDouble(mSlapDamagePercent);
             // Not mandatory
         }
 
         if(nextParam == "SlapEffectDuration")
         {
-            configFile >> nextParam;
-            mSlapEffectDuration = Helper::toDouble(nextParam);
+            configFile.nextUInt32(mSlapEffectDuration);
             // Not mandatory
         }
 
         if(nextParam == "TimePayDay")
         {
-            configFile >> nextParam;
-            mTimePayDay = Helper::toInt(nextParam);
+            int32_t timePayDay;
+            if(configFile.nextInt32(timePayDay))
+                mTimePayDay = timePayDay;
             // Not mandatory
         }
 
         if(nextParam == "NbTurnsFuriousMax")
         {
-            configFile >> nextParam;
-            mNbTurnsFuriousMax = Helper::toInt(nextParam);
+            configFile.nextInt32(mNbTurnsFuriousMax);
             // Not mandatory
         }
 
         if(nextParam == "MaxManaPerSeat")
         {
-            configFile >> nextParam;
-            mMaxManaPerSeat = Helper::toDouble(nextParam);
+            configFile.nextDouble(mMaxManaPerSeat);
             // Not mandatory
         }
 
         if(nextParam == "ClaimingWallPenalty")
         {
-            configFile >> nextParam;
-            mClaimingWallPenalty = Helper::toDouble(nextParam);
+            configFile.nextDouble(mClaimingWallPenalty);
             // Not mandatory
         }
 
         if(nextParam == "DigCoefGold")
         {
-            configFile >> nextParam;
-            mDigCoefGold = Helper::toDouble(nextParam);
+            configFile.nextDouble(mDigCoefGold);
             // Not mandatory
         }
 
         if(nextParam == "DigCoefGem")
         {
-            configFile >> nextParam;
-            mDigCoefGem = Helper::toDouble(nextParam);
+            configFile.nextDouble(mDigCoefGem);
             // Not mandatory
         }
 
         if(nextParam == "DigCoefClaimedWall")
         {
-            configFile >> nextParam;
-            mDigCoefClaimedWall = Helper::toDouble(nextParam);
+            configFile.nextDouble(mDigCoefClaimedWall);
             // Not mandatory
         }
 
         if(nextParam == "CreatureBaseMood")
         {
-            configFile >> nextParam;
-            mCreatureBaseMood = Helper::toInt(nextParam);
+            configFile.nextInt32(mCreatureBaseMood);
             // Not mandatory
         }
 
         if(nextParam == "CreatureMoodHappy")
         {
-            configFile >> nextParam;
-            mCreatureMoodHappy = Helper::toInt(nextParam);
+            configFile.nextInt32(mCreatureMoodHappy);
             // Not mandatory
         }
 
         if(nextParam == "CreatureMoodUpset")
         {
-            configFile >> nextParam;
-            mCreatureMoodUpset = Helper::toInt(nextParam);
+            configFile.nextInt32(mCreatureMoodUpset);
             // Not mandatory
         }
 
         if(nextParam == "CreatureMoodAngry")
         {
-            configFile >> nextParam;
-            mCreatureMoodAngry = Helper::toInt(nextParam);
+            configFile.nextInt32(mCreatureMoodAngry);
             // Not mandatory
         }
 
         if(nextParam == "CreatureMoodFurious")
         {
-            configFile >> nextParam;
-            mCreatureMoodFurious = Helper::toInt(nextParam);
+            configFile.nextInt32(mCreatureMoodFurious);
             // Not mandatory
         }
 
         if(nextParam == "NbWorkersDigSameFaceTile")
         {
-            configFile >> nextParam;
-            mNbWorkersDigSameFaceTile = Helper::toUInt32(nextParam);
+            configFile.nextUInt32(mNbWorkersDigSameFaceTile);
             // Not mandatory
         }
 
         if(nextParam == "NbWorkersClaimSameTile")
         {
-            configFile >> nextParam;
-            mNbWorkersClaimSameTile = Helper::toUInt32(nextParam);
+            configFile.nextUInt32(mNbWorkersClaimSameTile);
             // Not mandatory
         }
 
         if(nextParam == "NbTurnsKoCreatureAttacked")
         {
-            configFile >> nextParam;
-            mNbTurnsKoCreatureAttacked = Helper::toInt(nextParam);
+            configFile.nextInt32(mNbTurnsKoCreatureAttacked);
             // Not mandatory
         }
 
         if(nextParam == "MainMenuMusic")
         {
-            std::string line;
-            std::getline(configFile, line);
-            std::vector<std::string> elements = Helper::split(line, '\t', true);
+            boost::string_ref line;
+            configFile.nextLine(line);
+            std::vector<std::string> elements = Helper::split(line.to_string(), '\t', true);
             if (elements.empty())
             {
-                OD_LOG_WRN("Invalid MainMenuMusic : " + line);
+                OD_LOG_WRN("Invalid MainMenuMusic : " + line.to_string());
                 continue;
             }
             mMainMenuMusic = elements[0];
@@ -607,7 +576,8 @@ bool ConfigManager::loadGlobalGameConfig(std::stringstream& configFile)
 
         if(nextParam == "MasterServerUrl")
         {
-            configFile >> mMasterServerUrl;
+            configFile.nextToken(nextParam);
+            mMasterServerUrl = nextParam.to_string();
             // Not mandatory
         }
     }
@@ -624,27 +594,27 @@ bool ConfigManager::loadGlobalGameConfig(std::stringstream& configFile)
 bool ConfigManager::loadCreatureDefinitions(const std::string& fileName)
 {
     OD_LOG_INF("Load creature definition file: " + fileName);
-    std::stringstream defFile;
-    if(!Helper::readFileWithoutComments(fileName, defFile))
+    TextFileTokenizer defFile;
+    if(!defFile.open(fileName))
     {
         OD_LOG_ERR("Couldn't read " + fileName);
         return false;
     }
 
-    std::string nextParam;
+    // The definitions are loaded from a stream reading directly from the tokenizer
+    std::istream defStream(&defFile);
+
+    boost::string_ref nextParam;
     // Read in the creature class descriptions
-    defFile >> nextParam;
+    defFile.nextToken(nextParam);
     if (nextParam != "[CreatureDefinitions]")
     {
-        OD_LOG_ERR("Invalid Creature classes start format. Line was " + nextParam);
+        OD_LOG_ERR("Invalid Creature classes start format. Line was " + nextParam.to_string());
         return false;
     }
 
-    while(defFile.good())
+    while(defFile.nextToken(nextParam))
     {
-        if(!(defFile >> nextParam))
-            break;
-
         if (nextParam == "[/CreatureDefinitions]")
             break;
 
@@ -654,12 +624,12 @@ bool ConfigManager::loadCreatureDefinitions(const std::string& fileName)
         // Seek the [Creature] tag
         if (nextParam != "[Creature]")
         {
-            OD_LOG_ERR("Invalid Creature classes start format. Line was " + nextParam);
+            OD_LOG_ERR("Invalid Creature classes start format. Line was " + nextParam.to_string());
             return false;
         }
 
         // Load the creature definition until a [/Creature] tag is found
-        CreatureDefinition* creatureDef = CreatureDefinition::load(defFile, mCreatureDefs);
+        CreatureDefinition* creatureDef = CreatureDefinition::load(defStream, mCreatureDefs);
         if (creatureDef == nullptr)
         {
             OD_LOG_ERR("Invalid Creature classes start format");
@@ -674,27 +644,27 @@ bool ConfigManager::loadCreatureDefinitions(const std::string& fileName)
 bool ConfigManager::loadEquipements(const std::string& fileName)
 {
     OD_LOG_INF("Load weapon definition file: " + fileName);
-    std::stringstream defFile;
-    if(!Helper::readFileWithoutComments(fileName, defFile))
+    TextFileTokenizer defFile;
+    if(!defFile.open(fileName))
     {
         OD_LOG_ERR("Couldn't read " + fileName);
         return false;
     }
 
-    std::string nextParam;
+    // The definitions are loaded from a stream reading directly from the tokenizer
+    std::istream defStream(&defFile);
+
+    boost::string_ref nextParam;
     // Read in the creature class descriptions
-    defFile >> nextParam;
+    defFile.nextToken(nextParam);
     if (nextParam != "[EquipmentDefinitions]")
     {
-        OD_LOG_ERR("Invalid weapon start format. Line was " + nextParam);
+        OD_LOG_ERR("Invalid weapon start format. Line was " + nextParam.to_string());
         return false;
     }
 
-    while(defFile.good())
+    while(defFile.nextToken(nextParam))
     {
-        if(!(defFile >> nextParam))
-            break;
-
         if (nextParam == "[/EquipmentDefinitions]")
             break;
 
@@ -703,12 +673,12 @@ bool ConfigManager::loadEquipements(const std::string& fileName)
 
         if (nextParam != "[Equipment]")
         {
-            OD_LOG_ERR("Invalid Weapon definition format. Line was " + nextParam);
+            OD_LOG_ERR("Invalid Weapon definition format. Line was " + nextParam.to_string());
             return false;
         }
 
         // Load the definition
-        Weapon* weapon = Weapon::load(defFile);
+        Weapon* weapon = Weapon::load(defStream);
         if (weapon == nullptr)
         {
             OD_LOG_ERR("Invalid Weapon definition format");
@@ -723,27 +693,27 @@ bool ConfigManager::loadEquipements(const std::string& fileName)
 bool ConfigManager::loadSpawnConditions(const std::string& fileName)
 {
     OD_LOG_INF("Load creature spawn conditions file: " + fileName);
-    std::stringstream defFile;
-    if(!Helper::readFileWithoutComments(fileName, defFile))
+    TextFileTokenizer defFile;
+    if(!defFile.open(fileName))
     {
         OD_LOG_ERR("Couldn't read " + fileName);
         return false;
     }
 
-    std::string nextParam;
+    // The definitions are loaded from a stream reading directly from the tokenizer
+    std::istream defStream(&defFile);
+
+    boost::string_ref nextParam;
     // Read in the creature class descriptions
-    defFile >> nextParam;
+    defFile.nextToken(nextParam);
     if (nextParam != "[SpawnConditions]")
     {
-        OD_LOG_ERR("Invalid creature spawn condition start format. Line was " + nextParam);
+        OD_LOG_ERR("Invalid creature spawn condition start format. Line was " + nextParam.to_string());
         return false;
     }
 
-    while(defFile.good())
+    while(defFile.nextToken(nextParam))
     {
-        if(!(defFile >> nextParam))
-            break;
-
         if (nextParam == "[/SpawnConditions]")
             break;
 
@@ -752,48 +722,44 @@ bool ConfigManager::loadSpawnConditions(const std::string& fileName)
 
         if (nextParam == "BaseSpawnPoint")
         {
-            defFile >> nextParam;
-            mBaseSpawnPoint = Helper::toUInt32(nextParam);
+            defFile.nextUInt32(mBaseSpawnPoint);
             continue;
         }
 
         if (nextParam != "[SpawnCondition]")
         {
-            OD_LOG_ERR("Invalid creature spawn condition format. Line was " + nextParam);
+            OD_LOG_ERR("Invalid creature spawn condition format. Line was " + nextParam.to_string());
             return false;
         }
 
-        if(!(defFile >> nextParam))
+        if(!defFile.nextToken(nextParam))
                 break;
         if (nextParam != "CreatureClass")
         {
-            OD_LOG_ERR("Invalid creature spawn condition format. Line was " + nextParam);
+            OD_LOG_ERR("Invalid creature spawn condition format. Line was " + nextParam.to_string());
             return false;
         }
-        defFile >> nextParam;
-        const CreatureDefinition* creatureDefinition = getCreatureDefinition(nextParam);
+        defFile.nextToken(nextParam);
+        const CreatureDefinition* creatureDefinition = getCreatureDefinition(nextParam.to_string());
         if(creatureDefinition == nullptr)
         {
-            OD_LOG_ERR("nextParam=" + nextParam);
+            OD_LOG_ERR("nextParam=" + nextParam.to_string());
             return false;
         }
 
-        while(defFile.good())
+        while(defFile.nextToken(nextParam))
         {
-            if(!(defFile >> nextParam))
-                break;
-
             if (nextParam == "[/SpawnCondition]")
                 break;
 
             if (nextParam != "[Condition]")
             {
-                OD_LOG_ERR("Invalid creature spawn condition format. nextParam=" + nextParam);
+                OD_LOG_ERR("Invalid creature spawn condition format. nextParam=" + nextParam.to_string());
                 return false;
             }
 
             // Load the definition
-            SpawnCondition* def = SpawnCondition::load(defFile);
+            SpawnCondition* def = SpawnCondition::load(defStream);
             if (def == nullptr)
             {
                 OD_LOG_ERR("Invalid creature spawn condition format");
@@ -809,43 +775,37 @@ bool ConfigManager::loadSpawnConditions(const std::string& fileName)
 bool ConfigManager::loadFactions(const std::string& fileName)
 {
     OD_LOG_INF("Load factions file: " + fileName);
-    std::stringstream defFile;
-    if(!Helper::readFileWithoutComments(fileName, defFile))
+    TextFileTokenizer defFile;
+    if(!defFile.open(fileName))
     {
         OD_LOG_ERR("Couldn't read " + fileName);
         return false;
     }
 
-    std::string nextParam;
+    boost::string_ref nextParam;
     // Read in the creature class descriptions
-    defFile >> nextParam;
+    defFile.nextToken(nextParam);
     if (nextParam != "[Factions]")
     {
-        OD_LOG_ERR("Invalid factions start format. Line was " + nextParam);
+        OD_LOG_ERR("Invalid factions start format. Line was " + nextParam.to_string());
         return false;
     }
 
-    while(defFile.good())
+    while(defFile.nextToken(nextParam))
     {
-        if(!(defFile >> nextParam))
-            break;
-
         if (nextParam == "[/Factions]")
             break;
 
         if (nextParam != "[Faction]")
         {
-            OD_LOG_ERR("Invalid faction. Line was " + nextParam);
+            OD_LOG_ERR("Invalid faction. Line was " + nextParam.to_string());
             return false;
         }
 
         std::string factionName;
         std::string workerClass;
-        while(defFile.good())
+        while(defFile.nextToken(nextParam))
         {
-            if(!(defFile >> nextParam))
-                break;
-
             if (nextParam == "[/Faction]")
                 break;
 
@@ -854,7 +814,8 @@ bool ConfigManager::loadFactions(const std::string& fileName)
 
             if (nextParam == "Name")
             {
-                defFile >> factionName;
+                defFile.nextToken(nextParam);
+                factionName = nextParam.to_string();
                 continue;
             }
             if(factionName.empty())
@@ -865,7 +826,8 @@ bool ConfigManager::loadFactions(const std::string& fileName)
 
             if (nextParam == "WorkerClass")
             {
-                defFile >> workerClass;
+                defFile.nextToken(nextParam);
+                workerClass = nextParam.to_string();
                 continue;
             }
             if(workerClass.empty())
@@ -876,7 +838,7 @@ bool ConfigManager::loadFactions(const std::string& fileName)
 
             if (nextParam != "[SpawnPool]")
             {
-                OD_LOG_ERR("Invalid faction. Line was " + nextParam);
+                OD_LOG_ERR("Invalid faction. Line was " + nextParam.to_string());
                 return false;
             }
 
@@ -887,11 +849,8 @@ bool ConfigManager::loadFactions(const std::string& fileName)
             if(mDefaultWorkerRogue.empty())
                 mDefaultWorkerRogue = workerClass;
 
-            while(defFile.good())
+            while(defFile.nextToken(nextParam))
             {
-                if(!(defFile >> nextParam))
-                    break;
-
                 if (nextParam == "[/SpawnPool]")
                     break;
 
@@ -902,14 +861,14 @@ bool ConfigManager::loadFactions(const std::string& fileName)
                     break;
 
                 // We check if the creature definition exists
-                const CreatureDefinition* creatureDefinition = getCreatureDefinition(nextParam);
+                const CreatureDefinition* creatureDefinition = getCreatureDefinition(nextParam.to_string());
                 if(creatureDefinition == nullptr)
                 {
-                    OD_LOG_ERR("factionName=" + factionName + ", class=" + nextParam);
+                    OD_LOG_ERR("factionName=" + factionName + ", class=" + nextParam.to_string());
                     continue;
                 }
 
-                mFactionSpawnPool[factionName].push_back(nextParam);
+                mFactionSpawnPool[factionName].push_back(nextParam.to_string());
             }
         }
     }
@@ -920,130 +879,151 @@ bool ConfigManager::loadFactions(const std::string& fileName)
 bool ConfigManager::loadRooms(const std::string& fileName)
 {
     OD_LOG_INF("Load Rooms file: " + fileName);
-    std::stringstream defFile;
-    if(!Helper::readFileWithoutComments(fileName, defFile))
+    TextFileTokenizer defFile;
+    if(!defFile.open(fileName))
     {
         OD_LOG_ERR("Couldn't read " + fileName);
         return false;
     }
 
-    std::string nextParam;
+    boost::string_ref nextParam;
     // Read in the creature class descriptions
-    defFile >> nextParam;
+    defFile.nextToken(nextParam);
     if (nextParam != "[Rooms]")
     {
-        OD_LOG_ERR("Invalid factions start format. Line was " + nextParam);
+        OD_LOG_ERR("Invalid factions start format. Line was " + nextParam.to_string());
         return false;
     }
 
-    while(defFile.good())
+    while(defFile.nextToken(nextParam))
     {
-        if(!(defFile >> nextParam))
-            break;
-
         if (nextParam == "[/Rooms]")
             break;
 
-        defFile >> mRoomsConfig[nextParam];
+        boost::string_ref value;
+        defFile.nextToken(value);
+        std::string param = nextParam.to_string();
+        if(!mRoomsConfig.getLoadedConfig().setValue(param, value))
+        {
+            OD_LOG_ERR("Unknown or invalid room parameter param=" + param + ", value=" + value.to_string());
+            return false;
+        }
     }
 
-    return true;
+    std::vector<std::string> missingParams = mRoomsConfig.getLoadedConfig().getUnsetParams();
+    for(const std::string& param : missingParams)
+        OD_LOG_ERR("Missing room parameter param=" + param);
+
+    return missingParams.empty();
 }
 
 bool ConfigManager::loadTraps(const std::string& fileName)
 {
     OD_LOG_INF("Load traps file: " + fileName);
-    std::stringstream defFile;
-    if(!Helper::readFileWithoutComments(fileName, defFile))
+    TextFileTokenizer defFile;
+    if(!defFile.open(fileName))
     {
         OD_LOG_ERR("Couldn't read " + fileName);
         return false;
     }
 
-    std::string nextParam;
+    boost::string_ref nextParam;
     // Read in the creature class descriptions
-    defFile >> nextParam;
+    defFile.nextToken(nextParam);
     if (nextParam != "[Traps]")
     {
-        OD_LOG_ERR("Invalid Traps start format. Line was " + nextParam);
+        OD_LOG_ERR("Invalid Traps start format. Line was " + nextParam.to_string());
         return false;
     }
 
-    while(defFile.good())
+    while(defFile.nextToken(nextParam))
     {
-        if(!(defFile >> nextParam))
-            break;
-
         if (nextParam == "[/Traps]")
             break;
 
-        defFile >> mTrapsConfig[nextParam];
+        boost::string_ref value;
+        defFile.nextToken(value);
+        std::string param = nextParam.to_string();
+        if(!mTrapsConfig.getLoadedConfig().setValue(param, value))
+        {
+            OD_LOG_ERR("Unknown or invalid trap parameter param=" + param + ", value=" + value.to_string());
+            return false;
+        }
     }
 
-    return true;
+    std::vector<std::string> missingParams = mTrapsConfig.getLoadedConfig().getUnsetParams();
+    for(const std::string& param : missingParams)
+        OD_LOG_ERR("Missing trap parameter param=" + param);
+
+    return missingParams.empty();
 }
 
 bool ConfigManager::loadSpellConfig(const std::string& fileName)
 {
     OD_LOG_INF("Load Spell config file: " + fileName);
-    std::stringstream defFile;
-    if(!Helper::readFileWithoutComments(fileName, defFile))
+    TextFileTokenizer defFile;
+    if(!defFile.open(fileName))
     {
         OD_LOG_ERR("Couldn't read " + fileName);
         return false;
     }
 
-    std::string nextParam;
+    boost::string_ref nextParam;
     // Read in the creature class descriptions
-    defFile >> nextParam;
+    defFile.nextToken(nextParam);
     if (nextParam != "[Spells]")
     {
-        OD_LOG_ERR("Invalid Spells start format. Line was " + nextParam);
+        OD_LOG_ERR("Invalid Spells start format. Line was " + nextParam.to_string());
         return false;
     }
 
-    while(defFile.good())
+    while(defFile.nextToken(nextParam))
     {
-        if(!(defFile >> nextParam))
-            break;
-
         if (nextParam == "[/Spells]")
             break;
 
-        defFile >> mSpellConfig[nextParam];
+        boost::string_ref value;
+        defFile.nextToken(value);
+        std::string param = nextParam.to_string();
+        if(!mSpellsConfig.getLoadedConfig().setValue(param, value))
+        {
+            OD_LOG_ERR("Unknown or invalid spell parameter param=" + param + ", value=" + value.to_string());
+            return false;
+        }
     }
 
-    return true;
+    std::vector<std::string> missingParams = mSpellsConfig.getLoadedConfig().getUnsetParams();
+    for(const std::string& param : missingParams)
+        OD_LOG_ERR("Missing spell parameter param=" + param);
+
+    return missingParams.empty();
 }
 
 bool ConfigManager::loadSkills(const std::string& fileName)
 {
     OD_LOG_INF("Load Skills file: " + fileName);
-    std::stringstream defFile;
-    if(!Helper::readFileWithoutComments(fileName, defFile))
+    TextFileTokenizer defFile;
+    if(!defFile.open(fileName))
     {
         OD_LOG_ERR("Couldn't read " + fileName);
         return false;
     }
 
-    std::string nextParam;
+    boost::string_ref nextParam;
     // Read in the creature class descriptions
-    defFile >> nextParam;
+    defFile.nextToken(nextParam);
     if (nextParam != "[Skills]")
     {
-        OD_LOG_ERR("Invalid Skills start format. Line was " + nextParam);
+        OD_LOG_ERR("Invalid Skills start format. Line was " + nextParam.to_string());
         return false;
     }
 
-    while(defFile.good())
+    while(defFile.nextToken(nextParam))
     {
-        if(!(defFile >> nextParam))
-            break;
-
         if (nextParam == "[/Skills]")
             break;
 
-        defFile >> mSkillPoints[nextParam];
+        defFile.nextInt32(mSkillPoints[nextParam.to_string()]);
     }
     return true;
 }
@@ -1051,24 +1031,29 @@ bool ConfigManager::loadSkills(const std::string& fileName)
 bool ConfigManager::loadTilesets(const std::string& fileName)
 {
     OD_LOG_INF("Load Tilesets file: " + fileName);
-    std::stringstream defFile;
-    if(!Helper::readFileWithoutComments(fileName, defFile))
+    TextFileTokenizer defFile;
+    if(!defFile.open(fileName))
     {
         OD_LOG_ERR("Couldn't read " + fileName);
         return false;
     }
 
-    std::string nextParam;
-    defFile >> nextParam;
+    boost::string_ref nextParam;
+    defFile.nextToken(nextParam);
     if (nextParam != "[Tilesets]")
     {
-        OD_LOG_ERR("Invalid Tilesets start format. Line was " + nextParam);
+        OD_LOG_ERR("Invalid Tilesets start format. Line was " + nextParam.to_string());
         return false;
     }
 
     while(true)
     {
-        defFile >> nextParam;
+        if(!defFile.nextToken(nextParam))
+        {
+            OD_LOG_ERR("Unexpected end of file in tilesets");
+            return false;
+        }
+
         if (nextParam == "[/Tilesets]")
             break;
 
@@ -1077,48 +1062,53 @@ bool ConfigManager::loadTilesets(const std::string& fileName)
 
         if (nextParam != "[Tileset]")
         {
-            OD_LOG_ERR("Expecting TileSet tag but got=" + nextParam);
+            OD_LOG_ERR("Expecting TileSet tag but got=" + nextParam.to_string());
             return false;
         }
 
-        defFile >> nextParam;
+        defFile.nextToken(nextParam);
         if (nextParam != "Name")
         {
-            OD_LOG_ERR("Expecting Name tag but got=" + nextParam);
+            OD_LOG_ERR("Expecting Name tag but got=" + nextParam.to_string());
             return false;
         }
 
-        std::string tileSetName;
-        defFile >> tileSetName;
+        defFile.nextToken(nextParam);
+        std::string tileSetName = nextParam.to_string();
 
         TileSet* tileSet = new TileSet();
         mTileSets[tileSetName] = tileSet;
 
-        defFile >> nextParam;
+        defFile.nextToken(nextParam);
         if(nextParam != "[TileLink]")
         {
-            OD_LOG_ERR("Expecting TileLink tag but got=" + nextParam);
+            OD_LOG_ERR("Expecting TileLink tag but got=" + nextParam.to_string());
             return false;
         }
 
         while(true)
         {
-            defFile >> nextParam;
+            if(!defFile.nextToken(nextParam))
+            {
+                OD_LOG_ERR("Unexpected end of file in tileset=" + tileSetName);
+                return false;
+            }
+
             if(nextParam == "[/TileLink]")
                 break;
 
-            TileVisual tileVisual1 = Tile::tileVisualFromString(nextParam);
+            TileVisual tileVisual1 = Tile::tileVisualFromString(nextParam.to_string());
             if(tileVisual1 == TileVisual::nullTileVisual)
             {
-                OD_LOG_ERR("Wrong TileVisual1 in tileset=" + nextParam);
+                OD_LOG_ERR("Wrong TileVisual1 in tileset=" + nextParam.to_string());
                 return false;
             }
 
-            defFile >> nextParam;
-            TileVisual tileVisual2 = Tile::tileVisualFromString(nextParam);
+            defFile.nextToken(nextParam);
+            TileVisual tileVisual2 = Tile::tileVisualFromString(nextParam.to_string());
             if(tileVisual2 == TileVisual::nullTileVisual)
             {
-                OD_LOG_ERR("Wrong TileVisual2 in tileset=" + nextParam);
+                OD_LOG_ERR("Wrong TileVisual2 in tileset=" + nextParam.to_string());
                 return false;
             }
 
@@ -1160,51 +1150,56 @@ bool ConfigManager::loadTilesets(const std::string& fileName)
     return true;
 }
 
-bool ConfigManager::loadTilesetValues(std::istream& defFile, TileVisual tileVisual, std::vector<TileSetValue>& tileValues)
+bool ConfigManager::loadTilesetValues(TextFileTokenizer& defFile, TileVisual tileVisual, std::vector<TileSetValue>& tileValues)
 {
-    std::string nextParam;
+    boost::string_ref nextParam;
     std::string beginTag = "[" + Tile::tileVisualToString(tileVisual) + "]";
     std::string endTag = "[/" + Tile::tileVisualToString(tileVisual) + "]";
-    defFile >> nextParam;
+    defFile.nextToken(nextParam);
     if (nextParam != beginTag)
     {
-        OD_LOG_ERR("Expecting " + beginTag + " tag but got=" + nextParam);
+        OD_LOG_ERR("Expecting " + beginTag + " tag but got=" + nextParam.to_string());
         return false;
     }
     while(true)
     {
-        std::string indexStr;
-        defFile >> indexStr;
+        boost::string_ref indexStr;
+        if(!defFile.nextToken(indexStr))
+        {
+            OD_LOG_ERR("Unexpected end of file in tileset=" + endTag);
+            return false;
+        }
+
         if(indexStr == endTag)
             return true;
 
-        boost::dynamic_bitset<> x(indexStr);
+        boost::dynamic_bitset<> x(indexStr.to_string());
         uint32_t index = static_cast<int>(x.to_ulong());
 
-        std::string meshName;
-        defFile >> meshName;
+        boost::string_ref meshName;
+        defFile.nextToken(meshName);
 
-        std::string materialName;
-        defFile >> materialName;
-        if(materialName.compare("''") == 0)
+        boost::string_ref materialName;
+        defFile.nextToken(materialName);
+        if(materialName == "''")
             materialName.clear();
 
-        double rotX;
-        defFile >> rotX;
+        double rotX = 0.0;
+        defFile.nextDouble(rotX);
 
-        double rotY;
-        defFile >> rotY;
+        double rotY = 0.0;
+        defFile.nextDouble(rotY);
 
-        double rotZ;
-        defFile >> rotZ;
+        double rotZ = 0.0;
+        defFile.nextDouble(rotZ);
 
         if(index >= tileValues.size())
         {
-            OD_LOG_ERR("Tileset index too high in tileset=" + endTag + ", index=" + indexStr);
+            OD_LOG_ERR("Tileset index too high in tileset=" + endTag + ", index=" + indexStr.to_string());
             return false;
         }
 
-        tileValues[index] = TileSetValue(meshName, materialName, rotX, rotY, rotZ);
+        tileValues[index] = TileSetValue(meshName.to_string(), materialName.to_string(), rotX, rotY, rotZ);
     }
 }
 
@@ -1216,8 +1211,8 @@ void ConfigManager::loadUserConfig(const std::string& fileName)
     mFilenameUserCfg = fileName;
 
     OD_LOG_INF("Load user config file: " + fileName);
-    std::stringstream defFile;
-    if(!Helper::readFileWithoutComments(fileName, defFile))
+    TextFileTokenizer defFile;
+    if(!defFile.open(fileName))
     {
         OD_LOG_INF("Couldn't read " + fileName);
         return;
@@ -1226,19 +1221,19 @@ void ConfigManager::loadUserConfig(const std::string& fileName)
     mUserConfig.clear();
     mUserConfig.resize(Config::Ctg::TOTAL);
 
-    std::string nextParam;
-    defFile >> nextParam;
+    boost::string_ref nextParam;
+    defFile.nextToken(nextParam);
     if (nextParam != "[Configuration]")
     {
-        OD_LOG_WRN("Invalid User configuration start format. Line was " + nextParam);
+        OD_LOG_WRN("Invalid User configuration start format. Line was " + nextParam.to_string());
         return;
     }
 
     std::string value;
     Config::Ctg category = Config::Ctg::NONE;
-    while(defFile.good())
+    while(true)
     {
-        if (!(defFile >> nextParam))
+        if(!defFile.nextToken(nextParam))
         {
             break;
         }
@@ -1274,10 +1269,10 @@ void ConfigManager::loadUserConfig(const std::string& fileName)
         }
         else if (!nextParam.empty())
         {
-            std::string line;
-            std::getline(defFile, line);
+            boost::string_ref endOfLine;
+            defFile.nextLine(endOfLine);
             // Make sure to cut the line only when encountering a tab.
-            line = nextParam + line;
+            std::string line = nextParam.to_string() + endOfLine.to_string();
             std::vector<std::string> elements = Helper::split(line, '\t');
             if (elements.size() != 2)
             {
@@ -1372,148 +1367,30 @@ const std::string ConfigManager::getUserValue(Config::Ctg category,
     return it->second;
 }
 
-const std::string& ConfigManager::getRoomConfigString(const std::string& param) const
+bool ConfigManager::setGameConfigParam(const std::string& category, const std::string& param, const std::string& value)
 {
-    auto it = mRoomsConfig.find(param);
-    if(it == mRoomsConfig.end())
-    {
-        OD_LOG_ERR("Unknown parameter param=" + param);
-        return EMPTY_STRING;
-    }
-
-    return it->second;
+    if(category == "rooms")
+        return mRoomsConfig.setValue(param, value);
+    if(category == "traps")
+        return mTrapsConfig.setValue(param, value);
+    if(category == "spells")
+        return mSpellsConfig.setValue(param, value);
+
+    OD_LOG_ERR("Unknown category=" + category);
+    return false;
 }
 
-uint32_t ConfigManager::getRoomConfigUInt32(const std::string& param) const
+bool ConfigManager::getGameConfigParam(const std::string& category, const std::string& param, std::string& value) const
 {
-    auto it = mRoomsConfig.find(param);
-    if(it == mRoomsConfig.end())
-    {
-        OD_LOG_ERR("Unknown parameter param=" + param);
-        return 0;
-    }
-
-    return Helper::toUInt32(it->second);
-}
-
-int32_t ConfigManager::getRoomConfigInt32(const std::string& param) const
-{
-    auto it = mRoomsConfig.find(param);
-    if(it == mRoomsConfig.end())
-    {
-        OD_LOG_ERR("Unknown parameter param=" + param);
-        return 0;
-    }
-
-    return Helper::toInt(it->second);
-}
-
-double ConfigManager::getRoomConfigDouble(const std::string& param) const
-{
-    auto it = mRoomsConfig.find(param);
-    if(it == mRoomsConfig.end())
-    {
-        OD_LOG_ERR("Unknown parameter param=" + param);
-        return 0.0;
-    }
-
-    return Helper::toDouble(it->second);
-}
-
-const std::string& ConfigManager::getTrapConfigString(const std::string& param) const
-{
-    auto it = mTrapsConfig.find(param);
-    if(it == mTrapsConfig.end())
-    {
-        OD_LOG_ERR("Unknown parameter param=" + param);
-        return EMPTY_STRING;
-    }
-
-    return it->second;
-}
-
-uint32_t ConfigManager::getTrapConfigUInt32(const std::string& param) const
-{
-    auto it = mTrapsConfig.find(param);
-    if(it == mTrapsConfig.end())
-    {
-        OD_LOG_ERR("Unknown parameter param=" + param);
-        return 0;
-    }
-
-    return Helper::toUInt32(it->second);
-}
-
-int32_t ConfigManager::getTrapConfigInt32(const std::string& param) const
-{
-    auto it = mTrapsConfig.find(param);
-    if(it == mTrapsConfig.end())
-    {
-        OD_LOG_ERR("Unknown parameter param=" + param);
-        return 0;
-    }
-
-    return Helper::toInt(it->second);
-}
-
-double ConfigManager::getTrapConfigDouble(const std::string& param) const
-{
-    auto it = mTrapsConfig.find(param);
-    if(it == mTrapsConfig.end())
-    {
-        OD_LOG_ERR("Unknown parameter param=" + param);
-        return 0.0;
-    }
-
-    return Helper::toDouble(it->second);
-}
-
-const std::string& ConfigManager::getSpellConfigString(const std::string& param) const
-{
-    auto it = mSpellConfig.find(param);
-    if(it == mSpellConfig.end())
-    {
-        OD_LOG_ERR("Unknown parameter param=" + param);
-        return EMPTY_STRING;
-    }
-
-    return it->second;
-}
-
-uint32_t ConfigManager::getSpellConfigUInt32(const std::string& param) const
-{
-    auto it = mSpellConfig.find(param);
-    if(it == mSpellConfig.end())
-    {
-        OD_LOG_ERR("Unknown parameter param=" + param);
-        return 0;
-    }
-
-    return Helper::toUInt32(it->second);
-}
-
-int32_t ConfigManager::getSpellConfigInt32(const std::string& param) const
-{
-    auto it = mSpellConfig.find(param);
-    if(it == mSpellConfig.end())
-    {
-        OD_LOG_ERR("Unknown parameter param=" + param);
-        return 0;
-    }
-
-    return Helper::toInt(it->second);
-}
-
-double ConfigManager::getSpellConfigDouble(const std::string& param) const
-{
-    auto it = mSpellConfig.find(param);
-    if(it == mSpellConfig.end())
-    {
-        OD_LOG_ERR("Unknown parameter param=" + param);
-        return 0.0;
-    }
-
-    return Helper::toDouble(it->second);
+    if(category == "rooms")
+        return mRoomsConfig.get().getValue(param, value);
+    if(category == "traps")
+        return mTrapsConfig.get().getValue(param, value);
+    if(category == "spells")
+        return mSpellsConfig.get().getValue(param, value);
+
+    OD_LOG_ERR("Unknown category=" + category);
+    return false;
 }
 
 int32_t ConfigManager::getSkillPoints(const std::string& res) const
@@ -18,6 +18,8 @@
 #ifndef CONFIGMANAGER_H
 #define CONFIGMANAGER_H
 
+#include "utils/ConfigParams.h"
+
 #include <OgreSingleton.h>
 #include <OgreColourValue.h>
 
@@ -27,6 +29,7 @@ class CreatureDefinition;
 class Weapon;
 class SpawnCondition;
 class Skill;
+class TextFileTokenizer;
 class TileSet;
 class TileSetValue;
 
@@ -174,23 +177,26 @@ public:
     inline const std::vector<std::string>& getFactions() const
     { return mFactions; }
 
-    //! Rooms configuration
-    const std::string& getRoomConfigString(const std::string& param) const;
-    uint32_t getRoomConfigUInt32(const std::string& param) const;
-    int32_t getRoomConfigInt32(const std::string& param) const;
-    double getRoomConfigDouble(const std::string& param) const;
+    //! Rooms, traps and spells configuration. They can be changed at runtime from the console so the
+    //! returned reference should not be kept longer than needed to read the values
+    inline const RoomsConfig& getRoomsConfig() const
+    { return mRoomsConfig.get(); }
+
+    inline const TrapsConfig& getTrapsConfig() const
+    { return mTrapsConfig.get(); }
+
+    inline const SpellsConfig& getSpellsConfig() const
+    { return mSpellsConfig.get(); }
 
-    //! Traps configuration
-    const std::string& getTrapConfigString(const std::string& param) const;
-    uint32_t getTrapConfigUInt32(const std::string& param) const;
-    int32_t getTrapConfigInt32(const std::string& param) const;
-    double getTrapConfigDouble(const std::string& param) const;
+    //! \brief Changes a rooms/traps/spells parameter at runtime (used from the console to retune
+    //! the game). category should be "rooms", "traps" or "spells". Returns false if the parameter
+    //! is unknown or if the value is invalid. The change is published as a new copy of the config
+    //! so that it can be made while other threads read it
+    bool setGameConfigParam(const std::string& category, const std::string& param, const std::string& value);
 
-    //! Spells configuration
-    const std::string& getSpellConfigString(const std::string& param) const;
-    uint32_t getSpellConfigUInt32(const std::string& param) const;
-    int32_t getSpellConfigInt32(const std::string& param) const;
-    double getSpellConfigDouble(const std::string& param) const;
+    //! \brief Sets value with the current value of the given rooms/traps/spells parameter.
+    //! Returns false if the parameter is unknown
+    bool getGameConfigParam(const std::string& category, const std::string& param, std::string& value) const;
 
     int32_t getSkillPoints(const std::string& res) const;
 
@@ -248,9 +254,9 @@ private:
     //! \brief Function used to load the global configuration. They should return true if the configuration
     //! is ok and false if a mandatory parameter is missing
     bool loadGlobalConfig(const std::string& configPath);
-    bool loadGlobalConfigSeatColors(std::stringstream& configFile);
-    bool loadGlobalConfigDefinitionFiles(std::stringstream& configFile);
-    bool loadGlobalGameConfig(std::stringstream& configFile);
+    bool loadGlobalConfigSeatColors(TextFileTokenizer& configFile);
+    bool loadGlobalConfigDefinitionFiles(TextFileTokenizer& configFile);
+    bool loadGlobalGameConfig(TextFileTokenizer& configFile);
     bool loadCreatureDefinitions(const std::string& fileName);
     bool loadEquipements(const std::string& fileName);
     bool loadSpawnConditions(const std::string& fileName);
@@ -260,7 +266,7 @@ private:
     bool loadSpellConfig(const std::string& fileName);
     bool loadSkills(const std::string& fileName);
     bool loadTilesets(const std::string& fileName);
-    bool loadTilesetValues(std::istream& defFile, TileVisual tileVisual, std::vector<TileSetValue>& tileValues);
+    bool loadTilesetValues(TextFileTokenizer& defFile, TileVisual tileVisual, std::vector<TileSetValue>& tileValues);
 
     //! \brief Loads the user configuration values, and use default ones if it cannot do it.
     void loadUserConfig(const std::string& fileName);
@@ -317,9 +323,9 @@ private:
     std::map<const std::string, std::string> mFactionDefaultWorkerClass;
 
     std::vector<std::string> mFactions;
-    std::map<const std::string, std::string> mRoomsConfig;
-    std::map<const std::string, std::string> mTrapsConfig;
-    std::map<const std::string, std::string> mSpellConfig;
+    ConfigSnapshots<RoomsConfig> mRoomsConfig;
+    ConfigSnapshots<TrapsConfig> mTrapsConfig;
+    ConfigSnapshots<SpellsConfig> mSpellsConfig;
     std::map<const std::string, int32_t> mSkillPoints;
 
     //! \brief Default definition for the editor. At map loading, it will spawn a creature from
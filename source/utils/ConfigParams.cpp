@@ -0,0 +1,398 @@
+/*
+ *  Copyright (C) 2011-2016  OpenDungeons Team
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "utils/ConfigParams.h"
+
+#include "utils/Helper.h"
+#include "utils/LogManager.h"
+#include "utils/TextFileTokenizer.h"
+
+void ConfigParamRegistry::registerParam(const std::string& name, uint32_t& field)
+{
+    Param& param = mParams[name];
+    param.mUInt32 = &field;
+}
+
+void ConfigParamRegistry::registerParam(const std::string& name, int32_t& field)
+{
+    Param& param = mParams[name];
+    param.mInt32 = &field;
+}
+
+void ConfigParamRegistry::registerParam(const std::string& name, double& field)
+{
+    Param& param = mParams[name];
+    param.mDouble = &field;
+}
+
+void ConfigParamRegistry::registerParam(const std::string& name, std::string& field)
+{
+    Param& param = mParams[name];
+    param.mString = &field;
+}
+
+bool ConfigParamRegistry::setValue(const std::string& name, boost::string_ref value)
+{
+    auto it = mParams.find(name);
+    if(it == mParams.end())
+        return false;
+
+    Param& param = it->second;
+    bool ok;
+    if(param.mUInt32 != nullptr)
+        ok = TextFileTokenizer::toUInt32(value, *param.mUInt32);
+    else if(param.mInt32 != nullptr)
+        ok = TextFileTokenizer::toInt32(value, *param.mInt32);
+    else if(param.mDouble != nullptr)
+        ok = TextFileTokenizer::toDouble(value, *param.mDouble);
+    else
+    {
+        *param.mString = value.to_string();
+        ok = !value.empty();
+    }
+
+    if(!ok)
+    {
+        OD_LOG_ERR("Invalid value for param=" + name + ", value=" + value.to_string());
+        return false;
+    }
+
+    param.mIsSet = true;
+    return true;
+}
+
+bool ConfigParamRegistry::getValue(const std::string& name, std::string& value) const
+{
+    auto it = mParams.find(name);
+    if(it == mParams.end())
+        return false;
+
+    const Param& param = it->second;
+    if(param.mUInt32 != nullptr)
+        value = Helper::toString(*param.mUInt32);
+    else if(param.mInt32 != nullptr)
+        value = Helper::toString(*param.mInt32);
+    else if(param.mDouble != nullptr)
+        value = Helper::toString(*param.mDouble);
+    else
+        value = *param.mString;
+
+    return true;
+}
+
+uint32_t ConfigParamRegistry::getUInt32(const std::string& name) const
+{
+    auto it = mParams.find(name);
+    if((it == mParams.end()) || (it->second.mUInt32 == nullptr))
+    {
+        OD_LOG_ERR("Unknown parameter param=" + name);
+        return 0;
+    }
+
+    return *it->second.mUInt32;
+}
+
+std::vector<std::string> ConfigParamRegistry::getUnsetParams() const
+{
+    std::vector<std::string> ret;
+    for(const std::pair<const std::string, Param>& p : mParams)
+    {
+        if(!p.second.mIsSet)
+            ret.push_back(p.first);
+    }
+    return ret;
+}
+
+std::vector<std::string> ConfigParamRegistry::getParamNames() const
+{
+    std::vector<std::string> ret;
+    for(const std::pair<const std::string, Param>& p : mParams)
+        ret.push_back(p.first);
+
+    return ret;
+}
+
+void ConfigParamRegistry::copyValuesFrom(const ConfigParamRegistry& other)
+{
+    for(std::pair<const std::string, Param>& p : mParams)
+    {
+        auto it = other.mParams.find(p.first);
+        if(it == other.mParams.end())
+        {
+            OD_LOG_ERR("Unknown parameter param=" + p.first);
+            continue;
+        }
+
+        Param& param = p.second;
+        const Param& otherParam = it->second;
+        if((param.mUInt32 != nullptr) && (otherParam.mUInt32 != nullptr))
+            *param.mUInt32 = *otherParam.mUInt32;
+        else if((param.mInt32 != nullptr) && (otherParam.mInt32 != nullptr))
+            *param.mInt32 = *otherParam.mInt32;
+        else if((param.mDouble != nullptr) && (otherParam.mDouble != nullptr))
+            *param.mDouble = *otherParam.mDouble;
+        else if((param.mString != nullptr) && (otherParam.mString != nullptr))
+            *param.mString = *otherParam.mString;
+        else
+        {
+            OD_LOG_ERR("Type mismatch for param=" + p.first);
+            continue;
+        }
+
+        param.mIsSet = otherParam.mIsSet;
+    }
+}
+
+RoomsConfig::RoomsConfig() :
+    mHatcheryCostPerTile(0),
+    mHatcheryHungerPerChicken(0.0),
+    mHatcheryHpRecoveredPerChicken(0.0),
+    mHatcheryChickenSpawnRate(0),
+    mHatcheryCooldownChickenMin(0),
+    mHatcheryCooldownChickenMax(0),
+    mTrainHallCostPerTile(0),
+    mTrainHallXpPerAttack(0.0),
+    mTrainHallWakefulnessPerAttack(0.0),
+    mTrainHallCooldownHitMin(0),
+    mTrainHallCooldownHitMax(0),
+    mTrainHallBonusWallActiveSpot(0.0),
+    mTrainHallMaxTrainingLevel(0),
+    mCryptCostPerTile(0),
+    mCryptRotNbTurns(0),
+    mCryptBonusWallActiveSpot(0.0),
+    mCryptPointsForSpawn(0),
+    mWorkshopCostPerTile(0),
+    mWorkshopPointsPerWork(0.0),
+    mWorkshopWakefulnessPerWork(0.0),
+    mWorkshopCooldownWorkMin(0),
+    mWorkshopCooldownWorkMax(0),
+    mTreasuryCostPerTile(0),
+    mDormitoryCostPerTile(0),
+    mLibraryCostPerTile(0),
+    mLibraryPointsPerWork(0.0),
+    mLibraryWakefulnessPerWork(0.0),
+    mLibraryCooldownWorkMin(0),
+    mLibraryCooldownWorkMax(0),
+    mLibrarySkillPointsBook(0),
+    mPortalCooldownSpawnMin(0),
+    mPortalCooldownSpawnMax(0),
+    mPrisonCostPerTile(0),
+    mPrisonDamagePerTurn(0.0),
+    mWoodenBridgeCostPerTile(0),
+    mStoneBridgeCostPerTile(0),
+    mArenaCostPerTile(0),
+    mArenaMaxTrainingLevel(0),
+    mCasinoCostPerTile(0),
+    mCasinoWakefulnessPerWork(0.0),
+    mCasinoCooldownWorkMin(0),
+    mCasinoCooldownWorkMax(0),
+    mCasinoBet(0),
+    mCasinoFee(0.0),
+    mTortureCostPerTile(0),
+    mTortureRallyPercent(0.0),
+    mTortureSessionLengthMin(0),
+    mTortureSessionLengthMax(0),
+    mTortureDamagePerTurn(0.0)
+{
+    registerParam("HatcheryCostPerTile", mHatcheryCostPerTile);
+    registerParam("HatcheryHungerPerChicken", mHatcheryHungerPerChicken);
+    registerParam("HatcheryHpRecoveredPerChicken", mHatcheryHpRecoveredPerChicken);
+    registerParam("HatcheryChickenSpawnRate", mHatcheryChickenSpawnRate);
+    registerParam("HatcheryCooldownChickenMin", mHatcheryCooldownChickenMin);
+    registerParam("HatcheryCooldownChickenMax", mHatcheryCooldownChickenMax);
+    registerParam("TrainHallCostPerTile", mTrainHallCostPerTile);
+    registerParam("TrainHallXpPerAttack", mTrainHallXpPerAttack);
+    registerParam("TrainHallWakefulnessPerAttack", mTrainHallWakefulnessPerAttack);
+    registerParam("TrainHallCooldownHitMin", mTrainHallCooldownHitMin);
+    registerParam("TrainHallCooldownHitMax", mTrainHallCooldownHitMax);
+    registerParam("TrainHallBonusWallActiveSpot", mTrainHallBonusWallActiveSpot);
+    registerParam("TrainHallMaxTrainingLevel", mTrainHallMaxTrainingLevel);
+    registerParam("CryptCostPerTile", mCryptCostPerTile);
+    registerParam("CryptRotNbTurns", mCryptRotNbTurns);
+    registerParam("CryptBonusWallActiveSpot", mCryptBonusWallActiveSpot);
+    registerParam("CryptPointsForSpawn", mCryptPointsForSpawn);
+    registerParam("CryptSpawnClass", mCryptSpawnClass);
+    registerParam("WorkshopCostPerTile", mWorkshopCostPerTile);
+    registerParam("WorkshopPointsPerWork", mWorkshopPointsPerWork);
+    registerParam("WorkshopWakefulnessPerWork", mWorkshopWakefulnessPerWork);
+    registerParam("WorkshopCooldownWorkMin", mWorkshopCooldownWorkMin);
+    registerParam("WorkshopCooldownWorkMax", mWorkshopCooldownWorkMax);
+    registerParam("TreasuryCostPerTile", mTreasuryCostPerTile);
+    registerParam("DormitoryCostPerTile", mDormitoryCostPerTile);
+    registerParam("LibraryCostPerTile", mLibraryCostPerTile);
+    registerParam("LibraryPointsPerWork", mLibraryPointsPerWork);
+    registerParam("LibraryWakefulnessPerWork", mLibraryWakefulnessPerWork);
+    registerParam("LibraryCooldownWorkMin", mLibraryCooldownWorkMin);
+    registerParam("LibraryCooldownWorkMax", mLibraryCooldownWorkMax);
+    registerParam("LibrarySkillPointsBook", mLibrarySkillPointsBook);
+    registerParam("PortalCooldownSpawnMin", mPortalCooldownSpawnMin);
+    registerParam("PortalCooldownSpawnMax", mPortalCooldownSpawnMax);
+    registerParam("PrisonCostPerTile", mPrisonCostPerTile);
+    registerParam("PrisonDamagePerTurn", mPrisonDamagePerTurn);
+    registerParam("PrisonSpawnClass", mPrisonSpawnClass);
+    registerParam("WoodenBridgeCostPerTile", mWoodenBridgeCostPerTile);
+    registerParam("StoneBridgeCostPerTile", mStoneBridgeCostPerTile);
+    registerParam("ArenaCostPerTile", mArenaCostPerTile);
+    registerParam("ArenaMaxTrainingLevel", mArenaMaxTrainingLevel);
+    registerParam("CasinoCostPerTile", mCasinoCostPerTile);
+    registerParam("CasinoWakefulnessPerWork", mCasinoWakefulnessPerWork);
+    registerParam("CasinoCooldownWorkMin", mCasinoCooldownWorkMin);
+    registerParam("CasinoCooldownWorkMax", mCasinoCooldownWorkMax);
+    registerParam("CasinoBet", mCasinoBet);
+    registerParam("CasinoFee", mCasinoFee);
+    registerParam("TortureCostPerTile", mTortureCostPerTile);
+    registerParam("TortureRallyPercent", mTortureRallyPercent);
+    registerParam("TortureSessionLengthMin", mTortureSessionLengthMin);
+    registerParam("TortureSessionLengthMax", mTortureSessionLengthMax);
+    registerParam("TortureDamagePerTurn", mTortureDamagePerTurn);
+}
+
+TrapsConfig::TrapsConfig() :
+    mBoulderCostPerTile(0),
+    mBoulderWorkshopPointsPerTile(0),
+    mBoulderReloadTurns(0),
+    mBoulderSpeed(0.0),
+    mBoulderDamagePerHitMin(0.0),
+    mBoulderDamagePerHitMax(0.0),
+    mBoulderNbShootsBeforeDeactivation(0),
+    mCannonCostPerTile(0),
+    mCannonPhyDef(0),
+    mCannonMagDef(0),
+    mCannonEleDef(0),
+    mCannonWorkshopPointsPerTile(0),
+    mCannonRange(0),
+    mCannonSpeed(0.0),
+    mCannonReloadTurns(0),
+    mCannonDamagePerHitMin(0.0),
+    mCannonDamagePerHitMax(0.0),
+    mCannonNbShootsBeforeDeactivation(0),
+    mSpikeCostPerTile(0),
+    mSpikeWorkshopPointsPerTile(0),
+    mSpikeReloadTurns(0),
+    mSpikeDamagePerHitMin(0.0),
+    mSpikeDamagePerHitMax(0.0),
+    mSpikeNbShootsBeforeDeactivation(0),
+    mWoodenDoorCostPerTile(0),
+    mWoodenDoorPointsPerTile(0)
+{
+    registerParam("BoulderCostPerTile", mBoulderCostPerTile);
+    registerParam("BoulderWorkshopPointsPerTile", mBoulderWorkshopPointsPerTile);
+    registerParam("BoulderReloadTurns", mBoulderReloadTurns);
+    registerParam("BoulderSpeed", mBoulderSpeed);
+    registerParam("BoulderDamagePerHitMin", mBoulderDamagePerHitMin);
+    registerParam("BoulderDamagePerHitMax", mBoulderDamagePerHitMax);
+    registerParam("BoulderNbShootsBeforeDeactivation", mBoulderNbShootsBeforeDeactivation);
+    registerParam("CannonCostPerTile", mCannonCostPerTile);
+    registerParam("CannonPhyDef", mCannonPhyDef);
+    registerParam("CannonMagDef", mCannonMagDef);
+    registerParam("CannonEleDef", mCannonEleDef);
+    registerParam("CannonWorkshopPointsPerTile", mCannonWorkshopPointsPerTile);
+    registerParam("CannonRange", mCannonRange);
+    registerParam("CannonSpeed", mCannonSpeed);
+    registerParam("CannonReloadTurns", mCannonReloadTurns);
+    registerParam("CannonDamagePerHitMin", mCannonDamagePerHitMin);
+    registerParam("CannonDamagePerHitMax", mCannonDamagePerHitMax);
+    registerParam("CannonNbShootsBeforeDeactivation", mCannonNbShootsBeforeDeactivation);
+    registerParam("SpikeCostPerTile", mSpikeCostPerTile);
+    registerParam("SpikeWorkshopPointsPerTile", mSpikeWorkshopPointsPerTile);
+    registerParam("SpikeReloadTurns", mSpikeReloadTurns);
+    registerParam("SpikeDamagePerHitMin", mSpikeDamagePerHitMin);
+    registerParam("SpikeDamagePerHitMax", mSpikeDamagePerHitMax);
+    registerParam("SpikeNbShootsBeforeDeactivation", mSpikeNbShootsBeforeDeactivation);
+    registerParam("WoodenDoorCostPerTile", mWoodenDoorCostPerTile);
+    registerParam("WoodenDoorPointsPerTile", mWoodenDoorPointsPerTile);
+}
+
+SpellsConfig::SpellsConfig() :
+    mSummonWorkerNbFree(0),
+    mSummonWorkerBasePrice(0),
+    mSummonWorkerCooldown(0),
+    mCallToWarPrice(0),
+    mCallToWarNbTurnsMax(0),
+    mCallToWarCooldown(0),
+    mCreatureExplosionPrice(0),
+    mCreatureExplosionDuration(0),
+    mCreatureExplosionValue(0.0),
+    mCreatureExplosionCooldown(0),
+    mCreatureHastePrice(0),
+    mCreatureHasteDuration(0),
+    mCreatureHasteValue(0.0),
+    mCreatureHasteCooldown(0),
+    mCreatureDefensePrice(0),
+    mCreatureDefenseDuration(0),
+    mCreatureDefenseValue(0.0),
+    mCreatureDefenseCooldown(0),
+    mCreatureHealPrice(0),
+    mCreatureHealDuration(0),
+    mCreatureHealValue(0.0),
+    mCreatureHealCooldown(0),
+    mCreatureSlowPrice(0),
+    mCreatureSlowDuration(0),
+    mCreatureSlowValue(0.0),
+    mCreatureSlowCooldown(0),
+    mCreatureStrengthPrice(0),
+    mCreatureStrengthDuration(0),
+    mCreatureStrengthValue(0.0),
+    mCreatureStrengthCooldown(0),
+    mCreatureWeakPrice(0),
+    mCreatureWeakDuration(0),
+    mCreatureWeakValue(0.0),
+    mCreatureWeakCooldown(0),
+    mEyeEvilPrice(0),
+    mEyeEvilRadiusTiles(0),
+    mEyeEvilNbTurns(0),
+    mEyeEvilCooldown(0)
+{
+    registerParam("SummonWorkerNbFree", mSummonWorkerNbFree);
+    registerParam("SummonWorkerBasePrice", mSummonWorkerBasePrice);
+    registerParam("SummonWorkerCooldown", mSummonWorkerCooldown);
+    registerParam("CallToWarPrice", mCallToWarPrice);
+    registerParam("CallToWarNbTurnsMax", mCallToWarNbTurnsMax);
+    registerParam("CallToWarCooldown", mCallToWarCooldown);
+    registerParam("CreatureExplosionPrice", mCreatureExplosionPrice);
+    registerParam("CreatureExplosionDuration", mCreatureExplosionDuration);
+    registerParam("CreatureExplosionValue", mCreatureExplosionValue);
+    registerParam("CreatureExplosionCooldown", mCreatureExplosionCooldown);
+    registerParam("CreatureHastePrice", mCreatureHastePrice);
+    registerParam("CreatureHasteDuration", mCreatureHasteDuration);
+    registerParam("CreatureHasteValue", mCreatureHasteValue);
+    registerParam("CreatureHasteCooldown", mCreatureHasteCooldown);
+    registerParam("CreatureDefensePrice", mCreatureDefensePrice);
+    registerParam("CreatureDefenseDuration", mCreatureDefenseDuration);
+    registerParam("CreatureDefenseValue", mCreatureDefenseValue);
+    registerParam("CreatureDefenseCooldown", mCreatureDefenseCooldown);
+    registerParam("CreatureHealPrice", mCreatureHealPrice);
+    registerParam("CreatureHealDuration", mCreatureHealDuration);
+    registerParam("CreatureHealValue", mCreatureHealValue);
+    registerParam("CreatureHealCooldown", mCreatureHealCooldown);
+    registerParam("CreatureSlowPrice", mCreatureSlowPrice);
+    registerParam("CreatureSlowDuration", mCreatureSlowDuration);
+    registerParam("CreatureSlowValue", mCreatureSlowValue);
+    registerParam("CreatureSlowCooldown", mCreatureSlowCooldown);
+    registerParam("CreatureStrengthPrice", mCreatureStrengthPrice);
+    registerParam("CreatureStrengthDuration", mCreatureStrengthDuration);
+    registerParam("CreatureStrengthValue", mCreatureStrengthValue);
+    registerParam("CreatureStrengthCooldown", mCreatureStrengthCooldown);
+    registerParam("CreatureWeakPrice", mCreatureWeakPrice);
+    registerParam("CreatureWeakDuration", mCreatureWeakDuration);
+    registerParam("CreatureWeakValue", mCreatureWeakValue);
+    registerParam("CreatureWeakCooldown", mCreatureWeakCooldown);
+    registerParam("EyeEvilPrice", mEyeEvilPrice);
+    registerParam("EyeEvilRadiusTiles", mEyeEvilRadiusTiles);
+    registerParam("EyeEvilNbTurns", mEyeEvilNbTurns);
+    registerParam("EyeEvilCooldown", mEyeEvilCooldown);
+}
@@ -0,0 +1,275 @@
+/*
+ *  Copyright (C) 2011-2016  OpenDungeons Team
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef CONFIGPARAMS_H
+#define CONFIGPARAMS_H
+
+#include <boost/utility/string_ref.hpp>
+
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+//! \brief Binds the parameter names used in the configuration files to typed fields.
+//! Values are converted once when they are set (when loading the file or from the
+//! console) so that the game logic can read plain fields instead of looking up and
+//! converting strings each time a value is needed.
+class ConfigParamRegistry
+{
+public:
+    ConfigParamRegistry()
+    {}
+
+    virtual ~ConfigParamRegistry()
+    {}
+
+    //! \brief Converts the given value and sets the matching field. Returns false if
+    //! the parameter is unknown or if the value cannot be converted
+    bool setValue(const std::string& name, boost::string_ref value);
+
+    //! \brief Sets value with the current value of the given parameter. Returns false
+    //! if the parameter is unknown
+    bool getValue(const std::string& name, std::string& value) const;
+
+    //! \brief Typed accessors for the parameters that are only known at runtime. The
+    //! game logic should read the fields directly whenever the parameter is known
+    uint32_t getUInt32(const std::string& name) const;
+
+    //! \brief Returns the names of the registered parameters that were never set
+    std::vector<std::string> getUnsetParams() const;
+
+    //! \brief Returns the names of all the registered parameters
+    std::vector<std::string> getParamNames() const;
+
+    //! \brief Copies the values of the given registry, which should be of the same type
+    void copyValuesFrom(const ConfigParamRegistry& other);
+
+protected:
+    void registerParam(const std::string& name, uint32_t& field);
+    void registerParam(const std::string& name, int32_t& field);
+    void registerParam(const std::string& name, double& field);
+    void registerParam(const std::string& name, std::string& field);
+
+private:
+    //! \brief Only one of the pointers is set depending on the field type
+    struct Param
+    {
+        Param() :
+            mUInt32(nullptr),
+            mInt32(nullptr),
+            mDouble(nullptr),
+            mString(nullptr),
+            mIsSet(false)
+        {}
+
+        uint32_t* mUInt32;
+        int32_t* mInt32;
+        double* mDouble;
+        std::string* mString;
+        bool mIsSet;
+    };
+
+    //! \brief Fields are registered by address so the registry cannot be copied
+    ConfigParamRegistry(const ConfigParamRegistry&) = delete;
+    ConfigParamRegistry& operator=(const ConfigParamRegistry&) = delete;
+
+    std::map<std::string, Param> mParams;
+};
+
+//! \brief Holds a config that can be changed at runtime while other threads read it (the server
+//! and the client run in different threads of the same process). A change publishes a modified copy
+//! and the previous copies are kept until the holder is destroyed. That way, a reader never sees a
+//! partially written or deleted config. Changes should be made from one thread at a time
+template<typename ConfigType>
+class ConfigSnapshots
+{
+public:
+    ConfigSnapshots()
+    {
+        mSnapshots.emplace_back(new ConfigType);
+        mCurrent.store(mSnapshots.back().get());
+    }
+
+    //! \brief Config to fill when loading the configuration files, before other threads use it
+    ConfigType& getLoadedConfig()
+    { return *mSnapshots.front(); }
+
+    inline const ConfigType& get() const
+    { return *mCurrent.load(std::memory_order_acquire); }
+
+    //! \brief Publishes a copy of the current config with the given parameter changed. Returns false
+    //! (and publishes nothing) if the parameter is unknown or the value invalid
+    bool setValue(const std::string& name, boost::string_ref value)
+    {
+        std::unique_ptr<ConfigType> config(new ConfigType);
+        config->copyValuesFrom(get());
+        if(!config->setValue(name, value))
+            return false;
+
+        mCurrent.store(config.get(), std::memory_order_release);
+        mSnapshots.push_back(std::move(config));
+        return true;
+    }
+
+private:
+    ConfigSnapshots(const ConfigSnapshots&) = delete;
+    ConfigSnapshots& operator=(const ConfigSnapshots&) = delete;
+
+    std::atomic<const ConfigType*> mCurrent;
+    std::vector<std::unique_ptr<ConfigType>> mSnapshots;
+};
+
+//! \brief Values from rooms.cfg. See the file header for the meaning of each parameter
+struct RoomsConfig : public ConfigParamRegistry
+{
+    RoomsConfig();
+
+    int32_t mHatcheryCostPerTile;
+    double mHatcheryHungerPerChicken;
+    double mHatcheryHpRecoveredPerChicken;
+    uint32_t mHatcheryChickenSpawnRate;
+    uint32_t mHatcheryCooldownChickenMin;
+    uint32_t mHatcheryCooldownChickenMax;
+    int32_t mTrainHallCostPerTile;
+    double mTrainHallXpPerAttack;
+    double mTrainHallWakefulnessPerAttack;
+    uint32_t mTrainHallCooldownHitMin;
+    uint32_t mTrainHallCooldownHitMax;
+    double mTrainHallBonusWallActiveSpot;
+    uint32_t mTrainHallMaxTrainingLevel;
+    int32_t mCryptCostPerTile;
+    int32_t mCryptRotNbTurns;
+    double mCryptBonusWallActiveSpot;
+    int32_t mCryptPointsForSpawn;
+    std::string mCryptSpawnClass;
+    int32_t mWorkshopCostPerTile;
+    double mWorkshopPointsPerWork;
+    double mWorkshopWakefulnessPerWork;
+    uint32_t mWorkshopCooldownWorkMin;
+    uint32_t mWorkshopCooldownWorkMax;
+    int32_t mTreasuryCostPerTile;
+    int32_t mDormitoryCostPerTile;
+    int32_t mLibraryCostPerTile;
+    double mLibraryPointsPerWork;
+    double mLibraryWakefulnessPerWork;
+    uint32_t mLibraryCooldownWorkMin;
+    uint32_t mLibraryCooldownWorkMax;
+    int32_t mLibrarySkillPointsBook;
+    uint32_t mPortalCooldownSpawnMin;
+    uint32_t mPortalCooldownSpawnMax;
+    int32_t mPrisonCostPerTile;
+    double mPrisonDamagePerTurn;
+    std::string mPrisonSpawnClass;
+    int32_t mWoodenBridgeCostPerTile;
+    int32_t mStoneBridgeCostPerTile;
+    int32_t mArenaCostPerTile;
+    uint32_t mArenaMaxTrainingLevel;
+    int32_t mCasinoCostPerTile;
+    double mCasinoWakefulnessPerWork;
+    uint32_t mCasinoCooldownWorkMin;
+    uint32_t mCasinoCooldownWorkMax;
+    int32_t mCasinoBet;
+    double mCasinoFee;
+    int32_t mTortureCostPerTile;
+    double mTortureRallyPercent;
+    uint32_t mTortureSessionLengthMin;
+    uint32_t mTortureSessionLengthMax;
+    double mTortureDamagePerTurn;
+};
+
+//! \brief Values from traps.cfg. See the file header for the meaning of each parameter
+struct TrapsConfig : public ConfigParamRegistry
+{
+    TrapsConfig();
+
+    int32_t mBoulderCostPerTile;
+    int32_t mBoulderWorkshopPointsPerTile;
+    uint32_t mBoulderReloadTurns;
+    double mBoulderSpeed;
+    double mBoulderDamagePerHitMin;
+    double mBoulderDamagePerHitMax;
+    uint32_t mBoulderNbShootsBeforeDeactivation;
+    int32_t mCannonCostPerTile;
+    uint32_t mCannonPhyDef;
+    uint32_t mCannonMagDef;
+    uint32_t mCannonEleDef;
+    int32_t mCannonWorkshopPointsPerTile;
+    uint32_t mCannonRange;
+    double mCannonSpeed;
+    uint32_t mCannonReloadTurns;
+    double mCannonDamagePerHitMin;
+    double mCannonDamagePerHitMax;
+    uint32_t mCannonNbShootsBeforeDeactivation;
+    int32_t mSpikeCostPerTile;
+    int32_t mSpikeWorkshopPointsPerTile;
+    uint32_t mSpikeReloadTurns;
+    double mSpikeDamagePerHitMin;
+    double mSpikeDamagePerHitMax;
+    uint32_t mSpikeNbShootsBeforeDeactivation;
+    int32_t mWoodenDoorCostPerTile;
+    int32_t mWoodenDoorPointsPerTile;
+};
+
+//! \brief Values from spells.cfg. See the file header for the meaning of each parameter
+struct SpellsConfig : public ConfigParamRegistry
+{
+    SpellsConfig();
+
+    int32_t mSummonWorkerNbFree;
+    int32_t mSummonWorkerBasePrice;
+    uint32_t mSummonWorkerCooldown;
+    int32_t mCallToWarPrice;
+    int32_t mCallToWarNbTurnsMax;
+    uint32_t mCallToWarCooldown;
+    int32_t mCreatureExplosionPrice;
+    uint32_t mCreatureExplosionDuration;
+    double mCreatureExplosionValue;
+    uint32_t mCreatureExplosionCooldown;
+    int32_t mCreatureHastePrice;
+    uint32_t mCreatureHasteDuration;
+    double mCreatureHasteValue;
+    uint32_t mCreatureHasteCooldown;
+    int32_t mCreatureDefensePrice;
+    uint32_t mCreatureDefenseDuration;
+    double mCreatureDefenseValue;
+    uint32_t mCreatureDefenseCooldown;
+    int32_t mCreatureHealPrice;
+    uint32_t mCreatureHealDuration;
+    double mCreatureHealValue;
+    uint32_t mCreatureHealCooldown;
+    int32_t mCreatureSlowPrice;
+    uint32_t mCreatureSlowDuration;
+    double mCreatureSlowValue;
+    uint32_t mCreatureSlowCooldown;
+    int32_t mCreatureStrengthPrice;
+    uint32_t mCreatureStrengthDuration;
+    double mCreatureStrengthValue;
+    uint32_t mCreatureStrengthCooldown;
+    int32_t mCreatureWeakPrice;
+    uint32_t mCreatureWeakDuration;
+    double mCreatureWeakValue;
+    uint32_t mCreatureWeakCooldown;
+    int32_t mEyeEvilPrice;
+    uint32_t mEyeEvilRadiusTiles;
+    int32_t mEyeEvilNbTurns;
+    uint32_t mEyeEvilCooldown;
+};
+
+#endif // CONFIGPARAMS_H
@@ -17,88 +17,322 @@
 
 #include "utils/LogManager.h"
 
-#include <boost/filesystem.hpp>
-
-#include <iomanip>
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
 
 template<> LogManager* Ogre::Singleton<LogManager>::msSingleton = nullptr;
 
 //! \brief Log filename used when OD Application throws errors without using Ogre default logger.
 const std::string LogManager::GAMELOG_NAME = "gameLog";
 
-LogManager::LogManager()
-    : mLevel(LogMessageLevel::NORMAL)
+constexpr uint32_t LogManager::MODULE_ID_SEED;
+constexpr uint32_t LogManager::MODULE_ID_PRIME;
+
+namespace
 {
+    //! \brief Number of messages each thread can push before the writer thread drains them.
+    //! Must be a power of 2
+    const uint32_t RING_BUFFER_SIZE = 1024;
+
+    //! \brief How long the writer thread waits when there is nothing to write
+    const int32_t WRITER_SLEEP_MS = 10;
 
+    std::atomic<uint64_t> gNextInstanceId(1);
+
+    //! \brief Set while the current thread is writing to the sinks. Sinks may log too and,
+    //! in this case, we must not wait for the ring buffer to be drained
+    thread_local bool tlsDraining = false;
 }
 
-LogManager::~LogManager()
+//! \brief Single producer/single consumer lock-free queue. The producer is the thread owning
+//! the ring buffer. The consumer is the thread holding the LogManager drain lock.
+class LogRingBuffer
 {
+public:
+    LogRingBuffer() :
+        mEntries(RING_BUFFER_SIZE),
+        mHead(0),
+        mTail(0),
+        mIsOwnerExited(false)
+    {}
+
+    //! \brief Returns false if the ring buffer is full. Otherwise, the entry takes the next sequence
+    //! number. It is taken only once we know the entry will be pushed so that no number is lost
+    bool push(LogEntry& entry, std::atomic<uint64_t>& nextSequence)
+    {
+        uint32_t head = mHead.load(std::memory_order_relaxed);
+        if(head - mTail.load(std::memory_order_acquire) >= RING_BUFFER_SIZE)
+            return false;
+
+        entry.mSequence = nextSequence.fetch_add(1, std::memory_order_relaxed);
+        std::swap(mEntries[head & (RING_BUFFER_SIZE - 1)], entry);
+        mHead.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    //! \brief Moves the pending entries to the given vector
+    void popAll(std::vector<LogEntry>& entries)
+    {
+        uint32_t tail = mTail.load(std::memory_order_relaxed);
+        uint32_t head = mHead.load(std::memory_order_acquire);
+        for(; tail != head; ++tail)
+        {
+            entries.push_back(LogEntry());
+            std::swap(entries.back(), mEntries[tail & (RING_BUFFER_SIZE - 1)]);
+        }
+        mTail.store(tail, std::memory_order_release);
+    }
+
+    //! \brief Called when the owner thread exits. Nothing will be pushed anymore
+    void setOwnerExited()
+    {
+        mIsOwnerExited.store(true, std::memory_order_release);
+    }
 
+    bool isOwnerExited() const
+    {
+        return mIsOwnerExited.load(std::memory_order_acquire);
+    }
+
+private:
+    std::vector<LogEntry> mEntries;
+    std::atomic<uint32_t> mHead;
+    std::atomic<uint32_t> mTail;
+    std::atomic<bool> mIsOwnerExited;
+};
+
+namespace
+{
+    //! \brief Ring buffer of the current thread and the LogManager instance it belongs to. When the
+    //! thread exits, the ring buffer is flagged so that the LogManager releases it once drained
+    class ThreadRingBuffer
+    {
+    public:
+        ThreadRingBuffer() :
+            mOwner(0)
+        {}
+
+        ~ThreadRingBuffer()
+        {
+            release();
+        }
+
+        void release()
+        {
+            if(mRingBuffer == nullptr)
+                return;
+
+            mRingBuffer->setOwnerExited();
+            mRingBuffer.reset();
+        }
+
+        uint64_t mOwner;
+        std::shared_ptr<LogRingBuffer> mRingBuffer;
+    };
+
+    thread_local ThreadRingBuffer tlsRingBuffer;
+}
+
+LogManager::LogManager() :
+    mLevel(LogMessageLevel::NORMAL),
+    mHasModuleLevels(false),
+    mInstanceId(gNextInstanceId.fetch_add(1)),
+    mNextSequence(0),
+    mNextSequenceToWrite(0),
+    mLastTimestampTime(0),
+    mWriterRunning(true),
+    mWriterThread(&LogManager::writerThread, this)
+{
+    mWriterThread.launch();
+}
+
+LogManager::~LogManager()
+{
+    mWriterRunning.store(false);
+    mWriterThread.wait();
+    drain(true);
 }
 
 void LogManager::addSink(std::unique_ptr<LogSink> sink)
 {
+    sf::Lock lock(mDrainLock);
     mSinks.push_back(std::move(sink));
 }
 
 void LogManager::setLevel(LogMessageLevel level)
 {
-    mLevel = level;
+    mLevel.store(level);
 }
 
 void LogManager::setModuleLevel(const char* module, LogMessageLevel level)
 {
-    mModuleLevel[module] = level;
+    sf::Lock lock(mModuleLevelLock);
+    mModuleLevel[getModuleId(module)] = level;
+    mHasModuleLevels.store(true);
 }
 
-void LogManager::logMessage(LogMessageLevel level, const char* filepath, int line, const std::string& message)
+bool LogManager::isLoggedByModule(LogMessageLevel level, uint32_t moduleId) const
 {
-    sf::Lock locked(mLock);
-
-    // module
+    // Allow per-module overrides of the global logging level.
+    sf::Lock lock(mModuleLevelLock);
+    auto found = mModuleLevel.find(moduleId);
+    if (found == mModuleLevel.end())
+        return false;
 
-    const boost::filesystem::path strippedPath(filepath);
-    std::string module = strippedPath.stem().string();
+    return found->second <= level;
+}
 
-    // Check if the message fails the global threshold.
+LogRingBuffer& LogManager::getThreadRingBuffer()
+{
+    if((tlsRingBuffer.mRingBuffer != nullptr) && (tlsRingBuffer.mOwner == mInstanceId))
+        return *tlsRingBuffer.mRingBuffer;
 
-    if (mLevel > level)
+    // If the thread used a previous LogManager, its ring buffer can be released
+    tlsRingBuffer.release();
+    std::shared_ptr<LogRingBuffer> ringBuffer = std::make_shared<LogRingBuffer>();
     {
-        // Allow per-module overrides of the global logging level.
+        sf::Lock lock(mRingBuffersLock);
+        mRingBuffers.push_back(ringBuffer);
+    }
+    tlsRingBuffer.mOwner = mInstanceId;
+    tlsRingBuffer.mRingBuffer = ringBuffer;
+    return *ringBuffer;
+}
 
-        if (mModuleLevel.empty())
-        {
+void LogManager::logMessage(LogMessageLevel level, uint32_t moduleId, const char* filepath, int line, std::string message)
+{
+    LogEntry entry;
+    entry.mLevel = level;
+    entry.mFilepath = filepath;
+    entry.mLine = line;
+    entry.mTime = ::time(0);
+    std::swap(entry.mMessage, message);
+
+    LogRingBuffer& ringBuffer = getThreadRingBuffer();
+    while(!ringBuffer.push(entry, mNextSequence))
+    {
+        // If we are writing to the sinks, nobody else can drain the ring buffer
+        if(tlsDraining)
             return;
-        }
 
-        auto found = mModuleLevel.find(module);
-        if (found == mModuleLevel.end() ||
-            found->second > level)
+        drain(false);
+    }
+
+    // Critical messages are written right away in case the game is about to crash
+    if((level >= LogMessageLevel::CRITICAL) && !tlsDraining)
+        drain(false);
+}
+
+void LogManager::logMessage(LogMessageLevel level, const char* filepath, int line, const std::string& message)
+{
+    uint32_t moduleId = getModuleId(filepath);
+    if(!isLogged(level, moduleId))
+        return;
+
+    logMessage(level, moduleId, filepath, line, message);
+}
+
+void LogManager::flush()
+{
+    if(tlsDraining)
+        return;
+
+    drain(false);
+}
+
+uint32_t LogManager::drain(bool writeAll)
+{
+    sf::Lock lock(mDrainLock);
+    tlsDraining = true;
+
+    {
+        sf::Lock lockRingBuffers(mRingBuffersLock);
+        auto it = mRingBuffers.begin();
+        while(it != mRingBuffers.end())
         {
-            return;
+            // If the owner thread exited before we pop, nothing can be pushed after
+            LogRingBuffer& ringBuffer = **it;
+            bool isOwnerExited = ringBuffer.isOwnerExited();
+            ringBuffer.popAll(mPendingEntries);
+            if(isOwnerExited)
+                it = mRingBuffers.erase(it);
+            else
+                ++it;
         }
     }
 
-    // filename
+    // Messages from different threads are written in the order they were logged. A thread may have
+    // taken a sequence number without having pushed its entry yet. In this case, we keep the
+    // following entries for the next drain
+    std::sort(mPendingEntries.begin(), mPendingEntries.end(),
+        [](const LogEntry& a, const LogEntry& b) { return a.mSequence < b.mSequence; });
 
-    std::string filename = strippedPath.filename().string();
+    std::size_t nbEntries = 0;
+    for(; nbEntries < mPendingEntries.size(); ++nbEntries)
+    {
+        const LogEntry& entry = mPendingEntries[nbEntries];
+        if(!writeAll && (entry.mSequence != mNextSequenceToWrite))
+            break;
 
-    // timestamp
+        mNextSequenceToWrite = entry.mSequence + 1;
+    }
 
-    time_t current_time = ::time(0);
-    struct tm* now = ::localtime(&current_time);
+    if(nbEntries == 0)
+    {
+        tlsDraining = false;
+        return 0;
+    }
 
-    mTimestampStream.str("");
-    mTimestampStream
-        << std::setfill('0') << std::setw(2) << now->tm_hour << ':'
-        << std::setfill('0') << std::setw(2) << now->tm_min << ':'
-        << std::setfill('0') << std::setw(2) << now->tm_sec;
+    for(std::size_t i = 0; i < nbEntries; ++i)
+    {
+        const LogEntry& entry = mPendingEntries[i];
+        // module and filename
+        auto it = mModuleNames.find(entry.mFilepath);
+        if(it == mModuleNames.end())
+        {
+            const char* filename = entry.mFilepath;
+            for(const char* c = entry.mFilepath; *c != '\0'; ++c)
+            {
+                if((*c == '/') || (*c == '\\'))
+                    filename = c + 1;
+            }
+            const char* extension = std::strchr(filename, '.');
+            std::string module = (extension != nullptr) ? std::string(filename, extension) : std::string(filename);
+            it = mModuleNames.emplace(entry.mFilepath, std::make_pair(module, std::string(filename))).first;
+        }
 
-    std::string timestamp = mTimestampStream.str();
+        // timestamp
+        if((entry.mTime != mLastTimestampTime) || mLastTimestamp.empty())
+        {
+            mLastTimestampTime = entry.mTime;
+            struct tm* now = ::localtime(&entry.mTime);
+            char timestamp[16];
+            std::snprintf(timestamp, sizeof(timestamp), "%02d:%02d:%02d", now->tm_hour, now->tm_min, now->tm_sec);
+            mLastTimestamp = timestamp;
+        }
+
+        for (const auto& sink : mSinks)
+        {
+            sink->write(entry.mLevel, it->second.first, mLastTimestamp, it->second.second, entry.mLine, entry.mMessage);
+        }
+    }
 
     for (const auto& sink : mSinks)
     {
-        sink->write(level, module, timestamp, filename, line, message);
+        sink->flush();
+    }
+
+    mPendingEntries.erase(mPendingEntries.begin(), mPendingEntries.begin() + nbEntries);
+    tlsDraining = false;
+    return static_cast<uint32_t>(nbEntries);
+}
+
+void LogManager::writerThread()
+{
+    while(mWriterRunning.load())
+    {
+        if(drain(false) == 0)
+            sf::sleep(sf::milliseconds(WRITER_SLEEP_MS));
     }
 }
@@ -18,8 +18,14 @@
 #ifndef LOGMANAGER_H
 #define LOGMANAGER_H
 
+#include <atomic>
+#include <cstdint>
+#include <ctime>
+#include <map>
 #include <memory>
 #include <string>
+#include <type_traits>
+#include <vector>
 
 #include <SFML/System.hpp>
 
@@ -29,15 +35,47 @@
 #include "utils/LogMessageLevel.h"
 #include "utils/LogSink.h"
 
-#define OD_LOG_ERR(_message)                      LogManager::getSingleton().logMessage(LogMessageLevel::CRITICAL, __FILE__, __LINE__, (std::string("") + _message))
-#define OD_LOG_WRN(_message)                      LogManager::getSingleton().logMessage(LogMessageLevel::WARNING, __FILE__, __LINE__, (std::string("") + _message))
-#define OD_LOG_INF(_message)                      LogManager::getSingleton().logMessage(LogMessageLevel::NORMAL, __FILE__, __LINE__, (std::string("") + _message))
-#define OD_LOG_DBG(_message)                      LogManager::getSingleton().logMessage(LogMessageLevel::TRIVIAL, __FILE__, __LINE__, (std::string("") + _message))
+//! \brief Id of the module (source file name without extension) computed at compile time
+#define OD_LOG_MODULE_ID                          (std::integral_constant<uint32_t, LogManager::getModuleId(__FILE__)>::value)
 
-#define OD_ASSERT_TRUE(_condition)                if (!(_condition)) LogManager::getSingleton().logMessage(LogMessageLevel::CRITICAL, __FILE__, __LINE__, std::string(#_condition))
-#define OD_ASSERT_TRUE_MSG(_condition, _message)  if (!(_condition)) LogManager::getSingleton().logMessage(LogMessageLevel::CRITICAL, __FILE__, __LINE__, (std::string("") + _message))
+//! \brief The level is checked before the message is built so that filtered messages cost nothing
+#define OD_LOG_MSG(_level, _message)              do { LogManager& odLogMgr = LogManager::getSingleton(); \
+                                                       if (odLogMgr.isLogged(_level, OD_LOG_MODULE_ID)) \
+                                                           odLogMgr.logMessage(_level, OD_LOG_MODULE_ID, __FILE__, __LINE__, (std::string("") + _message)); \
+                                                     } while(0)
 
-//! \brief Helper/wrapper class to provide thread-safe logging when ogre is compiled without threads.
+#define OD_LOG_ERR(_message)                      OD_LOG_MSG(LogMessageLevel::CRITICAL, _message)
+#define OD_LOG_WRN(_message)                      OD_LOG_MSG(LogMessageLevel::WARNING, _message)
+#define OD_LOG_INF(_message)                      OD_LOG_MSG(LogMessageLevel::NORMAL, _message)
+#define OD_LOG_DBG(_message)                      OD_LOG_MSG(LogMessageLevel::TRIVIAL, _message)
+
+#define OD_ASSERT_TRUE(_condition)                if (!(_condition)) LogManager::getSingleton().logMessage(LogMessageLevel::CRITICAL, OD_LOG_MODULE_ID, __FILE__, __LINE__, std::string(#_condition))
+#define OD_ASSERT_TRUE_MSG(_condition, _message)  if (!(_condition)) LogManager::getSingleton().logMessage(LogMessageLevel::CRITICAL, OD_LOG_MODULE_ID, __FILE__, __LINE__, (std::string("") + _message))
+
+class LogRingBuffer;
+
+//! \brief A message waiting to be written by the LogManager
+struct LogEntry
+{
+    LogEntry() :
+        mSequence(0),
+        mLevel(LogMessageLevel::TRIVIAL),
+        mFilepath(nullptr),
+        mLine(0),
+        mTime(0)
+    {}
+
+    uint64_t mSequence;
+    LogMessageLevel mLevel;
+    const char* mFilepath;
+    int mLine;
+    time_t mTime;
+    std::string mMessage;
+};
+
+//! \brief Thread-safe logging. Each thread pushes its messages in its own lock-free ring
+//! buffer and a background thread drains them and writes them to the sinks in batches.
+//! Critical messages are written synchronously so that they are not lost if the game crashes.
 class LogManager : public Ogre::Singleton<LogManager>
 {
 public:
@@ -53,19 +91,93 @@ public:
     //! \brief Set the minimum logging level per module.
     void setModuleLevel(const char* module, LogMessageLevel level);
 
-    //! \brief Log a message to the sinks.
+    //! \brief Returns true if a message with the given level from the given module would be logged.
+    inline bool isLogged(LogMessageLevel level, uint32_t moduleId) const
+    {
+        if (level >= mLevel.load(std::memory_order_relaxed))
+            return true;
+
+        if (!mHasModuleLevels.load(std::memory_order_relaxed))
+            return false;
+
+        return isLoggedByModule(level, moduleId);
+    }
+
+    //! \brief Log a message to the sinks. The level is expected to have been checked with isLogged.
+    void logMessage(LogMessageLevel level, uint32_t moduleId, const char* filepath, int line, std::string message);
+
+    //! \brief Log a message to the sinks. The module id is computed from the file path.
     void logMessage(LogMessageLevel level, const char* filepath, int line, const std::string& message);
 
+    //! \brief Writes every pending message to the sinks before returning.
+    void flush();
+
+    //! \brief Computes the module id from the given path. The module is the file name without
+    //! extension. It is a hash so that it can be computed at compile time from __FILE__.
+    static constexpr uint32_t getModuleId(const char* path)
+    {
+        return getModuleIdHash(path, MODULE_ID_SEED, false);
+    }
+
     static const std::string GAMELOG_NAME;
 private:
     LogManager(const LogManager&) = delete;
     LogManager& operator=(const LogManager&) = delete;
 
-    LogMessageLevel mLevel;
-    std::map<std::string, LogMessageLevel> mModuleLevel;
-    sf::Mutex mLock;
+    //! \brief FNV-1a hash of the file name that restarts on each path separator and stops
+    //! at the extension
+    static constexpr uint32_t MODULE_ID_SEED = 2166136261u;
+    static constexpr uint32_t MODULE_ID_PRIME = 16777619u;
+    static constexpr uint32_t getModuleIdHash(const char* str, uint32_t hash, bool inExtension)
+    {
+        return (*str == '\0') ? hash :
+            ((*str == '/') || (*str == '\\')) ? getModuleIdHash(str + 1, MODULE_ID_SEED, false) :
+            (inExtension || (*str == '.')) ? getModuleIdHash(str + 1, hash, true) :
+            getModuleIdHash(str + 1, (hash ^ static_cast<uint8_t>(*str)) * MODULE_ID_PRIME, false);
+    }
+
+    bool isLoggedByModule(LogMessageLevel level, uint32_t moduleId) const;
+
+    //! \brief Returns the ring buffer of the calling thread. It is created if needed.
+    LogRingBuffer& getThreadRingBuffer();
+
+    //! \brief Writes the pending messages from every thread to the sinks. Returns the number
+    //! of messages written. Messages are written in sequence order. Unless writeAll is true, a
+    //! message is kept for the next drain if a previous sequence number was not pushed yet.
+    //! Ring buffers of exited threads are released once empty.
+    uint32_t drain(bool writeAll);
+
+    void writerThread();
+
+    std::atomic<LogMessageLevel> mLevel;
+    std::atomic<bool> mHasModuleLevels;
+    mutable sf::Mutex mModuleLevelLock;
+    std::map<uint32_t, LogMessageLevel> mModuleLevel;
+
+    //! \brief Unique id for this instance. It allows threads to know if their ring buffer
+    //! belongs to this LogManager
+    const uint64_t mInstanceId;
+
+    //! \brief Used to order the messages coming from different threads
+    std::atomic<uint64_t> mNextSequence;
+
+    //! \brief Sequence number of the next message to write. Protected by mDrainLock
+    uint64_t mNextSequenceToWrite;
+
+    //! \brief Shared with the threads so that a ring buffer outlives its thread until drained
+    sf::Mutex mRingBuffersLock;
+    std::vector<std::shared_ptr<LogRingBuffer>> mRingBuffers;
+
+    //! \brief Protects the sinks and the draining of the ring buffers
+    sf::Mutex mDrainLock;
     std::vector<std::unique_ptr<LogSink>> mSinks;
-    std::stringstream mTimestampStream;
+    std::vector<LogEntry> mPendingEntries;
+    std::map<const char*, std::pair<std::string, std::string>> mModuleNames;
+    time_t mLastTimestampTime;
+    std::string mLastTimestamp;
+
+    std::atomic<bool> mWriterRunning;
+    sf::Thread mWriterThread;
 };
 
 #endif // LOGMANAGER_H
@@ -48,7 +48,7 @@ void LogSinkConsole::write(LogMessageLevel level, const std::string& module, con
 
     ss
         << message
-        << std::endl;
+        << '\n';
 
     if (level >= LogMessageLevel::WARNING)
         std::cerr << ss.str();
@@ -59,3 +59,9 @@ void LogSinkConsole::write(LogMessageLevel level, const std::string& module, con
     ::OutputDebugStringA(ss.str().c_str());
 #endif
 }
+
+void LogSinkConsole::flush()
+{
+    std::cout.flush();
+    std::cerr.flush();
+}
@@ -0,0 +1,216 @@
+/*
+ *  Copyright (C) 2011-2016  OpenDungeons Team
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "utils/Metrics.h"
+
+#include <SFML/System.hpp>
+
+#include <cstdio>
+#include <map>
+
+namespace
+{
+    const double MICRO_PER_UNIT = 1000000.0;
+
+    //! \brief Bounds used for timers, in milliseconds
+    const std::vector<double> TIMER_BUCKET_BOUNDS =
+        { 0.01, 0.05, 0.1, 0.5, 1.0, 5.0, 10.0, 50.0, 100.0, 500.0, 1000.0 };
+
+    //! \brief Metrics are never deleted so that references kept in function local statics stay valid
+    struct Registry
+    {
+        sf::Mutex mLock;
+        std::map<std::string, std::unique_ptr<Metrics::Counter>> mCounters;
+        std::map<std::string, std::unique_ptr<Metrics::Histogram>> mHistograms;
+    };
+
+    Registry& getRegistry()
+    {
+        static Registry registry;
+        return registry;
+    }
+
+    std::string formatValue(double value)
+    {
+        char buffer[32];
+        std::snprintf(buffer, sizeof(buffer), "%.6g", value);
+        return buffer;
+    }
+
+    std::string formatCount(uint64_t value)
+    {
+        char buffer[32];
+        std::snprintf(buffer, sizeof(buffer), "%llu", static_cast<unsigned long long>(value));
+        return buffer;
+    }
+
+    void exportHeader(std::string& out, const std::string& name, const std::string& help, const char* type)
+    {
+        out += "# HELP " + name + " " + help + "\n";
+        out += "# TYPE " + name + " " + type + "\n";
+    }
+}
+
+namespace Metrics
+{
+
+Counter::Counter(const std::string& name, const std::string& help) :
+    mName(name),
+    mHelp(help),
+    mValue(0),
+    mLastTurnValue(0),
+    mValueAtTurnStart(0)
+{
+}
+
+void Counter::endTurn()
+{
+    uint64_t value = getValue();
+    mLastTurnValue.store(value - mValueAtTurnStart, std::memory_order_relaxed);
+    mValueAtTurnStart = value;
+}
+
+Histogram::Histogram(const std::string& name, const std::string& help, const std::vector<double>& bucketBounds) :
+    mName(name),
+    mHelp(help),
+    mBucketBounds(bucketBounds),
+    mBuckets(new std::atomic<uint64_t>[bucketBounds.size() + 1]),
+    mCount(0),
+    mSumMicro(0),
+    mLastTurnCount(0),
+    mLastTurnSumMicro(0),
+    mCountAtTurnStart(0),
+    mSumMicroAtTurnStart(0)
+{
+    for(uint32_t i = 0; i <= mBucketBounds.size(); ++i)
+        mBuckets[i].store(0);
+}
+
+void Histogram::observe(double value)
+{
+    uint32_t index = 0;
+    while((index < mBucketBounds.size()) && (value > mBucketBounds[index]))
+        ++index;
+
+    mBuckets[index].fetch_add(1, std::memory_order_relaxed);
+    mCount.fetch_add(1, std::memory_order_relaxed);
+    if(value > 0.0)
+        mSumMicro.fetch_add(static_cast<uint64_t>(value * MICRO_PER_UNIT), std::memory_order_relaxed);
+}
+
+double Histogram::getSum() const
+{
+    return static_cast<double>(mSumMicro.load(std::memory_order_relaxed)) / MICRO_PER_UNIT;
+}
+
+uint64_t Histogram::getBucketCount(uint32_t index) const
+{
+    if(index > mBucketBounds.size())
+        return 0;
+
+    return mBuckets[index].load(std::memory_order_relaxed);
+}
+
+double Histogram::getLastTurnSum() const
+{
+    return static_cast<double>(mLastTurnSumMicro.load(std::memory_order_relaxed)) / MICRO_PER_UNIT;
+}
+
+void Histogram::endTurn()
+{
+    uint64_t count = getCount();
+    uint64_t sumMicro = mSumMicro.load(std::memory_order_relaxed);
+    mLastTurnCount.store(count - mCountAtTurnStart, std::memory_order_relaxed);
+    mLastTurnSumMicro.store(sumMicro - mSumMicroAtTurnStart, std::memory_order_relaxed);
+    mCountAtTurnStart = count;
+    mSumMicroAtTurnStart = sumMicro;
+}
+
+Counter& getCounter(const std::string& name, const std::string& help)
+{
+    Registry& registry = getRegistry();
+    sf::Lock lock(registry.mLock);
+    std::unique_ptr<Counter>& counter = registry.mCounters[name];
+    if(counter == nullptr)
+        counter.reset(new Counter(name, help));
+
+    return *counter;
+}
+
+Histogram& getTimerHistogram(const std::string& name, const std::string& help)
+{
+    Registry& registry = getRegistry();
+    sf::Lock lock(registry.mLock);
+    std::unique_ptr<Histogram>& histogram = registry.mHistograms[name];
+    if(histogram == nullptr)
+        histogram.reset(new Histogram(name, help, TIMER_BUCKET_BOUNDS));
+
+    return *histogram;
+}
+
+void endTurn()
+{
+    Registry& registry = getRegistry();
+    sf::Lock lock(registry.mLock);
+    for(std::pair<const std::string, std::unique_ptr<Counter>>& p : registry.mCounters)
+        p.second->endTurn();
+
+    for(std::pair<const std::string, std::unique_ptr<Histogram>>& p : registry.mHistograms)
+        p.second->endTurn();
+}
+
+std::string exportText()
+{
+    Registry& registry = getRegistry();
+    sf::Lock lock(registry.mLock);
+    std::string out;
+    for(const std::pair<const std::string, std::unique_ptr<Counter>>& p : registry.mCounters)
+    {
+        const Counter& counter = *p.second;
+        exportHeader(out, counter.getName() + "_total", counter.getHelp(), "counter");
+        out += counter.getName() + "_total " + formatCount(counter.getValue()) + "\n";
+        exportHeader(out, counter.getName() + "_last_turn", counter.getHelp() + " (last turn)", "gauge");
+        out += counter.getName() + "_last_turn " + formatCount(counter.getLastTurnValue()) + "\n";
+    }
+
+    for(const std::pair<const std::string, std::unique_ptr<Histogram>>& p : registry.mHistograms)
+    {
+        const Histogram& histogram = *p.second;
+        const std::string& name = histogram.getName();
+        exportHeader(out, name, histogram.getHelp(), "histogram");
+        const std::vector<double>& bounds = histogram.getBucketBounds();
+        uint64_t cumulativeCount = 0;
+        for(uint32_t i = 0; i < bounds.size(); ++i)
+        {
+            cumulativeCount += histogram.getBucketCount(i);
+            out += name + "_bucket{le=\"" + formatValue(bounds[i]) + "\"} " + formatCount(cumulativeCount) + "\n";
+        }
+        cumulativeCount += histogram.getBucketCount(static_cast<uint32_t>(bounds.size()));
+        out += name + "_bucket{le=\"+Inf\"} " + formatCount(cumulativeCount) + "\n";
+        out += name + "_sum " + formatValue(histogram.getSum()) + "\n";
+        out += name + "_count " + formatCount(cumulativeCount) + "\n";
+
+        exportHeader(out, name + "_last_turn_sum", histogram.getHelp() + " (sum over last turn)", "gauge");
+        out += name + "_last_turn_sum " + formatValue(histogram.getLastTurnSum()) + "\n";
+        exportHeader(out, name + "_last_turn_count", histogram.getHelp() + " (count over last turn)", "gauge");
+        out += name + "_last_turn_count " + formatCount(histogram.getLastTurnCount()) + "\n";
+    }
+
+    return out;
+}
+
+}
@@ -0,0 +1,161 @@
+/*
+ *  Copyright (C) 2011-2016  OpenDungeons Team
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef METRICS_H
+#define METRICS_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+//! \brief Lightweight performance counters. Metrics are created once (usually as function
+//! local statics) and updated with relaxed atomics so that they can be placed in hot code.
+//! Values are aggregated in total and per turn and can be exported in the Prometheus text format.
+//! Example:
+//! \code
+//! static Metrics::Counter& calls = Metrics::getCounter("od_gamemap_path_calls", "Calls to GameMap::path");
+//! calls.increment();
+//! \endcode
+namespace Metrics
+{
+    //! \brief Monotonic counter
+    class Counter
+    {
+    public:
+        Counter(const std::string& name, const std::string& help);
+
+        inline void increment(uint64_t value = 1)
+        { mValue.fetch_add(value, std::memory_order_relaxed); }
+
+        inline uint64_t getValue() const
+        { return mValue.load(std::memory_order_relaxed); }
+
+        //! \brief Returns how much the counter was incremented during the last finished turn
+        inline uint64_t getLastTurnValue() const
+        { return mLastTurnValue.load(std::memory_order_relaxed); }
+
+        inline const std::string& getName() const
+        { return mName; }
+
+        inline const std::string& getHelp() const
+        { return mHelp; }
+
+        //! \brief Called by Metrics::endTurn
+        void endTurn();
+
+    private:
+        std::string mName;
+        std::string mHelp;
+        std::atomic<uint64_t> mValue;
+        std::atomic<uint64_t> mLastTurnValue;
+        uint64_t mValueAtTurnStart;
+    };
+
+    //! \brief Distribution of values (durations in milliseconds for timers)
+    class Histogram
+    {
+    public:
+        //! \brief bucketBounds are the upper bounds of the buckets, in increasing order. A last
+        //! bucket with no upper bound is always added
+        Histogram(const std::string& name, const std::string& help, const std::vector<double>& bucketBounds);
+
+        void observe(double value);
+
+        inline uint64_t getCount() const
+        { return mCount.load(std::memory_order_relaxed); }
+
+        double getSum() const;
+
+        //! \brief Returns the number of values in the given bucket (not cumulative)
+        uint64_t getBucketCount(uint32_t index) const;
+
+        inline const std::vector<double>& getBucketBounds() const
+        { return mBucketBounds; }
+
+        inline uint64_t getLastTurnCount() const
+        { return mLastTurnCount.load(std::memory_order_relaxed); }
+
+        double getLastTurnSum() const;
+
+        inline const std::string& getName() const
+        { return mName; }
+
+        inline const std::string& getHelp() const
+        { return mHelp; }
+
+        //! \brief Called by Metrics::endTurn
+        void endTurn();
+
+    private:
+        std::string mName;
+        std::string mHelp;
+        std::vector<double> mBucketBounds;
+        //! \brief One more bucket than bounds
+        std::unique_ptr<std::atomic<uint64_t>[]> mBuckets;
+        std::atomic<uint64_t> mCount;
+        //! \brief The sum is stored in millionths so that it can be updated atomically
+        std::atomic<uint64_t> mSumMicro;
+        std::atomic<uint64_t> mLastTurnCount;
+        std::atomic<uint64_t> mLastTurnSumMicro;
+        uint64_t mCountAtTurnStart;
+        uint64_t mSumMicroAtTurnStart;
+    };
+
+    //! \brief Adds the time elapsed between its construction and its destruction (in milliseconds)
+    //! to the given histogram
+    class ScopedTimer
+    {
+    public:
+        explicit ScopedTimer(Histogram& histogram) :
+            mHistogram(histogram),
+            mStart(std::chrono::steady_clock::now())
+        {}
+
+        ~ScopedTimer()
+        {
+            std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - mStart;
+            mHistogram.observe(elapsed.count());
+        }
+
+    private:
+        ScopedTimer(const ScopedTimer&) = delete;
+        ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+        Histogram& mHistogram;
+        std::chrono::steady_clock::time_point mStart;
+    };
+
+    //! \brief Returns the counter with the given name. It is created if needed. The returned
+    //! reference stays valid until the end of the program
+    Counter& getCounter(const std::string& name, const std::string& help);
+
+    //! \brief Returns the histogram with the given name. It is created if needed with buckets
+    //! suitable for durations in milliseconds
+    Histogram& getTimerHistogram(const std::string& name, const std::string& help);
+
+    //! \brief Computes the per turn values of every metric. Should be called once per turn
+    //! by the server
+    void endTurn();
+
+    //! \brief Returns every metric in the Prometheus text exposition format
+    std::string exportText();
+}
+
+#endif // METRICS_H
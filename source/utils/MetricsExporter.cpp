@@ -0,0 +1,222 @@
+/*
+ *  Copyright (C) 2011-2016  OpenDungeons Team
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "utils/MetricsExporter.h"
+
+#include "utils/Helper.h"
+#include "utils/LogManager.h"
+#include "utils/Metrics.h"
+
+#include <SFML/Network.hpp>
+
+#include <boost/filesystem.hpp>
+
+#include <fstream>
+
+namespace
+{
+    //! \brief Clients that did not send their request after this number of updates are dropped
+    const uint32_t MAX_UPDATES_PENDING_CLIENT = 50;
+
+    //! \brief Max size of the HTTP request we accept
+    const std::size_t MAX_REQUEST_SIZE = 4096;
+}
+
+MetricsExporter::MetricsExporter(const std::string& filePath, uint32_t port, const std::string& address,
+        uint32_t fileExportPeriod) :
+    mFilePath(filePath),
+    mFileExportPeriod(fileExportPeriod),
+    mNbUpdatesSinceFileExport(0),
+    mLocalClientsOnly(true)
+{
+    if(port == 0)
+        return;
+
+    sf::IpAddress bindAddress(address);
+    if(bindAddress == sf::IpAddress::None)
+    {
+        OD_LOG_ERR("Invalid metrics address=" + address + ". Metrics will only be served locally");
+        bindAddress = sf::IpAddress::LocalHost;
+    }
+    mLocalClientsOnly = (bindAddress == sf::IpAddress::LocalHost);
+
+    mListener.reset(new sf::TcpListener);
+#if (SFML_VERSION_MAJOR > 2) || (SFML_VERSION_MINOR >= 5)
+    sf::Socket::Status status = mListener->listen(static_cast<unsigned short>(port), bindAddress);
+#else
+    // Older SFML versions can only listen on all interfaces. Remote clients are refused in acceptClients
+    sf::Socket::Status status = mListener->listen(static_cast<unsigned short>(port));
+#endif
+    if(status != sf::Socket::Done)
+    {
+        OD_LOG_ERR("Could not listen on metrics port=" + Helper::toString(port) + ", address=" + bindAddress.toString());
+        mListener.reset();
+        return;
+    }
+    mListener->setBlocking(false);
+    OD_LOG_INF("Metrics available on port=" + Helper::toString(port) + ", address=" + bindAddress.toString());
+}
+
+MetricsExporter::~MetricsExporter()
+{
+    if(mListener != nullptr)
+        mListener->close();
+}
+
+void MetricsExporter::update()
+{
+    if(!mFilePath.empty() && (++mNbUpdatesSinceFileExport >= mFileExportPeriod))
+    {
+        mNbUpdatesSinceFileExport = 0;
+        exportToFile();
+    }
+
+    if(mListener != nullptr)
+    {
+        acceptClients();
+        answerClients();
+    }
+}
+
+void MetricsExporter::exportToFile()
+{
+    // We write to a temporary file and rename it so that readers never see a partial file
+    std::string tmpPath = mFilePath + ".tmp";
+    {
+        std::ofstream file(tmpPath.c_str(), std::ios::out | std::ios::trunc);
+        if(!file.is_open())
+        {
+            OD_LOG_ERR("Could not write metrics file=" + tmpPath);
+            return;
+        }
+        file << Metrics::exportText();
+    }
+
+    boost::system::error_code ec;
+    boost::filesystem::rename(tmpPath, mFilePath, ec);
+    if(ec)
+        OD_LOG_ERR("Could not rename metrics file=" + tmpPath + " to " + mFilePath + ", error=" + ec.message());
+}
+
+void MetricsExporter::acceptClients()
+{
+    while(true)
+    {
+        std::unique_ptr<sf::TcpSocket> socket(new sf::TcpSocket);
+        if(mListener->accept(*socket) != sf::Socket::Done)
+            return;
+
+        // Unless configured otherwise, metrics are only served locally
+        if(mLocalClientsOnly && (socket->getRemoteAddress() != sf::IpAddress::LocalHost))
+        {
+            OD_LOG_WRN("Refused metrics connection from " + socket->getRemoteAddress().toString());
+            socket->disconnect();
+            continue;
+        }
+
+        socket->setBlocking(false);
+        PendingClient client;
+        client.mSocket = std::move(socket);
+        client.mNbBytesSent = 0;
+        client.mNbUpdates = 0;
+        mPendingClients.push_back(std::move(client));
+    }
+}
+
+void MetricsExporter::answerClients()
+{
+    auto it = mPendingClients.begin();
+    while(it != mPendingClients.end())
+    {
+        PendingClient& client = *it;
+        if(++client.mNbUpdates > MAX_UPDATES_PENDING_CLIENT)
+        {
+            client.mSocket->disconnect();
+            it = mPendingClients.erase(it);
+            continue;
+        }
+
+        if(!client.mResponse.empty())
+        {
+            if(sendResponse(client))
+            {
+                client.mSocket->disconnect();
+                it = mPendingClients.erase(it);
+                continue;
+            }
+            ++it;
+            continue;
+        }
+
+        char buffer[1024];
+        std::size_t received = 0;
+        sf::Socket::Status status = client.mSocket->receive(buffer, sizeof(buffer), received);
+        if(status == sf::Socket::Done)
+            client.mRequest.append(buffer, received);
+
+        if((status == sf::Socket::Disconnected) ||
+           (status == sf::Socket::Error) ||
+           (client.mRequest.size() > MAX_REQUEST_SIZE))
+        {
+            client.mSocket->disconnect();
+            it = mPendingClients.erase(it);
+            continue;
+        }
+
+        if(client.mRequest.find("\r\n\r\n") == std::string::npos)
+        {
+            ++it;
+            continue;
+        }
+
+        std::string body = Metrics::exportText();
+        client.mResponse = "HTTP/1.0 200 OK\r\n"
+            "Content-Type: text/plain; version=0.0.4\r\n"
+            "Content-Length: " + Helper::toString(static_cast<uint32_t>(body.size())) + "\r\n"
+            "Connection: close\r\n\r\n" + body;
+
+        if(sendResponse(client))
+        {
+            client.mSocket->disconnect();
+            it = mPendingClients.erase(it);
+            continue;
+        }
+        ++it;
+    }
+}
+
+bool MetricsExporter::sendResponse(PendingClient& client)
+{
+#if (SFML_VERSION_MAJOR > 2) || (SFML_VERSION_MINOR >= 3)
+    // If the socket buffer is full, we send the remaining data at the next update
+    std::size_t sent = 0;
+    sf::Socket::Status status = client.mSocket->send(client.mResponse.c_str() + client.mNbBytesSent,
+        client.mResponse.size() - client.mNbBytesSent, sent);
+    client.mNbBytesSent += sent;
+    if((status == sf::Socket::Partial) || (status == sf::Socket::NotReady))
+        return false;
+
+    return true;
+#else
+    // Partial sends cannot be resumed with this SFML version. The response is small so we send it
+    // in blocking mode
+    client.mSocket->setBlocking(true);
+    client.mSocket->send(client.mResponse.c_str(), client.mResponse.size());
+    client.mNbBytesSent = client.mResponse.size();
+    return true;
+#endif
+}
@@ -0,0 +1,79 @@
+/*
+ *  Copyright (C) 2011-2016  OpenDungeons Team
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef METRICSEXPORTER_H
+#define METRICSEXPORTER_H
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace sf
+{
+class TcpListener;
+class TcpSocket;
+}
+
+//! \brief Periodically exports the metrics (see Metrics.h) from the server. They can be written to a
+//! file and/or served over HTTP so that they can be scraped by Prometheus or read with curl. By default,
+//! the HTTP listener only accepts local clients. Everything is done from the server thread without blocking.
+//! Note that with SFML < 2.3, the response is sent in blocking mode because partial sends cannot be resumed
+class MetricsExporter
+{
+public:
+    //! \brief filePath is the file to write (empty to disable). port is the port to listen on (0 to
+    //! disable) and address the address to bind it to. Clients from other hosts are only accepted if address
+    //! is not the loopback address. The file is written every fileExportPeriod calls to update
+    MetricsExporter(const std::string& filePath, uint32_t port, const std::string& address,
+        uint32_t fileExportPeriod);
+    ~MetricsExporter();
+
+    //! \brief To be called once per turn
+    void update();
+
+private:
+    MetricsExporter(const MetricsExporter&) = delete;
+    MetricsExporter& operator=(const MetricsExporter&) = delete;
+
+    struct PendingClient
+    {
+        std::unique_ptr<sf::TcpSocket> mSocket;
+        std::string mRequest;
+        //! \brief Empty until the request is complete
+        std::string mResponse;
+        std::size_t mNbBytesSent;
+        uint32_t mNbUpdates;
+    };
+
+    void exportToFile();
+    void acceptClients();
+    void answerClients();
+
+    //! \brief Sends what is left of the response. Returns true if the client is done (the whole response
+    //! was sent or an error occurred) and should be disconnected
+    bool sendResponse(PendingClient& client);
+
+    std::string mFilePath;
+    uint32_t mFileExportPeriod;
+    uint32_t mNbUpdatesSinceFileExport;
+    std::unique_ptr<sf::TcpListener> mListener;
+    bool mLocalClientsOnly;
+    std::vector<PendingClient> mPendingClients;
+};
+
+#endif // METRICSEXPORTER_H
@@ -0,0 +1,55 @@
+/*
+ *  Copyright (C) 2011-2016  OpenDungeons Team
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "utils/ObjectPool.h"
+
+#include <new>
+
+ObjectPoolFreeList::~ObjectPoolFreeList()
+{
+    while(mHead != nullptr)
+    {
+        FreeBlock* block = mHead;
+        mHead = block->mNext;
+        ::operator delete(block);
+    }
+}
+
+void* ObjectPoolFreeList::allocate()
+{
+    if(mHead == nullptr)
+        return ::operator new(mBlockSize);
+
+    FreeBlock* block = mHead;
+    mHead = block->mNext;
+    --mNbBlocks;
+    return block;
+}
+
+void ObjectPoolFreeList::release(void* block)
+{
+    if(mNbBlocks >= MAX_FREE_BLOCKS)
+    {
+        ::operator delete(block);
+        return;
+    }
+
+    FreeBlock* freeBlock = static_cast<FreeBlock*>(block);
+    freeBlock->mNext = mHead;
+    mHead = freeBlock;
+    ++mNbBlocks;
+}
@@ -0,0 +1,98 @@
+/*
+ *  Copyright (C) 2011-2016  OpenDungeons Team
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef OBJECTPOOL_H
+#define OBJECTPOOL_H
+
+#include <cstddef>
+#include <cstdint>
+
+//! \brief List of memory blocks of the same size that have been released and can be reused.
+//! Each thread has its own lists so that no locking is needed.
+class ObjectPoolFreeList
+{
+public:
+    ObjectPoolFreeList(std::size_t blockSize) :
+        mBlockSize(blockSize),
+        mHead(nullptr),
+        mNbBlocks(0)
+    {}
+
+    //! \brief Releases the kept blocks
+    ~ObjectPoolFreeList();
+
+    //! \brief Returns a block of blockSize bytes (reused if possible)
+    void* allocate();
+
+    //! \brief Keeps the given block for later use (or releases it if enough blocks are kept)
+    void release(void* block);
+
+private:
+    struct FreeBlock
+    {
+        FreeBlock* mNext;
+    };
+
+    //! \brief Maximum number of blocks kept per thread and per type. It is enough for big battles
+    //! and avoids keeping too much memory once they are over
+    static const uint32_t MAX_FREE_BLOCKS = 256;
+
+    std::size_t mBlockSize;
+    FreeBlock* mHead;
+    uint32_t mNbBlocks;
+};
+
+//! \brief Classes inheriting from PooledObject<T> (T being the class itself) allocate their instances
+//! from a pool. When an instance is deleted (usually in GameMap::processDeletionQueues), its memory
+//! is kept and given back to the next instance created. That avoids hammering the allocator with
+//! short-lived entities like missiles.
+//! Note that classes deriving from T do not have the same size and use the default allocator.
+template<typename T>
+class PooledObject
+{
+public:
+    static void* operator new(std::size_t size)
+    {
+        if(size != sizeof(T))
+            return ::operator new(size);
+
+        return getFreeList().allocate();
+    }
+
+    static void operator delete(void* p, std::size_t size)
+    {
+        if(p == nullptr)
+            return;
+
+        if(size != sizeof(T))
+        {
+            ::operator delete(p);
+            return;
+        }
+
+        getFreeList().release(p);
+    }
+
+private:
+    static ObjectPoolFreeList& getFreeList()
+    {
+        static thread_local ObjectPoolFreeList freeList(sizeof(T));
+        return freeList;
+    }
+};
+
+#endif // OBJECTPOOL_H
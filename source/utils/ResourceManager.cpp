@@ -88,6 +88,14 @@ ResourceManager::ResourceManager(boost::program_options::variables_map& options)
         mServerMode(false),
         mForcedNetworkPort(-1),
         mLogLevel(LogMessageLevel::NORMAL),
+        mMetricsPort(0),
+        mMetricsAddress("127.0.0.1"),
+        mServerTurnsPerSecond(0.0),
+        mServerMaxSpeed(false),
+        mTurnLeadWindow(0),
+        mClientMessageBudgetMs(8),
+        mNoAnimationLod(false),
+        mTraceAtStartup(false),
         mGameDataPath("./"),
         mUserDataPath("./"),
         mUserConfigPath("./")
@@ -442,6 +450,35 @@ void ResourceManager::setupUserDataFolders(boost::program_options::variables_map
     if(itOption != options.end())
         mLogLevel = static_cast<LogMessageLevel>(itOption->second.as<int32_t>());
 
+    itOption = options.find("metricsfile");
+    if(itOption != options.end())
+        mMetricsFile = itOption->second.as<std::string>();
+
+    itOption = options.find("metricsport");
+    if(itOption != options.end())
+        mMetricsPort = itOption->second.as<uint32_t>();
+
+    itOption = options.find("metricsaddress");
+    if(itOption != options.end())
+        mMetricsAddress = itOption->second.as<std::string>();
+
+    itOption = options.find("turnspersecond");
+    if(itOption != options.end())
+        mServerTurnsPerSecond = itOption->second.as<double>();
+
+    mServerMaxSpeed = (options.count("maxspeed") > 0);
+
+    itOption = options.find("turnlead");
+    if(itOption != options.end())
+        mTurnLeadWindow = itOption->second.as<uint32_t>();
+
+    itOption = options.find("messagebudget");
+    if(itOption != options.end())
+        mClientMessageBudgetMs = itOption->second.as<uint32_t>();
+
+    mNoAnimationLod = (options.count("noanimationlod") > 0);
+    mTraceAtStartup = (options.count("trace") > 0);
+
     mUserConfigFile = mUserConfigPath + USERCFGFILENAME;
     mCeguiLogFile = mUserDataPath + CEGUILOGFILENAME;
     mShaderCachePath = mUserDataPath + SHADERCACHESUBPATH;
@@ -602,6 +639,15 @@ void ResourceManager::buildCommandOptions(boost::program_options::options_descri
         ("mscreator", boost::program_options::value<std::string>(), "Sets the creator for this map to connect to the master server. server/servercustom/serversave option needs to be on")
         ("port", boost::program_options::value<int32_t>(), "Sets the port used. Note that the port is used for both single and multi player")
         ("loglevel", boost::program_options::value<int32_t>(), "Sets the log level (between 0=Trivial and 3=Critical)")
+        ("metricsfile", boost::program_options::value<std::string>(), "Periodically writes the performance metrics to the given file. Works in server mode or when hosting a game")
+        ("metricsport", boost::program_options::value<uint32_t>(), "Serves the performance metrics over HTTP on the given port. Works in server mode or when hosting a game")
+        ("metricsaddress", boost::program_options::value<std::string>(), "Address the metrics port is bound to. Defaults to 127.0.0.1. Other hosts are only allowed if another address is given")
+        ("turnspersecond", boost::program_options::value<double>(), "Server mode only. Sets how many turns are computed per second")
+        ("maxspeed", "Server mode only. Computes the turns as fast as possible. Meant for AI only games and tests")
+        ("turnlead", boost::program_options::value<uint32_t>(), "Sets how many turns a client can lag behind before the server stops sending it state refreshes until it catches up. With 0 (default), the server waits for every client")
+        ("messagebudget", boost::program_options::value<uint32_t>(), "Sets how many milliseconds per frame the client can spend applying the messages from the server (8 by default)")
+        ("noanimationlod", "Advances every animation every frame, even for the entities off screen or far from the camera. Meant to compare frame times")
+        ("trace", "Starts recording a timeline trace at startup. It is written to trace.json in the user data directory when SIGUSR1 is received")
     ;
 }
 
@@ -151,6 +151,35 @@ public:
     inline LogMessageLevel getLogLevel() const
     { return mLogLevel; }
 
+    inline const std::string& getMetricsFile() const
+    { return mMetricsFile; }
+
+    inline uint32_t getMetricsPort() const
+    { return mMetricsPort; }
+
+    inline const std::string& getMetricsAddress() const
+    { return mMetricsAddress; }
+
+    //! \brief Turn rate forced by the command line (0 if not forced)
+    inline double getServerTurnsPerSecond() const
+    { return mServerTurnsPerSecond; }
+
+    inline bool getServerMaxSpeed() const
+    { return mServerMaxSpeed; }
+
+    inline uint32_t getTurnLeadWindow() const
+    { return mTurnLeadWindow; }
+
+    //! \brief Time the client can spend per frame applying the messages from the server
+    inline uint32_t getClientMessageBudgetMs() const
+    { return mClientMessageBudgetMs; }
+
+    inline bool getNoAnimationLod() const
+    { return mNoAnimationLod; }
+
+    inline bool getTraceAtStartup() const
+    { return mTraceAtStartup; }
+
 private:
     //! \brief used when the executable is launched in server mode
     bool mServerMode;
@@ -163,6 +192,28 @@ private:
     //! \brief The log level
     LogMessageLevel mLogLevel;
 
+    //! \brief Where the server exports its performance metrics (empty/0 if not used)
+    std::string mMetricsFile;
+    uint32_t mMetricsPort;
+
+    //! \brief Address the metrics port is bound to (loopback by default)
+    std::string mMetricsAddress;
+
+    //! \brief Turn rate and max speed mode of the dedicated server
+    double mServerTurnsPerSecond;
+    bool mServerMaxSpeed;
+
+    //! \brief How many turns a client can lag behind before the server skips it (0 for lockstep)
+    uint32_t mTurnLeadWindow;
+
+    uint32_t mClientMessageBudgetMs;
+
+    //! \brief If true, animations are advanced every frame whether the entities are displayed or not
+    bool mNoAnimationLod;
+
+    //! \brief If true, trace recording is started with the application
+    bool mTraceAtStartup;
+
     //! \brief The application data path
     //! \example "/usr/share/game/opendungeons" on linux
     //! \example "C:/opendungeons" on windows
@@ -0,0 +1,379 @@
+/*!
+ *  Copyright (C) 2011-2016  OpenDungeons Team
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "utils/TextFileTokenizer.h"
+
+#include "utils/LogManager.h"
+
+#include <boost/filesystem.hpp>
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+
+#include <cstdlib>
+#include <cstring>
+
+namespace
+{
+    const char COMMENT_CHAR = '#';
+
+    inline bool isWhitespace(char c)
+    {
+        return (c == ' ') || (c == '\t') || (c == '\n') || (c == '\r') || (c == '\v') || (c == '\f');
+    }
+
+    inline bool isDigit(char c)
+    {
+        return (c >= '0') && (c <= '9');
+    }
+
+    //! \brief Powers of ten that can be exactly represented by a double
+    const double EXACT_POWERS_OF_TEN[] =
+    {
+        1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+        1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+    };
+    const int32_t MAX_EXACT_POWER_OF_TEN = 22;
+    const uint64_t MAX_EXACT_MANTISSA = (static_cast<uint64_t>(1) << 53);
+}
+
+TextFileTokenizer::TextFileTokenizer() :
+    mEnd(nullptr)
+{
+    setContent(nullptr, nullptr);
+}
+
+TextFileTokenizer::TextFileTokenizer(boost::string_ref content) :
+    mEnd(nullptr)
+{
+    setContent(content.data(), content.data() + content.size());
+}
+
+TextFileTokenizer::~TextFileTokenizer()
+{
+}
+
+bool TextFileTokenizer::open(const std::string& fileName)
+{
+    mRegion.reset();
+    setContent(nullptr, nullptr);
+
+    boost::system::error_code ec;
+    if(!boost::filesystem::is_regular_file(fileName, ec))
+    {
+        OD_LOG_WRN("File not found=" + fileName);
+        return false;
+    }
+
+    // Mapping an empty file is not allowed. In this case, there is nothing to tokenize
+    uintmax_t fileSize = boost::filesystem::file_size(fileName, ec);
+    if(ec || (fileSize == 0))
+        return !ec;
+
+    try
+    {
+        boost::interprocess::file_mapping mapping(fileName.c_str(), boost::interprocess::read_only);
+        mRegion.reset(new boost::interprocess::mapped_region(mapping, boost::interprocess::read_only));
+    }
+    catch(const boost::interprocess::interprocess_exception& e)
+    {
+        OD_LOG_WRN("Couldn't map file=" + fileName + ", error=" + e.what());
+        return false;
+    }
+
+    const char* begin = static_cast<const char*>(mRegion->get_address());
+    setContent(begin, begin + mRegion->get_size());
+    return true;
+}
+
+void TextFileTokenizer::setContent(const char* begin, const char* end)
+{
+    mEnd = end;
+    // The get area is empty so that the first read will compute the first segment
+    char* start = const_cast<char*>(begin);
+    setg(start, start, start);
+}
+
+bool TextFileTokenizer::fillSegment()
+{
+    if(gptr() < egptr())
+        return true;
+
+    const char* cursor = egptr();
+    if((cursor == nullptr) || (cursor >= mEnd))
+        return false;
+
+    // A segment always stops on a comment. We skip it up to the end of the line
+    // but we keep the end of line so that line delimiters are not lost
+    if(*cursor == COMMENT_CHAR)
+    {
+        const void* eol = std::memchr(cursor, '\n', mEnd - cursor);
+        if(eol == nullptr)
+        {
+            char* end = const_cast<char*>(mEnd);
+            setg(end, end, end);
+            return false;
+        }
+        cursor = static_cast<const char*>(eol);
+    }
+
+    const void* comment = std::memchr(cursor, COMMENT_CHAR, mEnd - cursor);
+    const char* segmentEnd = (comment != nullptr) ? static_cast<const char*>(comment) : mEnd;
+    char* start = const_cast<char*>(cursor);
+    setg(start, start, const_cast<char*>(segmentEnd));
+    return true;
+}
+
+TextFileTokenizer::int_type TextFileTokenizer::underflow()
+{
+    if(!fillSegment())
+        return traits_type::eof();
+
+    return traits_type::to_int_type(*gptr());
+}
+
+bool TextFileTokenizer::skipWhitespaces()
+{
+    while(fillSegment())
+    {
+        char* cursor = gptr();
+        char* end = egptr();
+        while((cursor < end) && isWhitespace(*cursor))
+            ++cursor;
+
+        setg(eback(), cursor, end);
+        if(cursor < end)
+            return true;
+    }
+    return false;
+}
+
+bool TextFileTokenizer::isEof()
+{
+    return !skipWhitespaces();
+}
+
+bool TextFileTokenizer::peekToken(boost::string_ref& token)
+{
+    if(!skipWhitespaces())
+        return false;
+
+    // Tokens cannot be split between 2 segments because segments stop on comments
+    const char* start = gptr();
+    const char* cursor = start;
+    const char* end = egptr();
+    while((cursor < end) && !isWhitespace(*cursor))
+        ++cursor;
+
+    token = boost::string_ref(start, cursor - start);
+    return true;
+}
+
+bool TextFileTokenizer::nextToken(boost::string_ref& token)
+{
+    if(!peekToken(token))
+        return false;
+
+    setg(eback(), gptr() + token.size(), egptr());
+    return true;
+}
+
+bool TextFileTokenizer::nextLine(boost::string_ref& line)
+{
+    if(!fillSegment())
+        return false;
+
+    const char* start = gptr();
+    const char* end = egptr();
+    const void* eol = std::memchr(start, '\n', end - start);
+    if(eol != nullptr)
+    {
+        end = static_cast<const char*>(eol);
+        setg(eback(), const_cast<char*>(end + 1), egptr());
+    }
+    else
+    {
+        // The line stops on a comment or on the end of file. In both cases,
+        // we consume the end of line if any
+        setg(eback(), egptr(), egptr());
+        if(fillSegment() && (*gptr() == '\n'))
+            setg(eback(), gptr() + 1, egptr());
+    }
+
+    if((end > start) && (*(end - 1) == '\r'))
+        --end;
+
+    line = boost::string_ref(start, end - start);
+    return true;
+}
+
+bool TextFileTokenizer::nextInt32(int32_t& value)
+{
+    boost::string_ref token;
+    if(!nextToken(token))
+        return false;
+
+    return toInt32(token, value);
+}
+
+bool TextFileTokenizer::nextUInt32(uint32_t& value)
+{
+    boost::string_ref token;
+    if(!nextToken(token))
+        return false;
+
+    return toUInt32(token, value);
+}
+
+bool TextFileTokenizer::nextDouble(double& value)
+{
+    boost::string_ref token;
+    if(!nextToken(token))
+        return false;
+
+    return toDouble(token, value);
+}
+
+bool TextFileTokenizer::nextFloat(float& value)
+{
+    double d;
+    if(!nextDouble(d))
+        return false;
+
+    value = static_cast<float>(d);
+    return true;
+}
+
+bool TextFileTokenizer::toInt32(boost::string_ref str, int32_t& value)
+{
+    uint32_t absValue;
+    bool negative = !str.empty() && (str.front() == '-');
+    if(negative)
+        str.remove_prefix(1);
+    else if(!str.empty() && (str.front() == '+'))
+        str.remove_prefix(1);
+
+    if(str.empty() || (str.front() == '-') || (str.front() == '+'))
+        return false;
+
+    if(!toUInt32(str, absValue))
+        return false;
+
+    int64_t v = negative ? -static_cast<int64_t>(absValue) : static_cast<int64_t>(absValue);
+    if((v > INT32_MAX) || (v < INT32_MIN))
+        return false;
+
+    value = static_cast<int32_t>(v);
+    return true;
+}
+
+bool TextFileTokenizer::toUInt32(boost::string_ref str, uint32_t& value)
+{
+    bool negative = !str.empty() && (str.front() == '-');
+    if(negative || (!str.empty() && (str.front() == '+')))
+        str.remove_prefix(1);
+
+    uint64_t v = 0;
+    size_t nbDigits = 0;
+    for(char c : str)
+    {
+        if(!isDigit(c))
+            break;
+
+        v = v * 10 + static_cast<uint64_t>(c - '0');
+        if(v > UINT32_MAX)
+            return false;
+
+        ++nbDigits;
+    }
+
+    if(nbDigits == 0)
+        return false;
+
+    // Same behaviour as streams: negative values wrap around
+    value = negative ? static_cast<uint32_t>(0 - v) : static_cast<uint32_t>(v);
+    return true;
+}
+
+bool TextFileTokenizer::toDouble(boost::string_ref str, double& value)
+{
+    const char* cursor = str.data();
+    const char* end = cursor + str.size();
+
+    bool negative = false;
+    if((cursor < end) && ((*cursor == '-') || (*cursor == '+')))
+    {
+        negative = (*cursor == '-');
+        ++cursor;
+    }
+
+    uint64_t mantissa = 0;
+    int32_t exponent = 0;
+    uint32_t nbDigits = 0;
+    bool mantissaTruncated = false;
+    for(; (cursor < end) && isDigit(*cursor); ++cursor, ++nbDigits)
+    {
+        if(mantissa < MAX_EXACT_MANTISSA)
+            mantissa = mantissa * 10 + static_cast<uint64_t>(*cursor - '0');
+        else
+        {
+            mantissaTruncated = true;
+            ++exponent;
+        }
+    }
+
+    if((cursor < end) && (*cursor == '.'))
+    {
+        for(++cursor; (cursor < end) && isDigit(*cursor); ++cursor, ++nbDigits)
+        {
+            if(mantissa < MAX_EXACT_MANTISSA)
+            {
+                mantissa = mantissa * 10 + static_cast<uint64_t>(*cursor - '0');
+                --exponent;
+            }
+            else
+                mantissaTruncated = true;
+        }
+    }
+
+    if(nbDigits == 0)
+        return false;
+
+    if((cursor < end) && ((*cursor == 'e') || (*cursor == 'E')))
+    {
+        int32_t exp;
+        if(toInt32(boost::string_ref(cursor + 1, end - cursor - 1), exp))
+            exponent += exp;
+    }
+
+    // When the value cannot be computed exactly, we fallback to the standard conversion
+    if(mantissaTruncated || (mantissa >= MAX_EXACT_MANTISSA) ||
+       (exponent > MAX_EXACT_POWER_OF_TEN) || (exponent < -MAX_EXACT_POWER_OF_TEN))
+    {
+        std::string copy(str.data(), str.size());
+        value = std::strtod(copy.c_str(), nullptr);
+        return true;
+    }
+
+    double d = static_cast<double>(mantissa);
+    if(exponent >= 0)
+        d *= EXACT_POWERS_OF_TEN[exponent];
+    else
+        d /= EXACT_POWERS_OF_TEN[-exponent];
+
+    value = negative ? -d : d;
+    return true;
+}
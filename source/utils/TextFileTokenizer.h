@@ -0,0 +1,107 @@
+/*!
+ *  Copyright (C) 2011-2016  OpenDungeons Team
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TEXTFILETOKENIZER_H
+#define TEXTFILETOKENIZER_H
+
+#include <boost/utility/string_ref.hpp>
+
+#include <cstdint>
+#include <memory>
+#include <streambuf>
+#include <string>
+
+namespace boost
+{
+namespace interprocess
+{
+class mapped_region;
+}
+}
+
+//! \brief Single pass tokenizer for the human editable text files (levels, configuration files).
+//! The file is memory mapped and comments (from '#' to the end of the line) are skipped in place,
+//! so that the returned tokens reference the mapped memory directly without any copy.
+//! The tokenizer is also a std::streambuf. That allows to build a std::istream on top of it for
+//! the loaders that still work with streams. Both share the same read position and can be mixed.
+//! Note that the returned tokens are only valid as long as the tokenizer lives.
+class TextFileTokenizer : public std::streambuf
+{
+public:
+    TextFileTokenizer();
+
+    //! \brief Tokenizes the given memory range. The memory is not copied and should live
+    //! longer than the tokenizer
+    TextFileTokenizer(boost::string_ref content);
+
+    virtual ~TextFileTokenizer();
+
+    //! \brief Maps the given file. Returns true if the file could be open and false otherwise
+    bool open(const std::string& fileName);
+
+    //! \brief Returns true if there is nothing more to read
+    bool isEof();
+
+    //! \brief Reads the next whitespace delimited token. Returns false if the end of the file is reached
+    bool nextToken(boost::string_ref& token);
+
+    //! \brief Same as nextToken but does not consume the token
+    bool peekToken(boost::string_ref& token);
+
+    //! \brief Reads what is left on the current line (comment excluded) and moves to the next
+    //! line. Returns false if the end of the file is reached
+    bool nextLine(boost::string_ref& line);
+
+    //! \brief Reads the next token and converts it. Returns false if the end of the file is
+    //! reached or if the token is not a valid number.
+    bool nextInt32(int32_t& value);
+    bool nextUInt32(uint32_t& value);
+    bool nextDouble(double& value);
+    bool nextFloat(float& value);
+
+    //! \brief Number conversions working on tokens. Like with streams, the conversion
+    //! stops at the first character that do not belong to the number. Returns false if
+    //! no number could be read
+    static bool toInt32(boost::string_ref str, int32_t& value);
+    static bool toUInt32(boost::string_ref str, uint32_t& value);
+    static bool toDouble(boost::string_ref str, double& value);
+
+protected:
+    //! \brief std::streambuf interface. The get area is set to the content up to the next comment
+    int_type underflow() override;
+
+private:
+    TextFileTokenizer(const TextFileTokenizer&) = delete;
+    TextFileTokenizer& operator=(const TextFileTokenizer&) = delete;
+
+    //! \brief Sets the read position at the beginning of the given content
+    void setContent(const char* begin, const char* end);
+
+    //! \brief Makes sure there is something available in the get area. Returns false on end of file
+    bool fillSegment();
+
+    //! \brief Skips whitespaces (and comments). Returns false on end of file
+    bool skipWhitespaces();
+
+    //! \brief The mapped file if any
+    std::unique_ptr<boost::interprocess::mapped_region> mRegion;
+
+    //! \brief End of the content to tokenize
+    const char* mEnd;
+};
+
+#endif // TEXTFILETOKENIZER_H
@@ -0,0 +1,327 @@
+/*
+ *  Copyright (C) 2011-2016  OpenDungeons Team
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "utils/Tracing.h"
+
+#include "utils/Helper.h"
+#include "utils/LogManager.h"
+
+#include <SFML/System.hpp>
+
+#include <chrono>
+#include <csignal>
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <vector>
+
+namespace
+{
+    //! \brief Events recorded after this number in a given thread are dropped so that
+    //! forgetting to stop recording does not eat all the memory
+    const size_t MAX_EVENTS_PER_THREAD = 1000000;
+
+    struct TraceEvent
+    {
+        //! \brief Used if not null. Otherwise, mName is used
+        const char* mStaticName;
+        std::string mName;
+        int64_t mStartUs;
+        int64_t mDurationUs;
+    };
+
+    struct ThreadBuffer
+    {
+        //! \brief Only contended while starting or dumping
+        sf::Mutex mLock;
+        uint32_t mThreadId;
+        std::string mThreadName;
+        std::vector<TraceEvent> mEvents;
+        uint64_t mNbDropped;
+    };
+
+    //! \brief Thread buffers are kept after their thread ends so that their events can still be dumped
+    struct Registry
+    {
+        sf::Mutex mLock;
+        std::vector<std::shared_ptr<ThreadBuffer>> mBuffers;
+        std::string mDefaultDumpFile = "trace.json";
+    };
+
+    Registry& getRegistry()
+    {
+        static Registry registry;
+        return registry;
+    }
+
+    std::atomic<bool> gRecording(false);
+    volatile std::sig_atomic_t gDumpRequested = 0;
+
+    const std::chrono::steady_clock::time_point gTimeOrigin = std::chrono::steady_clock::now();
+
+    int64_t nowUs()
+    {
+        return std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - gTimeOrigin).count();
+    }
+
+    ThreadBuffer& getThreadBuffer()
+    {
+        static thread_local ThreadBuffer* threadBuffer = nullptr;
+        if(threadBuffer != nullptr)
+            return *threadBuffer;
+
+        std::shared_ptr<ThreadBuffer> buffer = std::make_shared<ThreadBuffer>();
+        buffer->mNbDropped = 0;
+        Registry& registry = getRegistry();
+        sf::Lock lock(registry.mLock);
+        buffer->mThreadId = static_cast<uint32_t>(registry.mBuffers.size() + 1);
+        registry.mBuffers.push_back(buffer);
+        threadBuffer = buffer.get();
+        return *threadBuffer;
+    }
+
+    void recordEvent(const char* staticName, std::string&& name, int64_t startUs)
+    {
+        int64_t duration = nowUs() - startUs;
+        ThreadBuffer& buffer = getThreadBuffer();
+        sf::Lock lock(buffer.mLock);
+        if(buffer.mEvents.size() >= MAX_EVENTS_PER_THREAD)
+        {
+            ++buffer.mNbDropped;
+            return;
+        }
+        buffer.mEvents.push_back(TraceEvent());
+        TraceEvent& event = buffer.mEvents.back();
+        event.mStaticName = staticName;
+        event.mName = std::move(name);
+        event.mStartUs = startUs;
+        event.mDurationUs = duration;
+    }
+
+    void writeJsonString(std::ostream& os, const char* str)
+    {
+        os << '"';
+        for(; *str != '\0'; ++str)
+        {
+            char c = *str;
+            switch(c)
+            {
+                case '"':
+                    os << "\\\"";
+                    break;
+                case '\\':
+                    os << "\\\\";
+                    break;
+                default:
+                    if(static_cast<unsigned char>(c) < 0x20)
+                    {
+                        char escaped[8];
+                        std::snprintf(escaped, sizeof(escaped), "\\u%04x", static_cast<unsigned int>(c));
+                        os << escaped;
+                    }
+                    else
+                        os << c;
+                    break;
+            }
+        }
+        os << '"';
+    }
+
+#ifndef _WIN32
+    void signalHandler(int)
+    {
+        Tracing::requestDump();
+    }
+#endif
+}
+
+namespace Tracing
+{
+
+bool isRecording()
+{
+    return gRecording.load(std::memory_order_relaxed);
+}
+
+void start()
+{
+    Registry& registry = getRegistry();
+    sf::Lock lock(registry.mLock);
+    for(std::shared_ptr<ThreadBuffer>& buffer : registry.mBuffers)
+    {
+        sf::Lock bufferLock(buffer->mLock);
+        buffer->mEvents.clear();
+        buffer->mNbDropped = 0;
+    }
+    gRecording.store(true, std::memory_order_relaxed);
+}
+
+void stop()
+{
+    gRecording.store(false, std::memory_order_relaxed);
+}
+
+uint64_t getNbEvents()
+{
+    uint64_t nbEvents = 0;
+    Registry& registry = getRegistry();
+    sf::Lock lock(registry.mLock);
+    for(std::shared_ptr<ThreadBuffer>& buffer : registry.mBuffers)
+    {
+        sf::Lock bufferLock(buffer->mLock);
+        nbEvents += buffer->mEvents.size();
+    }
+    return nbEvents;
+}
+
+bool dumpToFile(const std::string& fileName)
+{
+    std::ofstream file(fileName.c_str(), std::ios_base::out | std::ios_base::trunc);
+    if(!file.is_open())
+    {
+        OD_LOG_ERR("Couldn't open trace file=" + fileName);
+        return false;
+    }
+
+    // Every event is a complete event ("X") with timestamps in microseconds
+    file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    bool first = true;
+    uint64_t nbDropped = 0;
+    Registry& registry = getRegistry();
+    sf::Lock lock(registry.mLock);
+    for(std::shared_ptr<ThreadBuffer>& buffer : registry.mBuffers)
+    {
+        sf::Lock bufferLock(buffer->mLock);
+        nbDropped += buffer->mNbDropped;
+        if(!buffer->mThreadName.empty())
+        {
+            file << (first ? "\n" : ",\n");
+            first = false;
+            file << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << buffer->mThreadId
+                << ",\"args\":{\"name\":";
+            writeJsonString(file, buffer->mThreadName.c_str());
+            file << "}}";
+        }
+
+        for(const TraceEvent& event : buffer->mEvents)
+        {
+            file << (first ? "\n" : ",\n");
+            first = false;
+            file << "{\"name\":";
+            writeJsonString(file, event.mStaticName != nullptr ? event.mStaticName : event.mName.c_str());
+            file << ",\"ph\":\"X\",\"pid\":1,\"tid\":" << buffer->mThreadId
+                << ",\"ts\":" << event.mStartUs << ",\"dur\":" << event.mDurationUs << "}";
+        }
+    }
+    file << "\n]}\n";
+
+    if(!file.good())
+    {
+        OD_LOG_ERR("Error while writing trace file=" + fileName);
+        return false;
+    }
+
+    if(nbDropped > 0)
+        OD_LOG_WRN("Trace buffers were full, " + Helper::toString(nbDropped) + " events were dropped");
+
+    OD_LOG_INF("Trace written to file=" + fileName);
+    return true;
+}
+
+void setThreadName(const std::string& name)
+{
+    ThreadBuffer& buffer = getThreadBuffer();
+    sf::Lock lock(buffer.mLock);
+    buffer.mThreadName = name;
+}
+
+void setDefaultDumpFile(const std::string& fileName)
+{
+    Registry& registry = getRegistry();
+    sf::Lock lock(registry.mLock);
+    registry.mDefaultDumpFile = fileName;
+}
+
+void requestDump()
+{
+    gDumpRequested = 1;
+}
+
+void dumpIfRequested()
+{
+    if(gDumpRequested == 0)
+        return;
+
+    gDumpRequested = 0;
+    // Without the --trace option, nothing was recorded yet. The first request starts
+    // recording and the next one writes the trace
+    if(!isRecording())
+    {
+        start();
+        OD_LOG_INF("Trace recording started, it will be written on the next dump request");
+        return;
+    }
+
+    std::string fileName;
+    {
+        Registry& registry = getRegistry();
+        sf::Lock lock(registry.mLock);
+        fileName = registry.mDefaultDumpFile;
+    }
+    dumpToFile(fileName);
+}
+
+void installSignalHandler()
+{
+#ifndef _WIN32
+    std::signal(SIGUSR1, signalHandler);
+#endif
+}
+
+ScopedEvent::ScopedEvent(const char* name) :
+    mStaticName(nullptr),
+    mStartUs(0)
+{
+    if(!isRecording())
+        return;
+
+    mStaticName = name;
+    mStartUs = nowUs();
+}
+
+ScopedEvent::ScopedEvent(std::string&& name) :
+    mStaticName(nullptr),
+    mName(std::move(name)),
+    mStartUs(0)
+{
+    // The name is empty when it was not built because recording was not active
+    if(mName.empty())
+        return;
+
+    mStartUs = nowUs();
+}
+
+ScopedEvent::~ScopedEvent()
+{
+    if((mStaticName == nullptr) && mName.empty())
+        return;
+
+    recordEvent(mStaticName, std::move(mName), mStartUs);
+}
+
+}
@@ -0,0 +1,106 @@
+/*
+ *  Copyright (C) 2011-2016  OpenDungeons Team
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TRACING_H
+#define TRACING_H
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+//! \brief Timeline tracing. Scopes marked with OD_TRACE_SCOPE are recorded as complete events
+//! (with their thread) into per thread buffers while recording is active. The recorded events
+//! can be dumped in the Chrome trace JSON format that can be opened with chrome://tracing or
+//! Perfetto.
+//! Tracing points are only compiled when OD_ENABLE_TRACING is defined (cmake option of the
+//! same name). Otherwise, the macros expand to nothing.
+//! Example:
+//! \code
+//! OD_TRACE_SCOPE("GameMap::doTurn");
+//! OD_TRACE_SCOPE_DYNAMIC("Creature action " + CreatureAction::toString(type));
+//! \endcode
+namespace Tracing
+{
+    //! \brief Returns true if events are currently recorded
+    bool isRecording();
+
+    //! \brief Clears the previously recorded events and starts recording
+    void start();
+
+    //! \brief Stops recording. Recorded events are kept until the next start
+    void stop();
+
+    //! \brief Writes the recorded events in the Chrome trace JSON format. Returns false if
+    //! the file could not be written
+    bool dumpToFile(const std::string& fileName);
+
+    //! \brief Returns the number of recorded events
+    uint64_t getNbEvents();
+
+    //! \brief Name displayed for the calling thread in the timeline
+    void setThreadName(const std::string& name);
+
+    //! \brief File written by dumpIfRequested
+    void setDefaultDumpFile(const std::string& fileName);
+
+    //! \brief Asks for a dump to the default file. It is safe to call from a signal handler
+    void requestDump();
+
+    //! \brief Dumps the recorded events to the default file if requestDump has been called
+    //! since the last dump. If recording was not active, it is started instead so that the
+    //! next request writes the trace. Should be called regularly by the main loops
+    void dumpIfRequested();
+
+    //! \brief Installs a handler requesting a dump on SIGUSR1 (no-op where not available)
+    void installSignalHandler();
+
+    //! \brief Records the time elapsed between its construction and its destruction. Nothing
+    //! is recorded if recording was not active at construction time
+    class ScopedEvent
+    {
+    public:
+        explicit ScopedEvent(const char* name);
+        explicit ScopedEvent(std::string&& name);
+        ~ScopedEvent();
+
+    private:
+        ScopedEvent(const ScopedEvent&) = delete;
+        ScopedEvent& operator=(const ScopedEvent&) = delete;
+
+        const char* mStaticName;
+        std::string mName;
+        int64_t mStartUs;
+    };
+}
+
+#define OD_TRACE_CONCAT_IMPL(a, b) a##b
+#define OD_TRACE_CONCAT(a, b) OD_TRACE_CONCAT_IMPL(a, b)
+
+#ifdef OD_ENABLE_TRACING
+//! \brief Traces the enclosing scope. _name should be a string literal
+#define OD_TRACE_SCOPE(_name) \
+    Tracing::ScopedEvent OD_TRACE_CONCAT(odTraceEvent, __LINE__)(_name)
+//! \brief Traces the enclosing scope with a name built at runtime. The name expression is
+//! only evaluated while recording
+#define OD_TRACE_SCOPE_DYNAMIC(_nameExpr) \
+    Tracing::ScopedEvent OD_TRACE_CONCAT(odTraceEvent, __LINE__)(Tracing::isRecording() ? std::string(_nameExpr) : std::string())
+#else
+#define OD_TRACE_SCOPE(_name) static_cast<void>(0)
+#define OD_TRACE_SCOPE_DYNAMIC(_nameExpr) static_cast<void>(0)
+#endif // OD_ENABLE_TRACING
+
+#endif // TRACING_H